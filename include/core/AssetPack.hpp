@@ -0,0 +1,71 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "core/AssetPackFormat.hpp"
+#include "core/MappedFile.hpp"
+
+namespace SFE {
+
+// Bytes of one asset: a view into a mapped pack or loose file (no copy), or an owned buffer for a
+// decompressed pack entry or an asynchronous read (VFS). Valid while this object and the pack it
+// came from live.
+class AssetData {
+public:
+    AssetData() = default;
+    AssetData(const AssetData&) = delete;
+    AssetData& operator=(const AssetData&) = delete;
+    AssetData(AssetData&&) noexcept = default;
+    AssetData& operator=(AssetData&&) noexcept = default;
+
+    const uint8_t* getData() const { return data; }
+    size_t getSize() const { return size; }
+    std::string_view getText() const { return {reinterpret_cast<const char*>(data), size}; }
+    // True when the bytes live in this object (decompressed or read) rather than in a mapping
+    bool ownsData() const { return !storage.empty(); }
+
+    void reset();
+
+private:
+    friend class AssetPack;
+    friend class VFS;
+
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    std::vector<uint8_t> storage;
+    MappedFile file; // Loose files keep their own mapping
+};
+
+// A memory-mapped .sfp pack (tools/asset_packer). Lookups are a binary search over the path
+// hashes; stored entries are returned as views into the mapping, LZ4 entries are decompressed
+// into the AssetData. Read-only once open, so it can be read from any thread; open() and close()
+// must not race with readers.
+class AssetPack {
+public:
+    AssetPack() = default;
+    AssetPack(const AssetPack&) = delete;
+    AssetPack& operator=(const AssetPack&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return header != nullptr; }
+
+    // nullptr if the pack has no such path (normalised before lookup)
+    const AssetPackEntry* find(const std::string& path) const;
+    bool read(const AssetPackEntry& entry, AssetData& data) const;
+    std::string_view getPath(const AssetPackEntry& entry) const;
+
+    size_t getEntryCount() const { return header ? header->entryCount : 0; }
+    const AssetPackEntry* begin() const { return entries; }
+    const AssetPackEntry* end() const { return entries + getEntryCount(); }
+
+private:
+    MappedFile file;
+    const AssetPackHeader* header = nullptr;
+    const AssetPackEntry* entries = nullptr;
+    const char* paths = nullptr;
+};
+
+} // namespace SFE
@@ -0,0 +1,79 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace SFE {
+
+// Asset pack (.sfp) written by tools/asset_packer and mapped by AssetPack.
+// Layout: AssetPackHeader | entry table | path strings | entry data. Every entry starts on an
+// ASSET_PACK_ALIGNMENT boundary, so stored (uncompressed) entries such as cooked meshes and
+// textures can be handed to GL straight from the mapping. The table is sorted by path hash for a
+// binary search. Compressed entries are single LZ4 blocks (core/Lz4.hpp).
+constexpr uint32_t ASSET_PACK_MAGIC = 0x4B504653; // "SFPK" little-endian
+constexpr uint32_t ASSET_PACK_VERSION = 1;
+constexpr uint32_t ASSET_PACK_ALIGNMENT = 64;
+
+enum class AssetCompression : uint32_t {
+    None,
+    LZ4,
+    Count
+};
+
+struct AssetPackHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t flags;
+    uint64_t entryTableOffset;
+    uint64_t pathTableOffset;
+    uint64_t fileSize;
+    uint32_t reserved[2];
+};
+static_assert(sizeof(AssetPackHeader) == 48, "AssetPackHeader layout is part of the file format");
+
+struct AssetPackEntry {
+    uint64_t pathHash;   // hashAssetPath of the path
+    uint64_t offset;     // From the start of the file
+    uint64_t storedSize; // Bytes in the file
+    uint64_t size;       // Bytes after decompression
+    uint32_t pathOffset; // Into the path table, not null-terminated
+    uint32_t pathLength;
+    uint32_t compression; // AssetCompression
+    uint32_t reserved;
+};
+static_assert(sizeof(AssetPackEntry) == 48, "AssetPackEntry layout is part of the file format");
+
+// Paths are relative, with forward slashes and no leading "./", e.g. "shaders/simple.vert"
+std::string normalizeAssetPath(const std::string& path);
+// 64-bit FNV-1a of a normalised path
+uint64_t hashAssetPath(const char* path, size_t length);
+
+struct AssetPackSource {
+    std::string path; // Normalised
+    std::vector<uint8_t> data;
+    bool compress = false; // Stored uncompressed anyway when LZ4 saves less than 1/8
+};
+
+struct AssetPackStats {
+    size_t entryCount = 0;
+    size_t compressedEntries = 0;
+    uint64_t inputBytes = 0;
+    uint64_t fileSize = 0;
+};
+
+// Write a pack of 'sources' (any order, paths unique) to 'path'. Returns false on I/O error or
+// duplicate paths.
+bool writeAssetPack(const std::string& path, const std::vector<AssetPackSource>& sources,
+                    AssetPackStats* stats = nullptr);
+
+// Check that 'data' holds a complete, supported pack whose entries are in range. Returns the
+// header (pointing into 'data') or nullptr with 'error' set.
+const AssetPackHeader* validateAssetPack(const uint8_t* data, size_t size, std::string& error);
+
+inline const AssetPackEntry* getAssetPackEntries(const uint8_t* data, const AssetPackHeader& header) {
+    return reinterpret_cast<const AssetPackEntry*>(data + header.entryTableOffset);
+}
+
+} // namespace SFE
@@ -0,0 +1,49 @@
+#pragma once
+#include <cstdint>
+
+namespace SFE {
+
+// Fixed-rate simulation clock. Each frame's elapsed time goes into an accumulator, which is
+// paid out in whole ticks of 'step' seconds; the remainder becomes the interpolation factor
+// between the previous and the current simulation state, so rendering can run at any rate
+// while the simulation always advances by the same amount. Not tied to a thread: whichever
+// thread owns the simulation calls advance().
+//
+//   uint32_t ticks = timestep.advance(frameSeconds);
+//   for (uint32_t i = 0; i < ticks; ++i) { previous = current; simulate(current, timestep.getStep()); }
+//   render(interpolate(previous, current, timestep.getAlpha()));
+class FixedTimestep {
+public:
+    // After a long stall (debugger, window drag) at most maxTicksPerFrame ticks are run and the
+    // rest of the backlog is discarded, rather than falling further behind every frame
+    explicit FixedTimestep(double stepSeconds = 1.0 / 60.0, uint32_t maxTicksPerFrame = 8);
+
+    // Adds a frame's elapsed time; returns the number of ticks to run now
+    uint32_t advance(double frameSeconds);
+
+    // Every advance() runs exactly one tick regardless of elapsed time, so a run is reproducible
+    // frame for frame (benchmarks, automated tests). Simulation time then runs slower or faster
+    // than wall time.
+    void setLockstep(bool enabled);
+    bool isLockstep() const { return lockstep; }
+
+    double getStep() const { return step; }
+    // Blend factor from the previous to the current state, in [0, 1); 1 in lockstep, where the
+    // current state is always exactly on time
+    float getAlpha() const { return lockstep ? 1.0f : static_cast<float>(accumulator / step); }
+    uint64_t getTickCount() const { return tickCount; }
+    // Time simulated so far (tick count times step)
+    double getSimulationTime() const { return static_cast<double>(tickCount) * step; }
+    // Wall time thrown away by the per-frame tick limit
+    double getDiscardedTime() const { return discarded; }
+
+private:
+    double step;
+    uint32_t maxTicksPerFrame;
+    double accumulator = 0.0;
+    uint64_t tickCount = 0;
+    double discarded = 0.0;
+    bool lockstep = false;
+};
+
+} // namespace SFE
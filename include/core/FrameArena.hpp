@@ -0,0 +1,89 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+
+namespace SFE {
+
+// Bump allocator over one block allocated up front. Deallocation is a no-op and reset() frees
+// everything at once in O(1), which suits data that lives for exactly one frame. Being a
+// std::pmr::memory_resource, std::pmr::vector/string and friends can allocate from it.
+// If the block runs out, allocations fall back to 'upstream' and are returned on reset(); the
+// overflow counter says when the capacity should be raised. Not thread-safe: one arena per
+// recording thread.
+class LinearArena : public std::pmr::memory_resource {
+public:
+    explicit LinearArena(size_t capacityBytes, std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+    ~LinearArena() override;
+
+    LinearArena(const LinearArena&) = delete;
+    LinearArena& operator=(const LinearArena&) = delete;
+
+    // Forgets every allocation
+    void reset();
+
+    // printf-style formatting into the arena; the string stays valid until reset()
+    const char* format(const char* fmt, ...)
+#if defined(__GNUC__)
+        __attribute__((format(printf, 2, 3)))
+#endif
+        ;
+
+    size_t getUsedBytes() const { return used; }
+    size_t getCapacity() const { return capacity; }
+    // Most bytes used between two resets, overflow included
+    size_t getPeakBytes() const { return peak; }
+    // Allocations that did not fit since the arena was created
+    uint64_t getOverflowCount() const { return overflowCount; }
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* /*pointer*/, size_t /*bytes*/, size_t /*alignment*/) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    // Header of an upstream allocation, chained so reset() can return them
+    struct OverflowBlock {
+        OverflowBlock* next;
+        size_t size;
+        size_t alignment;
+    };
+
+    std::pmr::memory_resource* upstream;
+    std::unique_ptr<unsigned char[]> storage;
+    size_t capacity = 0;
+    size_t used = 0;
+    size_t overflowBytes = 0;
+    size_t peak = 0;
+    uint64_t overflowCount = 0;
+    OverflowBlock* overflowBlocks = nullptr;
+};
+
+// Two LinearArenas used on alternate frames, for frame data that is handed to a pipelined
+// consumer (the RenderThread replays frame N while frame N+1 is recorded). beginFrame() resets
+// the arena of two frames ago, so the caller must know that frame is finished with it: with a
+// RenderThread, call it right after RenderThread::beginFrame(), which waits for exactly that.
+class FrameArena {
+public:
+    explicit FrameArena(size_t bytesPerFrame = 256 * 1024)
+        : arenas{std::make_unique<LinearArena>(bytesPerFrame), std::make_unique<LinearArena>(bytesPerFrame)} {}
+
+    void beginFrame() {
+        currentIndex ^= 1;
+        arenas[currentIndex]->reset();
+    }
+
+    LinearArena& current() { return *arenas[currentIndex]; }
+    std::pmr::memory_resource* resource() { return arenas[currentIndex].get(); }
+
+    template <typename... Args>
+    const char* format(const char* fmt, Args... args) {
+        return arenas[currentIndex]->format(fmt, args...);
+    }
+
+private:
+    std::unique_ptr<LinearArena> arenas[2];
+    uint32_t currentIndex = 0;
+};
+
+} // namespace SFE
@@ -0,0 +1,50 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+
+namespace SFE {
+
+// Offset-based suballocator for carving ranges out of a larger resource (e.g. a GPU buffer).
+// Sizes and offsets are in caller-defined units (vertices, indices, bytes...).
+// Free blocks are indexed both by offset (for coalescing) and by size (for best-fit lookup),
+// so allocate/free are O(log n) in the number of free blocks.
+class FreeListAllocator {
+public:
+    static constexpr uint32_t INVALID_OFFSET = 0xFFFFFFFFu;
+
+    explicit FreeListAllocator(uint32_t capacity = 0);
+
+    // Returns the offset of a block of 'size' units, or INVALID_OFFSET if no block fits
+    uint32_t allocate(uint32_t size);
+
+    // Returns a block previously handed out by allocate() to the free list
+    void free(uint32_t offset);
+
+    // Extends the managed range; existing allocations keep their offsets
+    void grow(uint32_t newCapacity);
+
+    // Drops every allocation and resets to a single free block
+    void reset();
+
+    uint32_t getCapacity() const { return capacity; }
+    uint32_t getUsed() const { return used; }
+    uint32_t getLargestFreeBlock() const;
+    size_t getFreeBlockCount() const { return freeByOffset.size(); }
+    size_t getAllocationCount() const { return allocations.size(); }
+
+private:
+    using SizeIndex = std::multimap<uint32_t, uint32_t>; // size -> offset
+
+    void insertFreeBlock(uint32_t offset, uint32_t size);
+    void removeFreeBlock(std::map<uint32_t, uint32_t>::iterator it);
+
+    uint32_t capacity;
+    uint32_t used;
+    std::map<uint32_t, uint32_t> freeByOffset; // offset -> size
+    SizeIndex freeBySize;
+    std::unordered_map<uint32_t, uint32_t> allocations; // offset -> size
+};
+
+} // namespace SFE
@@ -0,0 +1,121 @@
+#pragma once
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace SFE {
+
+// 32-bit reference to an object in a HandlePool<T>: a slot index plus the slot's generation at
+// creation. Destroying the object bumps the generation, so an old handle stops resolving instead
+// of reaching whatever reuses the slot. Trivially copyable, so it can go into POD command packets.
+// The zero value is never issued and means "no resource".
+template <typename T>
+struct Handle {
+    static constexpr uint32_t INDEX_BITS = 20;
+    static constexpr uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+    static constexpr uint32_t MAX_GENERATION = (1u << (32 - INDEX_BITS)) - 1;
+
+    uint32_t value = 0;
+
+    static Handle make(uint32_t index, uint32_t generation) { return {generation << INDEX_BITS | index}; }
+    uint32_t getIndex() const { return value & INDEX_MASK; }
+    uint32_t getGeneration() const { return value >> INDEX_BITS; }
+    bool isNull() const { return value == 0; }
+    explicit operator bool() const { return value != 0; }
+
+    bool operator==(Handle other) const { return value == other.value; }
+    bool operator!=(Handle other) const { return value != other.value; }
+    bool operator<(Handle other) const { return value < other.value; }
+};
+
+// Objects of one type in a contiguous array, addressed through generational handles. Lookups are
+// two array reads; destroy() moves the last object into the hole so iteration over all objects
+// never skips gaps. Pointers returned by get() are invalidated by create() and destroy(): keep the
+// handle, not the pointer. Not thread-safe.
+template <typename T>
+class HandlePool {
+public:
+    using HandleType = Handle<T>;
+
+    template <typename... Args>
+    HandleType create(Args&&... args) {
+        uint32_t slotIndex;
+        if (!freeSlots.empty()) {
+            slotIndex = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            if (slots.size() > HandleType::INDEX_MASK) return {};
+            slotIndex = static_cast<uint32_t>(slots.size());
+            slots.push_back({0, 1});
+        }
+        Slot& slot = slots[slotIndex];
+        slot.denseIndex = static_cast<uint32_t>(values.size());
+        values.emplace_back(std::forward<Args>(args)...);
+        denseToSlot.push_back(slotIndex);
+        return HandleType::make(slotIndex, slot.generation);
+    }
+
+    bool isValid(HandleType handle) const {
+        uint32_t index = handle.getIndex();
+        return !handle.isNull() && index < slots.size() && slots[index].generation == handle.getGeneration() &&
+               slots[index].denseIndex != INVALID_INDEX;
+    }
+
+    // nullptr for null or stale handles
+    T* get(HandleType handle) { return isValid(handle) ? &values[slots[handle.getIndex()].denseIndex] : nullptr; }
+    const T* get(HandleType handle) const {
+        return isValid(handle) ? &values[slots[handle.getIndex()].denseIndex] : nullptr;
+    }
+
+    bool destroy(HandleType handle) {
+        if (!isValid(handle)) return false;
+        Slot& slot = slots[handle.getIndex()];
+        uint32_t hole = slot.denseIndex;
+        uint32_t last = static_cast<uint32_t>(values.size() - 1);
+        if (hole != last) {
+            values[hole] = std::move(values[last]);
+            denseToSlot[hole] = denseToSlot[last];
+            slots[denseToSlot[hole]].denseIndex = hole;
+        }
+        values.pop_back();
+        denseToSlot.pop_back();
+
+        slot.denseIndex = INVALID_INDEX;
+        // Skip generation 0 so a recycled slot never hands out the null handle
+        slot.generation = slot.generation == HandleType::MAX_GENERATION ? 1 : slot.generation + 1;
+        freeSlots.push_back(handle.getIndex());
+        return true;
+    }
+
+    // Handle of the object at position 'denseIndex' of the array, for iteration with handles
+    HandleType getHandle(size_t denseIndex) const {
+        uint32_t slotIndex = denseToSlot[denseIndex];
+        return HandleType::make(slotIndex, slots[slotIndex].generation);
+    }
+
+    void clear() {
+        for (size_t i = values.size(); i > 0; --i) destroy(getHandle(i - 1));
+    }
+
+    size_t size() const { return values.size(); }
+    bool empty() const { return values.empty(); }
+    typename std::vector<T>::iterator begin() { return values.begin(); }
+    typename std::vector<T>::iterator end() { return values.end(); }
+    typename std::vector<T>::const_iterator begin() const { return values.begin(); }
+    typename std::vector<T>::const_iterator end() const { return values.end(); }
+
+private:
+    static constexpr uint32_t INVALID_INDEX = ~0u;
+
+    struct Slot {
+        uint32_t denseIndex;
+        uint32_t generation;
+    };
+
+    std::vector<T> values;             // Dense, in no particular order
+    std::vector<uint32_t> denseToSlot; // Parallel to values
+    std::vector<Slot> slots;           // Indexed by Handle::getIndex()
+    std::vector<uint32_t> freeSlots;
+};
+
+} // namespace SFE
@@ -0,0 +1,86 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+namespace SFE {
+
+// Start-up as a graph of named tasks instead of one long sequence. Main-thread tasks (anything
+// touching GLFW or the GL context) run on the thread that calls run(), in the order they were
+// added, as soon as their dependencies have finished; worker tasks (file reads, image decode,
+// font parsing) run on the JobSystem meanwhile. A task that fails skips everything depending on
+// it. Each task is timed against the graph's origin for the startup report and is a profiler
+// zone, so it also shows up in Chrome traces.
+class InitGraph {
+public:
+    enum class Thread {
+        Main,
+        Worker
+    };
+    enum class Status {
+        Pending,
+        Done,
+        Failed,
+        Skipped
+    };
+
+    using TaskId = uint32_t;
+    // Returns false on failure
+    using Task = std::function<bool()>;
+
+    struct Record {
+        const char* name; // Must outlive the graph (and the profiler capture)
+        Thread thread;
+        Status status = Status::Pending;
+        double startMs = 0.0; // Since the origin
+        double endMs = 0.0;
+    };
+
+    // 'origin' is time zero of the report, normally the start of main()
+    explicit InitGraph(std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now());
+
+    // Dependencies must have been added already, so the graph cannot have cycles
+    TaskId add(const char* name, Thread thread, Task task, std::initializer_list<TaskId> dependencies = {});
+    // Runs every task once; true if none failed or was skipped
+    bool run();
+
+    Status getStatus(TaskId id) const { return records[id].status; }
+    const std::vector<Record>& getRecords() const { return records; }
+    // Instant events on the same timeline, e.g. "first frame"
+    void mark(const char* name);
+    double getMarkMs(const char* name) const; // Negative if never marked
+    double getElapsedMs() const;
+
+    // Sum of task durations, i.e. the start-up time if everything ran in sequence
+    double getSerialMs() const;
+    // From the origin to the end of the last task
+    double getWallMs() const;
+
+    // Timeline table for the console/log, and the same data as a JSON object
+    std::string formatReport() const;
+    std::string toJson() const;
+
+private:
+    struct Node {
+        Task task;
+        std::vector<TaskId> dependents;
+        uint32_t unfinishedDependencies = 0;
+        bool dependencyFailed = false;
+    };
+    struct Mark {
+        const char* name;
+        double timeMs;
+    };
+
+    void execute(TaskId id);
+
+    std::chrono::steady_clock::time_point origin;
+    std::vector<Node> nodes;
+    std::vector<Record> records;
+    std::vector<Mark> marks;
+};
+
+} // namespace SFE
@@ -0,0 +1,79 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SFE {
+
+// Counts outstanding jobs of one batch; JobSystem::wait() returns once it reaches zero
+struct JobCounter {
+    std::atomic<uint32_t> pending{0};
+    bool isDone() const { return pending.load(std::memory_order_acquire) == 0; }
+};
+
+// Fixed pool of worker threads draining one FIFO job queue. Jobs are small CPU tasks (decoding a
+// file, a slice of a parallel loop); nothing here touches GL, so results that need the context
+// are handed back to the GL thread by the caller. Threads waiting on a counter run queued jobs
+// themselves instead of sleeping, so jobs may schedule and wait on other jobs.
+class JobSystem {
+public:
+    using Job = std::function<void()>;
+
+    static JobSystem& getInstance() {
+        static JobSystem instance;
+        return instance;
+    }
+
+    // Start 'threadCount' workers (0: one per hardware thread but the caller's). Called lazily by
+    // schedule() with the default; calling it again while running does nothing.
+    void initialize(unsigned threadCount = 0);
+    // Finish every queued job, then join the workers
+    void shutdown();
+
+    // Queue a job; 'counter' (optional) is incremented now and decremented when the job has run
+    void schedule(Job job, JobCounter* counter = nullptr);
+    // Run queued jobs on the calling thread until 'counter' reaches zero
+    void wait(const JobCounter& counter);
+    // Count work that is not a job yet (a read in flight, say) on 'counter'; end() it when done
+    void begin(JobCounter& counter);
+    void end(JobCounter& counter);
+
+    // Split [0, count) into ranges of at least 'grain' items, run body(begin, end) on the workers
+    // and the calling thread, and return when all ranges are done
+    void parallelFor(size_t count, size_t grain, const std::function<void(size_t begin, size_t end)>& body);
+
+    unsigned getWorkerCount() const { return workerCount.load(std::memory_order_acquire); }
+    // True on one of this pool's worker threads
+    static bool isWorkerThread();
+
+private:
+    JobSystem() = default;
+    ~JobSystem();
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    struct QueuedJob {
+        Job job;
+        JobCounter* counter = nullptr;
+    };
+
+    void workerLoop();
+    bool runOne(); // Pops and runs one job if any is queued
+    void run(QueuedJob& queued);
+
+    std::mutex mutex;
+    std::condition_variable jobAvailable;
+    std::condition_variable jobFinished; // Wakes waiters when a counter may have reached zero
+    std::deque<QueuedJob> jobs;
+    std::vector<std::thread> workers;
+    std::atomic<unsigned> workerCount{0};
+    bool stopping = false;
+};
+
+} // namespace SFE
@@ -1,73 +1,107 @@
 #pragma once
-#include <string>
-#include <fstream>
+#include <atomic>
 #include <chrono>
-#include <iomanip>
-#include <sstream>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include "core/MpscRing.hpp"
 
 namespace SFE {
 
+// Asynchronous logger. Producers copy a fixed-size binary record into a lock-free ring
+// (a clock read, a CAS and a 128-byte copy; no formatting, allocation or syscalls) and a
+// background thread formats and writes batches. When the ring is full the record is dropped
+// and counted rather than stalling the caller.
+// Output is CSV, or JSON Lines when the file name ends in .json/.jsonl.
 class Logger {
 public:
+    enum class Format {
+        CSV,
+        JSON
+    };
+
     static Logger& getInstance() {
         static Logger instance;
         return instance;
     }
 
-    void initialize(const std::string& logFilePath) {
-        if (logFile.is_open()) {
-            logFile.close();
-        }
-        logFile.open(logFilePath, std::ios::out | std::ios::app);
-        logStartTime = std::chrono::high_resolution_clock::now();
-        
-        // Write CSV header
-        logFile << "Timestamp,FPS,SceneRenderTime_ms,TextRenderTime_ms,TextDrawCalls,TotalCharacters,StressTestEnabled\n";
-    }
+    // Opens (appends to) the log file and starts the writer thread. Re-initialising shuts the
+    // previous file down first.
+    bool initialize(const std::string& logFilePath, size_t ringCapacity = 8192);
 
-    void logPerformanceMetrics(int fps, float sceneRenderTime, float textRenderTime, 
-                             int textDrawCalls, int totalCharacters, bool stressTestEnabled) {
-        if (!logFile.is_open()) return;
-
-        auto now = std::chrono::high_resolution_clock::now();
-        auto timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(now - logStartTime).count();
-
-        logFile << timestamp << ","
-                << fps << ","
-                << std::fixed << std::setprecision(3)
-                << sceneRenderTime * 1000.0f << ","
-                << textRenderTime * 1000.0f << ","
-                << textDrawCalls << ","
-                << totalCharacters << ","
-                << (stressTestEnabled ? "1" : "0") << "\n";
-        
-        logFile.flush();
-    }
+    // Drain what is queued, waiting at most 'timeout'; records still queued after that are
+    // discarded and counted as dropped. Called by the destructor with the default timeout.
+    void shutdown(std::chrono::milliseconds timeout = std::chrono::milliseconds(500));
 
-    void logMessage(const std::string& message) {
-        if (!logFile.is_open()) return;
+    void logPerformanceMetrics(int fps, float sceneRenderTime, float textRenderTime,
+                               int textDrawCalls, int totalCharacters, bool stressTestEnabled);
 
-        auto now = std::chrono::high_resolution_clock::now();
-        auto timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(now - logStartTime).count();
+    // Messages longer than MAX_MESSAGE_LENGTH are truncated (marked with "...")
+    void logMessage(std::string_view message);
 
-        logFile << timestamp << ",INFO,\"" << message << "\"\n";
-        logFile.flush();
-    }
+    uint64_t getDroppedCount() const { return droppedRecords.load(std::memory_order_relaxed); }
+    uint64_t getWrittenCount() const { return writtenRecords.load(std::memory_order_relaxed); }
+    Format getFormat() const { return format; }
 
-    ~Logger() {
-        if (logFile.is_open()) {
-            logFile.close();
-        }
-    }
+    struct PerformanceSample {
+        int32_t fps;
+        float sceneRenderTime; // Seconds
+        float textRenderTime;  // Seconds
+        int32_t textDrawCalls;
+        int32_t totalCharacters;
+        uint8_t stressTestEnabled;
+    };
+
+    static constexpr size_t MAX_MESSAGE_LENGTH = 116;
+
+    struct Record {
+        enum class Type : uint8_t {
+            Message,
+            PerformanceMetrics
+        };
+
+        int64_t timestamp; // Nanoseconds since initialize()
+        Type type;
+        uint8_t truncated;
+        uint16_t length; // Message bytes
+        union {
+            PerformanceSample metrics;
+            char text[MAX_MESSAGE_LENGTH];
+        };
+    };
+    static_assert(sizeof(Record) == 128, "Log records should stay two cache lines");
+
+    ~Logger();
 
 private:
     Logger() = default;
-    std::ofstream logFile;
-    std::chrono::high_resolution_clock::time_point logStartTime;
-
-    // Delete copy constructor and assignment operator
     Logger(const Logger&) = delete;
     Logger& operator=(const Logger&) = delete;
+
+    void push(const Record& record);
+    void writerLoop();
+    void formatRecord(const Record& record, std::string& out) const;
+
+    std::ofstream logFile;
+    Format format = Format::CSV;
+    std::chrono::steady_clock::time_point logStartTime;
+    std::unique_ptr<MpscRing<Record>> ring;
+
+    std::atomic<bool> running{false};
+    std::atomic<uint64_t> droppedRecords{0};
+    std::atomic<uint64_t> writtenRecords{0};
+
+    // Writer thread control; producers never touch these
+    std::thread writer;
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    bool stopRequested = false;
+    std::chrono::steady_clock::time_point stopDeadline;
 };
 
-} // namespace SFE 
\ No newline at end of file
+} // namespace SFE
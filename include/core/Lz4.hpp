@@ -0,0 +1,22 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace SFE {
+
+// LZ4 block format (github.com/lz4/lz4, lz4_Block_format.md): byte-aligned LZ77 that decodes at
+// memory speed, for asset pack entries. Raw blocks only, no frame header or checksum; the caller
+// stores the decompressed size. Output is readable by the reference LZ4_decompress_safe.
+
+// Worst case compressed size of 'size' input bytes
+size_t lz4CompressBound(size_t size);
+
+// Greedy single-probe compressor; fast rather than maximal
+std::vector<uint8_t> lz4Compress(const uint8_t* source, size_t size);
+
+// Decode exactly 'destinationSize' bytes. Returns false on malformed or truncated input instead of
+// reading or writing out of bounds.
+bool lz4Decompress(const uint8_t* source, size_t sourceSize, uint8_t* destination, size_t destinationSize);
+
+} // namespace SFE
@@ -0,0 +1,110 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Compile-time switch (CMake option SFE_TRACK_ALLOCATIONS); when 1 the global operator new/delete
+// are replaced by tracking versions, when 0 the tag macro compiles to nothing and nothing is counted
+#ifndef SFE_ALLOCATION_TRACKING
+#define SFE_ALLOCATION_TRACKING 0
+#endif
+
+namespace SFE {
+
+// Subsystem an allocation is charged to
+enum class MemoryTag : uint8_t {
+    General,
+    Text,
+    Mesh,
+    Shader,
+    Texture,
+    Logger,
+    Count
+};
+
+const char* getMemoryTagName(MemoryTag tag);
+
+// Heap accounting per subsystem. With tracking compiled in, every global new/delete goes through
+// recordAllocation()/recordFree() and is charged to the calling thread's current tag, which
+// SFE_MEMORY_TAG(tag) sets for a scope. A free is charged to the tag that allocated the block,
+// whichever tag is current at the time. Counters are atomics, so allocating threads never lock;
+// endFrame() (main thread, via Profiler::endFrame) collects and restarts the per-frame counts.
+// Everything is constant-initialised, so allocations made during static initialisation are safe.
+class MemoryTracker {
+public:
+    struct TagStats {
+        uint64_t allocations = 0; // Since the previous endFrame()
+        uint64_t frees = 0;
+        uint64_t bytes = 0;       // Allocated since the previous endFrame()
+        uint64_t liveBytes = 0;   // Outstanding at endFrame()
+        uint64_t peakBytes = 0;   // Highest liveBytes since resetPeaks()
+    };
+
+    struct FrameStats {
+        TagStats tags[static_cast<size_t>(MemoryTag::Count)];
+
+        const TagStats& operator[](MemoryTag tag) const { return tags[static_cast<size_t>(tag)]; }
+        // Sum over tags; the peak is the sum of per-tag peaks, an upper bound of the real one
+        TagStats total() const;
+    };
+
+    static MemoryTracker& getInstance() {
+        static MemoryTracker instance;
+        return instance;
+    }
+
+    static constexpr bool isEnabled() { return SFE_ALLOCATION_TRACKING != 0; }
+
+    static MemoryTag getCurrentTag();
+    static void setCurrentTag(MemoryTag tag);
+
+    void recordAllocation(MemoryTag tag, size_t bytes);
+    void recordFree(MemoryTag tag, size_t bytes);
+
+    // Counts since the previous call, and restarts them
+    FrameStats endFrame();
+    // Restarts peak tracking from the current live bytes, e.g. once loading is done
+    void resetPeaks();
+
+    constexpr MemoryTracker() = default;
+    MemoryTracker(const MemoryTracker&) = delete;
+    MemoryTracker& operator=(const MemoryTracker&) = delete;
+
+private:
+    struct Counters {
+        std::atomic<uint64_t> allocations{0};
+        std::atomic<uint64_t> frees{0};
+        std::atomic<uint64_t> bytes{0};
+        std::atomic<uint64_t> liveBytes{0};
+        std::atomic<uint64_t> peakBytes{0};
+    };
+
+    Counters counters[static_cast<size_t>(MemoryTag::Count)];
+};
+
+// Charges allocations made on this thread to 'tag' until the end of the scope
+class MemoryTagScope {
+public:
+    explicit MemoryTagScope(MemoryTag tag) : previous(MemoryTracker::getCurrentTag()) {
+        MemoryTracker::setCurrentTag(tag);
+    }
+    ~MemoryTagScope() { MemoryTracker::setCurrentTag(previous); }
+
+    MemoryTagScope(const MemoryTagScope&) = delete;
+    MemoryTagScope& operator=(const MemoryTagScope&) = delete;
+
+private:
+    MemoryTag previous;
+};
+
+} // namespace SFE
+
+#define SFE_MEMORY_TAG_CONCAT_INNER(a, b) a##b
+#define SFE_MEMORY_TAG_CONCAT(a, b) SFE_MEMORY_TAG_CONCAT_INNER(a, b)
+
+#if SFE_ALLOCATION_TRACKING
+#define SFE_MEMORY_TAG(tag) \
+    ::SFE::MemoryTagScope SFE_MEMORY_TAG_CONCAT(sfeMemoryTag, __LINE__)(::SFE::MemoryTag::tag)
+#else
+#define SFE_MEMORY_TAG(tag) ((void)0)
+#endif
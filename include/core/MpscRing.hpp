@@ -0,0 +1,78 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+namespace SFE {
+
+// Bounded lock-free multi-producer / single-consumer queue (Vyukov's sequence-number ring).
+// Producers claim a cell with one CAS and publish it with a release store; a full ring makes
+// tryPush() fail instead of blocking, so callers can count the drop and move on.
+template <typename T>
+class MpscRing {
+    static_assert(std::is_trivially_copyable<T>::value, "MpscRing stores records by memcpy");
+
+public:
+    // Capacity is rounded up to a power of two
+    explicit MpscRing(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) size <<= 1;
+        mask = size - 1;
+        cells.reset(new Cell[size]);
+        for (size_t i = 0; i < size; ++i) cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    MpscRing(const MpscRing&) = delete;
+    MpscRing& operator=(const MpscRing&) = delete;
+
+    size_t capacity() const { return mask + 1; }
+
+    // Any thread
+    bool tryPush(const T& value) {
+        size_t position = enqueuePosition.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &cells[position & mask];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (difference == 0) {
+                if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+            } else if (difference < 0) {
+                return false; // Full: the consumer has not released this cell yet
+            } else {
+                position = enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = value;
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer thread only
+    bool tryPop(T& value) {
+        Cell* cell = &cells[dequeuePosition & mask];
+        size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        if (static_cast<intptr_t>(sequence) - static_cast<intptr_t>(dequeuePosition + 1) < 0) {
+            return false; // Empty, or the next producer has not finished writing
+        }
+        value = cell->value;
+        cell->sequence.store(dequeuePosition + mask + 1, std::memory_order_release);
+        ++dequeuePosition;
+        return true;
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    size_t mask = 0;
+    alignas(64) std::atomic<size_t> enqueuePosition{0};
+    alignas(64) size_t dequeuePosition = 0;
+};
+
+} // namespace SFE
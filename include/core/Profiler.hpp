@@ -0,0 +1,179 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "core/MemoryTracker.hpp"
+#include "core/MpscRing.hpp"
+
+// Compile-time switch (CMake option SFE_ENABLE_PROFILER); when 0 the zone macros compile to nothing
+#ifndef SFE_PROFILING_ENABLED
+#define SFE_PROFILING_ENABLED 1
+#endif
+
+namespace SFE {
+
+// Hierarchical CPU profiler. SFE_PROFILE_SCOPE("name") records a zone with the CPU timestamp
+// counter on entry and exit; completed zones go into a per-thread ring, so recording never
+// takes a lock. endFrame(), called once per frame by the main thread, drains every thread's
+// ring, aggregates inclusive/exclusive time per zone and, while a capture is running, keeps the
+// raw zones for export as a Chrome trace (chrome://tracing, ui.perfetto.dev). With allocation
+// tracking compiled in it also collects the MemoryTracker's per-frame counts.
+// GPU timings (GpuProfiler) arrive as zones on a separate GPU track, converted to CPU ticks.
+// Zone names must be string literals (or otherwise outlive the profiler); only the pointer is
+// stored. Everything except zone recording and setThreadName() is main-thread only.
+class Profiler {
+public:
+    struct Zone {
+        const char* name;
+        uint64_t start; // Ticks, see now()
+        uint64_t end;
+        uint32_t threadId;
+        uint32_t depth; // 0 = outermost zone on its thread
+    };
+
+    struct ZoneStats {
+        const char* name;
+        uint32_t threadId;
+        uint32_t depth;
+        uint32_t calls;
+        double inclusiveMs;
+        double exclusiveMs; // Minus time spent in child zones
+        bool gpu;           // From a GPU track
+    };
+
+    struct FrameStats {
+        uint64_t frameIndex = 0;
+        double frameMs = 0.0; // Between the two endFrame() calls
+        std::vector<ZoneStats> zones;
+        MemoryTracker::FrameStats memory; // All zero unless allocation tracking is compiled in
+
+        // Inclusive time of every CPU (or GPU) zone with this name in the frame, summed over threads
+        double getZoneMs(const char* name) const;
+        double getGpuZoneMs(const char* name) const;
+    };
+
+    // Intentionally never destroyed: worker threads may still close zones during static destruction
+    static Profiler& getInstance() {
+        static Profiler* instance = new Profiler();
+        return *instance;
+    }
+
+    // Raw timestamp: TSC on x86, steady_clock nanoseconds elsewhere
+    static uint64_t now();
+    double ticksToMilliseconds(uint64_t ticks) const { return ticks * millisecondsPerTick; }
+    int64_t nanosecondsToTicks(int64_t nanoseconds) const {
+        return static_cast<int64_t>(nanoseconds * 1e-6 / millisecondsPerTick);
+    }
+
+    void beginZone(const char* name);
+    void endZone();
+
+    // Label the calling thread in traces
+    void setThreadName(const char* name);
+
+    // A timeline that is not a CPU thread (e.g. a GPU queue). Zones are submitted already
+    // complete, in CPU ticks, from the main thread, and are reported with the next endFrame().
+    uint32_t registerGpuTrack(const char* name);
+    void submitGpuZone(uint32_t trackId, const char* name, uint64_t start, uint64_t end, uint32_t depth);
+
+    void endFrame();
+    const FrameStats& getLastFrame() const { return lastFrame; }
+
+    // Keep raw zones from the following frames (at most maxZones) until stopCapture() writes them
+    void startCapture(size_t maxZones = 1 << 20);
+    bool stopCapture(const std::string& chromeTracePath);
+    bool isCapturing() const { return capturing; }
+
+    // Zones lost to full per-thread rings or a full capture
+    uint64_t getDroppedZoneCount() const { return droppedZones; }
+
+private:
+    static constexpr size_t THREAD_RING_CAPACITY = 16384;
+    static constexpr uint32_t MAX_DEPTH = 64;
+
+    struct ThreadBuffer {
+        explicit ThreadBuffer(uint32_t id) : threadId(id), zones(THREAD_RING_CAPACITY) {}
+
+        uint32_t threadId;
+        std::string name;     // Guarded by threadsMutex
+        bool retired = false; // Owning thread exited; guarded by threadsMutex
+        bool gpu = false;     // Registered with registerGpuTrack(), never tied to a thread
+        MpscRing<Zone> zones; // Written by the owning thread only
+        std::atomic<uint64_t> dropped{0};
+        uint32_t depth = 0;
+        uint64_t starts[MAX_DEPTH];
+        const char* names[MAX_DEPTH];
+    };
+
+    Profiler();
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    // Hands the thread's buffer back for reuse when the thread exits, so short-lived worker
+    // threads do not accumulate buffers
+    struct ThreadBufferSlot {
+        ThreadBuffer* buffer = nullptr;
+        ~ThreadBufferSlot();
+    };
+    static thread_local ThreadBufferSlot currentThreadBuffer;
+
+    ThreadBuffer& getThreadBuffer();
+    void calibrate();
+    void aggregate();
+
+    mutable std::mutex threadsMutex; // Guards thread registration
+    std::vector<std::unique_ptr<ThreadBuffer>> threads;
+
+    uint64_t startTicks = 0;
+    int64_t startNanoseconds = 0;
+    double millisecondsPerTick = 1e-6;
+
+    uint64_t frameStartTicks = 0;
+    uint64_t frameIndex = 0;
+    std::vector<Zone> frameZones;
+    std::vector<uint8_t> gpuThreads; // Per threadId, snapshot taken by endFrame()
+    FrameStats lastFrame;
+
+    // Heap counters at the end of a captured frame, written as counter tracks
+    struct MemorySample {
+        uint64_t ticks;
+        MemoryTracker::FrameStats memory;
+    };
+
+    bool capturing = false;
+    size_t captureLimit = 0;
+    std::vector<Zone> captured;
+    std::vector<MemorySample> capturedMemory;
+    uint64_t droppedCaptureZones = 0;
+    uint64_t droppedZones = 0;
+};
+
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name) { Profiler::getInstance().beginZone(name); }
+    ~ProfileScope() { Profiler::getInstance().endZone(); }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+};
+
+} // namespace SFE
+
+#define SFE_PROFILE_CONCAT_INNER(a, b) a##b
+#define SFE_PROFILE_CONCAT(a, b) SFE_PROFILE_CONCAT_INNER(a, b)
+
+// SFE_PROFILE_BEGIN/END are for zones that do not match a C++ scope; they must pair up on one thread
+#if SFE_PROFILING_ENABLED
+#define SFE_PROFILE_SCOPE(name) ::SFE::ProfileScope SFE_PROFILE_CONCAT(sfeProfileScope, __LINE__)(name)
+#define SFE_PROFILE_FUNCTION() SFE_PROFILE_SCOPE(__func__)
+#define SFE_PROFILE_BEGIN(name) ::SFE::Profiler::getInstance().beginZone(name)
+#define SFE_PROFILE_END() ::SFE::Profiler::getInstance().endZone()
+#else
+#define SFE_PROFILE_SCOPE(name) ((void)0)
+#define SFE_PROFILE_FUNCTION() ((void)0)
+#define SFE_PROFILE_BEGIN(name) ((void)0)
+#define SFE_PROFILE_END() ((void)0)
+#endif
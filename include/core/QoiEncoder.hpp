@@ -0,0 +1,13 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace SFE {
+
+// Encoder for the "Quite OK Image" format (qoiformat.org): lossless like PNG but an order of
+// magnitude faster to write, which suits screenshot sequences. Input is tightly packed RGBA8,
+// top row first. The result is a complete .qoi file.
+std::vector<uint8_t> encodeQoi(const uint8_t* rgba, uint32_t width, uint32_t height);
+
+} // namespace SFE
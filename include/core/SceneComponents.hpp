@@ -0,0 +1,61 @@
+#pragma once
+#include <glm/glm.hpp>
+#include "core/World.hpp"
+#include "rendering/ResourceHandles.hpp"
+#include "rendering/TextureArrayPool.hpp"
+
+namespace SFE {
+
+class Material;
+class SystemScheduler;
+
+// Components and systems for scene objects kept in a World: the data of SceneNode split into
+// separate columns, with its hard-coded orbit/rotation rule replaced by Orbit and Spin components
+// that any entity can carry. SceneBatcher::submit(World&) draws entities with a MeshInstance.
+
+struct Position {
+    glm::vec3 value{0.0f};
+};
+// Euler angles in degrees, applied X, then Y, then Z (as SceneNode)
+struct Rotation {
+    glm::vec3 degrees{0.0f};
+};
+struct Scale {
+    glm::vec3 value{1.0f};
+};
+// Circles 'center' in the XZ plane; updateOrbits() advances 'angle' and sets the Position
+struct Orbit {
+    glm::vec3 center{0.0f};
+    float radius = 1.0f;
+    float angle = 0.0f; // Radians
+    float speed = 1.0f; // Radians per second
+};
+// Adds 'degreesPerSecond' to the Rotation
+struct Spin {
+    glm::vec3 degreesPerSecond{0.0f};
+};
+// Model matrix written by updateLocalToWorld() from Position, Rotation and Scale
+struct LocalToWorld {
+    glm::mat4 matrix{1.0f};
+};
+struct MeshInstance {
+    MeshHandle mesh;
+    TextureHandle texture;
+    TextureSlice textureSlice;
+    Material* material = nullptr; // Must outlive the entity; null draws with the default shader
+    bool visible = true;
+};
+
+// Each runs over the matching archetypes on the JobSystem
+void updateOrbits(World& world, float deltaTime);
+void updateSpins(World& world, float deltaTime);
+// Entities with Position, Rotation, Scale and LocalToWorld
+void updateLocalToWorld(World& world);
+
+// Adds the three systems above, orbits and spins sharing a stage before the matrices
+void addSceneSystems(SystemScheduler& scheduler);
+
+// Entity with a transform (Position, Rotation, Scale, LocalToWorld) and nothing else
+Entity createTransformEntity(World& world, const glm::vec3& position, const glm::vec3& scale = glm::vec3(1.0f));
+
+} // namespace SFE
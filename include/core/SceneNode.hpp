@@ -2,20 +2,41 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include "rendering/Mesh.hpp"
+#include "rendering/ResourceHandles.hpp"
 #include "rendering/Shader.hpp"
+#include "rendering/TextureArrayPool.hpp"
 #include "core/Camera.hpp"
 #include <memory>
 
 namespace SFE {
+class Material;
+
+// A mesh placed in the scene. draw() renders the node on its own; SceneBatcher draws many nodes
+// that share a mesh, material and texture with one instanced draw. For many animated objects use
+// entities in a World instead (core/SceneComponents.hpp), which update in batches per component.
 class SceneNode {
 public:
-    SceneNode(Mesh* mesh = nullptr);
+    // Mesh and texture live in the ResourceRegistry
+    SceneNode(MeshHandle mesh = {});
     ~SceneNode() = default;
 
     void setPosition(const glm::vec3& pos) { position = pos; }
     void setRotation(const glm::vec3& rot) { rotation = rot; }
     void setScale(const glm::vec3& scaleValue) { scale = scaleValue; }
-    void setTexture(std::shared_ptr<Texture> tex) { texture = tex; }
+    void setTexture(TextureHandle tex) { texture = tex; }
+    // Texture array layer for batched drawing; travels in the instance matrix, so nodes with
+    // different slices still share a batch (see setInstanceTextureSlice)
+    void setTextureSlice(TextureSlice slice) { textureSlice = slice; }
+    // Batched nodes without a material use the shader passed to SceneBatcher::draw()
+    void setMaterial(std::shared_ptr<Material> nodeMaterial) { material = std::move(nodeMaterial); }
+    void setVisible(bool value) { visible = value; }
+
+    MeshHandle getMesh() const { return mesh; }
+    TextureHandle getTexture() const { return texture; }
+    TextureSlice getTextureSlice() const { return textureSlice; }
+    Material* getMaterial() const { return material.get(); }
+    bool isVisible() const { return visible; }
+    glm::mat4 getModelMatrix() const;
     
     glm::vec3 getPosition() const { return position; }
     glm::vec3 getRotation() const { return rotation; }
@@ -25,8 +46,11 @@ public:
     void draw(Shader& shader, const Camera& camera) const;
 
 private:
-    Mesh* mesh;
-    std::shared_ptr<Texture> texture;
+    MeshHandle mesh;
+    TextureHandle texture;
+    TextureSlice textureSlice;
+    std::shared_ptr<Material> material;
+    bool visible = true;
     glm::vec3 position{0.0f, 0.0f, 0.0f};
     glm::vec3 rotation{0.0f, 0.0f, 0.0f};
     glm::vec3 scale{1.0f, 1.0f, 1.0f};
@@ -1,40 +1,107 @@
 #pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 #include <glad/glad.h>
-#include "stb/stb_image_write.h"
 
 namespace SFE {
 
+// Asynchronous framebuffer capture. captureScreenshot() only queues a glReadPixels into one
+// of a small ring of pixel pack buffers; update() maps buffers whose fence has signalled (a
+// frame or two later, so the readback never stalls the pipeline) and hands the pixels to a
+// worker thread that encodes and writes the file. The format follows the file extension:
+//  .png - stb_image_write, smallest files, slowest
+//  .qoi - lossless, much faster to encode (see QoiEncoder)
+//  .raw - tightly packed RGBA8 rows, top row first, no header (e.g. ffmpeg -f rawvideo)
 class ScreenshotManager {
 public:
+    enum class Format {
+        PNG,
+        QOI,
+        Raw
+    };
+
+    // Called from update() on the capturing thread once a file has been written (or failed)
+    using CompletionCallback = std::function<void(const std::string& filename, bool success)>;
+
     static ScreenshotManager& getInstance() {
         static ScreenshotManager instance;
         return instance;
     }
 
-    bool captureScreenshot(const std::string& filename, int width, int height) {
-        std::vector<unsigned char> pixels(width * height * 4);
-        
-        // Read pixels from framebuffer
-        glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
-        
-        // Flip image vertically (OpenGL has bottom-left origin)
-        std::vector<unsigned char> flipped(width * height * 4);
-        for (int y = 0; y < height; y++) {
-            memcpy(&flipped[(height - 1 - y) * width * 4],
-                   &pixels[y * width * 4],
-                   width * 4);
-        }
-        
-        // Save to PNG file
-        return stbi_write_png(filename.c_str(), width, height, 4, flipped.data(), width * 4) != 0;
-    }
+    // Queue a capture of the current read framebuffer. Returns false if every readback slot is
+    // still in flight (the capture is dropped rather than stalling).
+    bool captureScreenshot(const std::string& filename, int width, int height);
+
+    // Call once per frame on the GL thread: retires finished readbacks and reports completions
+    void update();
+
+    // Block until every queued capture is written; then delete the GL objects and stop the
+    // worker. Must run while the context is still current.
+    void shutdown();
+
+    void setCompletionCallback(CompletionCallback callback) { completionCallback = std::move(callback); }
+    size_t getPendingCount() const { return inFlightCount + encodingCount(); }
+
+    static Format formatFromFilename(const std::string& filename);
 
 private:
     ScreenshotManager() = default;
+    ~ScreenshotManager();
     ScreenshotManager(const ScreenshotManager&) = delete;
     ScreenshotManager& operator=(const ScreenshotManager&) = delete;
+
+    static constexpr int READBACK_SLOTS = 3;
+
+    struct ReadbackSlot {
+        GLuint pbo = 0;
+        GLsync fence = nullptr;
+        size_t capacity = 0;
+        int width = 0;
+        int height = 0;
+        uint64_t sequence = 0; // Submission order, so files complete in capture order
+        std::string filename;
+    };
+
+    struct EncodeJob {
+        std::string filename;
+        Format format = Format::PNG;
+        int width = 0;
+        int height = 0;
+        std::vector<uint8_t> pixels; // Top row first
+    };
+
+    struct Completion {
+        std::string filename;
+        bool success = false;
+    };
+
+    void ensureWorker();
+    void workerLoop();
+    void retireSlot(ReadbackSlot& slot);
+    static bool writeImage(const EncodeJob& job);
+    size_t encodingCount() const;
+
+    ReadbackSlot slots[READBACK_SLOTS];
+    int inFlightCount = 0;
+    uint64_t nextSequence = 0;
+    CompletionCallback completionCallback;
+
+    // Shared with the worker thread
+    mutable std::mutex mutex;
+    std::condition_variable jobAvailable;
+    std::condition_variable jobFinished;
+    std::deque<EncodeJob> jobs;
+    std::vector<std::vector<uint8_t>> freeBuffers; // Recycled pixel buffers
+    std::vector<Completion> completions;
+    int activeJobs = 0;
+    bool stopping = false;
+    std::thread worker;
 };
 
-} // namespace SFE 
\ No newline at end of file
+} // namespace SFE
@@ -0,0 +1,43 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "core/World.hpp"
+
+namespace SFE {
+
+// Runs a list of systems over a World every frame, in parallel where that is safe. Each system
+// declares the component types it reads and writes; two systems conflict when one writes a type
+// the other reads or writes. Systems are placed in stages in the order they were added, each one
+// right after the last earlier system it conflicts with, so conflicting systems keep their order
+// and the rest share a stage. The systems of a stage run at the same time on the JobSystem (the
+// caller takes one), and each may split its own loop with World::parallelForEachChunk.
+//
+// Systems must not change the World's structure (create, destroy, add or remove components)
+// while run() is going; queue such changes and apply them afterwards.
+class SystemScheduler {
+public:
+    using SystemId = uint32_t;
+    using System = std::function<void(World& world, float deltaTime)>;
+
+    struct SystemInfo {
+        const char* name; // Also the profiler zone name, so it must outlive any capture
+        ComponentMask reads;
+        ComponentMask writes;
+        uint32_t stage;
+    };
+
+    // 'reads' and 'writes' as from World::maskOf<...>(); a type in both only needs 'writes'
+    SystemId add(const char* name, ComponentMask reads, ComponentMask writes, System system);
+    void run(World& world, float deltaTime);
+
+    uint32_t getStageCount() const { return static_cast<uint32_t>(stages.size()); }
+    const std::vector<SystemInfo>& getSystems() const { return systems; }
+
+private:
+    std::vector<SystemInfo> systems;
+    std::vector<System> functions;            // Parallel to 'systems'
+    std::vector<std::vector<SystemId>> stages; // Systems of each stage
+};
+
+} // namespace SFE
@@ -0,0 +1,136 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "core/AssetPack.hpp"
+#include "core/JobSystem.hpp"
+
+namespace SFE {
+
+struct IoUring;
+
+// Virtual file system every loader reads assets through. Asset paths ("shaders/simple.vert")
+// resolve against mount points, newest mount first: a directory or a .sfp pack mounted under a
+// path prefix ("" for the root). Absolute paths bypass the mounts, and with nothing mounted paths
+// resolve against the working directory.
+//
+// read() blocks; readAsync() queues the read and runs its callback as a JobSystem job once the
+// bytes are in memory, so decoding overlaps with the reads still in flight. On Linux loose files
+// are read through io_uring, one submission for everything queued; elsewhere (or if the kernel
+// refuses a ring) a job per file does a blocking read. Pack entries are already mapped, so their
+// jobs only decompress. preload() is readAsync() into a cache the next read() of the path takes
+// from, which lets a level load start every read up front without changing its loaders.
+//
+// Mounting and unmounting must not race with reads; everything else is thread-safe.
+class VFS {
+public:
+    enum class Backend {
+        IoUring,
+        ThreadPool
+    };
+
+    // Runs on a JobSystem worker; 'data' may be moved from
+    using ReadCallback = std::function<void(const std::string& path, AssetData& data, bool success)>;
+
+    static VFS& getInstance() {
+        static VFS instance;
+        return instance;
+    }
+
+    bool mountDirectory(const std::string& mountPoint, const std::string& directory);
+    bool mountPack(const std::string& mountPoint, const std::string& packPath);
+    void unmountAll();
+    size_t getMountCount() const { return mounts.size(); }
+
+    bool exists(const std::string& path) const;
+    // Loose files are memory-mapped, stored pack entries are views into the pack
+    bool read(const std::string& path, AssetData& data);
+    void readAsync(const std::string& path, ReadCallback callback);
+    void preload(const std::string& path);
+    // Drop preloaded data nobody read (waits for those reads first)
+    void clearPreloads();
+    // Block (running jobs) until every readAsync() callback has returned
+    void waitForReads();
+
+    // Not while asynchronous reads are in flight; false if io_uring is not available
+    bool setBackend(Backend backend);
+    Backend getBackend() const { return backend; }
+    static const char* getBackendName(Backend backend);
+
+    uint64_t getAsyncReadCount() const { return asyncReadCount.load(std::memory_order_relaxed); }
+    uint64_t getAsyncBytesRead() const { return asyncBytesRead.load(std::memory_order_relaxed); }
+
+    // Finish outstanding reads and stop the I/O thread
+    void shutdown();
+
+private:
+    VFS();
+    ~VFS();
+    VFS(const VFS&) = delete;
+    VFS& operator=(const VFS&) = delete;
+
+    struct Mount {
+        std::string point;     // Normalised prefix without trailing slash
+        std::string directory; // Directory mounts
+        std::unique_ptr<AssetPack> pack;
+    };
+
+    // Where a path lives: a pack entry or a file on disk
+    struct Location {
+        const AssetPack* pack = nullptr;
+        const AssetPackEntry* entry = nullptr;
+        std::string filePath;
+    };
+
+    struct FileRead {
+        std::string path; // As requested
+        std::string filePath;
+        ReadCallback callback;
+        AssetData data;
+        int fileDescriptor = -1;
+        uint64_t offset = 0;
+    };
+
+    struct Preload {
+        JobCounter done;
+        bool success = false;
+        AssetData data;
+    };
+
+    bool resolve(const std::string& path, Location& location) const;
+    void complete(std::unique_ptr<FileRead> request, bool success);
+    static bool readFileBlocking(FileRead& request);
+
+    // io_uring backend
+    void ensureIoThread();
+    void stopIoThread();
+    void ioThreadLoop();
+    bool openFileRead(FileRead& request);
+
+    std::vector<Mount> mounts;
+    Backend backend = Backend::ThreadPool;
+    JobCounter readCounter;
+    std::atomic<uint64_t> asyncReadCount{0};
+    std::atomic<uint64_t> asyncBytesRead{0};
+
+    std::mutex preloadMutex;
+    std::unordered_map<std::string, std::shared_ptr<Preload>> preloads;
+
+    // Shared with the I/O thread
+    std::unique_ptr<IoUring> ring;
+    std::mutex ioMutex;
+    std::condition_variable ioAvailable;
+    std::deque<std::unique_ptr<FileRead>> ioQueue;
+    bool ioStopping = false;
+    std::thread ioThread;
+};
+
+} // namespace SFE
@@ -0,0 +1,202 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "core/HandlePool.hpp"
+#include "core/JobSystem.hpp"
+
+namespace SFE {
+
+// Where an entity's components live: a row of one archetype
+struct EntityLocation {
+    uint32_t archetype;
+    uint32_t row;
+};
+using Entity = Handle<EntityLocation>;
+
+// One bit per component type (World::componentId)
+using ComponentMask = uint64_t;
+
+// Entities and their components, stored by archetype: every entity with exactly the same set of
+// component types shares an archetype, which keeps one tightly packed array (column) per
+// component type plus the entity handles, all indexed by row. Iterating the entities that have
+// some components is a loop over plain arrays per matching archetype, with no per-entity lookup
+// or virtual call, so the loop bodies can be vectorised.
+//
+// Components are plain data (trivially copyable, at most max_align_t aligned): rows move between
+// archetypes and within columns with memcpy. Adding or removing a component moves the entity's
+// row to another archetype; destroying an entity moves the last row into the hole. Both change
+// rows, so pointers from get() and the chunk pointers are invalidated by any structural change
+// (create, destroy, set of a new component type, remove). Up to 64 component types and about a
+// million live entities (Entity is a 32-bit generational handle).
+//
+// Not thread-safe for structural changes. Reading and writing components of existing entities
+// from several threads is fine as long as no two threads write the same component type, which is
+// what SystemScheduler arranges.
+class World {
+public:
+    static constexpr uint32_t MAX_COMPONENT_TYPES = 64;
+
+    World();
+    ~World();
+    World(const World&) = delete;
+    World& operator=(const World&) = delete;
+
+    // Process-wide id of a component type, assigned on first use
+    template <typename T>
+    static uint32_t componentId();
+    template <typename... Ts>
+    static ComponentMask maskOf() {
+        return (ComponentMask{0} | ... | (ComponentMask{1} << componentId<Ts>()));
+    }
+
+    // Null if the entity limit is reached
+    Entity create() { return createWithMask(0); }
+    template <typename... Ts>
+    Entity create(const Ts&... components);
+    bool destroy(Entity entity);
+    bool isAlive(Entity entity) const { return entities.isValid(entity); }
+    void clear();
+
+    // Adds the component if the entity lacks it, otherwise overwrites it
+    template <typename T>
+    void set(Entity entity, const T& value);
+    template <typename T>
+    bool remove(Entity entity);
+    // Null if the entity is dead or lacks the component
+    template <typename T>
+    T* get(Entity entity);
+    template <typename T>
+    bool has(Entity entity) const;
+
+    // fn(size_t count, const Entity* entities, Ts*... columns) once per archetype that has every Ts
+    template <typename... Ts, typename Fn>
+    void forEachChunk(Fn&& fn);
+    // fn(Ts&... components) for every entity that has every Ts
+    template <typename... Ts, typename Fn>
+    void forEach(Fn&& fn);
+    // forEachChunk() with each archetype split into ranges of at least 'grain' rows that run on
+    // the JobSystem; returns when all are done. 'fn' must be safe to call concurrently.
+    template <typename... Ts, typename Fn>
+    void parallelForEachChunk(size_t grain, Fn&& fn);
+
+    uint32_t getEntityCount() const { return static_cast<uint32_t>(entities.size()); }
+    uint32_t getArchetypeCount() const { return static_cast<uint32_t>(archetypes.size()); }
+
+private:
+    struct Column {
+        uint32_t component;
+        size_t elementSize;
+        std::vector<unsigned char> data;
+        void* at(size_t row) { return data.data() + row * elementSize; }
+    };
+    struct Archetype {
+        ComponentMask mask;
+        std::vector<Column> columns; // Sorted by component id
+        std::vector<Entity> entities;
+        uint8_t columnOf[MAX_COMPONENT_TYPES]; // Column of each component id, 0xFF if absent
+
+        size_t size() const { return entities.size(); }
+        template <typename T>
+        T* column() {
+            return reinterpret_cast<T*>(columns[columnOf[componentId<T>()]].data.data());
+        }
+    };
+
+    static uint32_t registerComponent(size_t size);
+    static size_t getComponentSize(uint32_t component);
+
+    Entity createWithMask(ComponentMask mask);
+    uint32_t findOrCreateArchetype(ComponentMask mask);
+    // Moves the entity's row to the archetype of 'mask', copying the components both have; new
+    // components are left zeroed for the caller to fill
+    void moveEntity(Entity entity, ComponentMask mask);
+    // Removes a row by moving the archetype's last row into it
+    void removeRow(uint32_t archetype, uint32_t row);
+    void* componentData(Entity entity, uint32_t component);
+
+    HandlePool<EntityLocation> entities;
+    std::vector<std::unique_ptr<Archetype>> archetypes;
+    std::vector<std::pair<ComponentMask, uint32_t>> archetypeIndex; // Sorted by mask
+};
+
+template <typename T>
+uint32_t World::componentId() {
+    static_assert(std::is_trivially_copyable_v<T>, "components are plain data");
+    static_assert(alignof(T) <= alignof(std::max_align_t), "component alignment exceeds max_align_t");
+    static const uint32_t id = registerComponent(sizeof(T));
+    return id;
+}
+
+template <typename... Ts>
+Entity World::create(const Ts&... components) {
+    Entity entity = createWithMask(maskOf<Ts...>());
+    if (entity) (std::memcpy(componentData(entity, componentId<Ts>()), &components, sizeof(Ts)), ...);
+    return entity;
+}
+
+template <typename T>
+void World::set(Entity entity, const T& value) {
+    const EntityLocation* location = entities.get(entity);
+    if (!location) return;
+    ComponentMask bit = ComponentMask{1} << componentId<T>();
+    ComponentMask mask = archetypes[location->archetype]->mask;
+    if (!(mask & bit)) moveEntity(entity, mask | bit);
+    std::memcpy(componentData(entity, componentId<T>()), &value, sizeof(T));
+}
+
+template <typename T>
+bool World::remove(Entity entity) {
+    const EntityLocation* location = entities.get(entity);
+    if (!location) return false;
+    ComponentMask bit = ComponentMask{1} << componentId<T>();
+    ComponentMask mask = archetypes[location->archetype]->mask;
+    if (!(mask & bit)) return false;
+    moveEntity(entity, mask & ~bit);
+    return true;
+}
+
+template <typename T>
+T* World::get(Entity entity) {
+    return static_cast<T*>(componentData(entity, componentId<T>()));
+}
+
+template <typename T>
+bool World::has(Entity entity) const {
+    const EntityLocation* location = entities.get(entity);
+    return location && (archetypes[location->archetype]->mask & (ComponentMask{1} << componentId<T>()));
+}
+
+template <typename... Ts, typename Fn>
+void World::forEachChunk(Fn&& fn) {
+    const ComponentMask required = maskOf<Ts...>();
+    for (auto& archetype : archetypes) {
+        if ((archetype->mask & required) != required || archetype->size() == 0) continue;
+        fn(archetype->size(), archetype->entities.data(), archetype->template column<Ts>()...);
+    }
+}
+
+template <typename... Ts, typename Fn>
+void World::forEach(Fn&& fn) {
+    forEachChunk<Ts...>([&fn](size_t count, const Entity*, Ts*... columns) {
+        for (size_t i = 0; i < count; ++i) fn(columns[i]...);
+    });
+}
+
+template <typename... Ts, typename Fn>
+void World::parallelForEachChunk(size_t grain, Fn&& fn) {
+    const ComponentMask required = maskOf<Ts...>();
+    for (auto& archetype : archetypes) {
+        if ((archetype->mask & required) != required || archetype->size() == 0) continue;
+        Archetype* chunk = archetype.get();
+        JobSystem::getInstance().parallelFor(chunk->size(), grain, [&fn, chunk](size_t begin, size_t end) {
+            fn(end - begin, chunk->entities.data() + begin, (chunk->template column<Ts>() + begin)...);
+        });
+    }
+}
+
+} // namespace SFE
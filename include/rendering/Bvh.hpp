@@ -0,0 +1,265 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "rendering/Frustum.hpp"
+
+namespace SFE {
+
+struct Aabb {
+    glm::vec3 min{0.0f};
+    glm::vec3 max{0.0f};
+
+    static Aabb merge(const Aabb& a, const Aabb& b) { return {glm::min(a.min, b.min), glm::max(a.max, b.max)}; }
+    bool overlaps(const Aabb& other) const {
+        return min.x <= other.max.x && max.x >= other.min.x && min.y <= other.max.y && max.y >= other.min.y &&
+               min.z <= other.max.z && max.z >= other.min.z;
+    }
+    bool contains(const Aabb& other) const {
+        return min.x <= other.min.x && min.y <= other.min.y && min.z <= other.min.z && max.x >= other.max.x &&
+               max.y >= other.max.y && max.z >= other.max.z;
+    }
+    float surfaceArea() const {
+        glm::vec3 size = max - min;
+        return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+    }
+    glm::vec3 center() const { return (min + max) * 0.5f; }
+    // Box around this one after 'transform' (exact for the transformed box's corners)
+    Aabb transformed(const glm::mat4& transform) const {
+        glm::vec3 worldCenter(transform * glm::vec4(center(), 1.0f));
+        glm::vec3 extent = (max - min) * 0.5f;
+        glm::vec3 worldExtent(0.0f);
+        for (int axis = 0; axis < 3; ++axis) worldExtent += glm::abs(glm::vec3(transform[axis])) * extent[axis];
+        return {worldCenter - worldExtent, worldCenter + worldExtent};
+    }
+};
+
+// Bounding volume hierarchy over axis-aligned boxes for culling, picking and proximity queries.
+// Every object (a proxy) is one leaf; its box is enlarged by a margin so small movements leave
+// the tree alone.
+//
+// Dynamic use: insert() descends to the sibling that adds the least surface area, move() refits
+// the ancestors of a leaf that left its enlarged box and remove() splices the leaf out. Refitting
+// keeps moves cheap but lets the tree degrade as objects drift apart from their neighbours;
+// getQuality() tracks this and rebuild() restores it with a binned SAH build, which is also the
+// way to build static sets in one go. Proxy ids stay valid across rebuilds.
+//
+// Queries take a callback called with the proxy's user data. Not thread-safe for writes;
+// concurrent queries are fine.
+class Bvh {
+public:
+    using ProxyId = uint32_t;
+    static constexpr uint32_t INVALID = 0xFFFFFFFFu;
+
+    // 'margin' enlarges each proxy's box on every side, in world units
+    explicit Bvh(float margin = 0.1f) : margin(margin) {}
+
+    ProxyId insert(const Aabb& bounds, uint32_t userData);
+    void remove(ProxyId proxy); // Its id is reused by a later insert()
+    // True if the proxy left its enlarged box and the tree was refit; false for removed or unknown ids
+    bool move(ProxyId proxy, const Aabb& bounds);
+    // Top-down binned SAH build over every proxy
+    void rebuild();
+    void clear();
+
+    uint32_t getProxyCount() const { return proxyCount; }
+    const Aabb& getFatBounds(ProxyId proxy) const { return proxies[proxy].bounds; }
+    uint32_t getUserData(ProxyId proxy) const { return proxies[proxy].userData; }
+    uint32_t getHeight() const;
+    // SAH cost of the tree (summed internal node areas relative to the root); lower is better
+    float getCost() const;
+    // getCost() divided by the cost right after the last rebuild(); refits make it grow, and a
+    // rebuild is worth it somewhere past 1.5-2
+    float getQuality() const { return builtCost > 0.0f ? getCost() / builtCost : 1.0f; }
+    // Parent links, child bounds containment and leaf/proxy links; for tests
+    bool validate() const;
+
+    // Proxies whose box overlaps the frustum. Subtrees entirely inside it are reported without
+    // further plane tests.
+    template <typename Callback>
+    void queryFrustum(const Frustum& frustum, Callback&& callback) const;
+    // Proxies whose box overlaps 'bounds'
+    template <typename Callback>
+    void queryAabb(const Aabb& bounds, Callback&& callback) const;
+    // Proxies whose box the ray enters within 'maxDistance', nearer subtrees first.
+    // 'callback(userData, entryDistance)' returns the distance of the actual hit on that object
+    // (anything >= maxDistance for a miss); subtrees behind the nearest hit so far are skipped.
+    // Returns the nearest hit distance, or maxDistance if nothing was hit. 'direction' need not
+    // be normalised; distances are in units of its length.
+    template <typename Callback>
+    float raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, Callback&& callback) const;
+
+private:
+    struct Node {
+        Aabb bounds;
+        uint32_t parent = INVALID;
+        uint32_t left = INVALID; // INVALID for leaves
+        uint32_t right = INVALID;
+        uint32_t proxy = INVALID; // Leaves only; next free node on the free list
+        bool isLeaf() const { return left == INVALID; }
+    };
+    struct Proxy {
+        Aabb bounds; // Enlarged by the margin
+        uint32_t userData = 0;
+        uint32_t leaf = INVALID; // INVALID once removed
+    };
+
+    uint32_t allocateNode();
+    void freeNode(uint32_t node);
+    void insertLeaf(uint32_t leaf);
+    void removeLeaf(uint32_t leaf);
+    void refitFrom(uint32_t node);
+    uint32_t buildRange(uint32_t* begin, uint32_t* end, const glm::vec3* centroids, uint32_t parent);
+    Aabb enlarge(const Aabb& bounds) const;
+    static float rayBoxEntry(const Aabb& box, const glm::vec3& origin, const glm::vec3& inverseDirection,
+                             float maxDistance);
+
+    std::vector<Node> nodes;
+    std::vector<Proxy> proxies;
+    uint32_t root = INVALID;
+    uint32_t freeNodes = INVALID;
+    std::vector<ProxyId> freeProxies;
+    uint32_t proxyCount = 0;
+    float margin;
+    float builtCost = 0.0f;
+};
+
+template <typename Callback>
+void Bvh::queryFrustum(const Frustum& frustum, Callback&& callback) const {
+    if (root == INVALID) return;
+    // Each entry carries the planes its box still straddles; a node inside a plane passes the
+    // plane on to its children, so a fully inside subtree is reported without any test
+    struct Entry {
+        uint32_t node;
+        uint32_t planeMask;
+    };
+    Entry stack[64];
+    std::vector<Entry> overflow;
+    uint32_t depth = 0;
+    stack[depth++] = {root, 0x3Fu};
+    while (depth > 0 || !overflow.empty()) {
+        Entry entry;
+        if (!overflow.empty()) {
+            entry = overflow.back();
+            overflow.pop_back();
+        } else {
+            entry = stack[--depth];
+        }
+        const Node& node = nodes[entry.node];
+        uint32_t mask = entry.planeMask;
+        bool outside = false;
+        for (uint32_t plane = 0; plane < 6 && mask != 0; ++plane) {
+            if (!(mask & (1u << plane))) continue;
+            const glm::vec4& p = frustum.planes[plane];
+            glm::vec3 positive(p.x >= 0.0f ? node.bounds.max.x : node.bounds.min.x,
+                               p.y >= 0.0f ? node.bounds.max.y : node.bounds.min.y,
+                               p.z >= 0.0f ? node.bounds.max.z : node.bounds.min.z);
+            if (glm::dot(glm::vec3(p), positive) + p.w < 0.0f) {
+                outside = true;
+                break;
+            }
+            glm::vec3 negative(p.x >= 0.0f ? node.bounds.min.x : node.bounds.max.x,
+                               p.y >= 0.0f ? node.bounds.min.y : node.bounds.max.y,
+                               p.z >= 0.0f ? node.bounds.min.z : node.bounds.max.z);
+            if (glm::dot(glm::vec3(p), negative) + p.w >= 0.0f) mask &= ~(1u << plane);
+        }
+        if (outside) continue;
+        if (node.isLeaf()) {
+            callback(proxies[node.proxy].userData);
+            continue;
+        }
+        for (uint32_t child : {node.left, node.right}) {
+            if (depth < 64) stack[depth++] = {child, mask};
+            else overflow.push_back({child, mask});
+        }
+    }
+}
+
+template <typename Callback>
+void Bvh::queryAabb(const Aabb& bounds, Callback&& callback) const {
+    if (root == INVALID) return;
+    uint32_t stack[64];
+    std::vector<uint32_t> overflow;
+    uint32_t depth = 0;
+    stack[depth++] = root;
+    while (depth > 0 || !overflow.empty()) {
+        uint32_t index;
+        if (!overflow.empty()) {
+            index = overflow.back();
+            overflow.pop_back();
+        } else {
+            index = stack[--depth];
+        }
+        const Node& node = nodes[index];
+        if (!node.bounds.overlaps(bounds)) continue;
+        if (node.isLeaf()) {
+            callback(proxies[node.proxy].userData);
+            continue;
+        }
+        for (uint32_t child : {node.left, node.right}) {
+            if (depth < 64) stack[depth++] = child;
+            else overflow.push_back(child);
+        }
+    }
+}
+
+template <typename Callback>
+float Bvh::raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, Callback&& callback) const {
+    if (root == INVALID) return maxDistance;
+    const float huge = std::numeric_limits<float>::max();
+    glm::vec3 inverseDirection(direction.x != 0.0f ? 1.0f / direction.x : huge,
+                               direction.y != 0.0f ? 1.0f / direction.y : huge,
+                               direction.z != 0.0f ? 1.0f / direction.z : huge);
+    struct Entry {
+        uint32_t node;
+        float entry;
+    };
+    Entry stack[64];
+    std::vector<Entry> overflow; // Only for degenerate trees deeper than the fixed stack
+    uint32_t depth = 0;
+    auto push = [&](uint32_t node, float entry) {
+        if (depth < 64) stack[depth++] = {node, entry};
+        else overflow.push_back({node, entry});
+    };
+    float nearest = maxDistance;
+    float rootEntry = rayBoxEntry(nodes[root].bounds, origin, inverseDirection, nearest);
+    if (rootEntry < 0.0f) return nearest;
+    push(root, rootEntry);
+    while (depth > 0 || !overflow.empty()) {
+        Entry entry;
+        if (!overflow.empty()) {
+            entry = overflow.back();
+            overflow.pop_back();
+        } else {
+            entry = stack[--depth];
+        }
+        if (entry.entry >= nearest) continue; // A closer hit was found since it was pushed
+        const Node& node = nodes[entry.node];
+        if (node.isLeaf()) {
+            float hit = callback(proxies[node.proxy].userData, entry.entry);
+            if (hit < nearest) nearest = hit;
+            continue;
+        }
+        float leftEntry = rayBoxEntry(nodes[node.left].bounds, origin, inverseDirection, nearest);
+        float rightEntry = rayBoxEntry(nodes[node.right].bounds, origin, inverseDirection, nearest);
+        // Push the farther child first so the nearer one is visited next
+        if (leftEntry >= 0.0f && rightEntry >= 0.0f) {
+            if (leftEntry <= rightEntry) {
+                push(node.right, rightEntry);
+                push(node.left, leftEntry);
+            } else {
+                push(node.left, leftEntry);
+                push(node.right, rightEntry);
+            }
+        } else if (leftEntry >= 0.0f) {
+            push(node.left, leftEntry);
+        } else if (rightEntry >= 0.0f) {
+            push(node.right, rightEntry);
+        }
+    }
+    return nearest;
+}
+
+} // namespace SFE
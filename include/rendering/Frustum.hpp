@@ -0,0 +1,22 @@
+#pragma once
+#include <glm/glm.hpp>
+
+namespace SFE {
+
+// Six clip planes (left, right, bottom, top, near, far) extracted from a view-projection
+// matrix, normals pointing inwards and normalised so plane distances are in world units.
+struct Frustum {
+    glm::vec4 planes[6];
+
+    static Frustum fromMatrix(const glm::mat4& viewProjection);
+
+    bool intersectsSphere(const glm::vec3& center, float radius) const;
+    bool intersectsAabb(const glm::vec3& boundsMin, const glm::vec3& boundsMax) const;
+};
+
+// World-space bounding sphere of an object-space sphere under 'model', using the largest axis
+// scale so the result stays conservative for non-uniform scales. Same math as the GPU culler.
+void transformBoundingSphere(const glm::mat4& model, const glm::vec3& center, float radius,
+                             glm::vec3& worldCenter, float& worldRadius);
+
+} // namespace SFE
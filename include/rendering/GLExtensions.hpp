@@ -0,0 +1,87 @@
+#pragma once
+#include <glad/glad.h>
+#include "rendering/TextureFormat.hpp"
+
+// The bundled glad loader only covers GL 3.3 core. Entry points and enums of newer versions
+// that optional fast paths use are declared and loaded here; callers must check the has*()
+// queries before using them.
+
+#ifndef GL_DRAW_INDIRECT_BUFFER
+#define GL_DRAW_INDIRECT_BUFFER 0x8F3F
+#endif
+#ifndef GL_SHADER_STORAGE_BUFFER
+#define GL_SHADER_STORAGE_BUFFER 0x90D2
+#endif
+#ifndef GL_COMPUTE_SHADER
+#define GL_COMPUTE_SHADER 0x91B9
+#endif
+#ifndef GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT
+#define GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT 0x00000001
+#endif
+#ifndef GL_COMMAND_BARRIER_BIT
+#define GL_COMMAND_BARRIER_BIT 0x00000040
+#endif
+#ifndef GL_SHADER_STORAGE_BARRIER_BIT
+#define GL_SHADER_STORAGE_BARRIER_BIT 0x00002000
+#endif
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#ifndef GL_COMPRESSED_RGBA_BPTC_UNORM
+#define GL_COMPRESSED_RGBA_BPTC_UNORM 0x8E8C
+#endif
+
+namespace SFE {
+
+class GLExtensions {
+public:
+    typedef void (APIENTRYP DispatchComputeProc)(GLuint groupsX, GLuint groupsY, GLuint groupsZ);
+    typedef void (APIENTRYP MemoryBarrierProc)(GLbitfield barriers);
+    typedef void (APIENTRYP DrawElementsIndirectProc)(GLenum mode, GLenum type, const void* indirect);
+    typedef GLuint64 (APIENTRYP GetTextureHandleProc)(GLuint texture);
+    typedef void (APIENTRYP MakeTextureHandleResidentProc)(GLuint64 handle);
+    typedef void (APIENTRYP MakeTextureHandleNonResidentProc)(GLuint64 handle);
+
+    // Query the context version and load the extra entry points. Call once after gladLoadGLLoader.
+    static void load(GLADloadproc loader);
+
+    static int getMajorVersion() { return majorVersion; }
+    static int getMinorVersion() { return minorVersion; }
+
+    // GL 4.0 / ARB_draw_indirect
+    static bool hasDrawIndirect() { return drawElementsIndirect != nullptr; }
+    // GL 4.3: compute shaders, SSBOs and glMemoryBarrier
+    static bool hasComputeShaders() { return dispatchCompute != nullptr && memoryBarrier != nullptr; }
+    // ARB_bindless_texture (needs GL 4.0 for its GLSL side)
+    static bool hasBindlessTexture() {
+        return getTextureHandle != nullptr && makeTextureHandleResident != nullptr &&
+               makeTextureHandleNonResident != nullptr;
+    }
+
+    // EXT_texture_compression_s3tc (BC1-BC3) and GL 4.2 / ARB_texture_compression_bptc (BC7)
+    static bool hasS3tcCompression() { return s3tcCompression; }
+    static bool hasBptcCompression() { return bptcCompression; }
+    // GL internal format to upload a cooked format's blocks as, or 0 when the context cannot
+    // sample them (and for uncompressed RGBA8)
+    static GLenum getCompressedTextureFormat(TextureFileFormat format);
+
+    static bool hasExtension(const char* name);
+
+    static DispatchComputeProc dispatchCompute;
+    static MemoryBarrierProc memoryBarrier;
+    static DrawElementsIndirectProc drawElementsIndirect;
+    static GetTextureHandleProc getTextureHandle;
+    static MakeTextureHandleResidentProc makeTextureHandleResident;
+    static MakeTextureHandleNonResidentProc makeTextureHandleNonResident;
+
+private:
+    static int majorVersion;
+    static int minorVersion;
+    static bool s3tcCompression;
+    static bool bptcCompression;
+};
+
+} // namespace SFE
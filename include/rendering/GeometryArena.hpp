@@ -0,0 +1,89 @@
+#pragma once
+#include <glad/glad.h>
+#include <cstddef>
+#include <cstdint>
+#include "core/FreeListAllocator.hpp"
+#include "rendering/VertexFormat.hpp"
+
+namespace SFE {
+
+// A mesh's slice of the shared geometry buffers
+struct GeometryAllocation {
+    VertexFormat format = VertexFormat::Standard;
+    uint32_t baseVertex = FreeListAllocator::INVALID_OFFSET;
+    uint32_t vertexCount = 0;
+    uint32_t firstIndex = FreeListAllocator::INVALID_OFFSET;
+    uint32_t indexCount = 0;
+
+    bool isValid() const { return baseVertex != FreeListAllocator::INVALID_OFFSET; }
+};
+
+// Owns a few large vertex/index buffers and suballocates every mesh out of them.
+// All meshes of one vertex format share a single VAO, so switching meshes only changes
+// the baseVertex/firstIndex of the draw call instead of rebinding vertex state.
+class GeometryArena {
+public:
+    static GeometryArena& getInstance();
+
+    // Reserve space for a mesh; buffers grow (doubling) when the free list cannot fit it
+    GeometryAllocation allocate(VertexFormat format, uint32_t vertexCount, uint32_t indexCount);
+
+    // Copy vertex/index data into a previously reserved allocation
+    void upload(const GeometryAllocation& allocation, const void* vertexData,
+                const uint32_t* indexData);
+
+    // Return the allocation's ranges to the free lists and invalidate it
+    void release(GeometryAllocation& allocation);
+
+    // Bind the shared VAO for a vertex format
+    void bindVertexFormat(VertexFormat format);
+
+    // Point the per-instance mat4 attributes (locations 3-6) of a format's VAO at 'buffer'.
+    // 'byteOffset' selects the first instance, which lets callers draw sub-ranges on GL 3.3.
+    void bindInstanceBuffer(VertexFormat format, GLuint buffer, size_t byteOffset = 0);
+
+    // Delete all GL objects; must be called while the context is still current
+    void shutdown();
+
+    static GLsizei getVertexStride(VertexFormat format);
+
+    size_t getVertexBytesUsed(VertexFormat format) const;
+    size_t getVertexBytesReserved(VertexFormat format) const;
+    size_t getIndexBytesUsed() const { return size_t(indexAllocator.getUsed()) * sizeof(uint32_t); }
+    size_t getIndexBytesReserved() const { return size_t(indexAllocator.getCapacity()) * sizeof(uint32_t); }
+
+    // Rule of five: singleton, no copies
+    GeometryArena(const GeometryArena&) = delete;
+    GeometryArena& operator=(const GeometryArena&) = delete;
+
+private:
+    GeometryArena() = default;
+    ~GeometryArena() = default;
+
+    struct VertexPool {
+        GLuint vao = 0;
+        GLuint vbo = 0;
+        FreeListAllocator allocator;
+    };
+
+    static constexpr uint32_t INITIAL_VERTEX_CAPACITY = 64 * 1024;
+    static constexpr uint32_t INITIAL_INDEX_CAPACITY = 256 * 1024;
+
+    VertexPool& getPool(VertexFormat format) { return pools[static_cast<size_t>(format)]; }
+    const VertexPool& getPool(VertexFormat format) const { return pools[static_cast<size_t>(format)]; }
+
+    void ensureIndexBuffer();
+    void ensurePool(VertexFormat format);
+    void setupVertexAttributes(VertexFormat format);
+    void growVertexPool(VertexFormat format, uint32_t minCapacity);
+    void growIndexBuffer(uint32_t minCapacity);
+
+    // Allocate a new buffer of 'newBytes' and copy 'oldBytes' of 'oldBuffer' into it
+    static GLuint reallocateBuffer(GLuint oldBuffer, size_t oldBytes, size_t newBytes);
+
+    VertexPool pools[static_cast<size_t>(VertexFormat::Count)];
+    GLuint ebo = 0;
+    FreeListAllocator indexAllocator;
+};
+
+} // namespace SFE
@@ -0,0 +1,130 @@
+#pragma once
+#include <glad/glad.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+#include "rendering/Frustum.hpp"
+
+namespace SFE {
+
+class Mesh;
+class Shader;
+
+// Frustum-culls instance matrices on the GPU into a shared output buffer that the instanced
+// draw reads its per-instance attributes from.
+//  - Compute (GL 4.3): one thread per instance appends survivors with an atomic counter that
+//    is the instanceCount of a DrawElementsIndirect command, so the draw never touches the CPU.
+//  - TransformFeedback (GL 3.3): a vertex shader pass with rasterisation disabled copies every
+//    instance and writes culled ones as zero matrices, which collapse all their vertices onto
+//    one point. GL 3.3 has no indirect draws and reading a survivor count back would wait for
+//    the GPU, so all instances are drawn; culled ones cost vertex shading but no fragments.
+// Every cullAndDraw() call in a frame writes its own range of the output buffer and its own
+// command, so several meshes or LOD buckets can be culled back to back.
+class GpuInstanceCuller {
+public:
+    enum class Mode {
+        Disabled,
+        TransformFeedback,
+        Compute
+    };
+
+    GpuInstanceCuller() = default;
+    ~GpuInstanceCuller();
+
+    GpuInstanceCuller(const GpuInstanceCuller&) = delete;
+    GpuInstanceCuller& operator=(const GpuInstanceCuller&) = delete;
+
+    // Load the culling programs. 'preferred' = Compute falls back to TransformFeedback when the
+    // context lacks GL 4.3. Returns false (and stays Disabled) if no path is usable.
+    bool initialize(Mode preferred = Mode::Compute);
+    void shutdown();
+
+    Mode getMode() const { return mode; }
+    bool isEnabled() const { return mode != Mode::Disabled; }
+    static const char* getModeName(Mode mode);
+
+    // Start a frame: set the frustum and recycle the output ranges of the previous frame
+    void beginFrame(const glm::mat4& viewProjection);
+
+    // Cull 'instanceCount' mat4 instances of 'instanceBuffer' starting at 'firstInstance' against
+    // the mesh's bounding sphere, then draw the survivors with the index range of 'lod' using
+    // 'drawShader' (re-bound after the culling program; its uniforms must already be set)
+    void cullAndDraw(const Mesh& mesh, uint32_t lod, const Shader& drawShader, GLuint instanceBuffer,
+                     uint32_t firstInstance, uint32_t instanceCount);
+
+    // Verification mode reads every result back and compares it with the CPU Frustum test.
+    // Stalls the pipeline; meant for driver bring-up (e.g. Mesa llvmpipe) and tests.
+    void setVerification(bool enabled) { verification = enabled; }
+    uint64_t getVerifiedCullCount() const { return verifiedCulls; }
+    uint64_t getVerificationFailureCount() const { return verificationFailures; }
+
+    // Instances submitted / drawn since beginFrame(); the drawn count is only known on the CPU
+    // in verification mode
+    uint32_t getSubmittedInstanceCount() const { return submittedInstances; }
+    uint32_t getVisibleInstanceCount() const { return visibleInstances; }
+
+private:
+    struct DrawElementsIndirectCommand {
+        GLuint count;
+        GLuint instanceCount;
+        GLuint firstIndex;
+        GLint baseVertex;
+        GLuint baseInstance;
+    };
+
+    static constexpr uint32_t COMPUTE_GROUP_SIZE = 64;
+    static constexpr uint32_t INITIAL_OUTPUT_CAPACITY = 4096;
+    static constexpr uint32_t INITIAL_COMMAND_CAPACITY = 64;
+
+    bool loadComputeProgram();
+    bool loadTransformFeedbackProgram();
+    GLuint compileStage(GLenum type, const std::string& path);
+    bool linkProgram(GLuint program, const std::string& name);
+    void cacheUniformLocations();
+
+    void ensureOutputCapacity(uint32_t instanceCount);
+    void ensureCommandCapacity(uint32_t commandCount);
+
+    uint32_t cullCompute(const Mesh& mesh, uint32_t lod, GLuint instanceBuffer, uint32_t firstInstance,
+                         uint32_t instanceCount, uint32_t outputOffset, uint32_t commandIndex);
+    void cullTransformFeedback(const Mesh& mesh, GLuint instanceBuffer, uint32_t firstInstance,
+                               uint32_t instanceCount, uint32_t outputOffset);
+    // Compute output is compacted; TransformFeedback output keeps every slot, zeroing culled ones.
+    // Both return the number of instances the GPU kept.
+    uint32_t verifyCull(const Mesh& mesh, GLuint instanceBuffer, uint32_t firstInstance, uint32_t instanceCount,
+                        uint32_t outputOffset, uint32_t gpuVisibleCount);
+    uint32_t verifyZeroedCull(const Mesh& mesh, GLuint instanceBuffer, uint32_t firstInstance,
+                              uint32_t instanceCount, uint32_t outputOffset);
+
+    Mode mode = Mode::Disabled;
+    GLuint program = 0;
+    GLuint feedbackVao = 0;   // TransformFeedback: input instance stream as points
+    GLuint outputBuffer = 0;  // Compacted instance matrices
+    GLuint commandBuffer = 0; // Compute: one indirect command per cullAndDraw
+    uint32_t outputCapacity = 0;
+    uint32_t commandCapacity = 0;
+
+    // Uniform locations of the active program
+    GLint frustumPlanesLocation = -1;
+    GLint boundingSphereLocation = -1;
+    GLint firstInstanceLocation = -1;
+    GLint instanceCountLocation = -1;
+    GLint outputOffsetLocation = -1;
+    GLint commandIndexLocation = -1;
+
+    Frustum frustum{};
+    uint32_t outputCursor = 0;
+    uint32_t commandCursor = 0;
+    uint32_t submittedInstances = 0;
+    uint32_t visibleInstances = 0;
+
+    bool verification = false;
+    uint64_t verifiedCulls = 0;
+    uint64_t verificationFailures = 0;
+    std::vector<glm::mat4> readbackScratch;
+    std::vector<glm::mat4> outputScratch;
+};
+
+} // namespace SFE
@@ -0,0 +1,94 @@
+#pragma once
+#include <glad/glad.h>
+#include <cstdint>
+#include <vector>
+#include "core/Profiler.hpp"
+
+namespace SFE {
+
+// GPU zones measured with GL_TIMESTAMP queries (timestamps rather than GL_TIME_ELAPSED, which
+// cannot nest). Each frame records into its own slot of a query pool; results are read
+// 'framesInFlight' frames later, once the GPU is known to be done, so nothing ever waits on
+// the GPU. A slot whose queries are still not available when it comes round again is dropped.
+// Resolved zones go to the CPU Profiler on a "GPU" track, so they show up in the same frame
+// report and Chrome trace as the CPU zones (reported framesInFlight frames late).
+class GpuProfiler {
+public:
+    static GpuProfiler& getInstance() {
+        static GpuProfiler instance;
+        return instance;
+    }
+
+    // Needs a current context; returns false (and stays disabled) without timer queries
+    bool initialize(uint32_t framesInFlight = 3);
+    void shutdown();
+    bool isEnabled() const { return enabled; }
+
+    // Call once per frame before Profiler::endFrame(): closes the previous frame's zones and
+    // submits any results that have become available
+    void beginFrame();
+
+    void beginZone(const char* name);
+    void endZone();
+
+    uint64_t getDroppedFrameCount() const { return droppedFrames; }
+    // GPU time between the two beginFrame() calls of the most recently resolved frame
+    double getLastFrameMs() const { return lastFrameMs; }
+
+private:
+    GpuProfiler() = default;
+    ~GpuProfiler() = default;
+    GpuProfiler(const GpuProfiler&) = delete;
+    GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+    struct QueryZone {
+        const char* name;
+        uint32_t beginQuery;
+        uint32_t endQuery;
+        uint32_t depth;
+    };
+
+    struct FrameSlot {
+        std::vector<GLuint> queries; // Grows as needed, reused every time the slot comes round
+        uint32_t usedQueries = 0;
+        std::vector<QueryZone> zones; // zones[0] spans the whole frame
+        bool pending = false;
+        uint64_t cpuSyncTicks = 0; // Profiler::now() and GL_TIMESTAMP sampled together
+        int64_t gpuSyncNanoseconds = 0;
+    };
+
+    uint32_t writeTimestamp(FrameSlot& slot);
+    void closeFrame(FrameSlot& slot);
+    void resolve(FrameSlot& slot);
+
+    bool enabled = false;
+    std::vector<FrameSlot> slots;
+    uint32_t currentSlot = 0;
+    bool frameOpen = false;
+    std::vector<uint32_t> openZones; // Indices into the current slot's zones
+    uint32_t gpuTrack = 0;
+    bool gpuTrackRegistered = false;
+    uint64_t droppedFrames = 0;
+    double lastFrameMs = 0.0;
+};
+
+class GpuProfileScope {
+public:
+    explicit GpuProfileScope(const char* name) { GpuProfiler::getInstance().beginZone(name); }
+    ~GpuProfileScope() { GpuProfiler::getInstance().endZone(); }
+
+    GpuProfileScope(const GpuProfileScope&) = delete;
+    GpuProfileScope& operator=(const GpuProfileScope&) = delete;
+};
+
+} // namespace SFE
+
+#if SFE_PROFILING_ENABLED
+#define SFE_GPU_PROFILE_SCOPE(name) ::SFE::GpuProfileScope SFE_PROFILE_CONCAT(sfeGpuProfileScope, __LINE__)(name)
+#define SFE_GPU_PROFILE_BEGIN(name) ::SFE::GpuProfiler::getInstance().beginZone(name)
+#define SFE_GPU_PROFILE_END() ::SFE::GpuProfiler::getInstance().endZone()
+#else
+#define SFE_GPU_PROFILE_SCOPE(name) ((void)0)
+#define SFE_GPU_PROFILE_BEGIN(name) ((void)0)
+#define SFE_GPU_PROFILE_END() ((void)0)
+#endif
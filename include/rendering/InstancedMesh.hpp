@@ -4,16 +4,46 @@
 #include <vector>
 
 namespace SFE {
+class Camera;
+class GpuInstanceCuller;
+class Shader;
+
 class InstancedMesh : public Mesh {
 public:
+    InstancedMesh(); // Geometry supplied later via setVertices()/loadFromFile()
     InstancedMesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
     ~InstancedMesh();
 
+    // Upload instances as given; every instance draws LOD 0
     void updateInstanceData(const std::vector<glm::mat4>& modelMatrices);
+    // Pick a LOD per instance from its projected size as seen by 'camera' (fov = camera.zoom) and
+    // upload the instances grouped by LOD, so drawInstanced() issues one draw per non-empty LOD
+    void updateInstanceData(const std::vector<glm::mat4>& modelMatrices, const Camera& camera,
+                            float viewportHeight, float maxPixelError = 1.0f);
+
+    // Draw the first 'instanceCount' uploaded instances at LOD 0
     void drawInstanced(unsigned int instanceCount) const;
+    // Draw all instances of the last update, one instanced draw per LOD bucket
+    void drawInstanced() const;
+    // Same, but frustum-cull each LOD bucket on the GPU first and draw only the survivors
+    // with 'shader' (see GpuInstanceCuller; falls back to drawInstanced() when it is disabled)
+    void drawInstanced(GpuInstanceCuller& culler, const Shader& shader) const;
+
+    // Instances assigned to 'lod' by the last update (for stats/HUD)
+    uint32_t getLodInstanceCount(uint32_t lod) const {
+        return lod < lodBuckets.size() ? lodBuckets[lod].instanceCount : 0;
+    }
 
 private:
+    struct LodBucket {
+        uint32_t firstInstance = 0;
+        uint32_t instanceCount = 0;
+    };
+
     unsigned int instanceVBO;
+    std::vector<LodBucket> lodBuckets;     // Indexed by LOD
+    std::vector<uint32_t> instanceLods;    // Scratch: selected LOD per input instance
+    std::vector<glm::mat4> sortedMatrices; // Scratch: instances grouped by LOD
     void setupInstanceVBO();
 };
-} 
\ No newline at end of file
+}
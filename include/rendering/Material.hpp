@@ -4,8 +4,8 @@
 #include <string>
 #include <unordered_map>
 #include <variant>
-#include "rendering/Shader.hpp"
-#include "rendering/Texture.hpp"
+#include "rendering/ResourceHandles.hpp"
+#include "rendering/TextureArrayPool.hpp"
 
 namespace SFE {
 
@@ -19,10 +19,13 @@ public:
         glm::vec4,
         glm::mat3,
         glm::mat4,
-        std::shared_ptr<Texture>
+        TextureHandle,
+        TextureSlice
     >;
 
-    Material(std::shared_ptr<Shader> shader);
+    // Shader and textures are ResourceRegistry handles. A TextureSlice uniform binds its array
+    // to unit 0 and sets "<name>Layer" to its layer (see shaders/simple_array.frag).
+    Material(ShaderHandle shader);
     ~Material() = default;
 
     // Set uniform values
@@ -35,7 +38,7 @@ public:
     void bind();
 
     // Get the shader
-    std::shared_ptr<Shader> getShader() const { return shader; }
+    ShaderHandle getShader() const { return shader; }
 
     // Set blending mode
     void setBlending(bool enabled);
@@ -50,7 +53,7 @@ public:
     bool getCulling() const { return cullingEnabled; }
 
 private:
-    std::shared_ptr<Shader> shader;
+    ShaderHandle shader;
     std::unordered_map<std::string, UniformValue> uniforms;
     
     bool blendingEnabled = false;
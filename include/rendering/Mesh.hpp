@@ -4,12 +4,19 @@
 #include <cstddef> // For size_t
 #include <memory>
 #include "rendering/Texture.hpp"
-#include <GL/glew.h>
+#include "rendering/GeometryArena.hpp"
+#include "rendering/MeshSimplifier.hpp"
+#include "rendering/ResourceHandles.hpp"
 #include <string>
 #include <glm/glm.hpp>
 
 namespace SFE { // Changed namespace to SFE
 
+class Shader;
+
+// Lightweight view of a mesh's vertex/index range inside the shared GeometryArena.
+// Owns no GL objects itself, so it is cheap to move and meshes of the same vertex
+// format can be drawn back to back without rebinding vertex state.
 class Mesh {
 public:
     struct Vertex {
@@ -19,29 +26,73 @@ public:
     };
 
     Mesh();
-    ~Mesh();
+    Mesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
+    virtual ~Mesh();
 
+    // Load a binary .sfm mesh (see MeshFormat.hpp) produced by tools/mesh_cooker
     bool loadFromFile(const std::string& filename);
     void setVertices(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
-    void setTexture(Texture* texture);
+    // Same, but first reorders triangles/vertices for the post-transform cache (see MeshOptimizer)
+    // and, with lodCount > 1, generates a simplified LOD chain (see MeshSimplifier)
+    void setVertices(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+                     bool optimize, uint32_t lodCount = 1);
+    // Texture bound by render(), resolved through the ResourceRegistry
+    void setTexture(TextureHandle texture) { m_texture = texture; }
+    TextureHandle getTexture() const { return m_texture; }
     void render() const;
 
-    // Rule of five: Prevent copying/moving for simple resource management
+    // Vertex layout used by subsequent setVertices() calls. Quantized formats halve the vertex
+    // size; shaders decode them with the uniforms set by applyVertexDecode().
+    void setVertexFormat(VertexFormat format) { m_requestedFormat = format; }
+    // Set positionScale/positionOffset/octNormals for the layout this mesh was uploaded in
+    void applyVertexDecode(const Shader& shader) const;
+
+    // Meshes own an arena allocation: movable, not copyable
     Mesh(const Mesh&) = delete;
     Mesh& operator=(const Mesh&) = delete;
-    Mesh(Mesh&&) = delete;
-    Mesh& operator=(Mesh&&) = delete;
+    Mesh(Mesh&& other) noexcept;
+    Mesh& operator=(Mesh&& other) noexcept;
 
     // Draw the mesh
     void draw() const;
-    void setTexture(std::shared_ptr<Texture> tex);
-
-private:
-    GLuint m_VAO;
-    GLuint m_VBO;
-    GLuint m_EBO;
-    GLsizei m_indexCount;
-    Texture* m_texture;
-    bool useEBO;          // Whether to use indexed drawing
+
+    // Location of the mesh inside the shared buffers (for batching callers); index ranges are LOD 0
+    VertexFormat getVertexFormat() const { return m_allocation.format; }
+    GLint getBaseVertex() const { return static_cast<GLint>(m_allocation.baseVertex); }
+    GLuint getFirstIndex() const { return getLodFirstIndex(0); }
+    GLsizei getIndexCount() const { return getLodIndexCount(0); }
+    const void* getIndexOffset() const { return getLodIndexOffset(0); }
+
+    // Level-of-detail chain: every LOD shares the vertex range and has its own index range
+    uint32_t getLodCount() const { return static_cast<uint32_t>(m_lods.size()); }
+    float getLodError(uint32_t lod) const { return lod < m_lods.size() ? m_lods[lod].error : 0.0f; }
+    GLuint getLodFirstIndex(uint32_t lod) const {
+        return m_allocation.firstIndex + (lod < m_lods.size() ? m_lods[lod].firstIndex : 0);
+    }
+    GLsizei getLodIndexCount(uint32_t lod) const {
+        return lod < m_lods.size() ? static_cast<GLsizei>(m_lods[lod].indexCount) : 0;
+    }
+    const void* getLodIndexOffset(uint32_t lod) const { return (void*)(size_t(getLodFirstIndex(lod)) * sizeof(GLuint)); }
+
+    // Coarsest LOD whose error, scaled by 'scale' and seen from 'distance', projects to at most
+    // 'maxPixelError' pixels. 'screenScale' is pixels per world unit at distance 1, i.e.
+    // viewportHeight / (2 * tan(fovY / 2)).
+    uint32_t selectLod(float distance, float scale, float screenScale, float maxPixelError) const;
+
+    // Object-space bounding box of the vertex positions
+    const glm::vec3& getBoundsMin() const { return m_boundsMin; }
+    const glm::vec3& getBoundsMax() const { return m_boundsMax; }
+
+protected:
+    void releaseGeometry();
+    void uploadGeometry(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+                        std::vector<MeshLod> lods);
+
+    GeometryAllocation m_allocation;
+    TextureHandle m_texture;
+    glm::vec3 m_boundsMin{0.0f};
+    glm::vec3 m_boundsMax{0.0f};
+    VertexFormat m_requestedFormat = VertexFormat::Standard;
+    std::vector<MeshLod> m_lods; // Empty until geometry is uploaded
 };
-} // End namespace SFE 
\ No newline at end of file
+} // End namespace SFE
@@ -0,0 +1,81 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "rendering/VertexFormat.hpp"
+
+namespace SFE {
+
+// Binary mesh blob (.sfm) written by tools/mesh_cooker and read by Mesh::loadFromFile.
+// Layout: MeshFileHeader | LOD table | vertex data | index data, each section aligned to
+// MESH_FILE_ALIGNMENT. Vertex data is stored in the exact GPU layout of 'vertexFormat'
+// so the loader can upload straight from the memory-mapped file. All LODs share the vertex
+// data; the index data holds their index ranges back to back, LOD 0 first.
+constexpr uint32_t MESH_FILE_MAGIC = 0x4D464653; // "SFFM" little-endian
+constexpr uint32_t MESH_FILE_VERSION = 2;
+constexpr uint32_t MESH_FILE_MIN_VERSION = 1; // Version 1: no LOD table
+constexpr uint32_t MESH_FILE_MAX_LODS = 8;
+constexpr uint32_t MESH_FILE_ALIGNMENT = 16;
+
+struct MeshFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t vertexFormat; // VertexFormat
+    uint32_t vertexStride; // Bytes per vertex, must match the runtime layout
+    uint32_t vertexCount;
+    uint32_t indexCount;   // 32-bit indices, triangle list, all LODs
+    uint32_t flags;        // MeshFileFlags
+    uint32_t lodCount;     // MeshFileLod entries; 0 means one LOD covering all indices
+    uint64_t vertexDataOffset;
+    uint64_t indexDataOffset;
+    uint64_t fileSize;
+    float boundsMin[3];
+    float boundsMax[3];
+    uint64_t lodTableOffset;
+    uint32_t reserved[2];
+};
+static_assert(sizeof(MeshFileHeader) == 96, "MeshFileHeader layout is part of the file format");
+
+struct MeshFileLod {
+    uint32_t firstIndex; // Relative to the start of the index data
+    uint32_t indexCount;
+    float error;         // Object-space simplification error (see MeshSimplifier)
+    uint32_t reserved;
+};
+static_assert(sizeof(MeshFileLod) == 16, "MeshFileLod layout is part of the file format");
+
+enum MeshFileFlags : uint32_t {
+    MESH_FILE_VERTEX_CACHE_OPTIMIZED = 1u << 0,
+    MESH_FILE_VERTEX_FETCH_OPTIMIZED = 1u << 1,
+    MESH_FILE_OVERDRAW_OPTIMIZED = 1u << 2,
+};
+
+// Everything needed to serialise a mesh; pointers are borrowed for the duration of the call
+struct MeshFileDesc {
+    VertexFormat vertexFormat = VertexFormat::Standard;
+    uint32_t vertexStride = 0;
+    const void* vertexData = nullptr;
+    uint32_t vertexCount = 0;
+    const uint32_t* indexData = nullptr;
+    uint32_t indexCount = 0;
+    uint32_t flags = 0;
+    const MeshFileLod* lods = nullptr; // Optional; none means a single full-detail LOD
+    uint32_t lodCount = 0;
+    float boundsMin[3] = {0.0f, 0.0f, 0.0f};
+    float boundsMax[3] = {0.0f, 0.0f, 0.0f};
+};
+
+// Write a mesh blob to 'path'. Returns false on I/O error.
+bool writeMeshFile(const std::string& path, const MeshFileDesc& desc);
+
+// Check that 'data' holds a complete, supported-version mesh blob with in-range indices and LODs.
+// Returns the header (pointing into 'data') or nullptr with 'error' set.
+const MeshFileHeader* validateMeshFile(const uint8_t* data, size_t size, std::string& error);
+
+// LOD table of a validated blob; nullptr when the file has none
+inline const MeshFileLod* getMeshFileLods(const uint8_t* data, const MeshFileHeader& header) {
+    if (header.version < 2 || header.lodCount == 0) return nullptr;
+    return reinterpret_cast<const MeshFileLod*>(data + header.lodTableOffset);
+}
+
+} // namespace SFE
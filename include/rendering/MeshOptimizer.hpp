@@ -0,0 +1,80 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace SFE {
+
+// Index/vertex reordering passes for triangle lists. Pure CPU, usable both offline
+// (tools/mesh_cooker) and at load time (Mesh::setVertices with optimize = true).
+
+// Post-transform cache efficiency of an index buffer, simulated with a FIFO cache
+struct VertexCacheStats {
+    uint32_t vertexTransforms = 0; // Cache misses
+    float acmr = 0.0f;             // Average cache miss ratio: transforms per triangle (0.5 is ideal)
+    float atvr = 0.0f;             // Average transform to vertex ratio: transforms per vertex (1.0 is ideal)
+};
+
+VertexCacheStats analyzeVertexCache(const std::vector<uint32_t>& indices, size_t vertexCount,
+                                    uint32_t cacheSize = 16);
+
+// Reorder triangles for post-transform vertex cache hits (Tom Forsyth's linear-speed algorithm).
+// The triangle set is unchanged; only the order (and rotation within a triangle) changes.
+// Triangles referencing a vertex >= vertexCount and a trailing partial triangle are dropped.
+std::vector<uint32_t> optimizeVertexCache(const std::vector<uint32_t>& indices, size_t vertexCount);
+
+// Reorder triangles so that clusters likely to occlude others are drawn first, while keeping the
+// cache efficiency of 'indices' within 'threshold' (e.g. 1.05 = allow 5% worse ACMR).
+// Expects indices that already went through optimizeVertexCache; drops invalid triangles the same way.
+std::vector<uint32_t> optimizeOverdraw(const std::vector<uint32_t>& indices, const float* positions,
+                                       size_t vertexCount, size_t positionStride,
+                                       float threshold = 1.05f);
+
+// Build a remap table ordering vertices by first use in 'indices' for fetch locality.
+// Unreferenced vertices map to UINT32_MAX and out-of-range indices are ignored. Returns the
+// number of referenced vertices.
+size_t buildVertexFetchRemap(std::vector<uint32_t>& remap, const std::vector<uint32_t>& indices,
+                             size_t vertexCount);
+
+// Apply a remap table in place: rewrites indices and compacts vertices (of 'vertexSize' bytes each).
+// Indices outside the table are left as they are.
+void remapVertexBuffer(void* vertices, size_t vertexCount, size_t vertexSize,
+                       const std::vector<uint32_t>& remap);
+void remapIndexBuffer(std::vector<uint32_t>& indices, const std::vector<uint32_t>& remap);
+
+struct MeshOptimizationReport {
+    VertexCacheStats before;
+    VertexCacheStats after;
+    size_t vertexCountBefore = 0;
+    size_t vertexCountAfter = 0;
+};
+
+// Run cache, optional overdraw, and fetch optimisation on an interleaved vertex buffer.
+// 'vertices' is resized to the referenced vertex count; positions are three floats at
+// 'positionOffset' within each vertex.
+template <typename VertexT>
+MeshOptimizationReport optimizeMesh(std::vector<VertexT>& vertices, std::vector<uint32_t>& indices,
+                                    size_t positionOffset, bool optimizeForOverdraw = false) {
+    MeshOptimizationReport report;
+    report.vertexCountBefore = vertices.size();
+    report.before = analyzeVertexCache(indices, vertices.size());
+
+    indices = optimizeVertexCache(indices, vertices.size());
+    if (optimizeForOverdraw) {
+        const float* positions = reinterpret_cast<const float*>(
+            reinterpret_cast<const uint8_t*>(vertices.data()) + positionOffset);
+        indices = optimizeOverdraw(indices, positions, vertices.size(), sizeof(VertexT));
+    }
+
+    std::vector<uint32_t> remap;
+    size_t uniqueVertices = buildVertexFetchRemap(remap, indices, vertices.size());
+    remapVertexBuffer(vertices.data(), vertices.size(), sizeof(VertexT), remap);
+    remapIndexBuffer(indices, remap);
+    vertices.resize(uniqueVertices);
+
+    report.vertexCountAfter = vertices.size();
+    report.after = analyzeVertexCache(indices, vertices.size());
+    return report;
+}
+
+} // namespace SFE
@@ -0,0 +1,38 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace SFE {
+
+// Quadric error metric (Garland & Heckbert) edge-collapse simplification for indexed triangle
+// lists. Vertices are never moved or created: collapses snap one endpoint onto the other, so
+// every LOD indexes the same vertex buffer and a chain only costs extra index data.
+// Vertices on open borders or attribute seams (several vertices sharing a position) are locked
+// so silhouettes and UV/normal discontinuities are preserved.
+
+// One level of detail: a range of the mesh's index data plus the geometric error it introduces
+struct MeshLod {
+    uint32_t firstIndex = 0; // Relative to the start of the mesh's indices
+    uint32_t indexCount = 0;
+    float error = 0.0f;      // Object-space deviation from LOD 0, in mesh units
+};
+
+// Simplify towards 'targetIndexCount' indices without exceeding 'targetError' (object-space
+// distance). Returns the new index list; 'resultError' receives the error actually introduced.
+std::vector<uint32_t> simplifyMesh(const std::vector<uint32_t>& indices, const float* positions,
+                                   size_t vertexCount, size_t positionStride, size_t targetIndexCount,
+                                   float targetError, float* resultError = nullptr);
+
+struct LodChain {
+    std::vector<uint32_t> indices; // All LODs back to back, LOD 0 first
+    std::vector<MeshLod> lods;
+};
+
+// Build up to 'maxLods' levels, each targeting 'reduction' times the previous triangle count.
+// LOD 0 is 'indices' unchanged; coarser levels are vertex-cache optimised. The chain stops early
+// once a level can no longer be reduced meaningfully (e.g. everything left is locked).
+LodChain buildLodChain(const std::vector<uint32_t>& indices, const float* positions, size_t vertexCount,
+                       size_t positionStride, uint32_t maxLods, float reduction = 0.5f);
+
+} // namespace SFE
@@ -0,0 +1,90 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "rendering/Bvh.hpp"
+
+namespace SFE {
+
+// Software occlusion culling against a hierarchical Z buffer. Each frame, begin() takes the
+// camera, addOccluder() queues a few large meshes (walls, terrain, buildings) and end()
+// rasterises them into a small depth buffer and builds a max-depth pyramid over it. isVisible()
+// then projects an object's box, picks the pyramid level where it covers at most 2x2 texels and
+// reports it hidden when its nearest depth lies behind all of them.
+//
+// Rasterisation runs on the JobSystem: occluders are transformed in parallel, their triangles
+// binned into 32x32 tiles and each tile filled by one job, four pixels at a time with SSE where
+// available. Occluder triangles crossing the near plane are dropped rather than clipped, which
+// only loses occlusion. Depth is sampled at pixel centres, so results are approximate to about
+// a pixel at occluder silhouettes. Pure CPU; begin()/addOccluder()/end() on one thread, queries
+// from any number of threads after end().
+class OcclusionCuller {
+public:
+    struct Stats {
+        uint32_t occluders = 0;
+        uint32_t triangles = 0;   // Rasterised; dropped and off-screen ones excluded
+        double rasterizeMs = 0.0; // end(), pyramid included
+    };
+
+    // The buffer is rounded up to whole tiles
+    explicit OcclusionCuller(uint32_t width = 256, uint32_t height = 128);
+
+    // Starts a frame; drops the previous frame's occluders and depth
+    void begin(const glm::mat4& viewProjection);
+    // 'positions' and 'indices' (triangle list, object space) must stay alive until end()
+    void addOccluder(const glm::vec3* positions, const uint32_t* indices, uint32_t indexCount,
+                     const glm::mat4& model);
+    void end();
+
+    // False if 'bounds' (world space) is hidden behind the occluders or outside the view
+    bool isVisible(const Aabb& bounds) const;
+    // isVisible() over many boxes on the job system; 'visible' gets 1 or 0 per box. Returns the
+    // number culled.
+    uint32_t testVisibility(const Aabb* bounds, size_t count, uint8_t* visible) const;
+
+    uint32_t getWidth() const { return width; }
+    uint32_t getHeight() const { return height; }
+    uint32_t getLevelCount() const { return static_cast<uint32_t>(levels.size()); }
+    // Level 0 is the depth buffer (0 near, 1 far, rows bottom to top); each further level holds
+    // the farthest depth of 2x2 texels of the one below
+    const std::vector<float>& getDepth(uint32_t level = 0) const { return levels[level].depth; }
+    const Stats& getStats() const { return stats; }
+
+    static constexpr uint32_t TILE_SIZE = 32;
+
+private:
+    struct Occluder {
+        const glm::vec3* positions;
+        const uint32_t* indices;
+        uint32_t indexCount;
+        glm::mat4 model;
+        uint32_t firstTriangle; // Into 'triangles'
+    };
+    // Screen-space triangle set up for rasterisation: edge functions a*x + b*y + c >= 0 inside,
+    // depth = depthX*x + depthY*y + depthC
+    struct ScreenTriangle {
+        float edgeA[3], edgeB[3], edgeC[3];
+        float depthX, depthY, depthC;
+        int minX, minY, maxX, maxY; // Pixel bounds, clamped to the screen; minX > maxX if dropped
+    };
+    struct Level {
+        uint32_t width, height;
+        std::vector<float> depth;
+    };
+
+    void setupTriangles(const Occluder& occluder);
+    void rasterizeTile(uint32_t tile);
+    void buildPyramid();
+
+    uint32_t width, height;
+    uint32_t tilesX, tilesY;
+    glm::mat4 viewProjection{1.0f};
+    std::vector<Occluder> occluders;
+    std::vector<ScreenTriangle> triangles;
+    std::vector<std::vector<uint32_t>> tileBins; // Triangle indices per tile
+    std::vector<Level> levels;
+    Stats stats;
+};
+
+} // namespace SFE
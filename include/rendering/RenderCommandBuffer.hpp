@@ -0,0 +1,168 @@
+#pragma once
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <type_traits>
+
+namespace SFE {
+
+// One frame of GL work as compact POD packets in a linear buffer allocated once up front.
+// Recording never touches GL or the heap, so any thread can record; the thread that owns the
+// context replays the packets in order. Packets name GL objects by id and uniforms by string
+// literal. Work that needs an engine object on the GL thread (text, instanced meshes,
+// screenshots) goes through call(), which stores a function pointer and a trivially copyable
+// argument inline.
+//
+// Packets grow from the front of the buffer and frame data copied with allocate()/copy() from
+// the back; the buffer is full when they meet.
+class RenderCommandBuffer {
+public:
+    explicit RenderCommandBuffer(size_t capacityBytes = 256 * 1024);
+
+    // Movable, not copyable
+    RenderCommandBuffer(const RenderCommandBuffer&) = delete;
+    RenderCommandBuffer& operator=(const RenderCommandBuffer&) = delete;
+    RenderCommandBuffer(RenderCommandBuffer&&) noexcept = default;
+    RenderCommandBuffer& operator=(RenderCommandBuffer&&) noexcept = default;
+
+    // Forgets every packet and copy; the storage is kept
+    void reset();
+
+    // Recorders return false, and count a drop, when the buffer is full
+    bool clear(const glm::vec4& color, GLbitfield mask);
+    bool viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+    bool setCapability(GLenum capability, bool enabled);
+    bool useProgram(GLuint program);
+    // Uniforms of the program bound by the last useProgram(); 'name' must outlive the replay
+    bool setUniform(const char* name, int value);
+    bool setUniform(const char* name, float value);
+    bool setUniform(const char* name, const glm::vec3& value);
+    bool setUniform(const char* name, const glm::mat4& value);
+    bool bindTexture(GLuint unit, GLenum target, GLuint texture);
+    bool bindVertexArray(GLuint vertexArray);
+    // The bytes are copied into the buffer now and uploaded at replay
+    bool bufferSubData(GLenum target, GLuint buffer, GLintptr offset, const void* data, size_t size);
+    bool drawArrays(GLenum mode, GLint first, GLsizei count, GLsizei instances = 1);
+    bool drawElements(GLenum mode, GLsizei count, GLenum indexType, size_t indexOffset, GLsizei instances = 1);
+
+    // Calls function(argument) at replay, on the GL thread. T comes from the function alone, so
+    // call(beginZone, "Scene") works for a function taking const char* const&.
+    template <typename T>
+    bool call(void (*function)(const T&), const std::common_type_t<T>& argument);
+
+    // Frame data for call() arguments to point at; valid until reset(). nullptr when full.
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+    template <typename T>
+    T* copy(const T* data, size_t count);
+    const char* copyString(std::string_view text);
+
+    // Executes the packets in order; needs the GL context current
+    void replay() const;
+
+    size_t getUsedBytes() const { return packetBytes + (capacity - dataStart); }
+    size_t getCapacity() const { return capacity; }
+    uint32_t getPacketCount() const { return packetCount; }
+    uint32_t getDroppedCount() const { return dropped; }
+
+private:
+    enum class PacketType : uint16_t {
+        Clear,
+        Viewport,
+        SetCapability,
+        UseProgram,
+        UniformInt,
+        UniformFloat,
+        UniformVec3,
+        UniformMat4,
+        BindTexture,
+        BindVertexArray,
+        BufferSubData,
+        DrawArrays,
+        DrawElements,
+        Call
+    };
+
+    // Every packet starts with its header; 'size' includes the header and alignment padding
+    struct PacketHeader {
+        PacketType type;
+        uint32_t size;
+    };
+
+    template <typename Payload>
+    struct Packet {
+        PacketHeader header;
+        Payload payload;
+    };
+
+    static constexpr size_t PACKET_ALIGNMENT = 16;
+
+    template <typename Payload>
+    bool push(PacketType type, const Payload& payload);
+    template <typename Payload>
+    static const Payload& payloadAt(const unsigned char* packet) {
+        return reinterpret_cast<const Packet<Payload>*>(packet)->payload;
+    }
+
+    template <typename T>
+    struct CallArgument {
+        void (*function)(const T&);
+        T argument;
+    };
+    struct CallPayload {
+        void (*invoke)(const void* argument);
+    };
+    template <typename T>
+    static void invokeCall(const void* argument) {
+        const auto* call = static_cast<const CallArgument<T>*>(argument);
+        call->function(call->argument);
+    }
+
+    std::unique_ptr<unsigned char[]> storage;
+    size_t capacity = 0;
+    size_t packetBytes = 0;
+    size_t dataStart = 0; // Copies occupy [dataStart, capacity)
+    uint32_t packetCount = 0;
+    uint32_t dropped = 0;
+};
+
+template <typename Payload>
+bool RenderCommandBuffer::push(PacketType type, const Payload& payload) {
+    static_assert(std::is_trivially_copyable_v<Payload>, "Packets must be POD");
+    constexpr size_t size = (sizeof(Packet<Payload>) + PACKET_ALIGNMENT - 1) & ~(PACKET_ALIGNMENT - 1);
+    if (packetBytes + size > dataStart) {
+        ++dropped;
+        return false;
+    }
+    new (storage.get() + packetBytes) Packet<Payload>{{type, static_cast<uint32_t>(size)}, payload};
+    packetBytes += size;
+    ++packetCount;
+    return true;
+}
+
+template <typename T>
+bool RenderCommandBuffer::call(void (*function)(const T&), const std::common_type_t<T>& argument) {
+    static_assert(std::is_trivially_copyable_v<T>, "call() arguments are copied into the buffer");
+    static_assert(alignof(T) <= PACKET_ALIGNMENT, "call() arguments are at most 16-byte aligned");
+    // The argument follows the packet header, at the next packet alignment boundary
+    struct CallPacket {
+        alignas(PACKET_ALIGNMENT) CallPayload payload;
+        alignas(PACKET_ALIGNMENT) CallArgument<T> call;
+    };
+    return push(PacketType::Call, CallPacket{{&invokeCall<T>}, {function, argument}});
+}
+
+template <typename T>
+T* RenderCommandBuffer::copy(const T* data, size_t count) {
+    static_assert(std::is_trivially_copyable_v<T>, "Only POD data can be copied into the buffer");
+    void* destination = allocate(sizeof(T) * count, alignof(T));
+    if (!destination) return nullptr;
+    if (count > 0) std::memcpy(destination, data, sizeof(T) * count);
+    return static_cast<T*>(destination);
+}
+
+} // namespace SFE
@@ -1,10 +1,9 @@
 #pragma once
 #include <memory>
 #include <vector>
-#include <unordered_map>
 #include <glm/glm.hpp>
 #include "rendering/Renderable.hpp"
-#include "rendering/Shader.hpp"
+#include "rendering/ResourceHandles.hpp"
 
 namespace SFE {
 
@@ -34,15 +33,25 @@ public:
     // Clear all renderables
     void clear();
 
+    // Materials are looked up when the pipeline sorts; call after changing a renderable's material
+    void markDirty() { needsSorting = true; }
+
 private:
+    // One renderable ready to draw; plain pointers into objects kept alive by 'renderables'
+    struct DrawItem {
+        ShaderHandle shader;
+        Material* material;
+        Renderable* renderable;
+    };
+
     // Sort renderables by shader and material for efficient rendering
     void sortRenderables();
 
     // Render a batch of objects with the same shader
-    void renderBatch(const std::vector<std::shared_ptr<Renderable>>& batch);
+    void renderBatch(const DrawItem* begin, const DrawItem* end);
 
     std::vector<std::shared_ptr<Renderable>> renderables;
-    std::unordered_map<std::shared_ptr<Shader>, std::vector<std::shared_ptr<Renderable>>> renderBatches;
+    std::vector<DrawItem> drawItems; // Grouped by shader
     
     glm::mat4 viewMatrix;
     glm::mat4 projectionMatrix;
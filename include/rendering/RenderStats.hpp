@@ -0,0 +1,86 @@
+#pragma once
+#include <glad/glad.h>
+#include <cstdint>
+#include <string>
+
+namespace SFE {
+
+// Per-frame counters of the work the engine submits to GL. The engine's GL call sites (Shader,
+// Mesh, InstancedMesh, TextRenderer, Texture, GeometryArena, GpuInstanceCuller) record into
+// it, so application code gets the numbers without counting anything by hand. GL thread only.
+class RenderStats {
+public:
+    struct Counters {
+        uint32_t drawCalls = 0;
+        uint32_t indirectDrawCalls = 0; // Also in drawCalls; their instance count stays on the GPU
+        uint64_t triangles = 0;
+        uint64_t instances = 0;
+        uint32_t programBinds = 0;
+        uint32_t vertexArrayBinds = 0;
+        uint32_t textureBinds = 0;
+        uint64_t bufferBytesUploaded = 0;
+        uint64_t textureBytesUploaded = 0;
+    };
+
+    // Running totals and peaks over every frame since the last reset, for benchmark reports
+    struct Summary {
+        uint64_t frames = 0;
+        Counters total;
+        Counters peak;
+    };
+
+    static RenderStats& getInstance() {
+        static RenderStats instance;
+        return instance;
+    }
+
+    void recordDraw(GLenum mode, uint32_t vertexCount, uint32_t instanceCount = 1) {
+        current.drawCalls++;
+        current.instances += instanceCount;
+        current.triangles += uint64_t(trianglesPerInstance(mode, vertexCount)) * instanceCount;
+    }
+    void recordIndirectDraw() {
+        current.drawCalls++;
+        current.indirectDrawCalls++;
+    }
+    void recordProgramBind() { current.programBinds++; }
+    void recordVertexArrayBind() { current.vertexArrayBinds++; }
+    void recordTextureBind() { current.textureBinds++; }
+    void recordBufferUpload(uint64_t bytes) { current.bufferBytesUploaded += bytes; }
+    void recordTextureUpload(uint64_t bytes) { current.textureBytesUploaded += bytes; }
+
+    // Counts so far in the frame being recorded; diff two snapshots to measure one section
+    const Counters& getCurrent() const { return current; }
+    // The last complete frame
+    const Counters& getLastFrame() const { return lastFrame; }
+    const Summary& getSummary() const { return summary; }
+
+    // Publish the current counters as the last frame, fold them into the summary and restart
+    void endFrame();
+    void resetSummary() { summary = Summary{}; }
+
+    static Counters difference(const Counters& later, const Counters& earlier);
+    // {"draw_calls":..,...} for the benchmark report
+    static std::string toJson(const Counters& counters);
+    static std::string toJson(const Summary& summary);
+
+private:
+    RenderStats() = default;
+    RenderStats(const RenderStats&) = delete;
+    RenderStats& operator=(const RenderStats&) = delete;
+
+    static uint32_t trianglesPerInstance(GLenum mode, uint32_t vertexCount) {
+        switch (mode) {
+        case GL_TRIANGLES: return vertexCount / 3;
+        case GL_TRIANGLE_STRIP:
+        case GL_TRIANGLE_FAN: return vertexCount >= 3 ? vertexCount - 2 : 0;
+        default: return 0; // Points and lines
+        }
+    }
+
+    Counters current;
+    Counters lastFrame;
+    Summary summary;
+};
+
+} // namespace SFE
@@ -0,0 +1,74 @@
+#pragma once
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "rendering/RenderCommandBuffer.hpp"
+
+namespace SFE {
+
+// Owns the window's GL context on a dedicated thread and replays RenderCommandBuffers there.
+// Two command buffers alternate: while the render thread replays and presents frame N, the game
+// thread simulates and records frame N+1, and only waits if it gets to frame N+2 before frame N
+// has been presented. Everything the game thread records into a frame (including copies made
+// with allocate()) therefore stays valid until that frame has been replayed.
+//
+// Without a thread (inline mode) submitFrame() replays and presents on the calling thread, which
+// keeps the context; the recording code is the same either way.
+class RenderThread {
+public:
+    RenderThread() = default;
+    ~RenderThread();
+
+    RenderThread(const RenderThread&) = delete;
+    RenderThread& operator=(const RenderThread&) = delete;
+
+    // Takes over the context current on the calling thread, which must be the window's
+    bool start(GLFWwindow* window, bool threaded, size_t commandBufferBytes = 1024 * 1024);
+    // Replays and presents everything submitted, then makes the context current on the caller again
+    void stop();
+    bool isThreaded() const { return threaded; }
+
+    // The command buffer for the next frame, empty. Blocks while its previous frame is still
+    // being replayed.
+    RenderCommandBuffer& beginFrame();
+    // Queues the frame recorded since beginFrame() to be replayed and presented
+    void submitFrame();
+
+    // Runs 'task' on the GL thread after every submitted frame and waits for it. For rare work
+    // that cannot be recorded (shader reloads, resource creation), not for every frame.
+    void execute(const std::function<void()>& task);
+
+    uint64_t getFramesPresented() const;
+    // Time the game thread spent blocked in beginFrame() for the last frame
+    double getLastWaitMs() const { return lastWaitMs; }
+
+private:
+    void run();
+    void present(RenderCommandBuffer& commands);
+
+    GLFWwindow* window = nullptr;
+    bool threaded = false;
+    bool running = false;
+    std::thread thread;
+
+    std::unique_ptr<RenderCommandBuffer> commandBuffers[2];
+    uint32_t recordIndex = 0; // Game thread only
+    uint32_t replayIndex = 0; // Render thread only
+    double lastWaitMs = 0.0;
+
+    // Shared with the render thread
+    mutable std::mutex mutex;
+    std::condition_variable workAvailable;
+    std::condition_variable workFinished;
+    bool queued[2] = {false, false};
+    const std::function<void()>* task = nullptr;
+    bool stopping = false;
+    uint64_t framesPresented = 0;
+};
+
+} // namespace SFE
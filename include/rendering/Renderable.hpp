@@ -17,6 +17,10 @@ public:
     // Bind the necessary resources (VAO, textures, etc.)
     virtual void bind() = 0;
 
+    // Set the shader's vertex decode uniforms for this renderable's geometry (see
+    // Mesh::applyVertexDecode); called after bind(), before draw()
+    virtual void applyVertexDecode(const Shader& shader) const = 0;
+
     // Perform the actual draw call
     virtual void draw() = 0;
 
@@ -0,0 +1,16 @@
+#pragma once
+#include "core/HandlePool.hpp"
+
+class Texture;
+
+namespace SFE {
+
+class Mesh;
+class Shader;
+
+// Handles into the ResourceRegistry pools
+using TextureHandle = Handle<::Texture>;
+using MeshHandle = Handle<Mesh>;
+using ShaderHandle = Handle<Shader>;
+
+} // namespace SFE
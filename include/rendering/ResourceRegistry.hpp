@@ -0,0 +1,80 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include "core/HandlePool.hpp"
+#include "rendering/Mesh.hpp"
+#include "rendering/ResourceHandles.hpp"
+#include "rendering/Shader.hpp"
+#include "rendering/TextureArrayPool.hpp"
+#include "rendering/Texture.hpp"
+
+namespace SFE {
+
+// Owns every texture, mesh and shader in dense per-type pools and hands out 32-bit generational
+// handles for them, so draw packets and materials store plain integers instead of pointers or
+// shared_ptrs. Resolving a handle is two array reads. A handle whose resource was released
+// resolves to nullptr and is counted (and reported once) instead of reaching freed memory.
+// Pointers from get() are only good until the next add or release of the same type.
+// Holds GL objects: modify it on the GL thread, and only while no other thread resolves handles
+// (before RenderThread::start(), or inside RenderThread::execute()).
+class ResourceRegistry {
+public:
+    static ResourceRegistry& getInstance();
+
+    // File-backed resources are loaded once per path; later calls return the same handle.
+    // A null handle means loading failed.
+    TextureHandle loadTexture(const std::string& path);
+    MeshHandle loadMesh(const std::string& path);
+
+    TextureHandle addTexture(Texture&& texture) { return textures.create(std::move(texture)); }
+    MeshHandle addMesh(Mesh&& mesh) { return meshes.create(std::move(mesh)); }
+    ShaderHandle addShader(Shader&& shader) { return shaders.create(std::move(shader)); }
+    // Swaps in a new program under an existing handle, e.g. after a hot reload
+    bool replaceShader(ShaderHandle handle, Shader&& shader);
+
+    Texture* get(TextureHandle handle) { return resolve(textures, handle, "texture"); }
+    Mesh* get(MeshHandle handle) { return resolve(meshes, handle, "mesh"); }
+    Shader* get(ShaderHandle handle) { return resolve(shaders, handle, "shader"); }
+
+    void release(TextureHandle handle);
+    void release(MeshHandle handle);
+    void release(ShaderHandle handle) { shaders.destroy(handle); }
+
+    // Textures packed into array layers, for batches that mix textures (TextureSlice)
+    TextureArrayPool& getTextureArrays() { return textureArrays; }
+
+    // Frees everything; must be called while the GL context is still current
+    void clear();
+
+    size_t getTextureCount() const { return textures.size(); }
+    size_t getMeshCount() const { return meshes.size(); }
+    size_t getShaderCount() const { return shaders.size(); }
+    // Lookups with a handle that was released
+    uint64_t getStaleLookupCount() const { return staleLookups.load(std::memory_order_relaxed); }
+
+    ResourceRegistry(const ResourceRegistry&) = delete;
+    ResourceRegistry& operator=(const ResourceRegistry&) = delete;
+
+private:
+    ResourceRegistry() = default;
+
+    template <typename T>
+    T* resolve(HandlePool<T>& pool, Handle<T> handle, const char* kind) {
+        T* resource = pool.get(handle);
+        if (!resource && !handle.isNull()) reportStale(kind, handle.getIndex(), handle.getGeneration());
+        return resource;
+    }
+    void reportStale(const char* kind, uint32_t index, uint32_t generation);
+
+    HandlePool<Texture> textures;
+    HandlePool<Mesh> meshes;
+    HandlePool<Shader> shaders;
+    TextureArrayPool textureArrays;
+    std::unordered_map<std::string, TextureHandle> texturePaths;
+    std::unordered_map<std::string, MeshHandle> meshPaths;
+    std::atomic<uint64_t> staleLookups{0}; // Lookups may come from the render thread and the main thread
+};
+
+} // namespace SFE
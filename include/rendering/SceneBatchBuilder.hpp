@@ -0,0 +1,36 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+#include "rendering/ResourceHandles.hpp"
+
+namespace SFE {
+
+class Material;
+
+// One instanced draw: a range of the instance stream
+struct SceneBatch {
+    ShaderHandle shader;
+    Material* material; // Null for instances drawn with the default shader
+    MeshHandle mesh;
+    TextureHandle texture;
+    uint32_t firstInstance;
+    uint32_t instanceCount;
+};
+
+// One queued instance
+struct SceneBatchItem {
+    ShaderHandle shader; // Already resolved; null items are dropped
+    Material* material;  // Only compared, never dereferenced
+    MeshHandle mesh;
+    TextureHandle texture;
+    uint32_t instance; // Into the submitted matrices
+};
+
+// The CPU half of SceneBatcher::draw(): sorts 'items' by shader, then material, mesh and texture
+// (submission order within a batch), and turns each run sharing all four into a batch whose
+// instances are consecutive in 'sortedMatrices'. Pure CPU, so it is testable without a context.
+void buildSceneBatches(std::vector<SceneBatchItem>& items, const std::vector<glm::mat4>& matrices,
+                       std::vector<SceneBatch>& batches, std::vector<glm::mat4>& sortedMatrices);
+
+} // namespace SFE
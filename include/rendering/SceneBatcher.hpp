@@ -0,0 +1,81 @@
+#pragma once
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+#include "core/World.hpp"
+#include "rendering/Frustum.hpp"
+#include "rendering/ResourceHandles.hpp"
+#include "rendering/SceneBatchBuilder.hpp"
+#include "rendering/TextureArrayPool.hpp"
+
+namespace SFE {
+
+class Material;
+class OcclusionCuller;
+class SceneNode;
+struct MeshInstance;
+
+// Draws SceneNodes with one glDrawElementsInstanced per mesh + material + texture instead of one
+// draw per node. Each frame, begin() takes the camera, submit() frustum-culls a node against its
+// mesh bounds and queues it, and draw() sorts the visible nodes into batches, uploads all their
+// model matrices as one instance stream and issues an instanced draw per batch. view/projection
+// are set once per shader. With an OcclusionCuller set, nodes it reports hidden are dropped at
+// submit() as well. Shaders read the model matrix from the instance stream when their
+// "instanced" uniform is set (see shaders/simple.vert). GL thread only.
+class SceneBatcher {
+public:
+    using Batch = SceneBatch;
+
+    SceneBatcher() = default;
+    ~SceneBatcher();
+
+    SceneBatcher(const SceneBatcher&) = delete;
+    SceneBatcher& operator=(const SceneBatcher&) = delete;
+
+    // Starts a frame; drops everything submitted for the previous one
+    void begin(const glm::mat4& view, const glm::mat4& projection);
+    // Hidden nodes, nodes without a mesh and nodes outside the frustum are skipped. The node's
+    // material must stay alive until draw().
+    void submit(const SceneNode& node);
+    // Every entity with a LocalToWorld and a MeshInstance (core/SceneComponents.hpp), culled the
+    // same way
+    void submit(World& world);
+    // One entity's components, e.g. from a snapshot taken off the render thread
+    void submit(const glm::mat4& model, const MeshInstance& instance);
+    // Culler whose end() ran for this frame's camera; null (the default) turns occlusion off
+    void setOcclusionCuller(const OcclusionCuller* culler) { occlusionCuller = culler; }
+    // Nodes without a material are drawn with 'defaultShader' (skipped if it is null)
+    void draw(ShaderHandle defaultShader = {});
+
+    // Batches of the last draw(), in draw order
+    const std::vector<Batch>& getBatches() const { return batches; }
+    uint32_t getSubmittedCount() const { return submittedCount; }
+    uint32_t getVisibleCount() const { return static_cast<uint32_t>(items.size()); }
+    uint32_t getOccludedCount() const { return occludedCount; }
+
+    // Delete the instance buffer; must be called while the context is still current
+    void shutdown();
+
+private:
+    void submitInstance(glm::mat4 model, MeshHandle mesh, TextureHandle texture, TextureSlice slice,
+                        Material* material);
+    void uploadInstances();
+
+    glm::mat4 viewMatrix{1.0f};
+    glm::mat4 projectionMatrix{1.0f};
+    Frustum frustum{};
+    const OcclusionCuller* occlusionCuller = nullptr;
+    uint32_t submittedCount = 0;
+    uint32_t occludedCount = 0;
+
+    std::vector<SceneBatchItem> items; // Shaders resolved by draw()
+    std::vector<glm::mat4> matrices;       // In submission order
+    std::vector<glm::mat4> sortedMatrices; // Grouped by batch
+    std::vector<Batch> batches;
+
+    GLuint instanceBuffer = 0;
+    size_t instanceCapacity = 0; // In matrices
+};
+
+} // namespace SFE
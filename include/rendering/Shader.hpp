@@ -6,14 +6,17 @@
 namespace SFE {
 class Shader {
 public:
+    // No program until a compiled shader is moved in
+    Shader() : programID(0) {}
     Shader(const std::string& vertexPath, const std::string& fragmentPath);
     ~Shader();
 
-    // Rule of five: Prevent copying/moving
+    // Owns a GL program: movable (ResourceRegistry keeps shaders in a dense array and reloads
+    // them in place), not copyable
     Shader(const Shader&) = delete;
     Shader& operator=(const Shader&) = delete;
-    Shader(Shader&&) = delete;
-    Shader& operator=(Shader&&) = delete;
+    Shader(Shader&& other) noexcept;
+    Shader& operator=(Shader&& other) noexcept;
 
     void use() const;
     GLuint getID() const { return programID; }
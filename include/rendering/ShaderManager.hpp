@@ -1,22 +1,22 @@
 #pragma once
 #include <string>
 #include <unordered_map>
-#include <memory>
 #include <glad/glad.h>
 #include <glm/glm.hpp>
+#include "rendering/ResourceHandles.hpp"
 
 namespace SFE {
 
-class Shader;  // Forward declaration
-
+// Shaders by name, stored in the ResourceRegistry. Reloading compiles every program again and
+// swaps it in under the same handle, so holders of a handle pick up the new program.
 class ShaderManager {
 public:
     static ShaderManager& getInstance();
     
-    std::shared_ptr<Shader> loadShader(const std::string& name, 
-                                      const std::string& vertexPath, 
-                                      const std::string& fragmentPath);
-    std::shared_ptr<Shader> getShader(const std::string& name);
+    ShaderHandle loadShader(const std::string& name, 
+                            const std::string& vertexPath, 
+                            const std::string& fragmentPath);
+    ShaderHandle getShader(const std::string& name);
     void reloadAllShaders();
     void clear();
 
@@ -25,9 +25,14 @@ public:
     ShaderManager& operator=(const ShaderManager&) = delete;
 
 private:
+    struct Entry {
+        ShaderHandle handle;
+        std::string vertexPath;
+        std::string fragmentPath;
+    };
+
     ShaderManager() = default;
-    std::unordered_map<std::string, std::shared_ptr<Shader>> shaderCache;
-    std::unordered_map<std::string, std::pair<std::string, std::string>> shaderPaths;
+    std::unordered_map<std::string, Entry> shaders;
 };
 
-} // namespace SFE 
\ No newline at end of file
+} // namespace SFE
@@ -2,6 +2,7 @@
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
 #include "rendering/Shader.hpp"
@@ -13,9 +14,16 @@ public:
     TextRenderer();
     ~TextRenderer();
 
+    // Reads and decodes the font atlas and parses the descriptor. No GL calls, so start-up runs
+    // it on a worker while the context is being created.
+    bool loadFont(const std::string& fontAtlasPath, const std::string& fontDescPath);
+    // Compiles the shader and uploads the font from loadFont(); needs the GL context
+    bool initialize();
     bool initialize(const std::string& fontAtlasPath, const std::string& fontDescPath);
-    void renderText(const std::string& text, float x, float y, float scale, const glm::vec3& color, const glm::mat4& projection);
+    void renderText(std::string_view text, float x, float y, float scale, const glm::vec3& color, const glm::mat4& projection);
     void renderBatch(const glm::mat4& projection); // New method for batched rendering
+    // Appends the glyph quads straight to the batch; no allocation once the batch has grown
+    void addToBatch(std::string_view text, float x, float y, float scale, const glm::vec3& color);
 
 private:
     struct Character {
@@ -26,30 +34,23 @@ private:
         float advance;          // How far to advance cursor (xadvance)
     };
 
-    struct TextInstance {
-        std::string text;
-        float x, y, scale;
-        glm::vec3 color;
-        std::vector<float> vertices;
-    };
-
     GLuint vao, vbo;
     Shader shader;
     std::unordered_map<char, Character> characters; // Store characters by ID
     GLuint textureID; // Font atlas texture
     float atlasWidth, atlasHeight; // Store atlas dimensions
+    std::vector<unsigned char> atlasPixels; // RGBA from loadFont(), released once uploaded
 
     // New members for batched rendering
     std::vector<float> batchedVertices;
-    std::unordered_map<std::string, TextInstance> cachedText;
     static constexpr size_t MAX_BATCH_VERTICES = 4096;
 
     void setupBuffers();
     bool loadFontAtlas(const std::string& atlasPath);
+    void uploadFontAtlas();
     bool loadFontDescriptor(const std::string& descPath);
-    void generateVertices(const std::string& text, float x, float y, float scale, const glm::vec3& color, std::vector<float>& vertices);
+    void generateVertices(std::string_view text, float x, float y, float scale, const glm::vec3& color, std::vector<float>& vertices);
     void flushBatch(const glm::mat4& projection);
-    void addToBatch(const std::string& text, float x, float y, float scale, const glm::vec3& color);
 };
 
 } 
\ No newline at end of file
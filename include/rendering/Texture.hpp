@@ -1,14 +1,26 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
-#include <GL/glew.h>
+#include <glad/glad.h>
 
 class Texture {
 public:
     Texture();
     ~Texture();
 
+    // Owns a GL texture: movable (ResourceRegistry keeps textures in a dense array), not copyable
+    Texture(const Texture&) = delete;
+    Texture& operator=(const Texture&) = delete;
+    Texture(Texture&& other) noexcept;
+    Texture& operator=(Texture&& other) noexcept;
+
+    // Image files through stb_image, or cooked .sft files (tools/texture_cooker), which upload
+    // their block-compressed mip chain as is. Read through the VFS.
     bool loadFromFile(const std::string& filename);
+    // 8-bit pixels, 1, 3 or 4 channels, rows bottom to top
+    bool loadFromPixels(const unsigned char* pixels, int width, int height, int channels, bool mipmaps = true);
     void bind(GLenum textureUnit = GL_TEXTURE0) const;
     void unbind() const;
 
@@ -17,6 +29,8 @@ public:
     int getHeight() const { return m_height; }
 
 private:
+    bool loadCooked(const uint8_t* fileData, size_t fileSize, const std::string& filename);
+
     GLuint m_textureID;
     int m_width;
     int m_height;
@@ -0,0 +1,118 @@
+#pragma once
+#include <glad/glad.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+#include "core/AssetPack.hpp"
+#include "rendering/TextureFormat.hpp"
+
+namespace SFE {
+
+// Where a texture lives in a TextureArrayPool: an array texture and a layer of it
+struct TextureSlice {
+    static constexpr uint16_t INVALID_ARRAY = 0xFFFF;
+
+    uint16_t array = INVALID_ARRAY;
+    uint16_t layer = 0;
+
+    bool isValid() const { return array != INVALID_ARRAY; }
+};
+
+// The CPU half of TextureArrayPool::addFromFile(): the file's bytes and, for images, the decoded
+// pixels. loadSource() fills it on any thread, addSource() uploads it on the GL thread.
+struct TextureSource {
+    struct PixelDeleter {
+        size_t bytes; // Reported to the MemoryTracker, which does not see stb_image's malloc
+        void operator()(unsigned char* pixels) const;
+    };
+
+    std::string path;
+    AssetData file; // Cooked .sft files are uploaded from here
+    std::unique_ptr<unsigned char, PixelDeleter> pixels;
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+};
+
+// Affine instance matrices never use row 3 of their first three columns (it is always 0), and
+// nothing that reads instance matrices (GpuInstanceCuller, LOD selection) looks at it. The slice
+// of an instance's texture travels there: layer in column 0, array in column 1. Shaders read it
+// back and zero it before using the matrix (see shaders/simple.vert).
+inline void setInstanceTextureSlice(glm::mat4& model, TextureSlice slice) {
+    model[0][3] = static_cast<float>(slice.layer);
+    model[1][3] = static_cast<float>(slice.array);
+}
+
+// Packs textures of the same size and format into the layers of GL_TEXTURE_2D_ARRAYs, so
+// objects with different textures share one texture binding and can be drawn in one batch; the
+// layer index comes per material (a uniform) or per instance (setInstanceTextureSlice). Each
+// size class gets arrays of 'layersPerArray' layers, a new one whenever the last is full.
+// With ARB_bindless_texture the arrays can also be made resident and addressed by 64-bit handles,
+// so instances with textures of different size classes still draw without any binding.
+// GL thread only.
+class TextureArrayPool {
+public:
+    explicit TextureArrayPool(uint32_t layersPerArray = 64) : layersPerArray(layersPerArray) {}
+    ~TextureArrayPool();
+
+    TextureArrayPool(const TextureArrayPool&) = delete;
+    TextureArrayPool& operator=(const TextureArrayPool&) = delete;
+
+    // 8-bit pixels, 1, 3 or 4 channels, rows bottom to top. Mipmaps are rebuilt on the next bind().
+    TextureSlice add(const unsigned char* pixels, int width, int height, int channels);
+    // Image files, or cooked .sft files whose compressed levels go into arrays of the same format
+    // and level count (decoded on the CPU if the context cannot sample the format). Read through
+    // the VFS.
+    TextureSlice addFromFile(const std::string& path);
+    // addFromFile() in two steps, so reading and decoding can run off the GL thread
+    static bool loadSource(const std::string& path, TextureSource& source);
+    TextureSlice addSource(const TextureSource& source);
+    // Frees the layer for reuse by a texture of the same size class
+    void remove(TextureSlice slice);
+
+    // Bind an array texture to a texture unit (mipmaps of updated layers are generated first)
+    void bind(uint32_t array, GLuint unit = 0);
+    GLuint getArrayTexture(uint32_t array) const { return array < arrays.size() ? arrays[array].texture : 0; }
+    uint32_t getArrayCount() const { return static_cast<uint32_t>(arrays.size()); }
+    uint32_t getLayerCount() const { return usedLayers; }
+
+    // Bindless path: resident 64-bit handle of an array, 0 if the context has no
+    // ARB_bindless_texture. Layers can still be added to a resident array.
+    bool isBindlessAvailable() const;
+    GLuint64 getBindlessHandle(uint32_t array);
+    // Handles of all arrays, split into the uvec2 halves GLSL takes, for a uniform array indexed
+    // by the array number of a TextureSlice; fills at most 'maxArrays' entries
+    uint32_t getBindlessHandles(glm::uvec2* handles, uint32_t maxArrays);
+
+    // Delete all GL objects; must be called while the context is still current
+    void shutdown();
+
+private:
+    struct ArrayTexture {
+        GLuint texture = 0;
+        int width = 0;
+        int height = 0;
+        GLenum internalFormat = 0;
+        TextureFileFormat blockFormat = TextureFileFormat::RGBA8; // RGBA8 for uncompressed arrays
+        uint32_t levels = 0;
+        uint32_t capacity = 0;
+        uint32_t used = 0;               // Layers handed out at least once
+        std::vector<uint16_t> freeLayers; // Removed layers, reused first
+        GLuint64 bindlessHandle = 0;
+        bool mipmapsDirty = false;
+    };
+
+    TextureSlice addCooked(const uint8_t* fileData, size_t fileSize, const std::string& path);
+    uint32_t findOrCreateArray(int width, int height, GLenum internalFormat, TextureFileFormat blockFormat,
+                               uint32_t levels);
+    uint16_t allocateLayer(ArrayTexture& array);
+    void updateMipmaps(ArrayTexture& array);
+
+    uint32_t layersPerArray;
+    std::vector<ArrayTexture> arrays;
+    uint32_t usedLayers = 0;
+};
+
+} // namespace SFE
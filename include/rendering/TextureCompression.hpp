@@ -0,0 +1,47 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "rendering/TextureFormat.hpp"
+
+namespace SFE {
+
+// Mip generation and block compression for cooked textures. Pure CPU, used offline by
+// tools/texture_cooker and at load time to decode blocks the context cannot sample.
+// Images are 8-bit RGBA, rows bottom to top.
+
+struct TextureMipLevel {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<uint8_t> pixels; // RGBA8
+};
+
+// Full mip chain down to 1x1 (at most 'maxLevels' levels), level 0 being a copy of the input.
+// Each level is a 2x2 box filter of the one above, weighted by alpha so fully transparent texels
+// do not bleed their colour. With 'srgb' the colour channels are filtered in linear light and
+// re-encoded, which keeps mips of high-contrast detail from darkening. Filtering runs on SSE
+// where available and keeps full precision down the chain (no re-quantisation between levels).
+std::vector<TextureMipLevel> generateMipChain(const uint8_t* rgba, uint32_t width, uint32_t height, bool srgb,
+                                              uint32_t maxLevels = TEXTURE_FILE_MAX_LEVELS);
+
+// One 4x4 block, 'rgba' being 16 texels row by row. BC1 ignores alpha; BC3 and BC7 keep it.
+// Endpoints start on the principal axis of the block's colours and get one least-squares refit.
+// BC7 output always uses mode 6 (one subset, RGBA 7.7.7.7 endpoints with p-bits, 4-bit indices).
+void compressBlockBC1(const uint8_t rgba[64], uint8_t block[8]);
+void compressBlockBC3(const uint8_t rgba[64], uint8_t block[16]);
+void compressBlockBC7(const uint8_t rgba[64], uint8_t block[16]);
+
+// Decoders; the BC7 one only understands mode 6 and decodes other modes to opaque magenta
+void decompressBlockBC1(const uint8_t block[8], uint8_t rgba[64]);
+void decompressBlockBC3(const uint8_t block[16], uint8_t rgba[64]);
+void decompressBlockBC7(const uint8_t block[16], uint8_t rgba[64]);
+
+// Whole images. Partial edge blocks repeat the last row and column; RGBA8 is a plain copy.
+std::vector<uint8_t> compressTexture(TextureFileFormat format, const uint8_t* rgba, uint32_t width, uint32_t height);
+std::vector<uint8_t> decompressTexture(TextureFileFormat format, const uint8_t* data, uint32_t width,
+                                       uint32_t height);
+
+// Peak signal-to-noise ratio of 'b' against 'a' over all four channels, in dB (infinity if identical)
+double computeTexturePsnr(const uint8_t* a, const uint8_t* b, uint32_t width, uint32_t height);
+
+} // namespace SFE
@@ -0,0 +1,82 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace SFE {
+
+// Cooked texture blob (.sft) written by tools/texture_cooker and read by Texture::loadFromFile,
+// modelled on KTX2: TextureFileHeader | level index | level data, each level aligned to
+// TEXTURE_FILE_ALIGNMENT. Levels are stored in the GPU's block layout, smallest first, so the
+// whole chain uploads straight from the memory-mapped file and a streamer could stop early.
+// Rows run bottom to top like the rest of the engine's textures.
+constexpr uint32_t TEXTURE_FILE_MAGIC = 0x58544653; // "SFTX" little-endian
+constexpr uint32_t TEXTURE_FILE_VERSION = 1;
+constexpr uint32_t TEXTURE_FILE_MAX_LEVELS = 16;
+constexpr uint32_t TEXTURE_FILE_ALIGNMENT = 16;
+
+enum class TextureFileFormat : uint32_t {
+    RGBA8, // Uncompressed fallback
+    BC1,   // 4 bpp RGB, 1-bit alpha unused
+    BC3,   // 8 bpp RGBA: BC1 colour plus interpolated alpha
+    BC7,   // 8 bpp RGBA, higher quality (the cooker writes mode 6 blocks)
+    Count
+};
+
+const char* getTextureFileFormatName(TextureFileFormat format);
+// Bytes per 4x4 block; 0 for uncompressed formats
+uint32_t getTextureBlockBytes(TextureFileFormat format);
+// Bytes of one mip level of the given size
+size_t getTextureLevelSize(TextureFileFormat format, uint32_t width, uint32_t height);
+
+struct TextureFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t format;     // TextureFileFormat
+    uint32_t flags;      // TextureFileFlags
+    uint32_t width;      // Level 0
+    uint32_t height;
+    uint32_t levelCount; // TextureFileLevel entries, level 0 first
+    uint32_t reserved0;
+    uint64_t levelIndexOffset;
+    uint64_t fileSize;
+    uint32_t reserved[4];
+};
+static_assert(sizeof(TextureFileHeader) == 64, "TextureFileHeader layout is part of the file format");
+
+struct TextureFileLevel {
+    uint64_t offset; // From the start of the file
+    uint64_t size;
+    uint32_t width;
+    uint32_t height;
+};
+static_assert(sizeof(TextureFileLevel) == 24, "TextureFileLevel layout is part of the file format");
+
+enum TextureFileFlags : uint32_t {
+    TEXTURE_FILE_SRGB = 1u << 0,        // Colour data is sRGB encoded
+    TEXTURE_FILE_LINEAR_MIPS = 1u << 1, // Mips were filtered in linear light
+};
+
+// Everything needed to serialise a texture; pointers are borrowed for the duration of the call
+struct TextureFileDesc {
+    TextureFileFormat format = TextureFileFormat::RGBA8;
+    uint32_t flags = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t levelCount = 0;
+    const uint8_t* const* levelData = nullptr; // levelCount pointers, level 0 first
+};
+
+// Write a texture blob to 'path'. Returns false on I/O error or inconsistent sizes.
+bool writeTextureFile(const std::string& path, const TextureFileDesc& desc);
+
+// Check that 'data' holds a complete, supported texture blob whose levels are in range and sized
+// for their format. Returns the header (pointing into 'data') or nullptr with 'error' set.
+const TextureFileHeader* validateTextureFile(const uint8_t* data, size_t size, std::string& error);
+
+// Level index of a validated blob
+inline const TextureFileLevel* getTextureFileLevels(const uint8_t* data, const TextureFileHeader& header) {
+    return reinterpret_cast<const TextureFileLevel*>(data + header.levelIndexOffset);
+}
+
+} // namespace SFE
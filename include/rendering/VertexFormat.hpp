@@ -0,0 +1,51 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace SFE {
+
+// Vertex layouts the GeometryArena keeps a shared vertex buffer + VAO for.
+// Values are stored in binary mesh files, so only append new entries.
+enum class VertexFormat : uint8_t {
+    Standard = 0,         // Mesh::Vertex: vec3 position, vec3 normal, vec2 texCoord (32 bytes)
+    QuantizedOct = 1,     // QuantizedVertexOct (16 bytes)
+    Quantized1010102 = 2, // QuantizedVertex1010102 (16 bytes)
+    Count
+};
+
+// Positions in both quantized formats are 16-bit unorm relative to the mesh bounds:
+// position = positionOffset + unorm * positionScale (see VertexQuantization.hpp)
+
+// uvec4 position (w unused), 2x snorm16 octahedral normal, 2x half-float texCoord
+struct QuantizedVertexOct {
+    uint16_t position[4];
+    int16_t normal[2];
+    uint16_t texCoord[2];
+};
+static_assert(sizeof(QuantizedVertexOct) == 16, "QuantizedVertexOct must stay 16 bytes");
+
+// uvec4 position (w unused), GL_INT_2_10_10_10_REV normal, 2x half-float texCoord
+struct QuantizedVertex1010102 {
+    uint16_t position[4];
+    uint32_t normal;
+    uint16_t texCoord[2];
+};
+static_assert(sizeof(QuantizedVertex1010102) == 16, "QuantizedVertex1010102 must stay 16 bytes");
+
+inline bool isQuantized(VertexFormat format) {
+    return format == VertexFormat::QuantizedOct || format == VertexFormat::Quantized1010102;
+}
+
+// Alignment vertex data of 'format' needs to be read in place
+inline size_t getVertexAlignment(VertexFormat format) {
+    switch (format) {
+    case VertexFormat::QuantizedOct:
+        return alignof(QuantizedVertexOct);
+    case VertexFormat::Quantized1010102:
+        return alignof(QuantizedVertex1010102);
+    default:
+        return alignof(float); // Mesh::Vertex is all floats
+    }
+}
+
+} // namespace SFE
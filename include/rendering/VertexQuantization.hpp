@@ -0,0 +1,24 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "rendering/VertexFormat.hpp"
+
+namespace SFE {
+
+// Scalar encoders shared by the runtime and tools/mesh_cooker
+uint16_t floatToHalf(float value);
+float halfToFloat(uint16_t value);
+uint16_t quantizeUnorm16(float value, float minimum, float maximum);
+void encodeOctahedral(const float normal[3], int16_t encoded[2]);
+void decodeOctahedral(const int16_t encoded[2], float normal[3]);
+uint32_t packSnorm1010102(const float normal[3]);
+
+// Convert Standard-layout vertices (vec3 position, vec3 normal, vec2 texCoord, 32 bytes each)
+// into 'format'. Positions are normalised against [boundsMin, boundsMax]; the matching shader
+// decode is positionOffset = boundsMin, positionScale = boundsMax - boundsMin.
+std::vector<uint8_t> quantizeVertices(VertexFormat format, const void* standardVertices,
+                                      size_t vertexCount, const float boundsMin[3],
+                                      const float boundsMax[3]);
+
+} // namespace SFE
@@ -0,0 +1,36 @@
+#version 330 core
+
+// GPU instance culling, GL 3.3 transform feedback path (see GpuInstanceCuller): one point per
+// instance, captured in place. Culled instances are written as zero matrices, which the
+// instanced draw collapses to a point, so the draw needs no survivor count from the GPU.
+layout (location = 0) in vec4 instanceColumn0;
+layout (location = 1) in vec4 instanceColumn1;
+layout (location = 2) in vec4 instanceColumn2;
+layout (location = 3) in vec4 instanceColumn3;
+
+// Captured with GL_INTERLEAVED_ATTRIBS: one mat4 per instance
+out vec4 outColumn0;
+out vec4 outColumn1;
+out vec4 outColumn2;
+out vec4 outColumn3;
+
+uniform vec4 frustumPlanes[6];
+uniform vec4 boundingSphere; // Object-space center (xyz) and radius (w)
+
+void main() {
+    mat4 model = mat4(instanceColumn0, instanceColumn1, instanceColumn2, instanceColumn3);
+    vec3 center = (model * vec4(boundingSphere.xyz, 1.0)).xyz;
+    float scale = sqrt(max(max(dot(model[0].xyz, model[0].xyz), dot(model[1].xyz, model[1].xyz)),
+                           dot(model[2].xyz, model[2].xyz)));
+    float radius = boundingSphere.w * scale;
+
+    bool visible = true;
+    for (int i = 0; i < 6; ++i) {
+        if (dot(frustumPlanes[i].xyz, center) + frustumPlanes[i].w < -radius) visible = false;
+    }
+
+    outColumn0 = visible ? instanceColumn0 : vec4(0.0);
+    outColumn1 = visible ? instanceColumn1 : vec4(0.0);
+    outColumn2 = visible ? instanceColumn2 : vec4(0.0);
+    outColumn3 = visible ? instanceColumn3 : vec4(0.0);
+}
@@ -3,16 +3,46 @@
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec2 aTexCoord;
+layout (location = 3) in mat4 aInstanceModel; // InstancedMesh stream, locations 3-6
 
 out vec3 normal;
 out vec2 texCoord;
+flat out ivec2 textureSlice; // Texture array layer and array of the instance
 
 uniform mat4 model;
+uniform bool instanced = false; // Take the model matrix from the instance stream
 uniform mat4 view;
 uniform mat4 projection;
 
+// Vertex decode for quantized meshes (Mesh::applyVertexDecode); defaults are the float layout
+uniform vec3 positionScale = vec3(1.0);
+uniform vec3 positionOffset = vec3(0.0);
+uniform bool octNormals = false;
+
+vec3 decodeOctahedral(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    if (n.z < 0.0) {
+        n.xy = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+    }
+    return normalize(n);
+}
+
 void main() {
-    gl_Position = projection * view * model * vec4(aPos, 1.0);
-    normal = mat3(transpose(inverse(model))) * aNormal;
+    vec3 position = positionOffset + aPos * positionScale;
+    vec3 objectNormal = octNormals ? decodeOctahedral(aNormal.xy) : aNormal;
+
+    // Instance matrices carry their TextureSlice in the otherwise unused row 3 of columns 0
+    // and 1 (TextureArrayPool.hpp, setInstanceTextureSlice)
+    mat4 objectToWorld = model;
+    textureSlice = ivec2(0);
+    if (instanced) {
+        objectToWorld = aInstanceModel;
+        textureSlice = ivec2(objectToWorld[0][3] + 0.5, objectToWorld[1][3] + 0.5);
+        objectToWorld[0][3] = 0.0;
+        objectToWorld[1][3] = 0.0;
+    }
+
+    gl_Position = projection * view * objectToWorld * vec4(position, 1.0);
+    normal = mat3(transpose(inverse(objectToWorld))) * objectNormal;
     texCoord = aTexCoord;
-} 
\ No newline at end of file
+}
@@ -0,0 +1,18 @@
+#version 330 core
+
+// simple.frag sampling a TextureArrayPool array: the layer comes from the material
+// (textureArray0Layer) or, when that is negative, from the instance
+
+in vec3 normal;
+in vec2 texCoord;
+flat in ivec2 textureSlice;
+
+out vec4 fragColor;
+
+uniform sampler2DArray textureArray0;
+uniform int textureArray0Layer = -1;
+
+void main() {
+    int layer = textureArray0Layer >= 0 ? textureArray0Layer : textureSlice.x;
+    fragColor = texture(textureArray0, vec3(texCoord, float(layer)));
+}
@@ -0,0 +1,18 @@
+#version 400 core
+#extension GL_ARB_bindless_texture : require
+
+// simple_array.frag without texture bindings: every TextureArrayPool array is a resident
+// handle, and each instance picks its array as well as its layer
+
+in vec3 normal;
+in vec2 texCoord;
+flat in ivec2 textureSlice;
+
+out vec4 fragColor;
+
+uniform uvec2 textureArrayHandles[16]; // TextureArrayPool::getBindlessHandles
+
+void main() {
+    sampler2DArray textureArray = sampler2DArray(textureArrayHandles[textureSlice.y]);
+    fragColor = texture(textureArray, vec3(texCoord, float(textureSlice.x)));
+}
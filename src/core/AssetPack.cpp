@@ -0,0 +1,76 @@
+#include "core/AssetPack.hpp"
+#include "core/Lz4.hpp"
+#include <algorithm>
+#include <iostream>
+
+namespace SFE {
+
+void AssetData::reset() {
+    data = nullptr;
+    size = 0;
+    storage.clear();
+    file.close();
+}
+
+bool AssetPack::open(const std::string& path) {
+    close();
+    if (!file.open(path)) {
+        return false;
+    }
+    std::string error;
+    header = validateAssetPack(file.getData(), file.getSize(), error);
+    if (!header) {
+        std::cerr << "AssetPack: invalid pack " << path << ": " << error << std::endl;
+        file.close();
+        return false;
+    }
+    entries = getAssetPackEntries(file.getData(), *header);
+    paths = reinterpret_cast<const char*>(file.getData() + header->pathTableOffset);
+    return true;
+}
+
+void AssetPack::close() {
+    file.close();
+    header = nullptr;
+    entries = nullptr;
+    paths = nullptr;
+}
+
+const AssetPackEntry* AssetPack::find(const std::string& path) const {
+    if (!header) return nullptr;
+    std::string normalized = normalizeAssetPath(path);
+    uint64_t hash = hashAssetPath(normalized.data(), normalized.size());
+    const AssetPackEntry* first = std::lower_bound(
+        begin(), end(), hash, [](const AssetPackEntry& entry, uint64_t value) { return entry.pathHash < value; });
+    // Hash collisions sit next to each other; the path decides
+    for (const AssetPackEntry* entry = first; entry != end() && entry->pathHash == hash; ++entry) {
+        if (getPath(*entry) == normalized) return entry;
+    }
+    return nullptr;
+}
+
+bool AssetPack::read(const AssetPackEntry& entry, AssetData& data) const {
+    data.reset();
+    const uint8_t* stored = file.getData() + entry.offset;
+    if (entry.compression == static_cast<uint32_t>(AssetCompression::None)) {
+        data.data = stored;
+        data.size = static_cast<size_t>(entry.size);
+        return true;
+    }
+
+    data.storage.resize(static_cast<size_t>(entry.size));
+    if (!lz4Decompress(stored, static_cast<size_t>(entry.storedSize), data.storage.data(), data.storage.size())) {
+        std::cerr << "AssetPack: corrupt entry " << getPath(entry) << std::endl;
+        data.reset();
+        return false;
+    }
+    data.data = data.storage.data();
+    data.size = data.storage.size();
+    return true;
+}
+
+std::string_view AssetPack::getPath(const AssetPackEntry& entry) const {
+    return {paths + entry.pathOffset, entry.pathLength};
+}
+
+} // namespace SFE
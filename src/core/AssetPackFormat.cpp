@@ -0,0 +1,163 @@
+#include "core/AssetPackFormat.hpp"
+#include "core/Lz4.hpp"
+#include <algorithm>
+#include <fstream>
+
+namespace SFE {
+
+namespace {
+
+uint64_t alignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+} // namespace
+
+std::string normalizeAssetPath(const std::string& path) {
+    std::string normalized = path;
+    std::replace(normalized.begin(), normalized.end(), '\\', '/');
+    while (normalized.compare(0, 2, "./") == 0) normalized.erase(0, 2);
+    return normalized;
+}
+
+uint64_t hashAssetPath(const char* path, size_t length) {
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < length; ++i) {
+        hash ^= static_cast<uint8_t>(path[i]);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+bool writeAssetPack(const std::string& path, const std::vector<AssetPackSource>& sources, AssetPackStats* stats) {
+    struct PendingEntry {
+        AssetPackEntry entry;
+        const AssetPackSource* source;
+        std::vector<uint8_t> compressed;
+    };
+
+    std::vector<PendingEntry> pending(sources.size());
+    std::string paths;
+    AssetPackStats totals;
+    for (size_t i = 0; i < sources.size(); ++i) {
+        const AssetPackSource& source = sources[i];
+        PendingEntry& item = pending[i];
+        item.source = &source;
+        item.entry = {};
+        item.entry.pathHash = hashAssetPath(source.path.data(), source.path.size());
+        item.entry.pathOffset = static_cast<uint32_t>(paths.size());
+        item.entry.pathLength = static_cast<uint32_t>(source.path.size());
+        item.entry.size = source.data.size();
+        item.entry.storedSize = source.data.size();
+        item.entry.compression = static_cast<uint32_t>(AssetCompression::None);
+        paths += source.path;
+
+        if (source.compress && !source.data.empty()) {
+            std::vector<uint8_t> compressed = lz4Compress(source.data.data(), source.data.size());
+            if (compressed.size() < source.data.size() - source.data.size() / 8) {
+                item.compressed = std::move(compressed);
+                item.entry.storedSize = item.compressed.size();
+                item.entry.compression = static_cast<uint32_t>(AssetCompression::LZ4);
+                ++totals.compressedEntries;
+            }
+        }
+        totals.inputBytes += source.data.size();
+    }
+
+    std::sort(pending.begin(), pending.end(), [](const PendingEntry& a, const PendingEntry& b) {
+        if (a.entry.pathHash != b.entry.pathHash) return a.entry.pathHash < b.entry.pathHash;
+        return a.source->path < b.source->path;
+    });
+    for (size_t i = 1; i < pending.size(); ++i) {
+        if (pending[i].source->path == pending[i - 1].source->path) return false;
+    }
+
+    AssetPackHeader header{};
+    header.magic = ASSET_PACK_MAGIC;
+    header.version = ASSET_PACK_VERSION;
+    header.entryCount = static_cast<uint32_t>(pending.size());
+    header.entryTableOffset = alignUp(sizeof(AssetPackHeader), alignof(AssetPackEntry));
+    header.pathTableOffset = header.entryTableOffset + pending.size() * sizeof(AssetPackEntry);
+    uint64_t offset = header.pathTableOffset + paths.size();
+    for (PendingEntry& item : pending) {
+        item.entry.offset = alignUp(offset, ASSET_PACK_ALIGNMENT);
+        offset = item.entry.offset + item.entry.storedSize;
+    }
+    header.fileSize = std::max<uint64_t>(offset, header.pathTableOffset + paths.size());
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    const char zeros[ASSET_PACK_ALIGNMENT] = {};
+    auto padTo = [&](uint64_t target) {
+        uint64_t position = static_cast<uint64_t>(file.tellp());
+        file.write(zeros, static_cast<std::streamsize>(target - position));
+    };
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    padTo(header.entryTableOffset);
+    for (const PendingEntry& item : pending) {
+        file.write(reinterpret_cast<const char*>(&item.entry), sizeof(AssetPackEntry));
+    }
+    file.write(paths.data(), static_cast<std::streamsize>(paths.size()));
+    for (const PendingEntry& item : pending) {
+        padTo(item.entry.offset);
+        const std::vector<uint8_t>& stored = item.compressed.empty() ? item.source->data : item.compressed;
+        file.write(reinterpret_cast<const char*>(stored.data()), static_cast<std::streamsize>(stored.size()));
+    }
+
+    totals.entryCount = pending.size();
+    totals.fileSize = header.fileSize;
+    if (stats) *stats = totals;
+    return file.good();
+}
+
+const AssetPackHeader* validateAssetPack(const uint8_t* data, size_t size, std::string& error) {
+    if (!data || size < sizeof(AssetPackHeader)) {
+        error = "file too small for header";
+        return nullptr;
+    }
+
+    const auto* header = reinterpret_cast<const AssetPackHeader*>(data);
+    if (header->magic != ASSET_PACK_MAGIC) {
+        error = "bad magic";
+        return nullptr;
+    }
+    if (header->version != ASSET_PACK_VERSION) {
+        error = "unsupported version " + std::to_string(header->version) + " (expected " +
+                std::to_string(ASSET_PACK_VERSION) + ")";
+        return nullptr;
+    }
+    if (header->fileSize != size) {
+        error = "truncated or padded file";
+        return nullptr;
+    }
+    if (header->entryTableOffset % alignof(AssetPackEntry) != 0 || header->entryTableOffset > size ||
+        uint64_t(header->entryCount) * sizeof(AssetPackEntry) > size - header->entryTableOffset ||
+        header->pathTableOffset > size) {
+        error = "entry table out of range";
+        return nullptr;
+    }
+
+    const AssetPackEntry* entries = getAssetPackEntries(data, *header);
+    for (uint32_t i = 0; i < header->entryCount; ++i) {
+        const AssetPackEntry& entry = entries[i];
+        if (entry.compression >= static_cast<uint32_t>(AssetCompression::Count) || entry.offset > size ||
+            entry.storedSize > size - entry.offset ||
+            uint64_t(entry.pathOffset) + entry.pathLength > size - header->pathTableOffset ||
+            (entry.compression == static_cast<uint32_t>(AssetCompression::None) && entry.storedSize != entry.size)) {
+            error = "entry " + std::to_string(i) + " out of range";
+            return nullptr;
+        }
+        if (i > 0 && entries[i - 1].pathHash > entry.pathHash) {
+            error = "entry table not sorted";
+            return nullptr;
+        }
+    }
+
+    return header;
+}
+
+} // namespace SFE
@@ -0,0 +1,38 @@
+#include "core/FixedTimestep.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace SFE {
+
+FixedTimestep::FixedTimestep(double stepSeconds, uint32_t maxTicksPerFrame)
+    : step(stepSeconds > 0.0 ? stepSeconds : 1.0 / 60.0), maxTicksPerFrame(std::max(maxTicksPerFrame, 1u)) {
+}
+
+uint32_t FixedTimestep::advance(double frameSeconds) {
+    if (lockstep) {
+        ++tickCount;
+        return 1;
+    }
+
+    accumulator += std::max(frameSeconds, 0.0);
+    uint32_t ticks = 0;
+    while (accumulator >= step && ticks < maxTicksPerFrame) {
+        accumulator -= step;
+        ++ticks;
+    }
+    if (accumulator >= step) {
+        // Keep the fractional part so interpolation stays continuous
+        double excess = std::floor(accumulator / step) * step;
+        discarded += excess;
+        accumulator -= excess;
+    }
+    tickCount += ticks;
+    return ticks;
+}
+
+void FixedTimestep::setLockstep(bool enabled) {
+    lockstep = enabled;
+    accumulator = 0.0;
+}
+
+} // namespace SFE
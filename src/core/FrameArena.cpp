@@ -0,0 +1,75 @@
+#include "core/FrameArena.hpp"
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+
+namespace SFE {
+
+LinearArena::LinearArena(size_t capacityBytes, std::pmr::memory_resource* upstreamResource)
+    : upstream(upstreamResource), storage(new unsigned char[capacityBytes]), capacity(capacityBytes) {
+}
+
+LinearArena::~LinearArena() {
+    reset();
+}
+
+void LinearArena::reset() {
+    while (overflowBlocks) {
+        OverflowBlock* block = overflowBlocks;
+        overflowBlocks = block->next;
+        upstream->deallocate(block, block->size, block->alignment);
+    }
+    used = 0;
+    overflowBytes = 0;
+}
+
+void* LinearArena::do_allocate(size_t bytes, size_t alignment) {
+    size_t start = (used + alignment - 1) & ~(alignment - 1);
+    if (start + bytes <= capacity) {
+        used = start + bytes;
+        peak = std::max(peak, used + overflowBytes);
+        return storage.get() + start;
+    }
+
+    // Header first, padded so the payload keeps the requested alignment
+    size_t blockAlignment = std::max(alignment, alignof(OverflowBlock));
+    size_t headerSize = (sizeof(OverflowBlock) + blockAlignment - 1) & ~(blockAlignment - 1);
+    size_t blockSize = headerSize + bytes;
+    auto* block = static_cast<OverflowBlock*>(upstream->allocate(blockSize, blockAlignment));
+    *block = {overflowBlocks, blockSize, blockAlignment};
+    overflowBlocks = block;
+    overflowBytes += bytes;
+    peak = std::max(peak, used + overflowBytes);
+    ++overflowCount;
+    return reinterpret_cast<unsigned char*>(block) + headerSize;
+}
+
+const char* LinearArena::format(const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    va_list retry;
+    va_copy(retry, args);
+
+    // Format straight into the free space; only if it does not fit, measure and allocate
+    char* destination = reinterpret_cast<char*>(storage.get() + used);
+    size_t available = capacity - used;
+    int length = std::vsnprintf(destination, available, fmt, args);
+    va_end(args);
+
+    const char* result = "";
+    if (length >= 0) {
+        if (static_cast<size_t>(length) < available) {
+            used += static_cast<size_t>(length) + 1;
+            peak = std::max(peak, used + overflowBytes);
+            result = destination;
+        } else {
+            char* overflow = static_cast<char*>(allocate(static_cast<size_t>(length) + 1, 1));
+            std::vsnprintf(overflow, static_cast<size_t>(length) + 1, fmt, retry);
+            result = overflow;
+        }
+    }
+    va_end(retry);
+    return result;
+}
+
+} // namespace SFE
@@ -0,0 +1,110 @@
+#include "core/FreeListAllocator.hpp"
+#include <iterator>
+
+namespace SFE {
+
+FreeListAllocator::FreeListAllocator(uint32_t capacity) : capacity(0), used(0) {
+    grow(capacity);
+}
+
+uint32_t FreeListAllocator::allocate(uint32_t size) {
+    if (size == 0) return INVALID_OFFSET;
+
+    // Best fit: smallest free block that can hold the request
+    auto fit = freeBySize.lower_bound(size);
+    if (fit == freeBySize.end()) return INVALID_OFFSET;
+
+    uint32_t blockOffset = fit->second;
+    uint32_t blockSize = fit->first;
+    removeFreeBlock(freeByOffset.find(blockOffset));
+
+    // Return the tail of the block to the free list
+    if (blockSize > size) {
+        insertFreeBlock(blockOffset + size, blockSize - size);
+    }
+
+    allocations[blockOffset] = size;
+    used += size;
+    return blockOffset;
+}
+
+void FreeListAllocator::free(uint32_t offset) {
+    auto alloc = allocations.find(offset);
+    if (alloc == allocations.end()) return;
+
+    uint32_t size = alloc->second;
+    allocations.erase(alloc);
+    used -= size;
+
+    // Coalesce with the following block
+    auto next = freeByOffset.find(offset + size);
+    if (next != freeByOffset.end()) {
+        size += next->second;
+        removeFreeBlock(next);
+    }
+
+    // Coalesce with the preceding block
+    auto prev = freeByOffset.lower_bound(offset);
+    if (prev != freeByOffset.begin()) {
+        prev = std::prev(prev);
+        if (prev->first + prev->second == offset) {
+            offset = prev->first;
+            size += prev->second;
+            removeFreeBlock(prev);
+        }
+    }
+
+    insertFreeBlock(offset, size);
+}
+
+void FreeListAllocator::grow(uint32_t newCapacity) {
+    if (newCapacity <= capacity) return;
+
+    uint32_t offset = capacity;
+    uint32_t size = newCapacity - capacity;
+    capacity = newCapacity;
+
+    // Merge with a free block that ends at the old capacity
+    if (!freeByOffset.empty()) {
+        auto last = std::prev(freeByOffset.end());
+        if (last->first + last->second == offset) {
+            offset = last->first;
+            size += last->second;
+            removeFreeBlock(last);
+        }
+    }
+
+    insertFreeBlock(offset, size);
+}
+
+void FreeListAllocator::reset() {
+    freeByOffset.clear();
+    freeBySize.clear();
+    allocations.clear();
+    used = 0;
+    if (capacity > 0) {
+        insertFreeBlock(0, capacity);
+    }
+}
+
+uint32_t FreeListAllocator::getLargestFreeBlock() const {
+    return freeBySize.empty() ? 0 : freeBySize.rbegin()->first;
+}
+
+void FreeListAllocator::insertFreeBlock(uint32_t offset, uint32_t size) {
+    freeByOffset[offset] = size;
+    freeBySize.emplace(size, offset);
+}
+
+void FreeListAllocator::removeFreeBlock(std::map<uint32_t, uint32_t>::iterator it) {
+    auto range = freeBySize.equal_range(it->second);
+    for (auto sizeIt = range.first; sizeIt != range.second; ++sizeIt) {
+        if (sizeIt->second == it->first) {
+            freeBySize.erase(sizeIt);
+            break;
+        }
+    }
+    freeByOffset.erase(it);
+}
+
+} // namespace SFE
@@ -0,0 +1,203 @@
+#include "core/InitGraph.hpp"
+#include "core/JobSystem.hpp"
+#include "core/Profiler.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <sstream>
+
+namespace SFE {
+
+namespace {
+
+const char* threadName(InitGraph::Thread thread) {
+    return thread == InitGraph::Thread::Main ? "main" : "worker";
+}
+
+const char* statusName(InitGraph::Status status) {
+    switch (status) {
+        case InitGraph::Status::Pending: return "pending";
+        case InitGraph::Status::Done: return "done";
+        case InitGraph::Status::Failed: return "failed";
+        case InitGraph::Status::Skipped: return "skipped";
+    }
+    return "unknown";
+}
+
+} // namespace
+
+InitGraph::InitGraph(std::chrono::steady_clock::time_point origin) : origin(origin) {}
+
+InitGraph::TaskId InitGraph::add(const char* name, Thread thread, Task task, std::initializer_list<TaskId> dependencies) {
+    TaskId id = static_cast<TaskId>(nodes.size());
+    Node node;
+    node.task = std::move(task);
+    for (TaskId dependency : dependencies) {
+        if (dependency >= id) {
+            std::cerr << "InitGraph: " << name << " depends on a task added after it" << std::endl;
+            continue;
+        }
+        nodes[dependency].dependents.push_back(id);
+        ++node.unfinishedDependencies;
+    }
+    nodes.push_back(std::move(node));
+    records.push_back({name, thread});
+    return id;
+}
+
+bool InitGraph::run() {
+    JobSystem& jobs = JobSystem::getInstance();
+    JobCounter workerTasks;
+    std::mutex mutex;
+    std::condition_variable taskFinished;
+    std::set<TaskId> mainReady; // Lowest id first keeps main-thread tasks in the order added
+    size_t finished = 0;
+
+    // All of these run with 'mutex' held
+    std::function<void(TaskId)> finish;
+    auto start = [&](TaskId id) {
+        if (records[id].thread == Thread::Main) {
+            mainReady.insert(id);
+            return;
+        }
+        jobs.schedule(
+            [&, id] {
+                execute(id);
+                std::lock_guard<std::mutex> lock(mutex);
+                finish(id);
+                taskFinished.notify_all();
+            },
+            &workerTasks);
+    };
+    finish = [&](TaskId id) {
+        std::vector<TaskId> done{id};
+        while (!done.empty()) {
+            TaskId current = done.back();
+            done.pop_back();
+            ++finished;
+            bool failed = records[current].status != Status::Done;
+            for (TaskId dependent : nodes[current].dependents) {
+                Node& node = nodes[dependent];
+                node.dependencyFailed |= failed;
+                if (--node.unfinishedDependencies != 0) continue;
+                if (node.dependencyFailed) {
+                    records[dependent].status = Status::Skipped;
+                    done.push_back(dependent);
+                } else {
+                    start(dependent);
+                }
+            }
+        }
+    };
+
+    std::unique_lock<std::mutex> lock(mutex);
+    for (TaskId id = 0; id < nodes.size(); ++id) {
+        if (nodes[id].unfinishedDependencies == 0) start(id);
+    }
+    while (finished < nodes.size()) {
+        if (mainReady.empty()) {
+            taskFinished.wait(lock);
+            continue;
+        }
+        TaskId id = *mainReady.begin();
+        mainReady.erase(mainReady.begin());
+        lock.unlock();
+        execute(id);
+        lock.lock();
+        finish(id);
+    }
+    lock.unlock();
+    // The last worker task may still be returning from finish()
+    jobs.wait(workerTasks);
+
+    return std::all_of(records.begin(), records.end(), [](const Record& record) { return record.status == Status::Done; });
+}
+
+void InitGraph::execute(TaskId id) {
+    Record& record = records[id];
+    SFE_PROFILE_SCOPE(record.name);
+    record.startMs = getElapsedMs();
+    bool success = nodes[id].task();
+    record.endMs = getElapsedMs();
+    record.status = success ? Status::Done : Status::Failed;
+    nodes[id].task = nullptr; // Release whatever the task captured
+    if (!success) std::cerr << "InitGraph: " << record.name << " failed" << std::endl;
+}
+
+void InitGraph::mark(const char* name) {
+    marks.push_back({name, getElapsedMs()});
+}
+
+double InitGraph::getMarkMs(const char* name) const {
+    for (const Mark& mark : marks) {
+        if (std::strcmp(mark.name, name) == 0) return mark.timeMs;
+    }
+    return -1.0;
+}
+
+double InitGraph::getElapsedMs() const {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - origin).count();
+}
+
+double InitGraph::getSerialMs() const {
+    double total = 0.0;
+    for (const Record& record : records) total += record.endMs - record.startMs;
+    return total;
+}
+
+double InitGraph::getWallMs() const {
+    double end = 0.0;
+    for (const Record& record : records) end = std::max(end, record.endMs);
+    return end;
+}
+
+std::string InitGraph::formatReport() const {
+    std::string report = "Startup timeline (ms since start):\n";
+    char line[160];
+    std::snprintf(line, sizeof(line), "  %-24s %-7s %9s %9s %9s\n", "task", "thread", "start", "end", "duration");
+    report += line;
+    for (const Record& record : records) {
+        if (record.status == Status::Done || record.status == Status::Failed) {
+            std::snprintf(line, sizeof(line), "  %-24s %-7s %9.1f %9.1f %9.1f%s\n", record.name, threadName(record.thread),
+                          record.startMs, record.endMs, record.endMs - record.startMs,
+                          record.status == Status::Failed ? "  FAILED" : "");
+        } else {
+            std::snprintf(line, sizeof(line), "  %-24s %-7s %29s\n", record.name, threadName(record.thread),
+                          statusName(record.status));
+        }
+        report += line;
+    }
+    for (const Mark& mark : marks) {
+        std::snprintf(line, sizeof(line), "  %-24s %-7s %9.1f\n", mark.name, "", mark.timeMs);
+        report += line;
+    }
+    double wall = getWallMs();
+    double serial = getSerialMs();
+    std::snprintf(line, sizeof(line), "  Tasks finished at %.1f ms; %.1f ms if run in sequence (%.2fx)\n", wall, serial,
+                  wall > 0.0 ? serial / wall : 0.0);
+    report += line;
+    return report;
+}
+
+std::string InitGraph::toJson() const {
+    std::ostringstream out;
+    out << "{\"wall_ms\":" << getWallMs() << ",\"serial_ms\":" << getSerialMs() << ",\"tasks\":[";
+    for (size_t i = 0; i < records.size(); ++i) {
+        const Record& record = records[i];
+        out << (i ? "," : "") << "{\"name\":\"" << record.name << "\",\"thread\":\"" << threadName(record.thread)
+            << "\",\"status\":\"" << statusName(record.status) << "\",\"start_ms\":" << record.startMs
+            << ",\"end_ms\":" << record.endMs << "}";
+    }
+    out << "],\"marks\":{";
+    for (size_t i = 0; i < marks.size(); ++i) {
+        out << (i ? "," : "") << "\"" << marks[i].name << "\":" << marks[i].timeMs;
+    }
+    out << "}}";
+    return out.str();
+}
+
+} // namespace SFE
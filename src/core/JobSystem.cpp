@@ -0,0 +1,132 @@
+#include "core/JobSystem.hpp"
+#include "core/Profiler.hpp"
+#include <algorithm>
+
+namespace SFE {
+
+namespace {
+thread_local bool workerThread = false;
+}
+
+JobSystem::~JobSystem() {
+    shutdown();
+}
+
+void JobSystem::initialize(unsigned threadCount) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!workers.empty()) return;
+    if (threadCount == 0) {
+        unsigned hardwareThreads = std::thread::hardware_concurrency();
+        threadCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+    }
+    stopping = false;
+    for (unsigned i = 0; i < threadCount; ++i) {
+        workers.emplace_back(&JobSystem::workerLoop, this);
+    }
+    workerCount.store(threadCount, std::memory_order_release);
+}
+
+void JobSystem::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (workers.empty()) return;
+        stopping = true;
+    }
+    jobAvailable.notify_all();
+    for (auto& worker : workers) worker.join();
+    workers.clear();
+    workerCount.store(0, std::memory_order_release);
+}
+
+void JobSystem::schedule(Job job, JobCounter* counter) {
+    if (getWorkerCount() == 0) initialize();
+    if (counter) begin(*counter);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push_back({std::move(job), counter});
+    }
+    jobAvailable.notify_one();
+    // Threads blocked in wait() help out, which keeps nested waits from starving the queue
+    jobFinished.notify_all();
+}
+
+void JobSystem::wait(const JobCounter& counter) {
+    while (!counter.isDone()) {
+        if (runOne()) continue;
+        std::unique_lock<std::mutex> lock(mutex);
+        jobFinished.wait(lock, [&] { return counter.isDone() || !jobs.empty(); });
+    }
+}
+
+void JobSystem::begin(JobCounter& counter) {
+    counter.pending.fetch_add(1, std::memory_order_relaxed);
+}
+
+void JobSystem::end(JobCounter& counter) {
+    if (counter.pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        // Take the lock so a waiter cannot check the counter and then miss this notification
+        { std::lock_guard<std::mutex> lock(mutex); }
+        jobFinished.notify_all();
+    }
+}
+
+void JobSystem::parallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& body) {
+    if (count == 0) return;
+    if (getWorkerCount() == 0) initialize();
+    grain = std::max<size_t>(grain, 1);
+    // A few ranges per thread so uneven ranges balance out
+    size_t maxRanges = size_t(getWorkerCount() + 1) * 4;
+    size_t rangeCount = std::min((count + grain - 1) / grain, maxRanges);
+    if (rangeCount <= 1) {
+        body(0, count);
+        return;
+    }
+
+    size_t rangeSize = (count + rangeCount - 1) / rangeCount;
+    JobCounter counter;
+    for (size_t begin = rangeSize; begin < count; begin += rangeSize) {
+        size_t end = std::min(begin + rangeSize, count);
+        schedule([&body, begin, end] { body(begin, end); }, &counter);
+    }
+    body(0, std::min(rangeSize, count));
+    wait(counter);
+}
+
+bool JobSystem::isWorkerThread() {
+    return workerThread;
+}
+
+void JobSystem::workerLoop() {
+    workerThread = true;
+    Profiler::getInstance().setThreadName("Job worker");
+    for (;;) {
+        QueuedJob queued;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            jobAvailable.wait(lock, [this] { return stopping || !jobs.empty(); });
+            if (jobs.empty()) return; // Stopping and drained
+            queued = std::move(jobs.front());
+            jobs.pop_front();
+        }
+        run(queued);
+    }
+}
+
+bool JobSystem::runOne() {
+    QueuedJob queued;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (jobs.empty()) return false;
+        queued = std::move(jobs.front());
+        jobs.pop_front();
+    }
+    run(queued);
+    return true;
+}
+
+void JobSystem::run(QueuedJob& queued) {
+    queued.job();
+    if (queued.counter) end(*queued.counter);
+}
+
+} // namespace SFE
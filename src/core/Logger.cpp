@@ -0,0 +1,182 @@
+#include "core/Logger.hpp"
+#include "core/MemoryTracker.hpp"
+#include "core/Profiler.hpp"
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+namespace SFE {
+
+namespace {
+
+constexpr size_t WRITER_BATCH = 256; // Records formatted per write
+constexpr auto WRITER_IDLE_WAIT = std::chrono::milliseconds(5); // Ring polling interval when idle
+
+bool endsWith(const std::string& text, const char* suffix) {
+    size_t length = std::strlen(suffix);
+    return text.size() >= length && text.compare(text.size() - length, length, suffix) == 0;
+}
+
+void appendEscaped(std::string& out, const char* text, size_t length, bool json) {
+    for (size_t i = 0; i < length; ++i) {
+        char c = text[i];
+        if (c == '"') {
+            out += json ? "\\\"" : "\"\""; // CSV doubles quotes inside a quoted field
+        } else if (json && c == '\\') {
+            out += "\\\\";
+        } else if (json && static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out += escaped;
+        } else {
+            out += c;
+        }
+    }
+}
+
+} // namespace
+
+Logger::~Logger() {
+    shutdown();
+}
+
+bool Logger::initialize(const std::string& logFilePath, size_t ringCapacity) {
+    shutdown();
+    SFE_MEMORY_TAG(Logger);
+
+    logFile.open(logFilePath, std::ios::out | std::ios::app | std::ios::binary);
+    if (!logFile.is_open()) {
+        std::cerr << "Logger: failed to open " << logFilePath << std::endl;
+        return false;
+    }
+    format = (endsWith(logFilePath, ".json") || endsWith(logFilePath, ".jsonl")) ? Format::JSON : Format::CSV;
+    if (format == Format::CSV && logFile.tellp() == 0) {
+        logFile << "Timestamp,FPS,SceneRenderTime_ms,TextRenderTime_ms,TextDrawCalls,TotalCharacters,StressTestEnabled\n";
+    }
+
+    if (!ring || ring->capacity() < ringCapacity) {
+        ring = std::make_unique<MpscRing<Record>>(ringCapacity);
+    }
+    droppedRecords.store(0, std::memory_order_relaxed);
+    writtenRecords.store(0, std::memory_order_relaxed);
+    stopRequested = false;
+    logStartTime = std::chrono::steady_clock::now();
+
+    writer = std::thread(&Logger::writerLoop, this);
+    running.store(true, std::memory_order_release);
+    return true;
+}
+
+void Logger::shutdown(std::chrono::milliseconds timeout) {
+    if (!running.exchange(false, std::memory_order_acq_rel)) return;
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopRequested = true;
+        stopDeadline = std::chrono::steady_clock::now() + timeout;
+    }
+    wake.notify_one();
+    if (writer.joinable()) writer.join();
+    logFile.close();
+}
+
+void Logger::push(const Record& record) {
+    if (!ring->tryPush(record)) {
+        droppedRecords.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void Logger::logPerformanceMetrics(int fps, float sceneRenderTime, float textRenderTime,
+                                   int textDrawCalls, int totalCharacters, bool stressTestEnabled) {
+    if (!running.load(std::memory_order_acquire)) return;
+
+    Record record;
+    record.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - logStartTime).count();
+    record.type = Record::Type::PerformanceMetrics;
+    record.truncated = 0;
+    record.length = 0;
+    record.metrics = {fps, sceneRenderTime, textRenderTime, textDrawCalls, totalCharacters,
+                      static_cast<uint8_t>(stressTestEnabled ? 1 : 0)};
+    push(record);
+}
+
+void Logger::logMessage(std::string_view message) {
+    if (!running.load(std::memory_order_acquire)) return;
+
+    Record record;
+    record.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - logStartTime).count();
+    record.type = Record::Type::Message;
+    size_t length = std::min(message.size(), MAX_MESSAGE_LENGTH);
+    record.truncated = message.size() > MAX_MESSAGE_LENGTH ? 1 : 0;
+    record.length = static_cast<uint16_t>(length);
+    std::memcpy(record.text, message.data(), length);
+    push(record);
+}
+
+void Logger::formatRecord(const Record& record, std::string& out) const {
+    char buffer[256];
+    int64_t milliseconds = record.timestamp / 1000000;
+
+    if (record.type == Record::Type::PerformanceMetrics) {
+        const PerformanceSample& m = record.metrics;
+        const char* pattern = format == Format::JSON
+            ? "{\"timestamp_ms\":%" PRId64 ",\"type\":\"metrics\",\"fps\":%d,\"scene_ms\":%.3f,\"text_ms\":%.3f,"
+              "\"text_draw_calls\":%d,\"total_characters\":%d,\"stress_test\":%d}\n"
+            : "%" PRId64 ",%d,%.3f,%.3f,%d,%d,%d\n";
+        std::snprintf(buffer, sizeof(buffer), pattern, milliseconds, m.fps, m.sceneRenderTime * 1000.0f,
+                      m.textRenderTime * 1000.0f, m.textDrawCalls, m.totalCharacters, m.stressTestEnabled);
+        out += buffer;
+        return;
+    }
+
+    bool json = format == Format::JSON;
+    std::snprintf(buffer, sizeof(buffer),
+                  json ? "{\"timestamp_ms\":%" PRId64 ",\"type\":\"message\",\"message\":\"" : "%" PRId64 ",INFO,\"",
+                  milliseconds);
+    out += buffer;
+    appendEscaped(out, record.text, record.length, json);
+    if (record.truncated) out += "...";
+    out += json ? "\"}\n" : "\"\n";
+}
+
+void Logger::writerLoop() {
+    Profiler::getInstance().setThreadName("Logger");
+    SFE_MEMORY_TAG(Logger);
+    std::string batch;
+    batch.reserve(WRITER_BATCH * 160);
+    Record record;
+
+    while (true) {
+        size_t count = 0;
+        while (count < WRITER_BATCH && ring->tryPop(record)) {
+            formatRecord(record, batch);
+            ++count;
+        }
+        if (count > 0) {
+            SFE_PROFILE_SCOPE("Logger::writeBatch");
+            logFile.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+            logFile.flush();
+            writtenRecords.fetch_add(count, std::memory_order_relaxed);
+            batch.clear();
+        }
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        if (stopRequested) {
+            if (count == 0) break; // Drained
+            if (std::chrono::steady_clock::now() >= stopDeadline) {
+                // Out of time: account for what is left instead of writing it
+                uint64_t discarded = 0;
+                while (ring->tryPop(record)) ++discarded;
+                droppedRecords.fetch_add(discarded, std::memory_order_relaxed);
+                break;
+            }
+            continue;
+        }
+        if (count == WRITER_BATCH) continue; // More is probably waiting
+        wake.wait_for(lock, WRITER_IDLE_WAIT, [this] { return stopRequested; });
+    }
+}
+
+} // namespace SFE
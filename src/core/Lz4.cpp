@@ -0,0 +1,133 @@
+#include "core/Lz4.hpp"
+#include <cstring>
+
+namespace SFE {
+
+namespace {
+
+constexpr size_t MIN_MATCH = 4;
+constexpr size_t LAST_LITERALS = 5; // The block always ends in at least this many literals
+constexpr size_t MATCH_FIND_LIMIT = 12; // No match may start within this many bytes of the end
+constexpr size_t MAX_OFFSET = 65535;
+constexpr int HASH_BITS = 12;
+
+uint32_t read32(const uint8_t* pointer) {
+    uint32_t value;
+    std::memcpy(&value, pointer, sizeof(value));
+    return value;
+}
+
+uint32_t hashSequence(uint32_t sequence) {
+    return (sequence * 2654435761u) >> (32 - HASH_BITS);
+}
+
+void writeLength(std::vector<uint8_t>& out, size_t length) {
+    while (length >= 255) {
+        out.push_back(255);
+        length -= 255;
+    }
+    out.push_back(static_cast<uint8_t>(length));
+}
+
+// One sequence: literals [literals, literals + literalLength), then a match unless this is the last
+void writeSequence(std::vector<uint8_t>& out, const uint8_t* literals, size_t literalLength, size_t offset,
+                   size_t matchLength) {
+    size_t matchCode = matchLength ? matchLength - MIN_MATCH : 0;
+    out.push_back(static_cast<uint8_t>((literalLength < 15 ? literalLength : 15) << 4 | (matchCode < 15 ? matchCode : 15)));
+    if (literalLength >= 15) writeLength(out, literalLength - 15);
+    out.insert(out.end(), literals, literals + literalLength);
+    if (matchLength == 0) return;
+    out.push_back(static_cast<uint8_t>(offset));
+    out.push_back(static_cast<uint8_t>(offset >> 8));
+    if (matchCode >= 15) writeLength(out, matchCode - 15);
+}
+
+bool readLength(const uint8_t* source, size_t sourceSize, size_t& position, size_t& length) {
+    uint8_t byte;
+    do {
+        if (position >= sourceSize) return false;
+        byte = source[position++];
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+} // namespace
+
+size_t lz4CompressBound(size_t size) {
+    return size + size / 255 + 16;
+}
+
+std::vector<uint8_t> lz4Compress(const uint8_t* source, size_t size) {
+    std::vector<uint8_t> out;
+    out.reserve(lz4CompressBound(size));
+
+    size_t anchor = 0;
+    if (size > MATCH_FIND_LIMIT) {
+        std::vector<int64_t> table(size_t(1) << HASH_BITS, -1);
+        const size_t matchStartLimit = size - MATCH_FIND_LIMIT;
+        const size_t matchEndLimit = size - LAST_LITERALS;
+        size_t position = 0;
+        size_t misses = 0;
+        while (position <= matchStartLimit) {
+            uint32_t sequence = read32(source + position);
+            uint32_t hash = hashSequence(sequence);
+            int64_t candidate = table[hash];
+            table[hash] = static_cast<int64_t>(position);
+
+            if (candidate < 0 || position - candidate > MAX_OFFSET || read32(source + candidate) != sequence) {
+                // Skip faster through data that does not compress
+                position += 1 + (misses++ >> 6);
+                continue;
+            }
+            misses = 0;
+
+            size_t match = static_cast<size_t>(candidate);
+            // Extend backwards over literals that also match
+            while (position > anchor && match > 0 && source[position - 1] == source[match - 1]) {
+                --position;
+                --match;
+            }
+            size_t length = MIN_MATCH;
+            while (position + length < matchEndLimit && source[match + length] == source[position + length]) ++length;
+
+            writeSequence(out, source + anchor, position - anchor, position - match, length);
+            position += length;
+            anchor = position;
+        }
+    }
+    writeSequence(out, source + anchor, size - anchor, 0, 0);
+    return out;
+}
+
+bool lz4Decompress(const uint8_t* source, size_t sourceSize, uint8_t* destination, size_t destinationSize) {
+    size_t in = 0, out = 0;
+    while (in < sourceSize) {
+        uint8_t token = source[in++];
+
+        size_t literalLength = token >> 4;
+        if (literalLength == 15 && !readLength(source, sourceSize, in, literalLength)) return false;
+        if (literalLength > sourceSize - in || literalLength > destinationSize - out) return false;
+        if (literalLength) std::memcpy(destination + out, source + in, literalLength);
+        in += literalLength;
+        out += literalLength;
+        if (in == sourceSize) break; // The last sequence has no match
+
+        if (sourceSize - in < 2) return false;
+        size_t offset = source[in] | size_t(source[in + 1]) << 8;
+        in += 2;
+        if (offset == 0 || offset > out) return false;
+
+        size_t matchLength = token & 15;
+        if (matchLength == 15 && !readLength(source, sourceSize, in, matchLength)) return false;
+        matchLength += MIN_MATCH;
+        if (matchLength > destinationSize - out) return false;
+        // Byte by byte: the match may overlap the bytes it produces (runs)
+        const uint8_t* match = destination + out - offset;
+        for (size_t i = 0; i < matchLength; ++i) destination[out + i] = match[i];
+        out += matchLength;
+    }
+    return out == destinationSize;
+}
+
+} // namespace SFE
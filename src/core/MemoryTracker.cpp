@@ -0,0 +1,172 @@
+#include "core/MemoryTracker.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+namespace SFE {
+
+namespace {
+
+thread_local MemoryTag currentTag = MemoryTag::General;
+
+} // namespace
+
+const char* getMemoryTagName(MemoryTag tag) {
+    switch (tag) {
+    case MemoryTag::General: return "General";
+    case MemoryTag::Text: return "Text";
+    case MemoryTag::Mesh: return "Mesh";
+    case MemoryTag::Shader: return "Shader";
+    case MemoryTag::Texture: return "Texture";
+    case MemoryTag::Logger: return "Logger";
+    case MemoryTag::Count: break;
+    }
+    return "Unknown";
+}
+
+MemoryTracker::TagStats MemoryTracker::FrameStats::total() const {
+    TagStats sum;
+    for (const TagStats& tag : tags) {
+        sum.allocations += tag.allocations;
+        sum.frees += tag.frees;
+        sum.bytes += tag.bytes;
+        sum.liveBytes += tag.liveBytes;
+        sum.peakBytes += tag.peakBytes;
+    }
+    return sum;
+}
+
+MemoryTag MemoryTracker::getCurrentTag() {
+    return currentTag;
+}
+
+void MemoryTracker::setCurrentTag(MemoryTag tag) {
+    currentTag = tag;
+}
+
+void MemoryTracker::recordAllocation(MemoryTag tag, size_t bytes) {
+    Counters& tagCounters = counters[static_cast<size_t>(tag)];
+    tagCounters.allocations.fetch_add(1, std::memory_order_relaxed);
+    tagCounters.bytes.fetch_add(bytes, std::memory_order_relaxed);
+    uint64_t live = tagCounters.liveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    uint64_t peak = tagCounters.peakBytes.load(std::memory_order_relaxed);
+    while (live > peak && !tagCounters.peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+    }
+}
+
+void MemoryTracker::recordFree(MemoryTag tag, size_t bytes) {
+    Counters& tagCounters = counters[static_cast<size_t>(tag)];
+    tagCounters.frees.fetch_add(1, std::memory_order_relaxed);
+    tagCounters.liveBytes.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+MemoryTracker::FrameStats MemoryTracker::endFrame() {
+    FrameStats stats;
+    for (size_t i = 0; i < static_cast<size_t>(MemoryTag::Count); ++i) {
+        Counters& tagCounters = counters[i];
+        TagStats& tag = stats.tags[i];
+        tag.allocations = tagCounters.allocations.exchange(0, std::memory_order_relaxed);
+        tag.frees = tagCounters.frees.exchange(0, std::memory_order_relaxed);
+        tag.bytes = tagCounters.bytes.exchange(0, std::memory_order_relaxed);
+        tag.liveBytes = tagCounters.liveBytes.load(std::memory_order_relaxed);
+        tag.peakBytes = std::max(tagCounters.peakBytes.load(std::memory_order_relaxed), tag.liveBytes);
+    }
+    return stats;
+}
+
+void MemoryTracker::resetPeaks() {
+    for (Counters& tagCounters : counters) {
+        tagCounters.peakBytes.store(tagCounters.liveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+}
+
+} // namespace SFE
+
+#if SFE_ALLOCATION_TRACKING
+
+// Replacements for every global operator new/delete. Each block gets a header right before the
+// pointer handed out, recording its size and tag so the free is charged to the same tag, and the
+// distance back to the malloc'd address, which over-aligned blocks need.
+namespace {
+
+struct alignas(std::max_align_t) AllocationHeader {
+    size_t size;
+    uint32_t offset;
+    SFE::MemoryTag tag;
+};
+
+void* trackedAllocate(size_t size, size_t alignment) noexcept {
+    size_t slack = alignment > alignof(std::max_align_t) ? alignment - 1 : 0;
+    void* raw = std::malloc(sizeof(AllocationHeader) + slack + size);
+    if (!raw) return nullptr;
+
+    uintptr_t start = reinterpret_cast<uintptr_t>(raw) + sizeof(AllocationHeader);
+    uintptr_t user = slack ? (start + slack) & ~static_cast<uintptr_t>(alignment - 1) : start;
+    auto* header = reinterpret_cast<AllocationHeader*>(user) - 1;
+    header->size = size;
+    header->offset = static_cast<uint32_t>(user - reinterpret_cast<uintptr_t>(raw));
+    header->tag = SFE::MemoryTracker::getCurrentTag();
+    SFE::MemoryTracker::getInstance().recordAllocation(header->tag, size);
+    return reinterpret_cast<void*>(user);
+}
+
+void* trackedAllocateOrThrow(size_t size, size_t alignment) {
+    if (size == 0) size = 1;
+    while (true) {
+        if (void* pointer = trackedAllocate(size, alignment)) return pointer;
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) throw std::bad_alloc();
+        handler();
+    }
+}
+
+void* trackedAllocateNothrow(size_t size, size_t alignment) noexcept {
+    try {
+        return trackedAllocateOrThrow(size, alignment);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void trackedFree(void* pointer) noexcept {
+    if (!pointer) return;
+    auto* header = static_cast<AllocationHeader*>(pointer) - 1;
+    SFE::MemoryTracker::getInstance().recordFree(header->tag, header->size);
+    std::free(static_cast<unsigned char*>(pointer) - header->offset);
+}
+
+constexpr size_t DEFAULT_ALIGNMENT = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+} // namespace
+
+void* operator new(size_t size) { return trackedAllocateOrThrow(size, DEFAULT_ALIGNMENT); }
+void* operator new[](size_t size) { return trackedAllocateOrThrow(size, DEFAULT_ALIGNMENT); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return trackedAllocateNothrow(size, DEFAULT_ALIGNMENT); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return trackedAllocateNothrow(size, DEFAULT_ALIGNMENT); }
+void* operator new(size_t size, std::align_val_t alignment) {
+    return trackedAllocateOrThrow(size, static_cast<size_t>(alignment));
+}
+void* operator new[](size_t size, std::align_val_t alignment) {
+    return trackedAllocateOrThrow(size, static_cast<size_t>(alignment));
+}
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return trackedAllocateNothrow(size, static_cast<size_t>(alignment));
+}
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return trackedAllocateNothrow(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* pointer) noexcept { trackedFree(pointer); }
+void operator delete[](void* pointer) noexcept { trackedFree(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { trackedFree(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { trackedFree(pointer); }
+void operator delete(void* pointer, size_t) noexcept { trackedFree(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { trackedFree(pointer); }
+void operator delete(void* pointer, std::align_val_t) noexcept { trackedFree(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { trackedFree(pointer); }
+void operator delete(void* pointer, size_t, std::align_val_t) noexcept { trackedFree(pointer); }
+void operator delete[](void* pointer, size_t, std::align_val_t) noexcept { trackedFree(pointer); }
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { trackedFree(pointer); }
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { trackedFree(pointer); }
+
+#endif
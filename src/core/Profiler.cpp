@@ -0,0 +1,317 @@
+#include "core/Profiler.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define SFE_PROFILER_HAS_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define SFE_PROFILER_HAS_TSC 1
+#else
+#define SFE_PROFILER_HAS_TSC 0
+#endif
+
+namespace SFE {
+
+namespace {
+
+int64_t steadyNanoseconds() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool sameName(const char* a, const char* b) {
+    return a == b || std::strcmp(a, b) == 0;
+}
+
+void appendJsonString(std::string& out, const char* text) {
+    out += '"';
+    for (const char* c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\') out += '\\';
+        out += *c;
+    }
+    out += '"';
+}
+
+} // namespace
+
+thread_local Profiler::ThreadBufferSlot Profiler::currentThreadBuffer;
+
+Profiler::ThreadBufferSlot::~ThreadBufferSlot() {
+    if (!buffer) return;
+    Profiler& profiler = getInstance();
+    std::lock_guard<std::mutex> lock(profiler.threadsMutex);
+    buffer->retired = true;
+    buffer->depth = 0;
+}
+
+Profiler::Profiler() {
+    startTicks = now();
+    startNanoseconds = steadyNanoseconds();
+    frameStartTicks = startTicks;
+}
+
+uint64_t Profiler::now() {
+#if SFE_PROFILER_HAS_TSC
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(steadyNanoseconds());
+#endif
+}
+
+Profiler::ThreadBuffer& Profiler::getThreadBuffer() {
+    if (!currentThreadBuffer.buffer) {
+        std::lock_guard<std::mutex> lock(threadsMutex);
+        ThreadBuffer* buffer = nullptr;
+        for (auto& thread : threads) {
+            if (thread->retired && !thread->gpu) {
+                buffer = thread.get();
+                break;
+            }
+        }
+        if (!buffer) {
+            threads.push_back(std::make_unique<ThreadBuffer>(static_cast<uint32_t>(threads.size())));
+            buffer = threads.back().get();
+        }
+        buffer->retired = false;
+        buffer->name = "Thread " + std::to_string(buffer->threadId);
+        currentThreadBuffer.buffer = buffer;
+    }
+    return *currentThreadBuffer.buffer;
+}
+
+void Profiler::beginZone(const char* name) {
+    ThreadBuffer& buffer = getThreadBuffer();
+    if (buffer.depth < MAX_DEPTH) {
+        buffer.names[buffer.depth] = name;
+        buffer.starts[buffer.depth] = now();
+    }
+    ++buffer.depth;
+}
+
+void Profiler::endZone() {
+    uint64_t end = now();
+    ThreadBuffer& buffer = getThreadBuffer();
+    if (buffer.depth == 0) return;
+    uint32_t depth = --buffer.depth;
+    if (depth >= MAX_DEPTH) return; // Too deep to record
+
+    Zone zone{buffer.names[depth], buffer.starts[depth], end, buffer.threadId, depth};
+    if (!buffer.zones.tryPush(zone)) {
+        buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void Profiler::setThreadName(const char* name) {
+    ThreadBuffer& buffer = getThreadBuffer();
+    std::lock_guard<std::mutex> lock(threadsMutex);
+    buffer.name = name;
+}
+
+uint32_t Profiler::registerGpuTrack(const char* name) {
+    std::lock_guard<std::mutex> lock(threadsMutex);
+    threads.push_back(std::make_unique<ThreadBuffer>(static_cast<uint32_t>(threads.size())));
+    threads.back()->name = name;
+    threads.back()->gpu = true;
+    return threads.back()->threadId;
+}
+
+void Profiler::submitGpuZone(uint32_t trackId, const char* name, uint64_t start, uint64_t end, uint32_t depth) {
+    ThreadBuffer* track;
+    {
+        std::lock_guard<std::mutex> lock(threadsMutex);
+        track = threads[trackId].get();
+    }
+    if (!track->zones.tryPush(Zone{name, start, std::max(start, end), trackId, depth})) {
+        track->dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void Profiler::calibrate() {
+#if SFE_PROFILER_HAS_TSC
+    // The TSC rate is constant on anything recent; a ratio over the whole run gets more precise
+    // the longer it runs
+    int64_t elapsedNanoseconds = steadyNanoseconds() - startNanoseconds;
+    uint64_t elapsedTicks = now() - startTicks;
+    if (elapsedNanoseconds > 1000000 && elapsedTicks > 0) {
+        millisecondsPerTick = elapsedNanoseconds * 1e-6 / static_cast<double>(elapsedTicks);
+    }
+#endif
+}
+
+void Profiler::endFrame() {
+    uint64_t frameEndTicks = now();
+    calibrate();
+
+    frameZones.clear();
+    gpuThreads.clear();
+    uint64_t threadDrops = 0;
+    {
+        std::lock_guard<std::mutex> lock(threadsMutex);
+        Zone zone;
+        for (auto& thread : threads) {
+            while (thread->zones.tryPop(zone)) frameZones.push_back(zone);
+            threadDrops += thread->dropped.load(std::memory_order_relaxed);
+            gpuThreads.push_back(thread->gpu);
+        }
+    }
+
+    lastFrame.frameIndex = frameIndex++;
+    lastFrame.frameMs = ticksToMilliseconds(frameEndTicks - frameStartTicks);
+    frameStartTicks = frameEndTicks;
+    aggregate();
+    if (MemoryTracker::isEnabled()) lastFrame.memory = MemoryTracker::getInstance().endFrame();
+
+    if (capturing) {
+        if (MemoryTracker::isEnabled()) capturedMemory.push_back({frameEndTicks, lastFrame.memory});
+        size_t room = captureLimit - captured.size();
+        size_t taken = std::min(room, frameZones.size());
+        captured.insert(captured.end(), frameZones.begin(), frameZones.begin() + taken);
+        droppedCaptureZones += frameZones.size() - taken;
+    }
+    droppedZones = threadDrops + droppedCaptureZones;
+}
+
+void Profiler::aggregate() {
+    // Start order per thread, parents before the children that start at the same tick
+    std::sort(frameZones.begin(), frameZones.end(), [](const Zone& a, const Zone& b) {
+        if (a.threadId != b.threadId) return a.threadId < b.threadId;
+        if (a.start != b.start) return a.start < b.start;
+        return a.depth < b.depth;
+    });
+
+    // Time covered by direct children, to turn inclusive into exclusive time
+    std::vector<uint64_t> childTicks(frameZones.size(), 0);
+    std::vector<size_t> open;
+    for (size_t i = 0; i < frameZones.size(); ++i) {
+        const Zone& zone = frameZones[i];
+        // Pop zones that cannot enclose this one. A parent still open at the end of the frame is
+        // not in the list, so its children simply have no parent this frame.
+        while (!open.empty()) {
+            const Zone& top = frameZones[open.back()];
+            if (top.threadId == zone.threadId && top.depth < zone.depth && top.end >= zone.end) break;
+            open.pop_back();
+        }
+        if (!open.empty() && frameZones[open.back()].depth + 1 == zone.depth) {
+            childTicks[open.back()] += zone.end - zone.start;
+        }
+        open.push_back(i);
+    }
+
+    lastFrame.zones.clear();
+    for (size_t i = 0; i < frameZones.size(); ++i) {
+        const Zone& zone = frameZones[i];
+        double inclusive = ticksToMilliseconds(zone.end - zone.start);
+        double exclusive = ticksToMilliseconds(zone.end - zone.start - std::min(childTicks[i], zone.end - zone.start));
+
+        auto stats = std::find_if(lastFrame.zones.begin(), lastFrame.zones.end(), [&](const ZoneStats& s) {
+            return s.threadId == zone.threadId && s.depth == zone.depth && sameName(s.name, zone.name);
+        });
+        if (stats == lastFrame.zones.end()) {
+            lastFrame.zones.push_back({zone.name, zone.threadId, zone.depth, 1, inclusive, exclusive,
+                                       static_cast<bool>(gpuThreads[zone.threadId])});
+        } else {
+            stats->calls++;
+            stats->inclusiveMs += inclusive;
+            stats->exclusiveMs += exclusive;
+        }
+    }
+}
+
+double Profiler::FrameStats::getZoneMs(const char* name) const {
+    double total = 0.0;
+    for (const auto& zone : zones) {
+        if (!zone.gpu && sameName(zone.name, name)) total += zone.inclusiveMs;
+    }
+    return total;
+}
+
+double Profiler::FrameStats::getGpuZoneMs(const char* name) const {
+    double total = 0.0;
+    for (const auto& zone : zones) {
+        if (zone.gpu && sameName(zone.name, name)) total += zone.inclusiveMs;
+    }
+    return total;
+}
+
+void Profiler::startCapture(size_t maxZones) {
+    captured.clear();
+    captured.reserve(std::min<size_t>(maxZones, 1 << 16));
+    capturedMemory.clear();
+    captureLimit = maxZones;
+    droppedCaptureZones = 0;
+    capturing = true;
+}
+
+bool Profiler::stopCapture(const std::string& chromeTracePath) {
+    if (!capturing) return false;
+    capturing = false;
+    calibrate();
+
+    FILE* file = std::fopen(chromeTracePath.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Profiler: failed to open " << chromeTracePath << std::endl;
+        return false;
+    }
+
+    // Trace Event Format: complete ("X") events with microsecond timestamps, plus thread names
+    std::string out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    {
+        std::lock_guard<std::mutex> lock(threadsMutex);
+        for (const auto& thread : threads) {
+            out += "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" + std::to_string(thread->threadId) +
+                   ",\"args\":{\"name\":";
+            appendJsonString(out, thread->name.c_str());
+            out += "}},\n";
+        }
+    }
+
+    char buffer[128];
+    for (const Zone& zone : captured) {
+        out += "{\"ph\":\"X\",\"name\":";
+        appendJsonString(out, zone.name);
+        std::snprintf(buffer, sizeof(buffer), ",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f},\n", zone.threadId,
+                      ticksToMilliseconds(zone.start - startTicks) * 1000.0,
+                      ticksToMilliseconds(zone.end - zone.start) * 1000.0);
+        out += buffer;
+        if (out.size() > (1 << 20)) {
+            std::fwrite(out.data(), 1, out.size(), file);
+            out.clear();
+        }
+    }
+    // Heap counters as counter ("C") events: live bytes and allocations per frame, by tag
+    for (const MemorySample& sample : capturedMemory) {
+        double timestamp = ticksToMilliseconds(sample.ticks - startTicks) * 1000.0;
+        for (bool heap : {true, false}) {
+            const char* counter = heap ? "Heap bytes" : "Allocations";
+            std::snprintf(buffer, sizeof(buffer), "{\"ph\":\"C\",\"name\":\"%s\",\"pid\":1,\"ts\":%.3f,\"args\":{",
+                          counter, timestamp);
+            out += buffer;
+            for (size_t i = 0; i < static_cast<size_t>(MemoryTag::Count); ++i) {
+                const MemoryTracker::TagStats& tag = sample.memory.tags[i];
+                std::snprintf(buffer, sizeof(buffer), "%s\"%s\":%llu", i ? "," : "",
+                              getMemoryTagName(static_cast<MemoryTag>(i)),
+                              static_cast<unsigned long long>(heap ? tag.liveBytes : tag.allocations));
+                out += buffer;
+            }
+            out += "}},\n";
+        }
+    }
+
+    // Closing metadata event avoids special-casing the trailing comma
+    out += "{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":1,\"args\":{\"name\":\"SilentForgeEngine\"}}\n]}\n";
+    std::fwrite(out.data(), 1, out.size(), file);
+    bool success = std::fclose(file) == 0;
+
+    captured.clear();
+    captured.shrink_to_fit();
+    capturedMemory.clear();
+    capturedMemory.shrink_to_fit();
+    return success;
+}
+
+} // namespace SFE
@@ -0,0 +1,113 @@
+#include "core/QoiEncoder.hpp"
+#include <cstring>
+
+namespace SFE {
+
+namespace {
+
+constexpr uint8_t QOI_OP_INDEX = 0x00; // 00xxxxxx
+constexpr uint8_t QOI_OP_DIFF = 0x40;  // 01xxxxxx
+constexpr uint8_t QOI_OP_LUMA = 0x80;  // 10xxxxxx
+constexpr uint8_t QOI_OP_RUN = 0xC0;   // 11xxxxxx
+constexpr uint8_t QOI_OP_RGB = 0xFE;
+constexpr uint8_t QOI_OP_RGBA = 0xFF;
+constexpr int QOI_MAX_RUN = 62;
+constexpr uint8_t QOI_END_MARKER[8] = {0, 0, 0, 0, 0, 0, 0, 1};
+
+struct Pixel {
+    uint8_t r, g, b, a;
+    bool operator==(const Pixel& other) const {
+        return r == other.r && g == other.g && b == other.b && a == other.a;
+    }
+};
+
+uint32_t hashPixel(const Pixel& p) {
+    return (p.r * 3u + p.g * 5u + p.b * 7u + p.a * 11u) % 64u;
+}
+
+void writeBigEndian(uint8_t* out, uint32_t value) {
+    out[0] = static_cast<uint8_t>(value >> 24);
+    out[1] = static_cast<uint8_t>(value >> 16);
+    out[2] = static_cast<uint8_t>(value >> 8);
+    out[3] = static_cast<uint8_t>(value);
+}
+
+} // namespace
+
+std::vector<uint8_t> encodeQoi(const uint8_t* rgba, uint32_t width, uint32_t height) {
+    size_t pixelCount = size_t(width) * height;
+
+    // Worst case: every pixel is a 5-byte QOI_OP_RGBA
+    std::vector<uint8_t> output(14 + pixelCount * 5 + sizeof(QOI_END_MARKER));
+    uint8_t* out = output.data();
+
+    std::memcpy(out, "qoif", 4);
+    writeBigEndian(out + 4, width);
+    writeBigEndian(out + 8, height);
+    out[12] = 4; // RGBA
+    out[13] = 0; // sRGB with linear alpha
+    size_t position = 14;
+
+    Pixel index[64] = {};
+    Pixel previous{0, 0, 0, 255};
+    int run = 0;
+
+    for (size_t i = 0; i < pixelCount; ++i) {
+        Pixel pixel{rgba[i * 4], rgba[i * 4 + 1], rgba[i * 4 + 2], rgba[i * 4 + 3]};
+
+        if (pixel == previous) {
+            ++run;
+            if (run == QOI_MAX_RUN || i + 1 == pixelCount) {
+                out[position++] = static_cast<uint8_t>(QOI_OP_RUN | (run - 1));
+                run = 0;
+            }
+            continue;
+        }
+
+        if (run > 0) {
+            out[position++] = static_cast<uint8_t>(QOI_OP_RUN | (run - 1));
+            run = 0;
+        }
+
+        uint32_t hash = hashPixel(pixel);
+        if (index[hash] == pixel) {
+            out[position++] = static_cast<uint8_t>(QOI_OP_INDEX | hash);
+        } else {
+            index[hash] = pixel;
+            if (pixel.a == previous.a) {
+                // Differences wrap around, as in the reference encoder
+                int8_t dr = static_cast<int8_t>(pixel.r - previous.r);
+                int8_t dg = static_cast<int8_t>(pixel.g - previous.g);
+                int8_t db = static_cast<int8_t>(pixel.b - previous.b);
+                int8_t drDg = static_cast<int8_t>(dr - dg);
+                int8_t dbDg = static_cast<int8_t>(db - dg);
+
+                if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1) {
+                    out[position++] = static_cast<uint8_t>(QOI_OP_DIFF | ((dr + 2) << 4) | ((dg + 2) << 2) | (db + 2));
+                } else if (drDg >= -8 && drDg <= 7 && dg >= -32 && dg <= 31 && dbDg >= -8 && dbDg <= 7) {
+                    out[position++] = static_cast<uint8_t>(QOI_OP_LUMA | (dg + 32));
+                    out[position++] = static_cast<uint8_t>(((drDg + 8) << 4) | (dbDg + 8));
+                } else {
+                    out[position++] = QOI_OP_RGB;
+                    out[position++] = pixel.r;
+                    out[position++] = pixel.g;
+                    out[position++] = pixel.b;
+                }
+            } else {
+                out[position++] = QOI_OP_RGBA;
+                out[position++] = pixel.r;
+                out[position++] = pixel.g;
+                out[position++] = pixel.b;
+                out[position++] = pixel.a;
+            }
+        }
+        previous = pixel;
+    }
+
+    std::memcpy(out + position, QOI_END_MARKER, sizeof(QOI_END_MARKER));
+    position += sizeof(QOI_END_MARKER);
+    output.resize(position);
+    return output;
+}
+
+} // namespace SFE
@@ -0,0 +1,69 @@
+#include "core/SceneComponents.hpp"
+#include "core/SystemScheduler.hpp"
+#include <cmath>
+
+namespace SFE {
+
+namespace {
+
+// Rows per job; the loops are a few dozen flops per entity
+constexpr size_t UPDATE_GRAIN = 1024;
+
+} // namespace
+
+void updateOrbits(World& world, float deltaTime) {
+    world.parallelForEachChunk<Orbit, Position>(
+        UPDATE_GRAIN, [deltaTime](size_t count, const Entity*, Orbit* orbits, Position* positions) {
+            for (size_t i = 0; i < count; ++i) {
+                Orbit& orbit = orbits[i];
+                orbit.angle = std::fmod(orbit.angle + orbit.speed * deltaTime, 6.28318531f);
+                positions[i].value = orbit.center + glm::vec3(std::cos(orbit.angle), 0.0f, std::sin(orbit.angle)) * orbit.radius;
+            }
+        });
+}
+
+void updateSpins(World& world, float deltaTime) {
+    world.parallelForEachChunk<Spin, Rotation>(
+        UPDATE_GRAIN, [deltaTime](size_t count, const Entity*, const Spin* spins, Rotation* rotations) {
+            for (size_t i = 0; i < count; ++i) {
+                glm::vec3 degrees = rotations[i].degrees + spins[i].degreesPerSecond * deltaTime;
+                rotations[i].degrees = glm::vec3(std::fmod(degrees.x, 360.0f), std::fmod(degrees.y, 360.0f),
+                                                 std::fmod(degrees.z, 360.0f));
+            }
+        });
+}
+
+void updateLocalToWorld(World& world) {
+    world.parallelForEachChunk<Position, Rotation, Scale, LocalToWorld>(
+        UPDATE_GRAIN, [](size_t count, const Entity*, const Position* positions, const Rotation* rotations,
+                         const Scale* scales, LocalToWorld* matrices) {
+            const float toRadians = 0.0174532925f;
+            for (size_t i = 0; i < count; ++i) {
+                // translate * rotateX * rotateY * rotateZ * scale, as SceneNode::getModelMatrix,
+                // multiplied out
+                glm::vec3 angles = rotations[i].degrees * toRadians;
+                float cx = std::cos(angles.x), sx = std::sin(angles.x);
+                float cy = std::cos(angles.y), sy = std::sin(angles.y);
+                float cz = std::cos(angles.z), sz = std::sin(angles.z);
+                const glm::vec3& s = scales[i].value;
+                glm::mat4& m = matrices[i].matrix;
+                m[0] = glm::vec4(cy * cz, cx * sz + sx * sy * cz, sx * sz - cx * sy * cz, 0.0f) * s.x;
+                m[1] = glm::vec4(-cy * sz, cx * cz - sx * sy * sz, sx * cz + cx * sy * sz, 0.0f) * s.y;
+                m[2] = glm::vec4(sy, -sx * cy, cx * cy, 0.0f) * s.z;
+                m[3] = glm::vec4(positions[i].value, 1.0f);
+            }
+        });
+}
+
+void addSceneSystems(SystemScheduler& scheduler) {
+    scheduler.add("Orbits", 0, World::maskOf<Orbit, Position>(), updateOrbits);
+    scheduler.add("Spins", World::maskOf<Spin>(), World::maskOf<Rotation>(), updateSpins);
+    scheduler.add("LocalToWorld", World::maskOf<Position, Rotation, Scale>(), World::maskOf<LocalToWorld>(),
+                  [](World& world, float) { updateLocalToWorld(world); });
+}
+
+Entity createTransformEntity(World& world, const glm::vec3& position, const glm::vec3& scale) {
+    return world.create(Position{position}, Rotation{}, Scale{scale}, LocalToWorld{});
+}
+
+} // namespace SFE
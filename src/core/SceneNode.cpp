@@ -1,9 +1,10 @@
 #include "core/SceneNode.hpp"
+#include "rendering/ResourceRegistry.hpp"
 #include <iostream>
 
 namespace SFE {
 
-SceneNode::SceneNode(Mesh* mesh) : mesh(mesh) {
+SceneNode::SceneNode(MeshHandle mesh) : mesh(mesh) {
     // Calculate orbit radius if this is not the center node
     if (position.x != 0.0f || position.y != 0.0f || position.z != 0.0f) {
         orbitRadius = glm::length(position);
@@ -27,13 +28,7 @@ void SceneNode::update(float deltaTime, float currentTime) {
     }
 }
 
-void SceneNode::draw(Shader& shader, const Camera& camera) const {
-    if (!mesh) return;
-    
-    if (texture) {
-        mesh->setTexture(texture);
-    }
-    
+glm::mat4 SceneNode::getModelMatrix() const {
     // Calculate model matrix based on position, rotation, scale
     glm::mat4 model = glm::mat4(1.0f);
     model = glm::translate(model, position);
@@ -44,14 +39,25 @@ void SceneNode::draw(Shader& shader, const Camera& camera) const {
     model = glm::rotate(model, glm::radians(rotation.z), glm::vec3(0.0f, 0.0f, 1.0f));
     
     // Apply scale
-    model = glm::scale(model, scale);
+    return glm::scale(model, scale);
+}
+
+void SceneNode::draw(Shader& shader, const Camera& camera) const {
+    Mesh* nodeMesh = ResourceRegistry::getInstance().get(mesh);
+    if (!nodeMesh) return;
+    
+    if (texture) {
+        nodeMesh->setTexture(texture);
+    }
     
     // Set uniforms and draw
-    shader.setMat4("model", model);
+    shader.setMat4("model", getModelMatrix());
     shader.setMat4("view", camera.getViewMatrix());
     shader.setMat4("projection", camera.getProjectionMatrix(800.0f / 600.0f));
+    // Quantized meshes need their decode uniforms
+    nodeMesh->applyVertexDecode(shader);
     
-    mesh->draw();
+    nodeMesh->draw();
 }
 
 } 
\ No newline at end of file
@@ -0,0 +1,225 @@
+#include "core/ScreenshotManager.hpp"
+#include "core/QoiEncoder.hpp"
+#include "core/Profiler.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include "stb/stb_image_write.h"
+
+namespace SFE {
+
+ScreenshotManager::~ScreenshotManager() {
+    // GL objects are gone with the context by now; only stop the worker
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    jobAvailable.notify_all();
+    if (worker.joinable()) worker.join();
+}
+
+ScreenshotManager::Format ScreenshotManager::formatFromFilename(const std::string& filename) {
+    auto endsWith = [&](const char* suffix) {
+        size_t length = std::strlen(suffix);
+        return filename.size() >= length && filename.compare(filename.size() - length, length, suffix) == 0;
+    };
+    if (endsWith(".qoi")) return Format::QOI;
+    if (endsWith(".raw")) return Format::Raw;
+    return Format::PNG;
+}
+
+bool ScreenshotManager::captureScreenshot(const std::string& filename, int width, int height) {
+    if (width <= 0 || height <= 0) return false;
+
+    ReadbackSlot* slot = nullptr;
+    for (auto& candidate : slots) {
+        if (!candidate.fence) {
+            slot = &candidate;
+            break;
+        }
+    }
+    if (!slot) return false;
+
+    size_t byteCount = size_t(width) * height * 4;
+    if (!slot->pbo) glGenBuffers(1, &slot->pbo);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot->pbo);
+    if (slot->capacity < byteCount) {
+        glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(byteCount), nullptr, GL_STREAM_READ);
+        slot->capacity = byteCount;
+    }
+
+    // With a pack buffer bound this only schedules the copy; the data pointer is an offset
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    slot->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot->width = width;
+    slot->height = height;
+    slot->filename = filename;
+    slot->sequence = nextSequence++;
+    ++inFlightCount;
+    return true;
+}
+
+void ScreenshotManager::retireSlot(ReadbackSlot& slot) {
+    EncodeJob job;
+    job.filename = std::move(slot.filename);
+    job.format = formatFromFilename(job.filename);
+    job.width = slot.width;
+    job.height = slot.height;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!freeBuffers.empty()) {
+            job.pixels = std::move(freeBuffers.back());
+            freeBuffers.pop_back();
+        }
+    }
+
+    // The one copy out of the mapped buffer also flips GL's bottom-up rows, so the worker
+    // gets top-down pixels that every encoder can use directly
+    size_t rowBytes = size_t(slot.width) * 4;
+    job.pixels.resize(rowBytes * slot.height);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+    const auto* mapped = static_cast<const uint8_t*>(
+        glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, static_cast<GLsizeiptr>(job.pixels.size()), GL_MAP_READ_BIT));
+    bool mappedOk = mapped != nullptr;
+    if (mappedOk) {
+        for (int y = 0; y < slot.height; ++y) {
+            std::memcpy(&job.pixels[(slot.height - 1 - y) * rowBytes], mapped + y * rowBytes, rowBytes);
+        }
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    glDeleteSync(slot.fence);
+    slot.fence = nullptr;
+    --inFlightCount;
+
+    if (!mappedOk) {
+        std::cerr << "ScreenshotManager: failed to map readback buffer for " << job.filename << std::endl;
+        if (completionCallback) completionCallback(job.filename, false);
+        return;
+    }
+
+    ensureWorker();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push_back(std::move(job));
+    }
+    jobAvailable.notify_one();
+}
+
+void ScreenshotManager::update() {
+    SFE_PROFILE_SCOPE("ScreenshotManager::update");
+    // Retire in submission order; stop at the first readback the GPU has not finished
+    while (inFlightCount > 0) {
+        ReadbackSlot* oldest = nullptr;
+        for (auto& slot : slots) {
+            if (slot.fence && (!oldest || slot.sequence < oldest->sequence)) oldest = &slot;
+        }
+        GLenum status = glClientWaitSync(oldest->fence, 0, 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) break;
+        retireSlot(*oldest);
+    }
+
+    std::vector<Completion> finished;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        finished.swap(completions);
+    }
+    if (completionCallback) {
+        for (const auto& completion : finished) {
+            completionCallback(completion.filename, completion.success);
+        }
+    }
+}
+
+void ScreenshotManager::shutdown() {
+    // Drain outstanding readbacks, waiting for the GPU this time
+    while (inFlightCount > 0) {
+        ReadbackSlot* oldest = nullptr;
+        for (auto& slot : slots) {
+            if (slot.fence && (!oldest || slot.sequence < oldest->sequence)) oldest = &slot;
+        }
+        glClientWaitSync(oldest->fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000); // 1 s
+        retireSlot(*oldest);
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        jobFinished.wait(lock, [this] { return jobs.empty() && activeJobs == 0; });
+        stopping = true;
+    }
+    jobAvailable.notify_all();
+    if (worker.joinable()) worker.join();
+    update(); // Report the last completions
+
+    for (auto& slot : slots) {
+        if (slot.pbo) glDeleteBuffers(1, &slot.pbo);
+        slot = ReadbackSlot{};
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    freeBuffers.clear();
+    stopping = false;
+}
+
+size_t ScreenshotManager::encodingCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return jobs.size() + static_cast<size_t>(activeJobs);
+}
+
+void ScreenshotManager::ensureWorker() {
+    if (!worker.joinable()) {
+        worker = std::thread(&ScreenshotManager::workerLoop, this);
+    }
+}
+
+void ScreenshotManager::workerLoop() {
+    Profiler::getInstance().setThreadName("Screenshot");
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        jobAvailable.wait(lock, [this] { return stopping || !jobs.empty(); });
+        if (jobs.empty()) return; // Stopping and drained
+
+        EncodeJob job = std::move(jobs.front());
+        jobs.pop_front();
+        ++activeJobs;
+        lock.unlock();
+
+        bool success = writeImage(job);
+        if (!success) {
+            std::cerr << "ScreenshotManager: failed to write " << job.filename << std::endl;
+        }
+
+        lock.lock();
+        --activeJobs;
+        completions.push_back({std::move(job.filename), success});
+        freeBuffers.push_back(std::move(job.pixels));
+        jobFinished.notify_all();
+    }
+}
+
+bool ScreenshotManager::writeImage(const EncodeJob& job) {
+    SFE_PROFILE_SCOPE("ScreenshotManager::writeImage");
+    switch (job.format) {
+    case Format::QOI: {
+        std::vector<uint8_t> encoded = encodeQoi(job.pixels.data(), job.width, job.height);
+        std::ofstream file(job.filename, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(encoded.data()), static_cast<std::streamsize>(encoded.size()));
+        return file.good();
+    }
+    case Format::Raw: {
+        std::ofstream file(job.filename, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(job.pixels.data()), static_cast<std::streamsize>(job.pixels.size()));
+        return file.good();
+    }
+    default:
+        return stbi_write_png(job.filename.c_str(), job.width, job.height, 4, job.pixels.data(), job.width * 4) != 0;
+    }
+}
+
+} // namespace SFE
@@ -0,0 +1,41 @@
+#include "core/SystemScheduler.hpp"
+#include "core/JobSystem.hpp"
+#include "core/Profiler.hpp"
+#include <algorithm>
+
+namespace SFE {
+
+SystemScheduler::SystemId SystemScheduler::add(const char* name, ComponentMask reads, ComponentMask writes,
+                                               System system) {
+    uint32_t stage = 0;
+    for (const SystemInfo& earlier : systems) {
+        bool conflicts = (writes & (earlier.reads | earlier.writes)) || (reads & earlier.writes);
+        if (conflicts) stage = std::max(stage, earlier.stage + 1);
+    }
+    SystemId id = static_cast<SystemId>(systems.size());
+    systems.push_back({name, reads, writes, stage});
+    functions.push_back(std::move(system));
+    if (stages.size() <= stage) stages.resize(stage + 1);
+    stages[stage].push_back(id);
+    return id;
+}
+
+void SystemScheduler::run(World& world, float deltaTime) {
+    SFE_PROFILE_SCOPE("SystemScheduler::run");
+    auto& jobs = JobSystem::getInstance();
+    for (const auto& stage : stages) {
+        auto runSystem = [this, &world, deltaTime](SystemId id) {
+            SFE_PROFILE_SCOPE(systems[id].name);
+            functions[id](world, deltaTime);
+        };
+        JobCounter counter;
+        for (size_t i = 1; i < stage.size(); ++i) {
+            SystemId id = stage[i];
+            jobs.schedule([&runSystem, id] { runSystem(id); }, &counter);
+        }
+        runSystem(stage[0]);
+        jobs.wait(counter);
+    }
+}
+
+} // namespace SFE
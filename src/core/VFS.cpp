@@ -0,0 +1,577 @@
+#include "core/VFS.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define SFE_VFS_IO_URING 1
+#endif
+#endif
+#ifndef SFE_VFS_IO_URING
+#define SFE_VFS_IO_URING 0
+#endif
+
+#if SFE_VFS_IO_URING
+#include <cerrno>
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace SFE {
+
+#if SFE_VFS_IO_URING
+
+// Minimal io_uring wrapper on the raw system calls (no liburing dependency): one submission queue
+// filled by the I/O thread only, reads only
+struct IoUring {
+    static constexpr unsigned ENTRIES = 16;
+
+    int fd = -1;
+    unsigned entries = 0;
+    bool failed = false; // enter() failed hard; reads fall back to blocking ones
+    unsigned* sqHead = nullptr;
+    unsigned* sqTail = nullptr;
+    unsigned* sqArray = nullptr;
+    unsigned sqMask = 0;
+    io_uring_sqe* sqes = nullptr;
+    unsigned* cqHead = nullptr;
+    unsigned* cqTail = nullptr;
+    unsigned cqMask = 0;
+    io_uring_cqe* cqes = nullptr;
+
+    void* ringMemory = MAP_FAILED;
+    size_t ringSize = 0;
+    void* cqMemory = MAP_FAILED; // Only without IORING_FEAT_SINGLE_MMAP
+    size_t cqSize = 0;
+    void* sqeMemory = MAP_FAILED;
+    size_t sqeSize = 0;
+
+    ~IoUring() {
+        if (sqeMemory != MAP_FAILED) munmap(sqeMemory, sqeSize);
+        if (cqMemory != MAP_FAILED) munmap(cqMemory, cqSize);
+        if (ringMemory != MAP_FAILED) munmap(ringMemory, ringSize);
+        if (fd >= 0) close(fd);
+    }
+
+    bool setup() {
+        io_uring_params params{};
+        fd = static_cast<int>(syscall(__NR_io_uring_setup, ENTRIES, &params));
+        if (fd < 0) return false;
+
+        bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        ringSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cqSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        if (singleMap) ringSize = std::max(ringSize, cqSize);
+        ringMemory = mmap(nullptr, ringSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+        if (ringMemory == MAP_FAILED) return false;
+        void* cqBase = ringMemory;
+        if (!singleMap) {
+            cqMemory = mmap(nullptr, cqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+            if (cqMemory == MAP_FAILED) return false;
+            cqBase = cqMemory;
+        }
+        sqeSize = params.sq_entries * sizeof(io_uring_sqe);
+        sqeMemory = mmap(nullptr, sqeSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+        if (sqeMemory == MAP_FAILED) return false;
+
+        auto* sq = static_cast<uint8_t*>(ringMemory);
+        auto* cq = static_cast<uint8_t*>(cqBase);
+        entries = params.sq_entries;
+        sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        sqMask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sqes = static_cast<io_uring_sqe*>(sqeMemory);
+        cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cqMask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        return true;
+    }
+
+    // Queue a read; the kernel sees it at the next enter()
+    bool prepareRead(int file, void* buffer, uint32_t length, uint64_t offset, uint64_t userData) {
+        unsigned tail = *sqTail;
+        if (tail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE) >= entries) return false;
+        unsigned index = tail & sqMask;
+        io_uring_sqe& sqe = sqes[index];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = IORING_OP_READ;
+        sqe.fd = file;
+        sqe.addr = reinterpret_cast<uint64_t>(buffer);
+        sqe.len = length;
+        sqe.off = offset;
+        sqe.user_data = userData;
+        sqArray[index] = index;
+        __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+        return true;
+    }
+
+    // Submit 'submitCount' queued reads and block until at least 'waitCount' have completed
+    int enter(unsigned submitCount, unsigned waitCount) {
+        for (;;) {
+            long result = syscall(__NR_io_uring_enter, fd, submitCount, waitCount,
+                                  waitCount ? IORING_ENTER_GETEVENTS : 0u, nullptr, 0);
+            if (result >= 0 || errno != EINTR) return static_cast<int>(result < 0 ? -errno : result);
+        }
+    }
+
+    // Take back the last 'count' queued reads, which the kernel has not seen
+    void withdraw(unsigned count) {
+        __atomic_store_n(sqTail, *sqTail - count, __ATOMIC_RELEASE);
+    }
+
+    template <typename Function>
+    void forEachCompletion(Function&& function) {
+        unsigned head = *cqHead;
+        unsigned tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+        for (; head != tail; ++head) {
+            const io_uring_cqe& cqe = cqes[head & cqMask];
+            function(cqe.user_data, cqe.res);
+        }
+        __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+    }
+};
+
+#else
+
+struct IoUring {};
+
+#endif
+
+namespace {
+
+std::string trimMountPoint(const std::string& mountPoint) {
+    std::string point = normalizeAssetPath(mountPoint);
+    while (!point.empty() && point.back() == '/') point.pop_back();
+    return point;
+}
+
+} // namespace
+
+VFS::VFS() {
+    // Constructed first so it outlives the reads this object waits for on exit
+    JobSystem::getInstance();
+#if SFE_VFS_IO_URING
+    ring = std::make_unique<IoUring>();
+    if (ring->setup()) {
+        backend = Backend::IoUring;
+    } else {
+        ring.reset();
+    }
+#endif
+}
+
+VFS::~VFS() {
+    shutdown();
+}
+
+bool VFS::mountDirectory(const std::string& mountPoint, const std::string& directory) {
+    std::error_code error;
+    if (!std::filesystem::is_directory(directory, error)) {
+        std::cerr << "VFS: cannot mount " << directory << ": not a directory" << std::endl;
+        return false;
+    }
+    Mount mount;
+    mount.point = trimMountPoint(mountPoint);
+    mount.directory = directory;
+    mounts.push_back(std::move(mount));
+    return true;
+}
+
+bool VFS::mountPack(const std::string& mountPoint, const std::string& packPath) {
+    auto pack = std::make_unique<AssetPack>();
+    if (!pack->open(packPath)) {
+        return false;
+    }
+    Mount mount;
+    mount.point = trimMountPoint(mountPoint);
+    mount.pack = std::move(pack);
+    mounts.push_back(std::move(mount));
+    return true;
+}
+
+void VFS::unmountAll() {
+    clearPreloads();
+    waitForReads();
+    mounts.clear();
+}
+
+bool VFS::resolve(const std::string& path, Location& location) const {
+    std::error_code error;
+    std::string normalized = normalizeAssetPath(path);
+    if (mounts.empty() || std::filesystem::path(path).is_absolute()) {
+        location.filePath = normalized;
+        return std::filesystem::is_regular_file(normalized, error);
+    }
+
+    for (auto mount = mounts.rbegin(); mount != mounts.rend(); ++mount) {
+        std::string relative;
+        if (mount->point.empty()) {
+            relative = normalized;
+        } else if (normalized.size() > mount->point.size() && normalized[mount->point.size()] == '/' &&
+                   normalized.compare(0, mount->point.size(), mount->point) == 0) {
+            relative = normalized.substr(mount->point.size() + 1);
+        } else {
+            continue;
+        }
+
+        if (mount->pack) {
+            if (const AssetPackEntry* entry = mount->pack->find(relative)) {
+                location.pack = mount->pack.get();
+                location.entry = entry;
+                return true;
+            }
+        } else {
+            std::string filePath = mount->directory + "/" + relative;
+            if (std::filesystem::is_regular_file(filePath, error)) {
+                location.filePath = std::move(filePath);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool VFS::exists(const std::string& path) const {
+    Location location;
+    return resolve(path, location);
+}
+
+bool VFS::read(const std::string& path, AssetData& data) {
+    std::shared_ptr<Preload> preloaded;
+    {
+        std::lock_guard<std::mutex> lock(preloadMutex);
+        auto it = preloads.find(normalizeAssetPath(path));
+        if (it != preloads.end()) {
+            preloaded = std::move(it->second);
+            preloads.erase(it);
+        }
+    }
+    if (preloaded) {
+        JobSystem::getInstance().wait(preloaded->done);
+        if (preloaded->success) {
+            data = std::move(preloaded->data);
+            return true;
+        }
+        // Read again below so the failure is reported where it happens
+    }
+
+    data.reset();
+    Location location;
+    if (!resolve(path, location)) {
+        std::cerr << "VFS: no such file " << path << std::endl;
+        return false;
+    }
+    if (location.entry) {
+        return location.pack->read(*location.entry, data);
+    }
+    if (!data.file.open(location.filePath)) {
+        return false;
+    }
+    data.data = data.file.getData();
+    data.size = data.file.getSize();
+    return true;
+}
+
+void VFS::readAsync(const std::string& path, ReadCallback callback) {
+    JobSystem& jobs = JobSystem::getInstance();
+    asyncReadCount.fetch_add(1, std::memory_order_relaxed);
+
+    Location location;
+    if (!resolve(path, location)) {
+        std::cerr << "VFS: no such file " << path << std::endl;
+        jobs.schedule(
+            [path, callback] {
+                AssetData data;
+                callback(path, data, false);
+            },
+            &readCounter);
+        return;
+    }
+
+    // Pack entries are mapped already: the job faults them in and decompresses
+    if (location.entry) {
+        const AssetPack* pack = location.pack;
+        const AssetPackEntry* entry = location.entry;
+        jobs.schedule(
+            [this, pack, entry, path, callback] {
+                AssetData data;
+                bool success = pack->read(*entry, data);
+                if (success) asyncBytesRead.fetch_add(entry->storedSize, std::memory_order_relaxed);
+                callback(path, data, success);
+            },
+            &readCounter);
+        return;
+    }
+
+    auto request = std::make_unique<FileRead>();
+    request->path = path;
+    request->filePath = std::move(location.filePath);
+    request->callback = std::move(callback);
+
+    if (backend == Backend::ThreadPool) {
+        std::shared_ptr<FileRead> shared = std::move(request);
+        jobs.schedule(
+            [this, shared] {
+                bool success = readFileBlocking(*shared);
+                if (success) asyncBytesRead.fetch_add(shared->data.size, std::memory_order_relaxed);
+                shared->callback(shared->path, shared->data, success);
+            },
+            &readCounter);
+        return;
+    }
+
+    // The read counts as pending until complete() has turned it into a callback job
+    jobs.begin(readCounter);
+    ensureIoThread();
+    {
+        std::lock_guard<std::mutex> lock(ioMutex);
+        ioQueue.push_back(std::move(request));
+    }
+    ioAvailable.notify_one();
+}
+
+void VFS::preload(const std::string& path) {
+    // Missing files are reported by the read() that wanted them
+    Location location;
+    if (!resolve(path, location)) return;
+
+    auto preloaded = std::make_shared<Preload>();
+    {
+        std::lock_guard<std::mutex> lock(preloadMutex);
+        if (!preloads.emplace(normalizeAssetPath(path), preloaded).second) return;
+    }
+    JobSystem& jobs = JobSystem::getInstance();
+    jobs.begin(preloaded->done);
+    readAsync(path, [preloaded](const std::string&, AssetData& data, bool success) {
+        preloaded->data = std::move(data);
+        preloaded->success = success;
+        JobSystem::getInstance().end(preloaded->done);
+    });
+}
+
+void VFS::clearPreloads() {
+    std::unordered_map<std::string, std::shared_ptr<Preload>> unused;
+    {
+        std::lock_guard<std::mutex> lock(preloadMutex);
+        unused.swap(preloads);
+    }
+    for (auto& entry : unused) {
+        JobSystem::getInstance().wait(entry.second->done);
+    }
+}
+
+void VFS::waitForReads() {
+    JobSystem::getInstance().wait(readCounter);
+}
+
+bool VFS::setBackend(Backend requested) {
+    if (!readCounter.isDone()) return requested == backend;
+    // The I/O thread may still be between its last completion and going idle
+    stopIoThread();
+    if (requested == Backend::IoUring && !ring) {
+#if SFE_VFS_IO_URING
+        ring = std::make_unique<IoUring>();
+        if (!ring->setup()) {
+            ring.reset();
+            return false;
+        }
+#else
+        return false;
+#endif
+    }
+    if (requested == Backend::ThreadPool) ring.reset();
+    backend = requested;
+    return true;
+}
+
+const char* VFS::getBackendName(Backend backend) {
+    switch (backend) {
+    case Backend::IoUring: return "io_uring";
+    case Backend::ThreadPool: return "thread pool";
+    }
+    return "unknown";
+}
+
+void VFS::shutdown() {
+    clearPreloads();
+    waitForReads();
+    stopIoThread();
+}
+
+void VFS::complete(std::unique_ptr<FileRead> request, bool success) {
+#if SFE_VFS_IO_URING
+    if (request->fileDescriptor >= 0) {
+        close(request->fileDescriptor);
+        request->fileDescriptor = -1;
+    }
+#endif
+    if (success) {
+        request->data.data = request->data.storage.data();
+        request->data.size = request->data.storage.size();
+        asyncBytesRead.fetch_add(request->data.size, std::memory_order_relaxed);
+    } else {
+        request->data.reset();
+    }
+
+    JobSystem& jobs = JobSystem::getInstance();
+    std::shared_ptr<FileRead> shared = std::move(request);
+    jobs.schedule([shared, success] { shared->callback(shared->path, shared->data, success); }, &readCounter);
+    jobs.end(readCounter);
+}
+
+bool VFS::readFileBlocking(FileRead& request) {
+    std::ifstream file(request.filePath, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        std::cerr << "VFS: failed to open " << request.filePath << std::endl;
+        return false;
+    }
+    std::streamoff size = file.tellg();
+    file.seekg(0);
+    request.data.storage.resize(static_cast<size_t>(size));
+    if (size > 0 && !file.read(reinterpret_cast<char*>(request.data.storage.data()), size)) {
+        std::cerr << "VFS: failed to read " << request.filePath << std::endl;
+        request.data.reset();
+        return false;
+    }
+    request.data.data = request.data.storage.data();
+    request.data.size = request.data.storage.size();
+    return true;
+}
+
+void VFS::stopIoThread() {
+    {
+        std::lock_guard<std::mutex> lock(ioMutex);
+        ioStopping = true;
+    }
+    ioAvailable.notify_all();
+    if (ioThread.joinable()) ioThread.join();
+    std::lock_guard<std::mutex> lock(ioMutex);
+    ioStopping = false;
+}
+
+void VFS::ensureIoThread() {
+    std::lock_guard<std::mutex> lock(ioMutex);
+    if (!ioThread.joinable()) {
+        ioThread = std::thread(&VFS::ioThreadLoop, this);
+    }
+}
+
+bool VFS::openFileRead(FileRead& request) {
+#if SFE_VFS_IO_URING
+    request.fileDescriptor = open(request.filePath.c_str(), O_RDONLY | O_CLOEXEC);
+    struct stat status;
+    if (request.fileDescriptor < 0 || fstat(request.fileDescriptor, &status) != 0) {
+        std::cerr << "VFS: failed to open " << request.filePath << std::endl;
+        return false;
+    }
+    request.data.storage.resize(static_cast<size_t>(status.st_size));
+    return true;
+#else
+    (void)request;
+    return false;
+#endif
+}
+
+void VFS::ioThreadLoop() {
+#if SFE_VFS_IO_URING
+    // Opened requests waiting for a ring slot, and reads the kernel returned short
+    std::deque<std::unique_ptr<FileRead>> waiting;
+    // Queued reads the kernel has not taken yet, oldest first
+    std::deque<FileRead*> unsubmitted;
+    unsigned inFlight = 0;
+    auto backoff = std::chrono::microseconds(0);
+    constexpr auto MAX_BACKOFF = std::chrono::microseconds(2000);
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(ioMutex);
+            if (inFlight == 0 && waiting.empty()) {
+                ioAvailable.wait(lock, [this] { return ioStopping || !ioQueue.empty(); });
+                if (ioQueue.empty()) return; // Stopping and drained
+            }
+            for (auto& request : ioQueue) waiting.push_back(std::move(request));
+            ioQueue.clear();
+        }
+
+        // Everything that fits goes to the kernel in one enter() call
+        while (!waiting.empty() && (ring->failed || inFlight < ring->entries)) {
+            std::unique_ptr<FileRead> request = std::move(waiting.front());
+            waiting.pop_front();
+            if (ring->failed) {
+                bool success = readFileBlocking(*request); // Before 'request' is moved from
+                complete(std::move(request), success);
+                continue;
+            }
+            if (request->fileDescriptor < 0 && !openFileRead(*request)) {
+                complete(std::move(request), false);
+                continue;
+            }
+            uint64_t remaining = request->data.storage.size() - request->offset;
+            if (remaining == 0) {
+                complete(std::move(request), true);
+                continue;
+            }
+            uint32_t length = static_cast<uint32_t>(std::min<uint64_t>(remaining, 1u << 30));
+            ring->prepareRead(request->fileDescriptor, request->data.storage.data() + request->offset, length,
+                              request->offset, reinterpret_cast<uint64_t>(request.get()));
+            unsubmitted.push_back(request.release()); // Owned by the ring until its completion
+            ++inFlight;
+        }
+        if (inFlight == 0) continue;
+
+        if (!ring->failed) {
+            int result = ring->enter(static_cast<unsigned>(unsubmitted.size()), 1);
+            if (result >= 0) {
+                unsubmitted.erase(unsubmitted.begin(),
+                                  unsubmitted.begin() + std::min<size_t>(unsubmitted.size(), result));
+                backoff = std::chrono::microseconds(0);
+            } else if (result == -EAGAIN || result == -EBUSY) {
+                // Out of kernel resources or completion space: reap below, then retry a little later
+                backoff = std::min(MAX_BACKOFF, std::max(std::chrono::microseconds(50), backoff * 2));
+            } else {
+                // The ring is unusable. Reads the kernel never took are withdrawn and read blocking;
+                // the ones it took still complete into their buffers.
+                std::cerr << "VFS: io_uring_enter failed: " << std::strerror(-result)
+                          << ", falling back to blocking reads" << std::endl;
+                ring->failed = true;
+                ring->withdraw(static_cast<unsigned>(unsubmitted.size()));
+                inFlight -= static_cast<unsigned>(unsubmitted.size());
+                for (FileRead* request : unsubmitted) waiting.emplace_back(request);
+                unsubmitted.clear();
+                backoff = std::chrono::microseconds(200);
+            }
+        }
+        ring->forEachCompletion([&](uint64_t userData, int32_t bytes) {
+            --inFlight;
+            std::unique_ptr<FileRead> request(reinterpret_cast<FileRead*>(userData));
+            if (bytes <= 0) {
+                std::cerr << "VFS: failed to read " << request->filePath << ": "
+                          << (bytes < 0 ? std::strerror(-bytes) : "unexpected end of file") << std::endl;
+                complete(std::move(request), false);
+                return;
+            }
+            request->offset += static_cast<uint64_t>(bytes);
+            if (request->offset < request->data.storage.size()) {
+                waiting.push_front(std::move(request));
+            } else {
+                complete(std::move(request), true);
+            }
+        });
+        // Without a working enter() nothing blocks until completions arrive, so poll gently
+        if (backoff.count() > 0 && inFlight > 0 && (!ring->failed || waiting.empty())) {
+            std::this_thread::sleep_for(backoff);
+        }
+    }
+#endif
+}
+
+} // namespace SFE
@@ -1,14 +1,22 @@
 // src/core/WindowManager.cpp
 #include "core/WindowManager.hpp"
+#include "rendering/GLExtensions.hpp"
 #include <iostream>
 
 namespace SFE {
 
 // Static callback function needs C linkage if used directly with C API like GLFW
 // Or make it a static member function as done here.
-void WindowManager::framebufferSizeCallback(GLFWwindow* /*window*/, int width, int height) {
-    // Make sure the viewport matches the new window dimensions;
-    glViewport(0, 0, width, height);
+void WindowManager::framebufferSizeCallback(GLFWwindow* window, int width, int height) {
+    if (auto* manager = static_cast<WindowManager*>(glfwGetWindowUserPointer(window))) {
+        manager->width = width;
+        manager->height = height;
+    }
+    // Events are polled on the main thread, which does not hold the context while a
+    // RenderThread runs; the render loop records the viewport from getWidth()/getHeight() then
+    if (glfwGetCurrentContext() == window) {
+        glViewport(0, 0, width, height);
+    }
 }
 
 WindowManager::WindowManager(int width, int height, const std::string& title)
@@ -53,6 +61,7 @@ bool WindowManager::initialize() {
     }
 
     glfwMakeContextCurrent(window);
+    glfwSetWindowUserPointer(window, this);
     glfwSetFramebufferSizeCallback(window, framebufferSizeCallback);
 
     if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
@@ -60,6 +69,7 @@ bool WindowManager::initialize() {
         glfwDestroyWindow(window); // Clean up the created window
         return false;
     }
+    GLExtensions::load((GLADloadproc)glfwGetProcAddress);
 
     glViewport(0, 0, width, height);
     std::cout << "WindowManager initialized successfully." << std::endl;
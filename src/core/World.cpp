@@ -0,0 +1,122 @@
+#include "core/World.hpp"
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+
+namespace SFE {
+
+namespace {
+
+std::mutex componentMutex;
+size_t componentSizes[World::MAX_COMPONENT_TYPES];
+uint32_t componentCount = 0;
+
+} // namespace
+
+uint32_t World::registerComponent(size_t size) {
+    std::lock_guard<std::mutex> lock(componentMutex);
+    if (componentCount == MAX_COMPONENT_TYPES) {
+        throw std::runtime_error("World: more than 64 component types");
+    }
+    componentSizes[componentCount] = size;
+    return componentCount++;
+}
+
+size_t World::getComponentSize(uint32_t component) {
+    std::lock_guard<std::mutex> lock(componentMutex);
+    return componentSizes[component];
+}
+
+World::World() {
+    findOrCreateArchetype(0); // Entities without components
+}
+
+World::~World() = default;
+
+Entity World::createWithMask(ComponentMask mask) {
+    uint32_t archetypeIndex = findOrCreateArchetype(mask);
+    Archetype& archetype = *archetypes[archetypeIndex];
+    uint32_t row = static_cast<uint32_t>(archetype.size());
+    Entity entity = entities.create(EntityLocation{archetypeIndex, row});
+    if (!entity) return {};
+    archetype.entities.push_back(entity);
+    for (Column& column : archetype.columns) column.data.resize(column.data.size() + column.elementSize);
+    return entity;
+}
+
+bool World::destroy(Entity entity) {
+    const EntityLocation* location = entities.get(entity);
+    if (!location) return false;
+    removeRow(location->archetype, location->row);
+    entities.destroy(entity);
+    return true;
+}
+
+void World::clear() {
+    entities.clear();
+    for (auto& archetype : archetypes) {
+        archetype->entities.clear();
+        for (Column& column : archetype->columns) column.data.clear();
+    }
+}
+
+uint32_t World::findOrCreateArchetype(ComponentMask mask) {
+    auto it = std::lower_bound(archetypeIndex.begin(), archetypeIndex.end(), std::make_pair(mask, 0u),
+                               [](const auto& a, const auto& b) { return a.first < b.first; });
+    if (it != archetypeIndex.end() && it->first == mask) return it->second;
+
+    auto archetype = std::make_unique<Archetype>();
+    archetype->mask = mask;
+    std::fill(std::begin(archetype->columnOf), std::end(archetype->columnOf), uint8_t{0xFF});
+    for (uint32_t component = 0; component < MAX_COMPONENT_TYPES; ++component) {
+        if (!(mask & (ComponentMask{1} << component))) continue;
+        archetype->columnOf[component] = static_cast<uint8_t>(archetype->columns.size());
+        archetype->columns.push_back({component, getComponentSize(component), {}});
+    }
+    uint32_t index = static_cast<uint32_t>(archetypes.size());
+    archetypes.push_back(std::move(archetype));
+    archetypeIndex.insert(it, {mask, index});
+    return index;
+}
+
+void World::moveEntity(Entity entity, ComponentMask mask) {
+    EntityLocation* location = entities.get(entity);
+    uint32_t targetIndex = findOrCreateArchetype(mask);
+    Archetype& source = *archetypes[location->archetype];
+    Archetype& target = *archetypes[targetIndex];
+    uint32_t targetRow = static_cast<uint32_t>(target.size());
+
+    target.entities.push_back(entity);
+    for (Column& column : target.columns) {
+        column.data.resize(column.data.size() + column.elementSize); // Zeroed
+        uint8_t sourceColumn = source.columnOf[column.component];
+        if (sourceColumn != 0xFF) {
+            std::memcpy(column.at(targetRow), source.columns[sourceColumn].at(location->row), column.elementSize);
+        }
+    }
+    removeRow(location->archetype, location->row);
+    *location = {targetIndex, targetRow};
+}
+
+void World::removeRow(uint32_t archetypeIndex, uint32_t row) {
+    Archetype& archetype = *archetypes[archetypeIndex];
+    uint32_t last = static_cast<uint32_t>(archetype.size() - 1);
+    if (row != last) {
+        Entity moved = archetype.entities[last];
+        archetype.entities[row] = moved;
+        for (Column& column : archetype.columns) std::memcpy(column.at(row), column.at(last), column.elementSize);
+        entities.get(moved)->row = row;
+    }
+    archetype.entities.pop_back();
+    for (Column& column : archetype.columns) column.data.resize(column.data.size() - column.elementSize);
+}
+
+void* World::componentData(Entity entity, uint32_t component) {
+    const EntityLocation* location = entities.get(entity);
+    if (!location) return nullptr;
+    Archetype& archetype = *archetypes[location->archetype];
+    uint8_t column = archetype.columnOf[component];
+    return column == 0xFF ? nullptr : archetype.columns[column].at(location->row);
+}
+
+} // namespace SFE
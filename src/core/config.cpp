@@ -1,5 +1,6 @@
 #include "config.h"
 #include "utils/log.h"
+#include "core/VFS.hpp"
 #include <fstream>
 #include <nlohmann/json.hpp>
 #include <filesystem>
@@ -7,15 +8,15 @@
 namespace sfe {
 
 bool Config::loadGamepadBindings(const std::string& path) const {
-    std::ifstream file(path);
-    if (!file.is_open()) {
+    SFE::AssetData file;
+    if (!SFE::VFS::getInstance().read(path, file)) {
         Log::error("Failed to open gamepad config: " + path);
         return false;
     }
 
     try {
-        nlohmann::json j;
-        file >> j;
+        std::string_view text = file.getText();
+        nlohmann::json j = nlohmann::json::parse(text.begin(), text.end());
 
         // Create temporary maps for validation
         std::map<SDL_GameControllerButton, std::string> newButtonMap;
@@ -18,7 +18,7 @@ public:
     explicit Config(Gamepad* gamepad = nullptr) : gamepad_(gamepad) {}
 
     /// @brief Loads gamepad bindings from a JSON file
-    /// @param path File path (e.g., "resources/config/gamepad.json")
+    /// @param path Path resolved through SFE::VFS (e.g., "resources/config/gamepad.json")
     /// @return True on success, false on error
     bool loadGamepadBindings(const std::string& path) const;
 
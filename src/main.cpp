@@ -4,23 +4,51 @@
 #include "core/WindowManager.hpp"
 #include "core/Camera.hpp"
 #include "core/InputManager.hpp"
+#include "core/SceneComponents.hpp"
 #include "core/SceneNode.hpp"
+#include "core/SystemScheduler.hpp"
+#include "core/World.hpp"
+#include "core/FixedTimestep.hpp"
+#include "core/FrameArena.hpp"
+#include "core/MemoryTracker.hpp"
+#include "core/JobSystem.hpp"
+#include "core/VFS.hpp"
+#include "core/InitGraph.hpp"
 #include "rendering/Shader.hpp"
 #include "rendering/Mesh.hpp"
 #include "rendering/InstancedMesh.hpp"
+#include "rendering/GeometryArena.hpp"
+#include "rendering/GpuInstanceCuller.hpp"
 #include "rendering/TextRenderer.hpp"
 #include "rendering/Texture.hpp"
 #include "rendering/ShaderManager.hpp"
+#include "rendering/ResourceRegistry.hpp"
+#include "rendering/OcclusionCuller.hpp"
+#include "rendering/SceneBatcher.hpp"
+#include "rendering/TextureArrayPool.hpp"
+#include "rendering/GLExtensions.hpp"
 #include "core/Logger.hpp"
+#include "core/Profiler.hpp"
+#include "rendering/GpuProfiler.hpp"
+#include "rendering/RenderStats.hpp"
+#include "rendering/RenderThread.hpp"
 #include "core/ScreenshotManager.hpp"
 #include <vector>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
 #include <iostream> // Include for potential debug output
 #include <sstream>
 #include <iomanip>
 #include <memory>
+#include <memory_resource>
 #include <filesystem>
+#include <fstream>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
 
 // Timing variables (moved outside main for clarity)
 float deltaTime = 0.0f;
@@ -30,20 +58,344 @@ float lastFrame = 0.0f;
 struct PerformanceMetrics {
     float textRenderTime = 0.0f;
     float sceneRenderTime = 0.0f;
-    int textDrawCalls = 0;
-    int totalCharacters = 0;
 };
 
 struct AutomatedTestConfig {
     bool enabled = false;
     float duration = 10.0f;  // Test duration in seconds
     float screenshotInterval = 1.0f;  // Screenshot interval in seconds
+    std::string screenshotExtension = ".png";  // .png, .qoi or .raw (see ScreenshotManager)
     std::string outputDir = "test_results";
     float lastScreenshotTime = 0.0f;
     float testStartTime = 0.0f;
 };
 
+// Everything the fixed-rate simulation advances. Rendering never reads it directly, only an
+// interpolation between the last two ticks, so motion stays smooth at any frame rate.
+struct SimulationState {
+    glm::vec3 cameraPosition = glm::vec3(0.0f);
+};
+
+static SimulationState interpolate(const SimulationState& previous, const SimulationState& current, float alpha) {
+    SimulationState result;
+    result.cameraPosition = previous.cameraPosition + (current.cameraPosition - previous.cameraPosition) * alpha;
+    return result;
+}
+
+// Component-wise blend; close enough to the true rotation for the few degrees a tick turns
+static void interpolate(const std::vector<glm::mat4>& previous, const std::vector<glm::mat4>& current, float alpha,
+                        std::vector<glm::mat4>& result) {
+    result.resize(current.size());
+    for (size_t i = 0; i < current.size(); ++i) {
+        for (int column = 0; column < 4; ++column) {
+            result[i][column] = previous[i][column] + (current[i][column] - previous[i][column]) * alpha;
+        }
+    }
+}
+
+// Heap traffic per MemoryTracker tag over the measured frames of the test run
+struct MemoryBenchmark {
+    uint64_t frames = 0;
+    SFE::MemoryTracker::FrameStats sum; // Counts summed over frames, peakBytes the highest seen
+
+    void add(const SFE::MemoryTracker::FrameStats& frame) {
+        ++frames;
+        for (size_t i = 0; i < static_cast<size_t>(SFE::MemoryTag::Count); ++i) {
+            sum.tags[i].allocations += frame.tags[i].allocations;
+            sum.tags[i].frees += frame.tags[i].frees;
+            sum.tags[i].bytes += frame.tags[i].bytes;
+            sum.tags[i].liveBytes = frame.tags[i].liveBytes;
+            sum.tags[i].peakBytes = std::max(sum.tags[i].peakBytes, frame.tags[i].peakBytes);
+        }
+    }
+
+    double getAllocationsPerFrame() const {
+        return frames > 0 ? static_cast<double>(sum.total().allocations) / frames : 0.0;
+    }
+};
+
+static void appendMemoryTagJson(std::ostream& out, const SFE::MemoryTracker::TagStats& tag, uint64_t frames) {
+    double perFrame = frames > 0 ? 1.0 / frames : 0.0;
+    out << "{\"allocations_per_frame\":" << tag.allocations * perFrame << ",\"bytes_per_frame\":"
+        << tag.bytes * perFrame << ",\"live_bytes\":" << tag.liveBytes << ",\"peak_bytes\":" << tag.peakBytes << "}";
+}
+
+// Summary of the automated test run for tooling: frame rate plus per-frame render statistics,
+// the startup timeline, and heap traffic when allocation tracking is compiled in
+static bool writeBenchmarkReport(const std::string& path, float duration, const SFE::RenderStats::Summary& stats,
+                                 const MemoryBenchmark& memory, const SFE::InitGraph& startup) {
+    std::ofstream file(path, std::ios::trunc);
+    if (!file.is_open()) return false;
+    double averageFps = duration > 0.0f ? stats.frames / duration : 0.0;
+    file << "{\"duration_s\":" << duration << ",\"average_fps\":" << averageFps
+         << ",\"render_stats\":" << SFE::RenderStats::toJson(stats) << ",\"startup\":" << startup.toJson();
+    if (SFE::MemoryTracker::isEnabled()) {
+        file << ",\"memory\":{\"frames\":" << memory.frames << ",\"total\":";
+        appendMemoryTagJson(file, memory.sum.total(), memory.frames);
+        for (size_t i = 0; i < static_cast<size_t>(SFE::MemoryTag::Count); ++i) {
+            file << ",\"" << SFE::getMemoryTagName(static_cast<SFE::MemoryTag>(i)) << "\":";
+            appendMemoryTagJson(file, memory.sum.tags[i], memory.frames);
+        }
+        file << "}";
+    }
+    file << "}\n";
+    return file.good();
+}
+
+// Once the first frame has been presented: the startup timeline on the console, the time to
+// first frame in the log, and the timeline as JSON next to it
+static void reportStartup(SFE::InitGraph& startup, SFE::Logger& logger) {
+    startup.mark("First frame");
+    std::cout << startup.formatReport();
+    logger.logMessage("Time to first frame: " + std::to_string(startup.getMarkMs("First frame")) + " ms");
+    std::ofstream file("test_results/startup.json", std::ios::trunc);
+    file << startup.toJson() << "\n";
+}
+
+// Engine objects that recorded frames call into. Once the RenderThread has started only the
+// render thread touches them.
+struct RenderResources {
+    SFE::InstancedMesh* cubeMesh = nullptr;
+    SFE::GpuInstanceCuller* instanceCuller = nullptr;
+    SFE::SceneBatcher* sceneBatcher = nullptr;
+    SFE::OcclusionCuller* occlusionCuller = nullptr;
+    std::vector<glm::vec3> occluderPositions; // Cube geometry, shared by every occluder
+    std::vector<uint32_t> occluderIndices;
+    SFE::TextRenderer* textRenderer = nullptr;
+    std::vector<glm::mat4> instanceTransforms; // Reused by every cube update
+    SFE::LinearArena arena{16 * 1024}; // Render thread strings, reset every replayed frame
+    SFE::RenderStats::Counters textStatsStart;
+    SFE::RenderStats::Counters lastTextStats;
+};
+
+// Arguments of the RenderCommandBuffer calls below: POD, with pointers into the frame's buffer
+
+struct CubeUpdate {
+    RenderResources* resources;
+    const glm::mat4* transforms;
+    size_t count;
+    SFE::Camera camera;
+    float viewportHeight;
+};
+
+struct CubeDraw {
+    RenderResources* resources;
+    SFE::ShaderHandle shader;
+    glm::mat4 viewProjection;
+};
+
+// A drawable entity as the simulation left it for this frame
+struct SceneEntity {
+    glm::mat4 model;
+    SFE::MeshInstance instance;
+};
+
+struct SceneDraw {
+    RenderResources* resources;
+    SFE::ShaderHandle shader; // For entities without a material
+    glm::mat4 view;
+    glm::mat4 projection;
+    const SceneEntity* entities;
+    size_t count;
+    const glm::mat4* occluders; // Model matrices of the cubes
+    size_t occluderCount;
+};
+
+// Size of textureArrayHandles in shaders/simple_bindless.frag
+constexpr uint32_t MAX_BINDLESS_TEXTURE_ARRAYS = 16;
+
+struct CubeTextures {
+    SFE::ShaderHandle shader;
+    uint32_t array; // Bound to unit 0 when not bindless
+    bool bindless;
+};
+
+struct TextLine {
+    const char* text;
+    float x, y, scale;
+    glm::vec3 color;
+};
+
+struct TextBatch {
+    RenderResources* resources;
+    const TextLine* lines;
+    size_t count;
+    glm::mat4 projection;
+};
+
+struct RenderOverlay {
+    RenderResources* resources;
+    glm::mat4 projection;
+    float textMetricsY;
+    float statsX;
+};
+
+struct TextSectionEnd {
+    RenderResources* resources;
+    int fps;
+    float sceneRenderTime;
+    float textRenderTime;
+    bool stressTest;
+};
+
+struct ScreenshotRequest {
+    const char* path;
+    int width, height;
+};
+
+static void beginRenderFrame(RenderResources* const& resources) {
+    // GPU zones and render statistics are per replayed frame, so they advance on this thread
+    resources->arena.reset();
+    SFE::GpuProfiler::getInstance().beginFrame();
+    SFE::RenderStats::getInstance().endFrame();
+    SFE::ScreenshotManager::getInstance().update();
+}
+
+static void beginRenderZone(const char* const& name) {
+    SFE_PROFILE_BEGIN(name);
+    SFE_GPU_PROFILE_BEGIN(name);
+}
+
+static void endRenderZone(const char* const& /*name*/) {
+    SFE_GPU_PROFILE_END();
+    SFE_PROFILE_END();
+}
+
+static void updateCubes(const CubeUpdate& update) {
+    if (!update.transforms) return;
+    auto& transforms = update.resources->instanceTransforms;
+    transforms.assign(update.transforms, update.transforms + update.count);
+    update.resources->cubeMesh->updateInstanceData(transforms, update.camera, update.viewportHeight);
+}
+
+static void drawCubes(const CubeDraw& draw) {
+    const SFE::Shader* shader = SFE::ResourceRegistry::getInstance().get(draw.shader);
+    if (!shader) return;
+    // The program, its uniforms and the texture were bound by the packets before this call
+    draw.resources->cubeMesh->applyVertexDecode(*shader);
+    draw.resources->instanceCuller->beginFrame(draw.viewProjection);
+    draw.resources->cubeMesh->drawInstanced(*draw.resources->instanceCuller, *shader);
+}
+
+static void drawSceneEntities(const SceneDraw& draw) {
+    if (!draw.entities) return;
+    RenderResources& resources = *draw.resources;
+    // Entities hidden behind the cubes are dropped at submit()
+    SFE::OcclusionCuller& culler = *resources.occlusionCuller;
+    culler.begin(draw.projection * draw.view);
+    if (draw.occluders) {
+        for (size_t i = 0; i < draw.occluderCount; ++i) {
+            culler.addOccluder(resources.occluderPositions.data(), resources.occluderIndices.data(),
+                               static_cast<uint32_t>(resources.occluderIndices.size()), draw.occluders[i]);
+        }
+    }
+    culler.end();
+
+    SFE::SceneBatcher& batcher = *resources.sceneBatcher;
+    batcher.setOcclusionCuller(&culler);
+    batcher.begin(draw.view, draw.projection);
+    for (size_t i = 0; i < draw.count; ++i) batcher.submit(draw.entities[i].model, draw.entities[i].instance);
+    // The cube shader's lighting uniforms and texture arrays are still bound from the cube draw
+    batcher.draw(draw.shader);
+}
+
+static void bindCubeTextures(const CubeTextures& textures) {
+    SFE::ResourceRegistry& registry = SFE::ResourceRegistry::getInstance();
+    SFE::TextureArrayPool& textureArrays = registry.getTextureArrays();
+    if (!textures.bindless) {
+        textureArrays.bind(textures.array, 0);
+        return;
+    }
+    // Every array at once; each instance picks its own through its TextureSlice
+    const SFE::Shader* shader = registry.get(textures.shader);
+    if (!shader) return;
+    glm::uvec2 handles[MAX_BINDLESS_TEXTURE_ARRAYS];
+    uint32_t count = textureArrays.getBindlessHandles(handles, MAX_BINDLESS_TEXTURE_ARRAYS);
+    if (count == 0) return;
+    glUniform2uiv(glGetUniformLocation(shader->getID(), "textureArrayHandles"), static_cast<GLsizei>(count),
+                  glm::value_ptr(handles[0]));
+}
+
+static void drawText(const TextBatch& batch) {
+    if (!batch.lines || batch.count == 0) return;
+    SFE::TextRenderer& textRenderer = *batch.resources->textRenderer;
+    for (size_t i = 0; i < batch.count; ++i) {
+        const TextLine& line = batch.lines[i];
+        textRenderer.addToBatch(line.text, line.x, line.y, line.scale, line.color);
+    }
+    textRenderer.renderBatch(batch.projection);
+}
+
+static void beginTextSection(RenderResources* const& resources) {
+    beginRenderZone("Text");
+    resources->textStatsStart = SFE::RenderStats::getInstance().getCurrent();
+}
+
+static void drawRenderOverlay(const RenderOverlay& overlay) {
+    SFE::TextRenderer& textRenderer = *overlay.resources->textRenderer;
+    const glm::vec3 grey(0.8f, 0.8f, 0.8f);
+
+    SFE::LinearArena& arena = overlay.resources->arena;
+
+    // Text work of the previous frame, continuing the performance metrics block
+    const SFE::RenderStats::Counters& textStats = overlay.resources->lastTextStats;
+    textRenderer.addToBatch(arena.format("Text Draw Calls: %u", textStats.drawCalls), 10.0f,
+                            overlay.textMetricsY, 1.0f, grey);
+    textRenderer.addToBatch(arena.format("Total Characters: %llu", static_cast<unsigned long long>(textStats.triangles / 2)),
+                            10.0f, overlay.textMetricsY + 25.0f, 1.0f, grey);
+
+    // Render statistics of the last complete frame
+    const SFE::RenderStats::Counters& frameStats = SFE::RenderStats::getInstance().getLastFrame();
+    const char* statsInfo[] = {
+        arena.format("Draws: %u (%u indirect)", frameStats.drawCalls, frameStats.indirectDrawCalls),
+        arena.format("Triangles: %llu  Instances: %llu", static_cast<unsigned long long>(frameStats.triangles),
+                     static_cast<unsigned long long>(frameStats.instances)),
+        arena.format("Binds: %u programs, %u VAOs, %u textures", frameStats.programBinds,
+                     frameStats.vertexArrayBinds, frameStats.textureBinds),
+        arena.format("Uploads: %llu KB buffers, %llu KB textures",
+                     static_cast<unsigned long long>(frameStats.bufferBytesUploaded / 1024),
+                     static_cast<unsigned long long>(frameStats.textureBytesUploaded / 1024)),
+        arena.format("Entities: %u of %u drawn in %zu batches, %u occluded",
+                     overlay.resources->sceneBatcher->getVisibleCount(),
+                     overlay.resources->sceneBatcher->getSubmittedCount(),
+                     overlay.resources->sceneBatcher->getBatches().size(),
+                     overlay.resources->sceneBatcher->getOccludedCount())
+    };
+    float yPos = 30.0f;
+    for (const char* text : statsInfo) {
+        textRenderer.addToBatch(text, overlay.statsX, yPos, 1.0f, grey);
+        yPos += 25.0f;
+    }
+    textRenderer.renderBatch(overlay.projection);
+}
+
+static void endTextSection(const TextSectionEnd& end) {
+    // Two triangles per glyph
+    RenderResources& resources = *end.resources;
+    resources.lastTextStats =
+        SFE::RenderStats::difference(SFE::RenderStats::getInstance().getCurrent(), resources.textStatsStart);
+    endRenderZone("Text");
+
+    SFE::Logger::getInstance().logPerformanceMetrics(end.fps, end.sceneRenderTime, end.textRenderTime,
+                                                     static_cast<int>(resources.lastTextStats.drawCalls),
+                                                     static_cast<int>(resources.lastTextStats.triangles / 2),
+                                                     end.stressTest);
+}
+
+static void captureScreenshot(const ScreenshotRequest& request) {
+    if (!request.path) return;
+    auto& logger = SFE::Logger::getInstance();
+    if (SFE::ScreenshotManager::getInstance().captureScreenshot(request.path, request.width, request.height)) {
+        logger.logMessage(std::string("Screenshot queued: ") + request.path);
+    } else {
+        logger.logMessage(std::string("Screenshot skipped, readback slots busy: ") + request.path);
+    }
+}
+
 int main() {
+    // Time zero of the startup report
+    const auto startTime = std::chrono::steady_clock::now();
+
     // Create output directory for test results
     std::filesystem::create_directories("test_results");
     std::filesystem::create_directories("test_results/screenshots");
@@ -52,16 +404,84 @@ int main() {
     auto& logger = SFE::Logger::getInstance();
     logger.initialize("test_results/performance_log.csv");
 
+    // CPU profiler; SFE_PROFILE_TRACE=<file.json> records a Chrome trace of the whole run,
+    // start-up included
+    auto& profiler = SFE::Profiler::getInstance();
+    profiler.setThreadName("Main");
+    const char* tracePath = std::getenv("SFE_PROFILE_TRACE");
+    if (tracePath) profiler.startCapture();
+
+    // Assets resolve through the VFS: the pack built by the pack_assets target first, then the
+    // working directory. SFE_ASSET_PACK overrides the pack path, SFE_VFS_BACKEND=threads skips
+    // io_uring.
+    auto& vfs = SFE::VFS::getInstance();
+    if (const char* vfsBackend = std::getenv("SFE_VFS_BACKEND"); vfsBackend && std::strcmp(vfsBackend, "threads") == 0) {
+        vfs.setBackend(SFE::VFS::Backend::ThreadPool);
+    }
+    vfs.mountDirectory("", ".");
+    const char* assetPackPath = std::getenv("SFE_ASSET_PACK");
+    if (!assetPackPath) assetPackPath = "assets.sfp";
+    if (std::filesystem::exists(assetPackPath) && vfs.mountPack("", assetPackPath)) {
+        std::cout << "Asset pack: " << assetPackPath << " mounted" << std::endl;
+    }
+    // Start reading everything startup needs while the window and GL context come up; the
+    // loaders below take the bytes from the preload cache
+    const char* startupAssets[] = {
+        "shaders/simple.vert", "shaders/simple_array.frag", "shaders/simple_bindless.frag",
+        "shaders/text2d.vert", "shaders/text2d.frag", "shaders/cull_instances.comp",
+        "assets/meshes/cube.sfm", "assets/textures/colortest.sft",
+        "assets/fonts/consolas.png", "assets/fonts/consolas.fnt",
+    };
+    for (const char* asset : startupAssets) vfs.preload(asset);
+
+    // Start-up is a dependency graph: the window and everything that needs its context run on
+    // this thread, reading and decoding files runs on the job system in the meantime. The
+    // timeline is reported once the first frame has been presented.
+    SFE::InitGraph startup(startTime);
+    using InitThread = SFE::InitGraph::Thread;
+
     // Use SFE namespace for engine classes
     SFE::WindowManager window(800, 600, "Silent Forge Engine");
-    if (!window.initialize()) {
-        std::cerr << "Failed to initialize WindowManager." << std::endl;
-        return -1;
-    }
+    auto windowTask = startup.add("Window", InitThread::Main, [&] {
+        if (!window.initialize()) {
+            std::cerr << "Failed to initialize WindowManager." << std::endl;
+            return false;
+        }
+        return true;
+    });
+
+    // Textures, meshes and shaders live in the registry; the frame code passes handles around
+    auto& registry = SFE::ResourceRegistry::getInstance();
+    SFE::TextureArrayPool& textureArrays = registry.getTextureArrays();
+
+    // Prefer the cooked texture (built by texture_cooker): compressed, with its mips filtered
+    // offline. Failing both, the upload below makes simple color patterns.
+    SFE::TextureSource cubeTextureSource;
+    auto decodeTextureTask = startup.add("Decode cube texture", InitThread::Worker, [&] {
+        if (!SFE::TextureArrayPool::loadSource("assets/textures/colortest.sft", cubeTextureSource)) {
+            SFE::TextureArrayPool::loadSource("assets/textures/colortest.png", cubeTextureSource);
+        }
+        return true;
+    });
+
+    SFE::TextRenderer textRenderer;
+    auto loadFontTask = startup.add("Load font", InitThread::Worker, [&] {
+        return textRenderer.loadFont("assets/fonts/consolas.png", "assets/fonts/consolas.fnt");
+    });
 
     // Create and load shader using ShaderManager
     auto& shaderManager = SFE::ShaderManager::getInstance();
-    auto shader = shaderManager.loadShader("simple", "shaders/simple.vert", "shaders/simple.frag");
+    // The cubes sample texture arrays, so cubes with different textures stay one instanced draw.
+    // With ARB_bindless_texture they address every array through resident handles instead.
+    bool bindlessTextures = false;
+    SFE::ShaderHandle shader;
+    startup.add("Shaders", InitThread::Main, [&] {
+        bindlessTextures = SFE::GLExtensions::hasBindlessTexture();
+        shader = bindlessTextures
+                     ? shaderManager.loadShader("simple_bindless", "shaders/simple.vert", "shaders/simple_bindless.frag")
+                     : shaderManager.loadShader("simple_array", "shaders/simple.vert", "shaders/simple_array.frag");
+        return registry.get(shader) != nullptr;
+    }, {windowTask});
 
     // Create cube vertices with proper normals
     // Using 8 vertices with averaged normals for smoother lighting
@@ -93,44 +513,141 @@ int main() {
         3, 2, 6,  6, 7, 3
     };
 
-    // Create instanced mesh instead of regular mesh
-    auto cubeMesh = std::make_shared<SFE::InstancedMesh>(vertices, indices);
-
-    // Load texture
-    auto texture = std::make_shared<SFE::Texture>();
-    if (!texture->loadFromFile("assets/textures/colortest.png")) {
-        std::cerr << "Failed to load texture from PNG, creating a simple color pattern" << std::endl;
-        
-        // Create a simple 2x2 texture with red, green, blue, and yellow pixels
-        unsigned char data[] = {
-            255, 0, 0, 255,     0, 255, 0, 255,
-            0, 0, 255, 255,     255, 255, 0, 255
+    // Create instanced mesh instead of regular mesh; prefer the cooked asset (built by mesh_cooker)
+    auto cubeMesh = std::make_shared<SFE::InstancedMesh>();
+    startup.add("Cube mesh", InitThread::Main, [&] {
+        if (!cubeMesh->loadFromFile("assets/meshes/cube.sfm")) {
+            std::cerr << "Falling back to built-in cube geometry" << std::endl;
+            cubeMesh->setVertices(vertices, indices);
+        }
+        return true;
+    }, {windowTask});
+
+    // GPU frustum culling of the cube instances. SFE_GPU_CULLING=off|tf|compute picks the path
+    // (default: compute, falling back to transform feedback); SFE_GPU_CULLING_VERIFY=1 checks
+    // every result against the CPU frustum test.
+    SFE::GpuInstanceCuller instanceCuller;
+    const char* cullingMode = std::getenv("SFE_GPU_CULLING");
+    if (!cullingMode || std::strcmp(cullingMode, "off") != 0) {
+        startup.add("GPU culling", InitThread::Main, [&] {
+            bool preferTransformFeedback = cullingMode && std::strcmp(cullingMode, "tf") == 0;
+            instanceCuller.initialize(preferTransformFeedback ? SFE::GpuInstanceCuller::Mode::TransformFeedback
+                                                              : SFE::GpuInstanceCuller::Mode::Compute);
+            const char* verifyCulling = std::getenv("SFE_GPU_CULLING_VERIFY");
+            instanceCuller.setVerification(verifyCulling && std::strcmp(verifyCulling, "0") != 0);
+            return true;
+        }, {windowTask});
+    }
+
+    // Load textures into array layers; cube i uses cubeTextures[i % size]
+    std::vector<SFE::TextureSlice> cubeTextures;
+    startup.add("Upload cube texture", InitThread::Main, [&] {
+        SFE::TextureSlice fileTexture = textureArrays.addSource(cubeTextureSource);
+        cubeTextureSource = SFE::TextureSource();
+        if (fileTexture.isValid()) {
+            cubeTextures.push_back(fileTexture);
+            return true;
+        }
+        std::cerr << "Failed to load texture from PNG, creating simple color patterns" << std::endl;
+
+        // 2x2 textures of red, green, blue and yellow pixels, rotated once per layer
+        const unsigned char colors[4][4] = {
+            {255, 0, 0, 255}, {0, 255, 0, 255}, {0, 0, 255, 255}, {255, 255, 0, 255}
         };
-        
-        glGenTextures(1, &texture->getID());
-        glBindTexture(GL_TEXTURE_2D, texture->getID());
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 2, 2, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-        glBindTexture(GL_TEXTURE_2D, 0);
+        for (int layer = 0; layer < 4; ++layer) {
+            unsigned char data[16];
+            for (int pixel = 0; pixel < 4; ++pixel) std::memcpy(data + pixel * 4, colors[(pixel + layer) % 4], 4);
+            cubeTextures.push_back(textureArrays.add(data, 2, 2, 4));
+        }
+        return true;
+    }, {windowTask, decodeTextureTask});
+
+    startup.add("Text renderer", InitThread::Main, [&] {
+        if (!textRenderer.initialize()) {
+            std::cerr << "Failed to initialize text renderer" << std::endl;
+            return false;
+        }
+        return true;
+    }, {windowTask, loadFontTask});
+
+    startup.run();
+    if (startup.getStatus(windowTask) != SFE::InitGraph::Status::Done) return -1;
+
+    // Without bindless textures one array is bound for the whole draw
+    const uint16_t cubeTextureArray = cubeTextures.empty() ? 0 : cubeTextures[0].array;
+    cubeTextures.erase(std::remove_if(cubeTextures.begin(), cubeTextures.end(),
+                                      [&](SFE::TextureSlice slice) {
+                                          return !slice.isValid() || (!bindlessTextures && slice.array != cubeTextureArray);
+                                      }),
+                       cubeTextures.end());
+
+    // The cubes are entities; the orbiting ones carry an Orbit that the scene systems advance
+    // (core/SceneComponents.hpp) every simulation tick
+    SFE::World world;
+    SFE::SystemScheduler sceneSystems;
+    SFE::addSceneSystems(sceneSystems);
+    const std::vector<SFE::Entity> cubes = {
+        SFE::createTransformEntity(world, glm::vec3(0.0f)),
+        SFE::createTransformEntity(world, glm::vec3(-2.0f, 0.0f, 0.0f), glm::vec3(0.5f)),
+        SFE::createTransformEntity(world, glm::vec3(2.0f, 0.0f, 0.0f), glm::vec3(0.5f))};
+    world.set(cubes[1], SFE::Orbit{glm::vec3(0.0f), 2.0f, 3.14159265f, 0.5f}); // Opposite the right one
+    world.set(cubes[2], SFE::Orbit{glm::vec3(0.0f), 2.0f, 0.0f, 0.5f});
+
+    // A ring of spinning crates around them, drawn through the SceneBatcher: frustum-culled per
+    // entity and batched into one instanced draw per mesh and texture
+    SFE::MeshHandle crateMesh = registry.loadMesh("assets/meshes/cube.sfm");
+    if (!crateMesh) crateMesh = registry.addMesh(SFE::Mesh(vertices, indices));
+    constexpr int CRATE_COUNT = 24;
+    for (int i = 0; i < CRATE_COUNT; ++i) {
+        float angle = 6.2831853f * i / CRATE_COUNT;
+        SFE::Entity crate = SFE::createTransformEntity(
+            world, glm::vec3(4.5f * std::cos(angle), -1.0f, 4.5f * std::sin(angle)), glm::vec3(0.4f));
+        world.set(crate, SFE::Spin{glm::vec3(0.0f, 30.0f + 5.0f * i, 0.0f)});
+        SFE::MeshInstance instance;
+        instance.mesh = crateMesh;
+        if (!cubeTextures.empty()) instance.textureSlice = cubeTextures[i % cubeTextures.size()];
+        world.set(crate, instance);
     }
+    sceneSystems.run(world, 0.0f);
 
-    // Store transformation matrices for all cubes
-    std::vector<glm::mat4> cubeTransforms;
-    
-    // Center cube
-    glm::mat4 centerTransform = glm::mat4(1.0f);
-    cubeTransforms.push_back(centerTransform);
-    
-    // Left orbiting cube
-    glm::mat4 leftTransform = glm::translate(glm::mat4(1.0f), glm::vec3(-2.0f, 0.0f, 0.0f));
-    leftTransform = glm::scale(leftTransform, glm::vec3(0.5f, 0.5f, 0.5f));
-    cubeTransforms.push_back(leftTransform);
-    
-    // Right orbiting cube
-    glm::mat4 rightTransform = glm::translate(glm::mat4(1.0f), glm::vec3(2.0f, 0.0f, 0.0f));
-    rightTransform = glm::scale(rightTransform, glm::vec3(0.5f, 0.5f, 0.5f));
-    cubeTransforms.push_back(rightTransform);
+    // Model matrices of everything drawn, the cubes first and then every entity with a
+    // MeshInstance, as of the last two ticks. Frames draw a blend of the two.
+    std::vector<glm::mat4> previousTransforms, currentTransforms, renderTransforms;
+    auto gatherTransforms = [&](std::vector<glm::mat4>& transforms) {
+        transforms.clear();
+        for (SFE::Entity cube : cubes) transforms.push_back(world.get<SFE::LocalToWorld>(cube)->matrix);
+        world.forEachChunk<SFE::LocalToWorld, SFE::MeshInstance>(
+            [&](size_t count, const SFE::Entity*, const SFE::LocalToWorld* matrices, const SFE::MeshInstance*) {
+                for (size_t i = 0; i < count; ++i) transforms.push_back(matrices[i].matrix);
+            });
+    };
+    gatherTransforms(previousTransforms);
+    gatherTransforms(currentTransforms);
+    renderTransforms = currentTransforms;
+
+    // The instance stream carries texture slices in the matrices; the occluders keep clean copies
+    std::vector<glm::mat4> cubeTransforms(cubes.size());
+    std::vector<glm::mat4> occluderTransforms(cubes.size());
+    auto gatherCubeTransforms = [&]() {
+        std::copy(renderTransforms.begin(), renderTransforms.begin() + cubes.size(), occluderTransforms.begin());
+        cubeTransforms = occluderTransforms;
+        if (cubeTextures.empty()) return;
+        for (size_t i = 0; i < cubeTransforms.size(); ++i) {
+            SFE::setInstanceTextureSlice(cubeTransforms[i], cubeTextures[i % cubeTextures.size()]);
+        }
+    };
+    gatherCubeTransforms();
+
+    // Snapshot of every drawable entity, copied into the frame's command buffer. The iteration
+    // order matches gatherTransforms() as long as no entity is created or changes archetype.
+    std::vector<SceneEntity> sceneEntities;
+    auto gatherSceneEntities = [&]() {
+        sceneEntities.clear();
+        const glm::mat4* transform = renderTransforms.data() + cubes.size();
+        world.forEachChunk<SFE::MeshInstance>([&](size_t count, const SFE::Entity*, const SFE::MeshInstance* instances) {
+            for (size_t i = 0; i < count; ++i) sceneEntities.push_back({*transform++, instances[i]});
+        });
+    };
 
     // Initialize instance data
     cubeMesh->updateInstanceData(cubeTransforms);
@@ -140,10 +657,9 @@ int main() {
     SFE::InputManager input;
     // No initialize method needed, InputManager is ready to use after construction
 
-    SFE::TextRenderer textRenderer;
-    if (!textRenderer.initialize("assets/fonts/consolas.png", "assets/fonts/consolas.fnt")) {
-        std::cerr << "Failed to initialize text renderer" << std::endl;
-    }
+    vfs.clearPreloads();
+    std::cout << "VFS: " << vfs.getAsyncReadCount() << " startup reads, " << vfs.getAsyncBytesRead() / 1024
+              << " KB (" << SFE::VFS::getBackendName(vfs.getBackend()) << ")" << std::endl;
 
     float frameTimes[60] = {0.0f};
     int frameIndex = 0;
@@ -164,21 +680,103 @@ int main() {
     AutomatedTestConfig testConfig;
     testConfig.enabled = true;  // Enable automated testing
     testConfig.testStartTime = static_cast<float>(glfwGetTime());
+    if (const char* screenshotFormat = std::getenv("SFE_SCREENSHOT_FORMAT")) {
+        testConfig.screenshotExtension = std::string(".") + screenshotFormat; // png, qoi or raw
+    }
+
+    // Screenshots are written on a worker thread; results are reported from update()
+    SFE::ScreenshotManager::getInstance().setCompletionCallback([&logger](const std::string& path, bool success) {
+        logger.logMessage((success ? "Screenshot saved: " : "Failed to save screenshot: ") + path);
+    });
+
+    auto& gpuProfiler = SFE::GpuProfiler::getInstance();
+    gpuProfiler.initialize();
+    auto& renderStats = SFE::RenderStats::getInstance();
+
+    // Simulation runs at a fixed 60 Hz. SFE_LOCKSTEP=1 runs exactly one tick per rendered frame,
+    // so the automated test sees the same frames (and screenshots) on every machine.
+    SFE::FixedTimestep timestep(1.0 / 60.0);
+    const char* lockstep = std::getenv("SFE_LOCKSTEP");
+    timestep.setLockstep(lockstep && std::strcmp(lockstep, "0") != 0);
+    SimulationState simulation;
+    simulation.cameraPosition = camera.getPosition();
+    SimulationState previousSimulation = simulation;
+    float previousTestTime = 0.0f;
 
     // Log test start
     logger.logMessage("Starting automated test");
     logger.logMessage("Window size: " + std::to_string(window.getWidth()) + "x" + 
                      std::to_string(window.getHeight()));
 
+    // GL work from here on is recorded into command buffers and replayed on a render thread that
+    // owns the context, one frame behind the simulation. SFE_RENDER_THREAD=0 replays inline.
+    RenderResources renderResources;
+    renderResources.cubeMesh = cubeMesh.get();
+    renderResources.instanceCuller = &instanceCuller;
+    SFE::SceneBatcher sceneBatcher;
+    renderResources.sceneBatcher = &sceneBatcher;
+    // The cubes occlude the crates behind them
+    SFE::OcclusionCuller occlusionCuller;
+    renderResources.occlusionCuller = &occlusionCuller;
+    for (const SFE::Mesh::Vertex& vertex : vertices) renderResources.occluderPositions.push_back(vertex.position);
+    renderResources.occluderIndices.assign(indices.begin(), indices.end());
+    renderResources.textRenderer = &textRenderer;
+    SFE::RenderThread renderThread;
+    const char* renderThreadMode = std::getenv("SFE_RENDER_THREAD");
+    renderThread.start(window.getWindow(), !renderThreadMode || std::strcmp(renderThreadMode, "0") != 0);
+    // Transient per-frame data (HUD strings and lines) comes from a double-buffered arena: it
+    // stays valid while the render thread replays the frame and is dropped in O(1) afterwards
+    SFE::FrameArena frameArena(256 * 1024);
+
+    // Heap allocations are measured once start-up churn has settled. SFE_ALLOCATION_BUDGET
+    // (allocations per frame) makes a test run fail when the steady state exceeds it.
+    constexpr uint64_t MEMORY_WARMUP_FRAMES = 60;
+    MemoryBenchmark memoryBenchmark;
+    const char* allocationBudget = std::getenv("SFE_ALLOCATION_BUDGET");
+    // SFE_STARTUP_BUDGET_MS does the same for the time from main() to the first presented frame
+    const char* startupBudget = std::getenv("SFE_STARTUP_BUDGET_MS");
+    bool startupReported = false;
+
     // Main loop
     while (!window.shouldClose()) {
+        // Close the previous frame's zones; the HUD and CSV report the last complete frame.
+        // Render thread and GPU zones come in a frame or more late and are merged into the same report.
+        profiler.endFrame();
+        metrics.sceneRenderTime = static_cast<float>(profiler.getLastFrame().getZoneMs("Scene") / 1000.0);
+        metrics.textRenderTime = static_cast<float>(profiler.getLastFrame().getZoneMs("Text") / 1000.0);
+        if (SFE::MemoryTracker::isEnabled()) {
+            if (profiler.getLastFrame().frameIndex == MEMORY_WARMUP_FRAMES) {
+                SFE::MemoryTracker::getInstance().resetPeaks();
+            } else if (profiler.getLastFrame().frameIndex > MEMORY_WARMUP_FRAMES) {
+                memoryBenchmark.add(profiler.getLastFrame().memory);
+            }
+        }
+        SFE_PROFILE_SCOPE("Frame");
+
         float currentFrame = static_cast<float>(glfwGetTime());
         deltaTime = currentFrame - lastFrame;
         lastFrame = currentFrame;
 
-        // Check if automated test should end
+        // Advance the simulation by whole ticks; input is sampled once per tick
+        SFE_PROFILE_BEGIN("Simulate");
+        uint32_t ticks = timestep.advance(deltaTime);
+        for (uint32_t tick = 0; tick < ticks; ++tick) {
+            previousSimulation = simulation;
+            std::swap(previousTransforms, currentTransforms);
+            float step = static_cast<float>(timestep.getStep());
+            camera.setPosition(simulation.cameraPosition);
+            input.processInput(window.getWindow(), camera, step);
+            simulation.cameraPosition = camera.getPosition();
+            sceneSystems.run(world, step);
+            gatherTransforms(currentTransforms);
+        }
+        SFE_PROFILE_END();
+
+        // Check if automated test should end. The schedule follows simulation time, which in
+        // lockstep mode is a fixed number of frames.
+        std::string screenshotPath;
         if (testConfig.enabled) {
-            float testElapsedTime = currentFrame - testConfig.testStartTime;
+            float testElapsedTime = static_cast<float>(timestep.getSimulationTime());
             if (testElapsedTime >= testConfig.duration) {
                 logger.logMessage("Automated test completed");
                 break;
@@ -186,22 +784,18 @@ int main() {
 
             // Toggle stress test every 5 seconds
             if (static_cast<int>(testElapsedTime) % 5 == 0 && 
-                static_cast<int>(testElapsedTime) != static_cast<int>(testElapsedTime - deltaTime)) {
+                static_cast<int>(testElapsedTime) != static_cast<int>(previousTestTime)) {
                 showStressTest = !showStressTest;
                 logger.logMessage("Stress test " + std::string(showStressTest ? "enabled" : "disabled"));
             }
+            previousTestTime = testElapsedTime;
 
-            // Capture screenshot at specified intervals
-            if (currentFrame - testConfig.lastScreenshotTime >= testConfig.screenshotInterval) {
-                std::string screenshotPath = "test_results/screenshots/frame_" + 
-                                           std::to_string(static_cast<int>(testElapsedTime)) + ".png";
-                if (SFE::ScreenshotManager::getInstance().captureScreenshot(
-                        screenshotPath, window.getWidth(), window.getHeight())) {
-                    logger.logMessage("Screenshot saved: " + screenshotPath);
-                } else {
-                    logger.logMessage("Failed to save screenshot: " + screenshotPath);
-                }
-                testConfig.lastScreenshotTime = currentFrame;
+            // Capture screenshot at specified intervals (recorded at the end of the frame)
+            if (testElapsedTime - testConfig.lastScreenshotTime >= testConfig.screenshotInterval) {
+                screenshotPath = "test_results/screenshots/frame_" + 
+                                 std::to_string(static_cast<int>(testElapsedTime)) +
+                                 testConfig.screenshotExtension;
+                testConfig.lastScreenshotTime = testElapsedTime;
             }
         }
 
@@ -209,8 +803,9 @@ int main() {
         bool isRPressed = glfwGetKey(window.getWindow(), GLFW_KEY_R) == GLFW_PRESS;
         if (isRPressed && !wasRPressed) {
             std::cout << "Reloading shaders..." << std::endl;
-            shaderManager.reloadAllShaders();
-            shader = shaderManager.getShader("simple");
+            // Compiles on the GL thread once queued frames are done with the old programs, which
+            // are then released there too
+            renderThread.execute([&] { shaderManager.reloadAllShaders(); });
         }
         wasRPressed = isRPressed;
 
@@ -228,119 +823,116 @@ int main() {
         frameIndex = (frameIndex + 1) % 60;
         float avgFrameTime = frameTimeSum / 60.0f;
         int fps = static_cast<int>(1.0f / avgFrameTime);
-        std::stringstream ss;
-        ss << "FPS: " << fps;
-        std::string fpsText = ss.str();
-
-        // Process input
-        input.processInput(window.getWindow(), camera, deltaTime);
-
-        // Update cube transforms
-        float angle = currentFrame * 0.5f;
-        cubeTransforms[1] = glm::translate(glm::mat4(1.0f), 
-            glm::vec3(-2.0f * cos(angle), 0.0f, -2.0f * sin(angle)));
-        cubeTransforms[1] = glm::scale(cubeTransforms[1], glm::vec3(0.5f));
-        
-        cubeTransforms[2] = glm::translate(glm::mat4(1.0f), 
-            glm::vec3(2.0f * cos(angle), 0.0f, 2.0f * sin(angle)));
-        cubeTransforms[2] = glm::scale(cubeTransforms[2], glm::vec3(0.5f));
-        
-        // Update instance data
-        cubeMesh->updateInstanceData(cubeTransforms);
-
-        // Start scene rendering timer
-        float sceneStartTime = static_cast<float>(glfwGetTime());
-
-        // Rendering
-        glClearColor(0.1f, 0.2f, 0.3f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-        // Render 3D scene
-        shader->use();
-        shader->setInt("texture0", 0);
-        shader->setVec3("lightDir", glm::vec3(1.0f, 1.0f, -1.0f));
-        shader->setVec3("viewPos", camera.getPosition());
-        shader->setMat4("view", camera.getViewMatrix());
-        shader->setMat4("projection", glm::perspective(glm::radians(45.0f),
-            static_cast<float>(window.getWidth()) / window.getHeight(), 0.1f, 100.0f));
+        // Render the state between the last two ticks
+        SFE_PROFILE_BEGIN("Update");
+        const SimulationState view = interpolate(previousSimulation, simulation, timestep.getAlpha());
+        SFE::Camera viewCamera = camera;
+        viewCamera.setPosition(view.cameraPosition);
 
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, texture->getID());
-        cubeMesh->drawInstanced(static_cast<unsigned int>(cubeTransforms.size()));
+        interpolate(previousTransforms, currentTransforms, timestep.getAlpha(), renderTransforms);
+        gatherCubeTransforms();
+        gatherSceneEntities();
+        SFE_PROFILE_END();
 
-        metrics.sceneRenderTime = static_cast<float>(glfwGetTime()) - sceneStartTime;
+        // Record the frame. Waits only if the render thread is still on the frame before last.
+        SFE_PROFILE_BEGIN("Record");
+        SFE::RenderCommandBuffer& commands = renderThread.beginFrame();
+        frameArena.beginFrame(); // Its previous user, the frame before last, has been replayed
+        commands.call(beginRenderFrame, &renderResources);
+        commands.viewport(0, 0, window.getWidth(), window.getHeight());
 
-        // Start text rendering timer
-        float textStartTime = static_cast<float>(glfwGetTime());
-        metrics.textDrawCalls = 0;
-        metrics.totalCharacters = 0;
+        // Instance data, bucketed by LOD for the current view
+        commands.call(updateCubes, CubeUpdate{&renderResources,
+                                              commands.copy(cubeTransforms.data(), cubeTransforms.size()),
+                                              cubeTransforms.size(), viewCamera,
+                                              static_cast<float>(window.getHeight())});
+
+        commands.call(beginRenderZone, "Scene");
+        commands.clear(glm::vec4(0.1f, 0.2f, 0.3f, 1.0f), GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        // Render 3D scene
+        glm::mat4 projection = glm::perspective(glm::radians(viewCamera.zoom),
+            static_cast<float>(window.getWidth()) / window.getHeight(), 0.1f, 100.0f);
+        commands.useProgram(registry.get(shader)->getID());
+        commands.setUniform("instanced", 1);
+        if (!bindlessTextures) commands.setUniform("textureArray0", 0);
+        commands.setUniform("lightDir", glm::vec3(1.0f, 1.0f, -1.0f));
+        commands.setUniform("viewPos", viewCamera.getPosition());
+        commands.setUniform("view", viewCamera.getViewMatrix());
+        commands.setUniform("projection", projection);
+        commands.call(bindCubeTextures, CubeTextures{shader, cubeTextureArray, bindlessTextures});
+        commands.call(drawCubes, CubeDraw{&renderResources, shader, projection * viewCamera.getViewMatrix()});
+        commands.call(drawSceneEntities, SceneDraw{&renderResources, shader, viewCamera.getViewMatrix(), projection,
+                                                   commands.copy(sceneEntities.data(), sceneEntities.size()),
+                                                   sceneEntities.size(),
+                                                   commands.copy(occluderTransforms.data(), occluderTransforms.size()),
+                                                   occluderTransforms.size()});
+        commands.call(endRenderZone, "Scene");
+
+        commands.call(beginTextSection, &renderResources);
 
         // Setup text projection
         glm::mat4 ortho = glm::ortho(0.0f, static_cast<float>(window.getWidth()), 
                                     static_cast<float>(window.getHeight()), 0.0f);
-
-        // 1. Title and FPS (cached)
-        textRenderer.renderText("Silent Forge Engine", 10.0f, 30.0f, 1.5f, 
-                              glm::vec3(1.0f, 0.0f, 0.0f), ortho);
-        metrics.totalCharacters += 18; // "Silent Forge Engine"
-
-        textRenderer.renderText(fpsText, 10.0f, 60.0f, 1.2f, 
-                              glm::vec3(0.0f, 1.0f, 0.0f), ortho);
-        metrics.totalCharacters += fpsText.length();
-
-        // 2. Performance metrics
-        std::vector<std::pair<std::string, glm::vec3>> perfInfo = {
-            {"Performance Metrics:", glm::vec3(1.0f, 1.0f, 0.0f)},
-            {"Scene Render Time: " + std::to_string(metrics.sceneRenderTime * 1000.0f) + " ms", 
-             glm::vec3(0.8f, 0.8f, 0.8f)},
-            {"Text Draw Calls: " + std::to_string(metrics.textDrawCalls), 
-             glm::vec3(0.8f, 0.8f, 0.8f)},
-            {"Total Characters: " + std::to_string(metrics.totalCharacters), 
-             glm::vec3(0.8f, 0.8f, 0.8f)}
+        // Text must be a literal or live in the frame arena; the lines are drawn in batches
+        std::pmr::vector<TextLine> hudLines(frameArena.resource());
+        hudLines.reserve(256);
+        size_t flushedLines = 0;
+        auto addText = [&](const char* text, float x, float y, float scale, const glm::vec3& color) {
+            hudLines.push_back({text, x, y, scale, color});
         };
+        auto flushText = [&]() {
+            commands.call(drawText, TextBatch{&renderResources, hudLines.data() + flushedLines,
+                                              hudLines.size() - flushedLines, ortho});
+            flushedLines = hudLines.size();
+        };
+
+        // 1. Title and FPS
+        addText("Silent Forge Engine", 10.0f, 30.0f, 1.5f, glm::vec3(1.0f, 0.0f, 0.0f));
+        addText(frameArena.format("FPS: %d", fps), 10.0f, 60.0f, 1.2f, glm::vec3(0.0f, 1.0f, 0.0f));
+        flushText();
 
-        float yPos = 90.0f;
-        for (const auto& [text, color] : perfInfo) {
-            textRenderer.addToBatch(text, 10.0f, yPos, 1.0f, color);
-            metrics.totalCharacters += text.length();
-            yPos += 25.0f;
+        // 2. Performance metrics; the text draw calls and characters counted on the render
+        // thread follow them (see drawRenderOverlay)
+        const glm::vec3 grey(0.8f, 0.8f, 0.8f);
+        addText("Performance Metrics:", 10.0f, 90.0f, 1.0f, glm::vec3(1.0f, 1.0f, 0.0f));
+        addText(frameArena.format("Scene Render Time: %f ms", metrics.sceneRenderTime * 1000.0f),
+                10.0f, 115.0f, 1.0f, grey);
+        addText(frameArena.format("Scene GPU Time: %f ms", profiler.getLastFrame().getGpuZoneMs("Scene")),
+                10.0f, 140.0f, 1.0f, grey);
+        if (SFE::MemoryTracker::isEnabled()) {
+            // Below the render statistics column
+            SFE::MemoryTracker::TagStats heap = profiler.getLastFrame().memory.total();
+            addText(frameArena.format("Heap: %.2f MB live, %llu allocs (%llu KB) per frame",
+                                      heap.liveBytes / (1024.0 * 1024.0),
+                                      static_cast<unsigned long long>(heap.allocations),
+                                      static_cast<unsigned long long>(heap.bytes / 1024)),
+                    window.getWidth() - 420.0f, 130.0f, 1.0f, grey);
         }
-        textRenderer.renderBatch(ortho);
-        metrics.textDrawCalls++;
+        flushText();
 
         // 3. Camera debug info
-        std::vector<std::pair<std::string, glm::vec3>> debugInfo = {
-            {"Camera Position:", glm::vec3(0.8f, 0.8f, 0.8f)},
-            {"X: " + std::to_string(camera.getPosition().x), glm::vec3(1.0f, 0.8f, 0.8f)},
-            {"Y: " + std::to_string(camera.getPosition().y), glm::vec3(0.8f, 1.0f, 0.8f)},
-            {"Z: " + std::to_string(camera.getPosition().z), glm::vec3(0.8f, 0.8f, 1.0f)}
-        };
-
-        yPos = 190.0f;
-        for (const auto& [text, color] : debugInfo) {
-            textRenderer.addToBatch(text, 10.0f, yPos, 1.0f, color);
-            metrics.totalCharacters += text.length();
-            yPos += 25.0f;
-        }
-        textRenderer.renderBatch(ortho);
-        metrics.textDrawCalls++;
+        const glm::vec3 cameraPosition = viewCamera.getPosition();
+        addText("Camera Position:", 10.0f, 215.0f, 1.0f, grey);
+        addText(frameArena.format("X: %f", cameraPosition.x), 10.0f, 240.0f, 1.0f, glm::vec3(1.0f, 0.8f, 0.8f));
+        addText(frameArena.format("Y: %f", cameraPosition.y), 10.0f, 265.0f, 1.0f, glm::vec3(0.8f, 1.0f, 0.8f));
+        addText(frameArena.format("Z: %f", cameraPosition.z), 10.0f, 290.0f, 1.0f, glm::vec3(0.8f, 0.8f, 1.0f));
+        flushText();
 
         // 4. Animated wave text
-        std::string animatedText = "Press R to reload shaders | Press T to toggle stress test";
+        const char* animatedText = "Press R to reload shaders | Press T to toggle stress test";
         float baseY = window.getHeight() - 40.0f;
         float charX = window.getWidth() - 500.0f;
-        for (char c : animatedText) {
+        for (const char* c = animatedText; *c; ++c) {
             float offsetY = sin(currentFrame * 2.0f + charX * 0.05f) * 10.0f;
-            std::string charStr(1, c);
-            textRenderer.addToBatch(charStr, charX, baseY + offsetY, 1.0f, 
-                                  glm::vec3(0.7f + sin(currentFrame) * 0.3f,
-                                          0.7f + cos(currentFrame) * 0.3f,
-                                          0.7f));
+            addText(frameArena.format("%c", *c), charX, baseY + offsetY, 1.0f, 
+                    glm::vec3(0.7f + sin(currentFrame) * 0.3f,
+                              0.7f + cos(currentFrame) * 0.3f,
+                              0.7f));
             charX += 15.0f;
         }
-        textRenderer.renderBatch(ortho);
-        metrics.textDrawCalls++;
-        metrics.totalCharacters += animatedText.length();
+        flushText();
 
         // 5. Stress test (optional)
         if (showStressTest) {
@@ -351,35 +943,100 @@ int main() {
                     float y = 300.0f + j * 30.0f;
                     float scale = 0.8f + sin(currentFrame + i * 0.1f + j * 0.1f) * 0.2f;
                     
-                    std::string text = "Test" + std::to_string(i) + std::to_string(j);
+                    const char* text = frameArena.format("Test%d%d", i, j);
                     glm::vec3 color(
                         0.5f + sin(currentFrame + i * 0.2f) * 0.5f,
                         0.5f + sin(currentFrame + j * 0.2f) * 0.5f,
                         0.5f + sin(currentFrame + (i + j) * 0.2f) * 0.5f
                     );
                     
-                    textRenderer.addToBatch(text, x, y, scale, color);
-                    metrics.totalCharacters += text.length();
+                    addText(text, x, y, scale, color);
                 }
             }
-            textRenderer.renderBatch(ortho);
-            metrics.textDrawCalls++;
+            flushText();
         }
 
-        metrics.textRenderTime = static_cast<float>(glfwGetTime()) - textStartTime;
+        // 6. Render statistics, read on the render thread
+        commands.call(drawRenderOverlay, RenderOverlay{&renderResources, ortho, 165.0f,
+                                                       window.getWidth() - 420.0f});
+
+        // Text work is whatever the renderer recorded in this section; logged with the metrics
+        commands.call(endTextSection, TextSectionEnd{&renderResources, fps, metrics.sceneRenderTime,
+                                                     metrics.textRenderTime, showStressTest});
 
-        // After performance metrics are updated
-        logger.logPerformanceMetrics(fps, metrics.sceneRenderTime, metrics.textRenderTime,
-                                   metrics.textDrawCalls, metrics.totalCharacters, showStressTest);
+        if (!screenshotPath.empty()) {
+            commands.call(captureScreenshot, ScreenshotRequest{commands.copyString(screenshotPath),
+                                                              window.getWidth(), window.getHeight()});
+        }
+        SFE_PROFILE_END();
 
-        window.swapBuffers();
+        // Replayed and presented on the render thread while the next frame is simulated
+        renderThread.submitFrame();
+        // With a render thread the first present is seen here up to a frame late
+        if (!startupReported && renderThread.getFramesPresented() > 0) {
+            reportStartup(startup, logger);
+            startupReported = true;
+        }
         window.pollEvents();
     }
 
+    // Presents the last frames and hands the context back for teardown
+    renderThread.stop();
+
+    int exitCode = 0;
+    if (testConfig.enabled) {
+        float testDuration = static_cast<float>(glfwGetTime()) - testConfig.testStartTime;
+        if (writeBenchmarkReport(testConfig.outputDir + "/benchmark.json", testDuration, renderStats.getSummary(),
+                                 memoryBenchmark, startup)) {
+            logger.logMessage("Benchmark report written: " + testConfig.outputDir + "/benchmark.json");
+        }
+        if (SFE::MemoryTracker::isEnabled() && allocationBudget) {
+            double budget = std::atof(allocationBudget);
+            double measured = memoryBenchmark.getAllocationsPerFrame();
+            if (measured > budget) {
+                std::cerr << "Allocation budget exceeded: " << measured << " allocations per frame, budget "
+                          << budget << std::endl;
+                logger.logMessage("Allocation budget exceeded: " + std::to_string(measured) + " per frame");
+                exitCode = 1;
+            }
+        }
+        if (startupBudget) {
+            double budget = std::atof(startupBudget);
+            double measured = startup.getMarkMs("First frame");
+            if (measured < 0.0 || measured > budget) {
+                std::cerr << "Startup budget exceeded: first frame after " << measured << " ms, budget " << budget
+                          << " ms" << std::endl;
+                logger.logMessage("Startup budget exceeded: " + std::to_string(measured) + " ms to first frame");
+                exitCode = 1;
+            }
+        }
+    }
+
+    if (tracePath) {
+        profiler.endFrame();
+        if (profiler.stopCapture(tracePath)) {
+            logger.logMessage(std::string("Profiler trace written: ") + tracePath);
+        }
+    }
+
     // Log final message
     logger.logMessage("Application shutting down");
 
+    // GPU culling and shared geometry buffers must be freed while the GL context is still alive
+    instanceCuller.shutdown();
+    sceneBatcher.shutdown();
+    gpuProfiler.shutdown();
+    SFE::ScreenshotManager::getInstance().shutdown();
+    shaderManager.clear();
+    registry.clear();
+    SFE::GeometryArena::getInstance().shutdown();
+    vfs.shutdown();
+    SFE::JobSystem::getInstance().shutdown();
+
+    // Write out queued log records (bounded wait)
+    logger.shutdown();
+
     // WindowManager destructor handles GLFW termination
 
-    return 0;
+    return exitCode;
 } 
\ No newline at end of file
@@ -0,0 +1,332 @@
+#include "rendering/Bvh.hpp"
+
+namespace SFE {
+
+namespace {
+
+bool sameBounds(const Aabb& a, const Aabb& b) {
+    return a.min == b.min && a.max == b.max;
+}
+
+} // namespace
+
+Bvh::ProxyId Bvh::insert(const Aabb& bounds, uint32_t userData) {
+    ProxyId proxy;
+    if (!freeProxies.empty()) {
+        proxy = freeProxies.back();
+        freeProxies.pop_back();
+    } else {
+        proxy = static_cast<ProxyId>(proxies.size());
+        proxies.emplace_back();
+    }
+    uint32_t leaf = allocateNode();
+    proxies[proxy] = {enlarge(bounds), userData, leaf};
+    nodes[leaf].bounds = proxies[proxy].bounds;
+    nodes[leaf].proxy = proxy;
+    insertLeaf(leaf);
+    ++proxyCount;
+    return proxy;
+}
+
+void Bvh::remove(ProxyId proxy) {
+    if (proxy >= proxies.size() || proxies[proxy].leaf == INVALID) return;
+    uint32_t leaf = proxies[proxy].leaf;
+    removeLeaf(leaf);
+    freeNode(leaf);
+    proxies[proxy].leaf = INVALID;
+    freeProxies.push_back(proxy);
+    --proxyCount;
+}
+
+bool Bvh::move(ProxyId proxy, const Aabb& bounds) {
+    if (proxy >= proxies.size() || proxies[proxy].leaf == INVALID) return false;
+    Proxy& moved = proxies[proxy];
+    if (moved.bounds.contains(bounds)) return false;
+    moved.bounds = enlarge(bounds);
+    nodes[moved.leaf].bounds = moved.bounds;
+    refitFrom(nodes[moved.leaf].parent);
+    return true;
+}
+
+void Bvh::rebuild() {
+    std::vector<uint32_t> live;
+    live.reserve(proxyCount);
+    std::vector<glm::vec3> centroids(proxies.size());
+    for (uint32_t proxy = 0; proxy < proxies.size(); ++proxy) {
+        if (proxies[proxy].leaf != INVALID) {
+            live.push_back(proxy);
+            centroids[proxy] = proxies[proxy].bounds.center();
+        }
+    }
+
+    nodes.clear();
+    freeNodes = INVALID;
+    root = INVALID;
+    builtCost = 0.0f;
+    if (live.empty()) return;
+    nodes.reserve(live.size() * 2 - 1); // Leaves plus their internal nodes
+    root = buildRange(live.data(), live.data() + live.size(), centroids.data(), INVALID);
+    builtCost = getCost();
+}
+
+void Bvh::clear() {
+    nodes.clear();
+    proxies.clear();
+    root = INVALID;
+    freeNodes = INVALID;
+    freeProxies.clear();
+    proxyCount = 0;
+    builtCost = 0.0f;
+}
+
+uint32_t Bvh::getHeight() const {
+    if (root == INVALID) return 0;
+    uint32_t height = 0;
+    std::vector<std::pair<uint32_t, uint32_t>> stack{{root, 1}};
+    while (!stack.empty()) {
+        auto [index, depth] = stack.back();
+        stack.pop_back();
+        height = std::max(height, depth);
+        if (!nodes[index].isLeaf()) {
+            stack.push_back({nodes[index].left, depth + 1});
+            stack.push_back({nodes[index].right, depth + 1});
+        }
+    }
+    return height;
+}
+
+float Bvh::getCost() const {
+    if (root == INVALID) return 0.0f;
+    float rootArea = nodes[root].bounds.surfaceArea();
+    if (rootArea <= 0.0f) return 0.0f;
+    float area = 0.0f;
+    std::vector<uint32_t> stack{root};
+    while (!stack.empty()) {
+        uint32_t index = stack.back();
+        stack.pop_back();
+        if (nodes[index].isLeaf()) continue;
+        area += nodes[index].bounds.surfaceArea();
+        stack.push_back(nodes[index].left);
+        stack.push_back(nodes[index].right);
+    }
+    return area / rootArea;
+}
+
+bool Bvh::validate() const {
+    if (root == INVALID) return proxyCount == 0;
+    if (nodes[root].parent != INVALID) return false;
+    uint32_t leaves = 0;
+    std::vector<uint32_t> stack{root};
+    while (!stack.empty()) {
+        uint32_t index = stack.back();
+        stack.pop_back();
+        const Node& node = nodes[index];
+        if (node.isLeaf()) {
+            if (node.proxy >= proxies.size() || proxies[node.proxy].leaf != index) return false;
+            if (!sameBounds(node.bounds, proxies[node.proxy].bounds)) return false;
+            ++leaves;
+            continue;
+        }
+        for (uint32_t child : {node.left, node.right}) {
+            if (child >= nodes.size() || nodes[child].parent != index) return false;
+            if (!node.bounds.contains(nodes[child].bounds)) return false;
+            stack.push_back(child);
+        }
+    }
+    return leaves == proxyCount;
+}
+
+uint32_t Bvh::allocateNode() {
+    if (freeNodes != INVALID) {
+        uint32_t node = freeNodes;
+        freeNodes = nodes[node].proxy;
+        nodes[node] = Node();
+        return node;
+    }
+    nodes.emplace_back();
+    return static_cast<uint32_t>(nodes.size() - 1);
+}
+
+void Bvh::freeNode(uint32_t node) {
+    nodes[node] = Node();
+    nodes[node].proxy = freeNodes;
+    freeNodes = node;
+}
+
+void Bvh::insertLeaf(uint32_t leaf) {
+    if (root == INVALID) {
+        root = leaf;
+        nodes[leaf].parent = INVALID;
+        return;
+    }
+
+    // Walk down towards the cheapest sibling: stop where pairing with the current node costs less
+    // than the least that going deeper could (the enlargement of this node is paid either way)
+    const Aabb leafBounds = nodes[leaf].bounds;
+    uint32_t index = root;
+    while (!nodes[index].isLeaf()) {
+        const Node& node = nodes[index];
+        float area = node.bounds.surfaceArea();
+        float combinedArea = Aabb::merge(node.bounds, leafBounds).surfaceArea();
+        float cost = 2.0f * combinedArea;
+        float inheritanceCost = 2.0f * (combinedArea - area);
+        auto descendCost = [&](uint32_t child) {
+            float merged = Aabb::merge(nodes[child].bounds, leafBounds).surfaceArea();
+            if (nodes[child].isLeaf()) return merged + inheritanceCost;
+            return merged - nodes[child].bounds.surfaceArea() + inheritanceCost;
+        };
+        float leftCost = descendCost(node.left);
+        float rightCost = descendCost(node.right);
+        if (cost < leftCost && cost < rightCost) break;
+        index = leftCost < rightCost ? node.left : node.right;
+    }
+
+    uint32_t sibling = index;
+    uint32_t oldParent = nodes[sibling].parent;
+    uint32_t newParent = allocateNode();
+    nodes[newParent].parent = oldParent;
+    nodes[newParent].bounds = Aabb::merge(nodes[sibling].bounds, leafBounds);
+    nodes[newParent].left = sibling;
+    nodes[newParent].right = leaf;
+    nodes[sibling].parent = newParent;
+    nodes[leaf].parent = newParent;
+    if (oldParent == INVALID) {
+        root = newParent;
+        return;
+    }
+    if (nodes[oldParent].left == sibling) nodes[oldParent].left = newParent;
+    else nodes[oldParent].right = newParent;
+    refitFrom(oldParent);
+}
+
+void Bvh::removeLeaf(uint32_t leaf) {
+    if (leaf == root) {
+        root = INVALID;
+        return;
+    }
+    uint32_t parent = nodes[leaf].parent;
+    uint32_t grandparent = nodes[parent].parent;
+    uint32_t sibling = nodes[parent].left == leaf ? nodes[parent].right : nodes[parent].left;
+    nodes[sibling].parent = grandparent;
+    freeNode(parent);
+    if (grandparent == INVALID) {
+        root = sibling;
+        return;
+    }
+    if (nodes[grandparent].left == parent) nodes[grandparent].left = sibling;
+    else nodes[grandparent].right = sibling;
+    refitFrom(grandparent);
+}
+
+void Bvh::refitFrom(uint32_t node) {
+    // Ancestors above the first node whose bounds come out unchanged are already right
+    for (uint32_t index = node; index != INVALID; index = nodes[index].parent) {
+        Aabb bounds = Aabb::merge(nodes[nodes[index].left].bounds, nodes[nodes[index].right].bounds);
+        if (sameBounds(bounds, nodes[index].bounds)) return;
+        nodes[index].bounds = bounds;
+    }
+}
+
+uint32_t Bvh::buildRange(uint32_t* begin, uint32_t* end, const glm::vec3* centroids, uint32_t parent) {
+    uint32_t node = allocateNode();
+    nodes[node].parent = parent;
+    size_t count = size_t(end - begin);
+    if (count == 1) {
+        nodes[node].proxy = *begin;
+        nodes[node].bounds = proxies[*begin].bounds;
+        proxies[*begin].leaf = node;
+        return node;
+    }
+
+    glm::vec3 centroidMin = centroids[*begin];
+    glm::vec3 centroidMax = centroidMin;
+    for (const uint32_t* proxy = begin + 1; proxy != end; ++proxy) {
+        centroidMin = glm::min(centroidMin, centroids[*proxy]);
+        centroidMax = glm::max(centroidMax, centroids[*proxy]);
+    }
+    glm::vec3 extent = centroidMax - centroidMin;
+    int axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+
+    // Binned SAH: bin centroids along the widest axis and split between the bins where
+    // area * count summed over both sides is smallest
+    uint32_t* middle = begin + count / 2;
+    if (extent[axis] > 0.0f) {
+        constexpr int BIN_COUNT = 16;
+        struct Bin {
+            Aabb bounds;
+            uint32_t count = 0;
+        };
+        Bin bins[BIN_COUNT];
+        float binScale = BIN_COUNT / extent[axis];
+        auto binOf = [&](uint32_t proxy) {
+            int bin = static_cast<int>((centroids[proxy][axis] - centroidMin[axis]) * binScale);
+            return std::min(bin, BIN_COUNT - 1);
+        };
+        for (const uint32_t* proxy = begin; proxy != end; ++proxy) {
+            Bin& bin = bins[binOf(*proxy)];
+            bin.bounds = bin.count == 0 ? proxies[*proxy].bounds : Aabb::merge(bin.bounds, proxies[*proxy].bounds);
+            ++bin.count;
+        }
+
+        // Right-hand sums first, then sweep from the left
+        float rightCost[BIN_COUNT];
+        Aabb rightBounds;
+        uint32_t rightCount = 0;
+        for (int i = BIN_COUNT - 1; i > 0; --i) {
+            if (bins[i].count > 0) {
+                rightBounds = rightCount == 0 ? bins[i].bounds : Aabb::merge(rightBounds, bins[i].bounds);
+                rightCount += bins[i].count;
+            }
+            rightCost[i] = rightCount > 0 ? rightBounds.surfaceArea() * rightCount : 0.0f;
+        }
+        Aabb leftBounds;
+        uint32_t leftCount = 0;
+        float bestCost = std::numeric_limits<float>::max();
+        int bestSplit = -1; // Last bin on the left
+        for (int i = 0; i < BIN_COUNT - 1; ++i) {
+            if (bins[i].count > 0) {
+                leftBounds = leftCount == 0 ? bins[i].bounds : Aabb::merge(leftBounds, bins[i].bounds);
+                leftCount += bins[i].count;
+            }
+            if (leftCount == 0 || leftCount == count) continue;
+            float cost = leftBounds.surfaceArea() * leftCount + rightCost[i + 1];
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestSplit = i;
+            }
+        }
+        if (bestSplit >= 0) {
+            middle = std::partition(begin, end, [&](uint32_t proxy) { return binOf(proxy) <= bestSplit; });
+        }
+    }
+    if (middle == begin || middle == end || extent[axis] <= 0.0f) {
+        // Coincident centroids: any even split
+        middle = begin + count / 2;
+        std::nth_element(begin, middle, end,
+                         [&](uint32_t a, uint32_t b) { return centroids[a][axis] < centroids[b][axis]; });
+    }
+
+    uint32_t left = buildRange(begin, middle, centroids, node);
+    uint32_t right = buildRange(middle, end, centroids, node);
+    nodes[node].left = left;
+    nodes[node].right = right;
+    nodes[node].bounds = Aabb::merge(nodes[left].bounds, nodes[right].bounds);
+    return node;
+}
+
+Aabb Bvh::enlarge(const Aabb& bounds) const {
+    return {bounds.min - glm::vec3(margin), bounds.max + glm::vec3(margin)};
+}
+
+float Bvh::rayBoxEntry(const Aabb& box, const glm::vec3& origin, const glm::vec3& inverseDirection,
+                       float maxDistance) {
+    glm::vec3 t0 = (box.min - origin) * inverseDirection;
+    glm::vec3 t1 = (box.max - origin) * inverseDirection;
+    glm::vec3 near = glm::min(t0, t1);
+    glm::vec3 far = glm::max(t0, t1);
+    float entry = std::max(std::max(near.x, near.y), std::max(near.z, 0.0f));
+    float exit = std::min(std::min(far.x, far.y), std::min(far.z, maxDistance));
+    return entry <= exit ? entry : -1.0f;
+}
+
+} // namespace SFE
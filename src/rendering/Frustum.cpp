@@ -0,0 +1,56 @@
+#include "rendering/Frustum.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace SFE {
+
+Frustum Frustum::fromMatrix(const glm::mat4& viewProjection) {
+    // Gribb/Hartmann: each plane is the fourth row of the matrix plus or minus one of the others
+    const glm::mat4& m = viewProjection;
+    glm::vec4 row[4];
+    for (int i = 0; i < 4; ++i) {
+        row[i] = glm::vec4(m[0][i], m[1][i], m[2][i], m[3][i]);
+    }
+
+    Frustum frustum;
+    frustum.planes[0] = row[3] + row[0];
+    frustum.planes[1] = row[3] - row[0];
+    frustum.planes[2] = row[3] + row[1];
+    frustum.planes[3] = row[3] - row[1];
+    frustum.planes[4] = row[3] + row[2];
+    frustum.planes[5] = row[3] - row[2];
+    for (auto& plane : frustum.planes) {
+        float length = glm::length(glm::vec3(plane));
+        if (length > 0.0f) plane = plane * (1.0f / length);
+    }
+    return frustum;
+}
+
+bool Frustum::intersectsSphere(const glm::vec3& center, float radius) const {
+    for (const auto& plane : planes) {
+        if (glm::dot(glm::vec3(plane), center) + plane.w < -radius) return false;
+    }
+    return true;
+}
+
+bool Frustum::intersectsAabb(const glm::vec3& boundsMin, const glm::vec3& boundsMax) const {
+    for (const auto& plane : planes) {
+        // Test the box corner furthest along the plane normal
+        glm::vec3 positive(plane.x >= 0.0f ? boundsMax.x : boundsMin.x,
+                           plane.y >= 0.0f ? boundsMax.y : boundsMin.y,
+                           plane.z >= 0.0f ? boundsMax.z : boundsMin.z);
+        if (glm::dot(glm::vec3(plane), positive) + plane.w < 0.0f) return false;
+    }
+    return true;
+}
+
+void transformBoundingSphere(const glm::mat4& model, const glm::vec3& center, float radius,
+                             glm::vec3& worldCenter, float& worldRadius) {
+    float scaleSquared = std::max({glm::dot(glm::vec3(model[0]), glm::vec3(model[0])),
+                                   glm::dot(glm::vec3(model[1]), glm::vec3(model[1])),
+                                   glm::dot(glm::vec3(model[2]), glm::vec3(model[2]))});
+    worldCenter = glm::vec3(model * glm::vec4(center, 1.0f));
+    worldRadius = radius * std::sqrt(scaleSquared);
+}
+
+} // namespace SFE
@@ -0,0 +1,73 @@
+#include "rendering/GLExtensions.hpp"
+#include <cstring>
+#include <iostream>
+
+namespace SFE {
+
+GLExtensions::DispatchComputeProc GLExtensions::dispatchCompute = nullptr;
+GLExtensions::MemoryBarrierProc GLExtensions::memoryBarrier = nullptr;
+GLExtensions::DrawElementsIndirectProc GLExtensions::drawElementsIndirect = nullptr;
+GLExtensions::GetTextureHandleProc GLExtensions::getTextureHandle = nullptr;
+GLExtensions::MakeTextureHandleResidentProc GLExtensions::makeTextureHandleResident = nullptr;
+GLExtensions::MakeTextureHandleNonResidentProc GLExtensions::makeTextureHandleNonResident = nullptr;
+int GLExtensions::majorVersion = 0;
+int GLExtensions::minorVersion = 0;
+bool GLExtensions::s3tcCompression = false;
+bool GLExtensions::bptcCompression = false;
+
+void GLExtensions::load(GLADloadproc loader) {
+    glGetIntegerv(GL_MAJOR_VERSION, &majorVersion);
+    glGetIntegerv(GL_MINOR_VERSION, &minorVersion);
+    int version = majorVersion * 10 + minorVersion;
+
+    // Core profiles may hand out non-null pointers for functions the context does not
+    // support, so the version decides and the pointer only confirms
+    dispatchCompute = nullptr;
+    memoryBarrier = nullptr;
+    drawElementsIndirect = nullptr;
+    getTextureHandle = nullptr;
+    makeTextureHandleResident = nullptr;
+    makeTextureHandleNonResident = nullptr;
+    if (version >= 40) {
+        drawElementsIndirect = reinterpret_cast<DrawElementsIndirectProc>(loader("glDrawElementsIndirect"));
+        if (hasExtension("GL_ARB_bindless_texture")) {
+            getTextureHandle = reinterpret_cast<GetTextureHandleProc>(loader("glGetTextureHandleARB"));
+            makeTextureHandleResident =
+                reinterpret_cast<MakeTextureHandleResidentProc>(loader("glMakeTextureHandleResidentARB"));
+            makeTextureHandleNonResident =
+                reinterpret_cast<MakeTextureHandleNonResidentProc>(loader("glMakeTextureHandleNonResidentARB"));
+        }
+    }
+    if (version >= 43) {
+        dispatchCompute = reinterpret_cast<DispatchComputeProc>(loader("glDispatchCompute"));
+        memoryBarrier = reinterpret_cast<MemoryBarrierProc>(loader("glMemoryBarrier"));
+    }
+    s3tcCompression = hasExtension("GL_EXT_texture_compression_s3tc");
+    bptcCompression = version >= 42 || hasExtension("GL_ARB_texture_compression_bptc");
+
+    std::cout << "OpenGL " << majorVersion << "." << minorVersion << " context: draw indirect "
+              << (hasDrawIndirect() ? "yes" : "no") << ", compute " << (hasComputeShaders() ? "yes" : "no")
+              << ", bindless textures " << (hasBindlessTexture() ? "yes" : "no") << ", BC1-3 "
+              << (s3tcCompression ? "yes" : "no") << ", BC7 " << (bptcCompression ? "yes" : "no") << std::endl;
+}
+
+GLenum GLExtensions::getCompressedTextureFormat(TextureFileFormat format) {
+    switch (format) {
+    case TextureFileFormat::BC1: return s3tcCompression ? GL_COMPRESSED_RGB_S3TC_DXT1_EXT : 0;
+    case TextureFileFormat::BC3: return s3tcCompression ? GL_COMPRESSED_RGBA_S3TC_DXT5_EXT : 0;
+    case TextureFileFormat::BC7: return bptcCompression ? GL_COMPRESSED_RGBA_BPTC_UNORM : 0;
+    default: return 0;
+    }
+}
+
+bool GLExtensions::hasExtension(const char* name) {
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count; ++i) {
+        const char* extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));
+        if (extension && std::strcmp(extension, name) == 0) return true;
+    }
+    return false;
+}
+
+} // namespace SFE
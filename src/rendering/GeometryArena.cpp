@@ -0,0 +1,254 @@
+#include "rendering/GeometryArena.hpp"
+#include "core/MemoryTracker.hpp"
+#include "rendering/Mesh.hpp"
+#include "rendering/RenderStats.hpp"
+#include <algorithm>
+#include <iostream>
+#include <glm/glm.hpp>
+
+namespace SFE {
+
+GeometryArena& GeometryArena::getInstance() {
+    static GeometryArena instance;
+    return instance;
+}
+
+GLsizei GeometryArena::getVertexStride(VertexFormat format) {
+    switch (format) {
+    case VertexFormat::Standard:
+        return sizeof(Mesh::Vertex);
+    case VertexFormat::QuantizedOct:
+        return sizeof(QuantizedVertexOct);
+    case VertexFormat::Quantized1010102:
+        return sizeof(QuantizedVertex1010102);
+    default:
+        return 0;
+    }
+}
+
+GeometryAllocation GeometryArena::allocate(VertexFormat format, uint32_t vertexCount,
+                                           uint32_t indexCount) {
+    SFE_MEMORY_TAG(Mesh);
+    GeometryAllocation allocation;
+    allocation.format = format;
+    if (vertexCount == 0 || indexCount == 0) return allocation;
+
+    ensurePool(format);
+    VertexPool& pool = getPool(format);
+
+    uint32_t baseVertex = pool.allocator.allocate(vertexCount);
+    if (baseVertex == FreeListAllocator::INVALID_OFFSET) {
+        growVertexPool(format, pool.allocator.getCapacity() + vertexCount);
+        baseVertex = pool.allocator.allocate(vertexCount);
+    }
+
+    uint32_t firstIndex = indexAllocator.allocate(indexCount);
+    if (firstIndex == FreeListAllocator::INVALID_OFFSET) {
+        growIndexBuffer(indexAllocator.getCapacity() + indexCount);
+        firstIndex = indexAllocator.allocate(indexCount);
+    }
+
+    allocation.baseVertex = baseVertex;
+    allocation.vertexCount = vertexCount;
+    allocation.firstIndex = firstIndex;
+    allocation.indexCount = indexCount;
+    return allocation;
+}
+
+void GeometryArena::upload(const GeometryAllocation& allocation, const void* vertexData,
+                           const uint32_t* indexData) {
+    if (!allocation.isValid()) return;
+
+    const VertexPool& pool = getPool(allocation.format);
+    GLsizei stride = getVertexStride(allocation.format);
+
+    // Upload through the copy-write target so the bound VAO's element buffer is left untouched
+    glBindBuffer(GL_COPY_WRITE_BUFFER, pool.vbo);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, GLintptr(allocation.baseVertex) * stride,
+                    GLsizeiptr(allocation.vertexCount) * stride, vertexData);
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, ebo);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, GLintptr(allocation.firstIndex) * sizeof(uint32_t),
+                    GLsizeiptr(allocation.indexCount) * sizeof(uint32_t), indexData);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    RenderStats::getInstance().recordBufferUpload(uint64_t(allocation.vertexCount) * stride +
+                                                  uint64_t(allocation.indexCount) * sizeof(uint32_t));
+}
+
+void GeometryArena::release(GeometryAllocation& allocation) {
+    if (!allocation.isValid()) return;
+
+    getPool(allocation.format).allocator.free(allocation.baseVertex);
+    indexAllocator.free(allocation.firstIndex);
+    allocation = GeometryAllocation{};
+}
+
+void GeometryArena::bindVertexFormat(VertexFormat format) {
+    ensurePool(format);
+    glBindVertexArray(getPool(format).vao);
+    RenderStats::getInstance().recordVertexArrayBind();
+}
+
+void GeometryArena::bindInstanceBuffer(VertexFormat format, GLuint buffer, size_t byteOffset) {
+    bindVertexFormat(format);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+
+    // A mat4 uses 4 vertex attributes
+    std::size_t vec4Size = sizeof(glm::vec4);
+    for (int i = 0; i < 4; i++) {
+        glEnableVertexAttribArray(3 + i);
+        glVertexAttribPointer(3 + i, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4),
+                              (void*)(byteOffset + vec4Size * i));
+        glVertexAttribDivisor(3 + i, 1);
+    }
+}
+
+void GeometryArena::shutdown() {
+    for (auto& pool : pools) {
+        if (pool.vbo) glDeleteBuffers(1, &pool.vbo);
+        if (pool.vao) glDeleteVertexArrays(1, &pool.vao);
+        pool.vbo = 0;
+        pool.vao = 0;
+        pool.allocator = FreeListAllocator();
+    }
+    if (ebo) glDeleteBuffers(1, &ebo);
+    ebo = 0;
+    indexAllocator = FreeListAllocator();
+}
+
+size_t GeometryArena::getVertexBytesUsed(VertexFormat format) const {
+    return size_t(getPool(format).allocator.getUsed()) * getVertexStride(format);
+}
+
+size_t GeometryArena::getVertexBytesReserved(VertexFormat format) const {
+    return size_t(getPool(format).allocator.getCapacity()) * getVertexStride(format);
+}
+
+void GeometryArena::ensureIndexBuffer() {
+    if (ebo) return;
+
+    glGenBuffers(1, &ebo);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, ebo);
+    glBufferData(GL_COPY_WRITE_BUFFER, GLsizeiptr(INITIAL_INDEX_CAPACITY) * sizeof(uint32_t),
+                 nullptr, GL_STATIC_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    indexAllocator = FreeListAllocator(INITIAL_INDEX_CAPACITY);
+}
+
+void GeometryArena::ensurePool(VertexFormat format) {
+    ensureIndexBuffer();
+
+    VertexPool& pool = getPool(format);
+    if (pool.vao) return;
+
+    glGenVertexArrays(1, &pool.vao);
+    glGenBuffers(1, &pool.vbo);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, pool.vbo);
+    glBufferData(GL_COPY_WRITE_BUFFER, GLsizeiptr(INITIAL_VERTEX_CAPACITY) * getVertexStride(format),
+                 nullptr, GL_STATIC_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    pool.allocator = FreeListAllocator(INITIAL_VERTEX_CAPACITY);
+
+    setupVertexAttributes(format);
+}
+
+void GeometryArena::setupVertexAttributes(VertexFormat format) {
+    VertexPool& pool = getPool(format);
+    GLsizei stride = getVertexStride(format);
+
+    glBindVertexArray(pool.vao);
+    glBindBuffer(GL_ARRAY_BUFFER, pool.vbo);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+
+    switch (format) {
+    case VertexFormat::Standard:
+        // Position attribute
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(Mesh::Vertex, position));
+        glEnableVertexAttribArray(0);
+        // Normal attribute
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(Mesh::Vertex, normal));
+        glEnableVertexAttribArray(1);
+        // Texture coordinate attribute
+        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(Mesh::Vertex, texCoord));
+        glEnableVertexAttribArray(2);
+        break;
+    case VertexFormat::QuantizedOct:
+        // 16-bit unorm position, dequantized in the vertex shader with the mesh bounds
+        glVertexAttribPointer(0, 3, GL_UNSIGNED_SHORT, GL_TRUE, stride, (void*)offsetof(QuantizedVertexOct, position));
+        glEnableVertexAttribArray(0);
+        // Octahedral normal, decoded in the vertex shader
+        glVertexAttribPointer(1, 2, GL_SHORT, GL_TRUE, stride, (void*)offsetof(QuantizedVertexOct, normal));
+        glEnableVertexAttribArray(1);
+        // Half-float texture coordinates
+        glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, stride, (void*)offsetof(QuantizedVertexOct, texCoord));
+        glEnableVertexAttribArray(2);
+        break;
+    case VertexFormat::Quantized1010102:
+        glVertexAttribPointer(0, 3, GL_UNSIGNED_SHORT, GL_TRUE, stride, (void*)offsetof(QuantizedVertex1010102, position));
+        glEnableVertexAttribArray(0);
+        // Signed 10:10:10:2 normal, unpacked by the fixed-function fetch
+        glVertexAttribPointer(1, 4, GL_INT_2_10_10_10_REV, GL_TRUE, stride, (void*)offsetof(QuantizedVertex1010102, normal));
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, stride, (void*)offsetof(QuantizedVertex1010102, texCoord));
+        glEnableVertexAttribArray(2);
+        break;
+    default:
+        break;
+    }
+
+    glBindVertexArray(0);
+}
+
+void GeometryArena::growVertexPool(VertexFormat format, uint32_t minCapacity) {
+    VertexPool& pool = getPool(format);
+    GLsizei stride = getVertexStride(format);
+    uint32_t oldCapacity = pool.allocator.getCapacity();
+    uint32_t newCapacity = std::max(oldCapacity * 2, minCapacity);
+
+    pool.vbo = reallocateBuffer(pool.vbo, size_t(oldCapacity) * stride, size_t(newCapacity) * stride);
+    pool.allocator.grow(newCapacity);
+
+    // The VAO captured the old buffer name in its attribute pointers
+    setupVertexAttributes(format);
+
+    std::cout << "GeometryArena: grew vertex pool " << static_cast<int>(format) << " to "
+              << newCapacity << " vertices" << std::endl;
+}
+
+void GeometryArena::growIndexBuffer(uint32_t minCapacity) {
+    uint32_t oldCapacity = indexAllocator.getCapacity();
+    uint32_t newCapacity = std::max(oldCapacity * 2, minCapacity);
+
+    ebo = reallocateBuffer(ebo, size_t(oldCapacity) * sizeof(uint32_t),
+                           size_t(newCapacity) * sizeof(uint32_t));
+    indexAllocator.grow(newCapacity);
+
+    // Every VAO references the element buffer, so re-attach the new one
+    for (auto& pool : pools) {
+        if (!pool.vao) continue;
+        glBindVertexArray(pool.vao);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+    }
+    glBindVertexArray(0);
+
+    std::cout << "GeometryArena: grew index buffer to " << newCapacity << " indices" << std::endl;
+}
+
+GLuint GeometryArena::reallocateBuffer(GLuint oldBuffer, size_t oldBytes, size_t newBytes) {
+    GLuint newBuffer = 0;
+    glGenBuffers(1, &newBuffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, newBuffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, GLsizeiptr(newBytes), nullptr, GL_STATIC_DRAW);
+
+    if (oldBuffer) {
+        glBindBuffer(GL_COPY_READ_BUFFER, oldBuffer);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, GLsizeiptr(oldBytes));
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        glDeleteBuffers(1, &oldBuffer);
+    }
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    return newBuffer;
+}
+
+} // namespace SFE
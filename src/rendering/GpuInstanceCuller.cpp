@@ -0,0 +1,424 @@
+#include "rendering/GpuInstanceCuller.hpp"
+#include "core/VFS.hpp"
+#include "rendering/GpuProfiler.hpp"
+#include "rendering/GLExtensions.hpp"
+#include "rendering/GeometryArena.hpp"
+#include "rendering/Mesh.hpp"
+#include "rendering/RenderStats.hpp"
+#include "rendering/Shader.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <glm/gtc/type_ptr.hpp>
+
+#ifndef GL_BUFFER_UPDATE_BARRIER_BIT
+#define GL_BUFFER_UPDATE_BARRIER_BIT 0x00000200
+#endif
+
+namespace SFE {
+
+namespace {
+
+constexpr GLsizeiptr INSTANCE_SIZE = sizeof(glm::mat4);
+constexpr uint32_t MAX_DISPATCH_GROUPS = 65535; // Minimum GL_MAX_COMPUTE_WORK_GROUP_COUNT
+
+void boundingSphere(const Mesh& mesh, glm::vec3& center, float& radius) {
+    center = (mesh.getBoundsMin() + mesh.getBoundsMax()) * 0.5f;
+    radius = glm::length(mesh.getBoundsMax() - mesh.getBoundsMin()) * 0.5f;
+}
+
+// Bitwise: transform feedback copies matrices exactly
+bool sameMatrix(const glm::mat4& a, const glm::mat4& b) {
+    return std::memcmp(&a, &b, sizeof(glm::mat4)) == 0;
+}
+
+} // namespace
+
+GpuInstanceCuller::~GpuInstanceCuller() {
+    shutdown();
+}
+
+const char* GpuInstanceCuller::getModeName(Mode mode) {
+    switch (mode) {
+    case Mode::TransformFeedback: return "transform feedback";
+    case Mode::Compute: return "compute";
+    default: return "disabled";
+    }
+}
+
+bool GpuInstanceCuller::initialize(Mode preferred) {
+    shutdown();
+    if (preferred == Mode::Disabled) return false;
+
+    if (preferred == Mode::Compute && GLExtensions::hasComputeShaders() && GLExtensions::hasDrawIndirect() &&
+        loadComputeProgram()) {
+        mode = Mode::Compute;
+        glGenBuffers(1, &commandBuffer);
+    } else if (loadTransformFeedbackProgram()) {
+        mode = Mode::TransformFeedback;
+
+        // Instance matrices come in as four vec4 attributes, one point per instance
+        glGenVertexArrays(1, &feedbackVao);
+        glBindVertexArray(feedbackVao);
+        for (GLuint column = 0; column < 4; ++column) {
+            glEnableVertexAttribArray(column);
+        }
+        glBindVertexArray(0);
+    } else {
+        std::cerr << "GpuInstanceCuller: no usable culling path, drawing unculled" << std::endl;
+        return false;
+    }
+
+    glGenBuffers(1, &outputBuffer);
+    cacheUniformLocations();
+    std::cout << "GPU instance culling: " << getModeName(mode) << std::endl;
+    return true;
+}
+
+void GpuInstanceCuller::shutdown() {
+    if (verifiedCulls > 0) {
+        std::cout << "GpuInstanceCuller: " << verifiedCulls << " culls verified, " << verificationFailures
+                  << " mismatches" << std::endl;
+    }
+    if (program) glDeleteProgram(program);
+    if (feedbackVao) glDeleteVertexArrays(1, &feedbackVao);
+    if (outputBuffer) glDeleteBuffers(1, &outputBuffer);
+    if (commandBuffer) glDeleteBuffers(1, &commandBuffer);
+    program = feedbackVao = outputBuffer = commandBuffer = 0;
+    outputCapacity = commandCapacity = 0;
+    verifiedCulls = verificationFailures = 0;
+    mode = Mode::Disabled;
+}
+
+GLuint GpuInstanceCuller::compileStage(GLenum type, const std::string& path) {
+    AssetData file;
+    if (!VFS::getInstance().read(path, file)) {
+        std::cerr << "GpuInstanceCuller: cannot read " << path << std::endl;
+        return 0;
+    }
+    const char* sourcePointer = reinterpret_cast<const char*>(file.getData());
+    GLint sourceLength = static_cast<GLint>(file.getSize());
+
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &sourcePointer, &sourceLength);
+    glCompileShader(shader);
+
+    GLint success = 0;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (!success) {
+        char infoLog[1024];
+        glGetShaderInfoLog(shader, sizeof(infoLog), nullptr, infoLog);
+        std::cerr << "GpuInstanceCuller: failed to compile " << path << "\n" << infoLog << std::endl;
+        glDeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+bool GpuInstanceCuller::linkProgram(GLuint linkedProgram, const std::string& name) {
+    glLinkProgram(linkedProgram);
+    GLint success = 0;
+    glGetProgramiv(linkedProgram, GL_LINK_STATUS, &success);
+    if (!success) {
+        char infoLog[1024];
+        glGetProgramInfoLog(linkedProgram, sizeof(infoLog), nullptr, infoLog);
+        std::cerr << "GpuInstanceCuller: failed to link " << name << "\n" << infoLog << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool GpuInstanceCuller::loadComputeProgram() {
+    GLuint computeShader = compileStage(GL_COMPUTE_SHADER, "shaders/cull_instances.comp");
+    if (!computeShader) return false;
+
+    program = glCreateProgram();
+    glAttachShader(program, computeShader);
+    bool linked = linkProgram(program, "compute culling program");
+    glDeleteShader(computeShader);
+    if (!linked) {
+        glDeleteProgram(program);
+        program = 0;
+    }
+    return linked;
+}
+
+bool GpuInstanceCuller::loadTransformFeedbackProgram() {
+    GLuint vertexShader = compileStage(GL_VERTEX_SHADER, "shaders/cull_instances.vert");
+    if (!vertexShader) return false;
+
+    program = glCreateProgram();
+    glAttachShader(program, vertexShader);
+    // Interleaved capture lays the four columns out exactly like a mat4 instance attribute
+    const char* varyings[] = {"outColumn0", "outColumn1", "outColumn2", "outColumn3"};
+    glTransformFeedbackVaryings(program, 4, varyings, GL_INTERLEAVED_ATTRIBS);
+    bool linked = linkProgram(program, "transform feedback culling program");
+    glDeleteShader(vertexShader);
+    if (!linked) {
+        glDeleteProgram(program);
+        program = 0;
+    }
+    return linked;
+}
+
+void GpuInstanceCuller::cacheUniformLocations() {
+    frustumPlanesLocation = glGetUniformLocation(program, "frustumPlanes");
+    boundingSphereLocation = glGetUniformLocation(program, "boundingSphere");
+    firstInstanceLocation = glGetUniformLocation(program, "firstInstance");
+    instanceCountLocation = glGetUniformLocation(program, "instanceCount");
+    outputOffsetLocation = glGetUniformLocation(program, "outputOffset");
+    commandIndexLocation = glGetUniformLocation(program, "commandIndex");
+}
+
+void GpuInstanceCuller::ensureOutputCapacity(uint32_t instanceCount) {
+    if (instanceCount <= outputCapacity) return;
+
+    // Ranges written earlier this frame were already consumed by their draws, and GL keeps the
+    // old storage alive for those, so the new store does not need their contents
+    outputCapacity = std::max({instanceCount, outputCapacity * 2, INITIAL_OUTPUT_CAPACITY});
+    glBindBuffer(GL_COPY_WRITE_BUFFER, outputBuffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, GLsizeiptr(outputCapacity) * INSTANCE_SIZE, nullptr, GL_DYNAMIC_COPY);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+void GpuInstanceCuller::ensureCommandCapacity(uint32_t commandCount) {
+    if (commandCount <= commandCapacity) return;
+
+    // Commands of earlier draws this frame must survive, so copy them over
+    uint32_t newCapacity = std::max({commandCount, commandCapacity * 2, INITIAL_COMMAND_CAPACITY});
+    GLuint newBuffer = 0;
+    glGenBuffers(1, &newBuffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, newBuffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, GLsizeiptr(newCapacity) * sizeof(DrawElementsIndirectCommand), nullptr,
+                 GL_DYNAMIC_DRAW);
+    if (commandCapacity > 0) {
+        glBindBuffer(GL_COPY_READ_BUFFER, commandBuffer);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0,
+                            GLsizeiptr(commandCapacity) * sizeof(DrawElementsIndirectCommand));
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    glDeleteBuffers(1, &commandBuffer);
+    commandBuffer = newBuffer;
+    commandCapacity = newCapacity;
+}
+
+void GpuInstanceCuller::beginFrame(const glm::mat4& viewProjection) {
+    frustum = Frustum::fromMatrix(viewProjection);
+    outputCursor = 0;
+    commandCursor = 0;
+    submittedInstances = 0;
+    visibleInstances = 0;
+}
+
+void GpuInstanceCuller::cullAndDraw(const Mesh& mesh, uint32_t lod, const Shader& drawShader,
+                                    GLuint instanceBuffer, uint32_t firstInstance, uint32_t instanceCount) {
+    if (!isEnabled() || instanceCount == 0 || mesh.getLodIndexCount(lod) == 0) return;
+    SFE_PROFILE_SCOPE("GpuInstanceCuller::cullAndDraw");
+    SFE_GPU_PROFILE_SCOPE("GpuInstanceCuller::cullAndDraw");
+
+    uint32_t outputOffset = outputCursor;
+    ensureOutputCapacity(outputCursor + instanceCount);
+    outputCursor += instanceCount;
+    submittedInstances += instanceCount;
+
+    auto& arena = GeometryArena::getInstance();
+    if (mode == Mode::Compute) {
+        uint32_t commandIndex = commandCursor++;
+        ensureCommandCapacity(commandCursor);
+        uint32_t verifiedCount = cullCompute(mesh, lod, instanceBuffer, firstInstance, instanceCount,
+                                             outputOffset, commandIndex);
+
+        drawShader.use();
+        arena.bindInstanceBuffer(mesh.getVertexFormat(), outputBuffer, size_t(outputOffset) * INSTANCE_SIZE);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commandBuffer);
+        GLExtensions::drawElementsIndirect(
+            GL_TRIANGLES, GL_UNSIGNED_INT,
+            reinterpret_cast<const void*>(size_t(commandIndex) * sizeof(DrawElementsIndirectCommand)));
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+        RenderStats::getInstance().recordIndirectDraw();
+        visibleInstances += verifiedCount;
+        return;
+    }
+
+    // Every slot is drawn; culled instances are zero matrices and produce no fragments
+    cullTransformFeedback(mesh, instanceBuffer, firstInstance, instanceCount, outputOffset);
+    if (verification) {
+        visibleInstances += verifyZeroedCull(mesh, instanceBuffer, firstInstance, instanceCount, outputOffset);
+    }
+
+    drawShader.use();
+    arena.bindInstanceBuffer(mesh.getVertexFormat(), outputBuffer, size_t(outputOffset) * INSTANCE_SIZE);
+    glDrawElementsInstancedBaseVertex(GL_TRIANGLES, mesh.getLodIndexCount(lod), GL_UNSIGNED_INT,
+                                      mesh.getLodIndexOffset(lod), instanceCount, mesh.getBaseVertex());
+    RenderStats::getInstance().recordDraw(GL_TRIANGLES, mesh.getLodIndexCount(lod), instanceCount);
+}
+
+uint32_t GpuInstanceCuller::cullCompute(const Mesh& mesh, uint32_t lod, GLuint instanceBuffer,
+                                        uint32_t firstInstance, uint32_t instanceCount, uint32_t outputOffset,
+                                        uint32_t commandIndex) {
+    // The shader only bumps instanceCount; the rest of the command comes from the mesh
+    DrawElementsIndirectCommand command{static_cast<GLuint>(mesh.getLodIndexCount(lod)), 0,
+                                        mesh.getLodFirstIndex(lod), mesh.getBaseVertex(), 0};
+    glBindBuffer(GL_COPY_WRITE_BUFFER, commandBuffer);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, GLintptr(commandIndex) * sizeof(command), sizeof(command), &command);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    RenderStats::getInstance().recordBufferUpload(sizeof(command));
+
+    glm::vec3 center;
+    float radius;
+    boundingSphere(mesh, center, radius);
+
+    glUseProgram(program);
+    RenderStats::getInstance().recordProgramBind();
+    glUniform4fv(frustumPlanesLocation, 6, glm::value_ptr(frustum.planes[0]));
+    glUniform4f(boundingSphereLocation, center.x, center.y, center.z, radius);
+    glUniform1ui(outputOffsetLocation, outputOffset);
+    glUniform1ui(commandIndexLocation, commandIndex);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, instanceBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, outputBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, commandBuffer);
+
+    // Large batches are split over several dispatches that append to the same command
+    const uint32_t maxPerDispatch = MAX_DISPATCH_GROUPS * COMPUTE_GROUP_SIZE;
+    for (uint32_t start = 0; start < instanceCount; start += maxPerDispatch) {
+        uint32_t count = std::min(maxPerDispatch, instanceCount - start);
+        glUniform1ui(firstInstanceLocation, firstInstance + start);
+        glUniform1ui(instanceCountLocation, count);
+        GLExtensions::dispatchCompute((count + COMPUTE_GROUP_SIZE - 1) / COMPUTE_GROUP_SIZE, 1, 1);
+    }
+
+    GLbitfield barriers = GL_COMMAND_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT;
+    if (verification) barriers |= GL_BUFFER_UPDATE_BARRIER_BIT;
+    GLExtensions::memoryBarrier(barriers);
+
+    for (GLuint binding = 0; binding < 3; ++binding) {
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, 0);
+    }
+
+    if (!verification) return 0;
+
+    DrawElementsIndirectCommand result{};
+    glBindBuffer(GL_COPY_READ_BUFFER, commandBuffer);
+    glGetBufferSubData(GL_COPY_READ_BUFFER, GLintptr(commandIndex) * sizeof(result), sizeof(result), &result);
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    return verifyCull(mesh, instanceBuffer, firstInstance, instanceCount, outputOffset, result.instanceCount);
+}
+
+void GpuInstanceCuller::cullTransformFeedback(const Mesh& mesh, GLuint instanceBuffer,
+                                                  uint32_t firstInstance, uint32_t instanceCount,
+                                                  uint32_t outputOffset) {
+    glm::vec3 center;
+    float radius;
+    boundingSphere(mesh, center, radius);
+
+    glUseProgram(program);
+    glUniform4fv(frustumPlanesLocation, 6, glm::value_ptr(frustum.planes[0]));
+    glUniform4f(boundingSphereLocation, center.x, center.y, center.z, radius);
+
+    glBindVertexArray(feedbackVao);
+    auto& stats = RenderStats::getInstance();
+    stats.recordProgramBind();
+    stats.recordVertexArrayBind();
+    glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+    for (GLuint column = 0; column < 4; ++column) {
+        glVertexAttribPointer(column, 4, GL_FLOAT, GL_FALSE, INSTANCE_SIZE,
+                              reinterpret_cast<const void*>(size_t(firstInstance) * INSTANCE_SIZE +
+                                                            column * sizeof(glm::vec4)));
+    }
+    glBindBufferRange(GL_TRANSFORM_FEEDBACK_BUFFER, 0, outputBuffer, GLintptr(outputOffset) * INSTANCE_SIZE,
+                      GLsizeiptr(instanceCount) * INSTANCE_SIZE);
+
+    glEnable(GL_RASTERIZER_DISCARD);
+    glBeginTransformFeedback(GL_POINTS);
+    glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(instanceCount));
+    stats.recordDraw(GL_POINTS, instanceCount);
+    glEndTransformFeedback();
+    glDisable(GL_RASTERIZER_DISCARD);
+
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, 0);
+    glBindVertexArray(0);
+}
+
+uint32_t GpuInstanceCuller::verifyCull(const Mesh& mesh, GLuint instanceBuffer, uint32_t firstInstance,
+                                   uint32_t instanceCount, uint32_t outputOffset, uint32_t gpuVisibleCount) {
+    glm::vec3 center;
+    float radius;
+    boundingSphere(mesh, center, radius);
+    auto isVisible = [&](const glm::mat4& model) {
+        glm::vec3 worldCenter;
+        float worldRadius;
+        transformBoundingSphere(model, center, radius, worldCenter, worldRadius);
+        return frustum.intersectsSphere(worldCenter, worldRadius);
+    };
+
+    readbackScratch.resize(instanceCount);
+    glBindBuffer(GL_COPY_READ_BUFFER, instanceBuffer);
+    glGetBufferSubData(GL_COPY_READ_BUFFER, GLintptr(firstInstance) * INSTANCE_SIZE,
+                       GLsizeiptr(instanceCount) * INSTANCE_SIZE, readbackScratch.data());
+    auto expectedCount =
+        static_cast<uint32_t>(std::count_if(readbackScratch.begin(), readbackScratch.end(), isVisible));
+
+    // Every compacted instance must pass the CPU test as well (order is not deterministic)
+    bool outputValid = gpuVisibleCount <= instanceCount;
+    if (outputValid && gpuVisibleCount > 0) {
+        readbackScratch.resize(gpuVisibleCount);
+        glBindBuffer(GL_COPY_READ_BUFFER, outputBuffer);
+        glGetBufferSubData(GL_COPY_READ_BUFFER, GLintptr(outputOffset) * INSTANCE_SIZE,
+                           GLsizeiptr(gpuVisibleCount) * INSTANCE_SIZE, readbackScratch.data());
+        outputValid = std::all_of(readbackScratch.begin(), readbackScratch.end(), isVisible);
+    }
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+
+    ++verifiedCulls;
+    if (gpuVisibleCount == expectedCount && outputValid) return gpuVisibleCount;
+
+    ++verificationFailures;
+    std::cerr << "GpuInstanceCuller (" << getModeName(mode) << "): GPU kept " << gpuVisibleCount << " of "
+              << instanceCount << " instances, CPU expects " << expectedCount
+              << (outputValid ? "" : ", output contains culled instances") << std::endl;
+    return gpuVisibleCount;
+}
+
+uint32_t GpuInstanceCuller::verifyZeroedCull(const Mesh& mesh, GLuint instanceBuffer, uint32_t firstInstance,
+                                             uint32_t instanceCount, uint32_t outputOffset) {
+    glm::vec3 center;
+    float radius;
+    boundingSphere(mesh, center, radius);
+
+    readbackScratch.resize(instanceCount);
+    outputScratch.resize(instanceCount);
+    glBindBuffer(GL_COPY_READ_BUFFER, instanceBuffer);
+    glGetBufferSubData(GL_COPY_READ_BUFFER, GLintptr(firstInstance) * INSTANCE_SIZE,
+                       GLsizeiptr(instanceCount) * INSTANCE_SIZE, readbackScratch.data());
+    glBindBuffer(GL_COPY_READ_BUFFER, outputBuffer);
+    glGetBufferSubData(GL_COPY_READ_BUFFER, GLintptr(outputOffset) * INSTANCE_SIZE,
+                       GLsizeiptr(instanceCount) * INSTANCE_SIZE, outputScratch.data());
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+
+    // Each slot must hold its input matrix if the CPU test keeps it and zeros otherwise
+    const glm::mat4 culled(0.0f);
+    uint32_t gpuVisibleCount = 0;
+    uint32_t expectedCount = 0;
+    uint32_t wrongSlots = 0;
+    for (uint32_t i = 0; i < instanceCount; ++i) {
+        glm::vec3 worldCenter;
+        float worldRadius;
+        transformBoundingSphere(readbackScratch[i], center, radius, worldCenter, worldRadius);
+        bool visible = frustum.intersectsSphere(worldCenter, worldRadius);
+        expectedCount += visible ? 1 : 0;
+        gpuVisibleCount += sameMatrix(outputScratch[i], culled) ? 0 : 1;
+        if (!sameMatrix(outputScratch[i], visible ? readbackScratch[i] : culled)) ++wrongSlots;
+    }
+
+    ++verifiedCulls;
+    if (wrongSlots == 0) return gpuVisibleCount;
+
+    ++verificationFailures;
+    std::cerr << "GpuInstanceCuller (" << getModeName(mode) << "): GPU kept " << gpuVisibleCount << " of "
+              << instanceCount << " instances, CPU expects " << expectedCount << ", " << wrongSlots
+              << " slots differ" << std::endl;
+    return gpuVisibleCount;
+}
+
+} // namespace SFE
@@ -0,0 +1,123 @@
+#include "rendering/GpuProfiler.hpp"
+#include <algorithm>
+#include <iostream>
+
+namespace SFE {
+
+bool GpuProfiler::initialize(uint32_t framesInFlight) {
+    shutdown();
+    if (!glQueryCounter || !glGetQueryObjectui64v || !glGetInteger64v) {
+        std::cerr << "GpuProfiler: timer queries not available, GPU zones disabled" << std::endl;
+        return false;
+    }
+
+    slots.resize(std::max(framesInFlight, 2u));
+    currentSlot = 0;
+    frameOpen = false;
+    droppedFrames = 0;
+    if (!gpuTrackRegistered) {
+        gpuTrack = Profiler::getInstance().registerGpuTrack("GPU");
+        gpuTrackRegistered = true;
+    }
+    enabled = true;
+    return true;
+}
+
+void GpuProfiler::shutdown() {
+    for (auto& slot : slots) {
+        if (!slot.queries.empty()) {
+            glDeleteQueries(static_cast<GLsizei>(slot.queries.size()), slot.queries.data());
+        }
+    }
+    slots.clear();
+    openZones.clear();
+    frameOpen = false;
+    enabled = false;
+}
+
+uint32_t GpuProfiler::writeTimestamp(FrameSlot& slot) {
+    if (slot.usedQueries == slot.queries.size()) {
+        size_t grow = std::max<size_t>(slot.queries.size(), 16);
+        slot.queries.resize(slot.queries.size() + grow);
+        glGenQueries(static_cast<GLsizei>(grow), slot.queries.data() + slot.usedQueries);
+    }
+    uint32_t index = slot.usedQueries++;
+    glQueryCounter(slot.queries[index], GL_TIMESTAMP);
+    return index;
+}
+
+void GpuProfiler::beginFrame() {
+    if (!enabled) return;
+
+    if (frameOpen) {
+        closeFrame(slots[currentSlot]);
+        currentSlot = (currentSlot + 1) % slots.size();
+    }
+
+    // The slot about to be reused was recorded framesInFlight frames ago
+    FrameSlot& slot = slots[currentSlot];
+    if (slot.pending) {
+        GLuint lastQuery = slot.queries[slot.zones[0].endQuery]; // Timestamps complete in order
+        GLint available = 0;
+        glGetQueryObjectiv(lastQuery, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available) {
+            resolve(slot);
+        } else {
+            ++droppedFrames;
+        }
+        slot.pending = false;
+    }
+
+    slot.usedQueries = 0;
+    slot.zones.clear();
+    GLint64 gpuNow = 0;
+    glGetInteger64v(GL_TIMESTAMP, &gpuNow);
+    slot.cpuSyncTicks = Profiler::now();
+    slot.gpuSyncNanoseconds = gpuNow;
+
+    slot.zones.push_back({"Frame", writeTimestamp(slot), 0, 0});
+    openZones.assign(1, 0);
+    frameOpen = true;
+}
+
+void GpuProfiler::beginZone(const char* name) {
+    if (!enabled || !frameOpen) return;
+    FrameSlot& slot = slots[currentSlot];
+    uint32_t depth = static_cast<uint32_t>(openZones.size());
+    openZones.push_back(static_cast<uint32_t>(slot.zones.size()));
+    slot.zones.push_back({name, writeTimestamp(slot), 0, depth});
+}
+
+void GpuProfiler::endZone() {
+    if (!enabled || !frameOpen || openZones.size() <= 1) return; // Never closes the frame zone
+    FrameSlot& slot = slots[currentSlot];
+    slot.zones[openZones.back()].endQuery = writeTimestamp(slot);
+    openZones.pop_back();
+}
+
+void GpuProfiler::closeFrame(FrameSlot& slot) {
+    // Zones left open (and the frame zone itself) end here
+    uint32_t end = writeTimestamp(slot);
+    for (uint32_t zone : openZones) slot.zones[zone].endQuery = end;
+    openZones.clear();
+    slot.pending = true;
+    frameOpen = false;
+}
+
+void GpuProfiler::resolve(FrameSlot& slot) {
+    Profiler& profiler = Profiler::getInstance();
+    auto toCpuTicks = [&](GLuint64 gpuNanoseconds) {
+        int64_t delta = static_cast<int64_t>(gpuNanoseconds) - slot.gpuSyncNanoseconds;
+        return static_cast<uint64_t>(static_cast<int64_t>(slot.cpuSyncTicks) + profiler.nanosecondsToTicks(delta));
+    };
+
+    for (const QueryZone& zone : slot.zones) {
+        GLuint64 begin = 0, end = 0;
+        glGetQueryObjectui64v(slot.queries[zone.beginQuery], GL_QUERY_RESULT, &begin);
+        glGetQueryObjectui64v(slot.queries[zone.endQuery], GL_QUERY_RESULT, &end);
+        if (zone.depth == 0) lastFrameMs = (end > begin ? end - begin : 0) * 1e-6;
+        profiler.submitGpuZone(gpuTrack, zone.name, toCpuTicks(begin), toCpuTicks(end), zone.depth);
+    }
+}
+
+} // namespace SFE
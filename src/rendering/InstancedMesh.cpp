@@ -1,10 +1,21 @@
 #include "rendering/InstancedMesh.hpp"
+#include "core/Camera.hpp"
+#include "core/MemoryTracker.hpp"
+#include "core/Profiler.hpp"
+#include "rendering/GpuInstanceCuller.hpp"
+#include "rendering/RenderStats.hpp"
 #include <glad/glad.h>
+#include <algorithm>
+#include <cmath>
 
 namespace SFE {
 
+InstancedMesh::InstancedMesh() : instanceVBO(0) {
+    setupInstanceVBO();
+}
+
 InstancedMesh::InstancedMesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices)
-    : Mesh(vertices, indices) {
+    : Mesh(vertices, indices), instanceVBO(0) {
     setupInstanceVBO();
 }
 
@@ -14,37 +25,107 @@ InstancedMesh::~InstancedMesh() {
 
 void InstancedMesh::setupInstanceVBO() {
     glGenBuffers(1, &instanceVBO);
-    
-    // Bind VAO first
-    glBindVertexArray(VAO);
-    
-    // Set up instance data buffer
-    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
-    // We'll update the buffer data later with actual instances
-    
-    // Set up matrix attribute pointers (a mat4 uses 4 vertex attributes)
-    std::size_t vec4Size = sizeof(glm::vec4);
-    for (int i = 0; i < 4; i++) {
-        glEnableVertexAttribArray(3 + i); // Start after existing attributes
-        glVertexAttribPointer(3 + i, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4),
-                             (void*)(vec4Size * i));
-        glVertexAttribDivisor(3 + i, 1); // Tell OpenGL this is instanced
-    }
-    
-    glBindVertexArray(0);
+    // We'll update the buffer data later with actual instances; the matrix attribute
+    // pointers live in the arena's shared VAO and are re-pointed in drawInstanced()
 }
 
 void InstancedMesh::updateInstanceData(const std::vector<glm::mat4>& modelMatrices) {
     glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
     glBufferData(GL_ARRAY_BUFFER, modelMatrices.size() * sizeof(glm::mat4),
                  modelMatrices.data(), GL_DYNAMIC_DRAW);
+    RenderStats::getInstance().recordBufferUpload(modelMatrices.size() * sizeof(glm::mat4));
+
+    lodBuckets.assign(1, LodBucket{0, static_cast<uint32_t>(modelMatrices.size())});
+}
+
+void InstancedMesh::updateInstanceData(const std::vector<glm::mat4>& modelMatrices, const Camera& camera,
+                                       float viewportHeight, float maxPixelError) {
+    SFE_PROFILE_SCOPE("InstancedMesh::updateInstanceData");
+    SFE_MEMORY_TAG(Mesh);
+    uint32_t lodCount = std::max(getLodCount(), 1u);
+    if (lodCount == 1) {
+        updateInstanceData(modelMatrices);
+        return;
+    }
+
+    float screenScale = viewportHeight / (2.0f * std::tan(glm::radians(camera.zoom) * 0.5f));
+    glm::vec3 boundsCenter = (getBoundsMin() + getBoundsMax()) * 0.5f;
+    float boundsRadius = glm::length(getBoundsMax() - getBoundsMin()) * 0.5f;
+    glm::vec3 cameraPosition = camera.getPosition();
+
+    // Select per instance: distance to the nearest point of the bounding sphere, scaled by the
+    // largest axis scale so non-uniformly scaled instances never pick too coarse a LOD
+    lodBuckets.assign(lodCount, LodBucket{});
+    instanceLods.resize(modelMatrices.size());
+    for (size_t i = 0; i < modelMatrices.size(); ++i) {
+        const glm::mat4& model = modelMatrices[i];
+        float scale = std::sqrt(std::max({glm::dot(glm::vec3(model[0]), glm::vec3(model[0])),
+                                          glm::dot(glm::vec3(model[1]), glm::vec3(model[1])),
+                                          glm::dot(glm::vec3(model[2]), glm::vec3(model[2]))}));
+        glm::vec3 center = glm::vec3(model * glm::vec4(boundsCenter, 1.0f));
+        float distance = glm::length(center - cameraPosition) - boundsRadius * scale;
+
+        uint32_t lod = selectLod(distance, scale, screenScale, maxPixelError);
+        instanceLods[i] = lod;
+        ++lodBuckets[lod].instanceCount;
+    }
+
+    // Counting sort into contiguous per-LOD ranges of the instance buffer
+    uint32_t offset = 0;
+    for (auto& bucket : lodBuckets) {
+        bucket.firstInstance = offset;
+        offset += bucket.instanceCount;
+    }
+    sortedMatrices.resize(modelMatrices.size());
+    std::vector<uint32_t> cursor(lodCount);
+    for (uint32_t lod = 0; lod < lodCount; ++lod) cursor[lod] = lodBuckets[lod].firstInstance;
+    for (size_t i = 0; i < modelMatrices.size(); ++i) {
+        sortedMatrices[cursor[instanceLods[i]]++] = modelMatrices[i];
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    glBufferData(GL_ARRAY_BUFFER, sortedMatrices.size() * sizeof(glm::mat4),
+                 sortedMatrices.data(), GL_DYNAMIC_DRAW);
+    RenderStats::getInstance().recordBufferUpload(sortedMatrices.size() * sizeof(glm::mat4));
 }
 
 void InstancedMesh::drawInstanced(unsigned int instanceCount) const {
-    glBindVertexArray(VAO);
-    glDrawElementsInstanced(GL_TRIANGLES, static_cast<GLsizei>(indices.size()),
-                          GL_UNSIGNED_INT, 0, instanceCount);
-    glBindVertexArray(0);
+    if (!m_allocation.isValid() || instanceCount == 0) return;
+
+    // Binds the shared VAO for our vertex format and attaches our instance stream to it
+    GeometryArena::getInstance().bindInstanceBuffer(getVertexFormat(), instanceVBO);
+    glDrawElementsInstancedBaseVertex(GL_TRIANGLES, getIndexCount(), GL_UNSIGNED_INT,
+                                      getIndexOffset(), instanceCount, getBaseVertex());
+    RenderStats::getInstance().recordDraw(GL_TRIANGLES, getIndexCount(), instanceCount);
+}
+
+void InstancedMesh::drawInstanced() const {
+    if (!m_allocation.isValid()) return;
+
+    // GL 3.3 has no base instance, so each bucket re-points the instance attributes at its range
+    auto& arena = GeometryArena::getInstance();
+    for (uint32_t lod = 0; lod < lodBuckets.size(); ++lod) {
+        const LodBucket& bucket = lodBuckets[lod];
+        if (bucket.instanceCount == 0) continue;
+        arena.bindInstanceBuffer(getVertexFormat(), instanceVBO, bucket.firstInstance * sizeof(glm::mat4));
+        glDrawElementsInstancedBaseVertex(GL_TRIANGLES, getLodIndexCount(lod), GL_UNSIGNED_INT,
+                                          getLodIndexOffset(lod), bucket.instanceCount, getBaseVertex());
+        RenderStats::getInstance().recordDraw(GL_TRIANGLES, getLodIndexCount(lod), bucket.instanceCount);
+    }
 }
 
-} 
\ No newline at end of file
+void InstancedMesh::drawInstanced(GpuInstanceCuller& culler, const Shader& shader) const {
+    if (!culler.isEnabled()) {
+        drawInstanced();
+        return;
+    }
+    if (!m_allocation.isValid()) return;
+
+    for (uint32_t lod = 0; lod < lodBuckets.size(); ++lod) {
+        const LodBucket& bucket = lodBuckets[lod];
+        if (bucket.instanceCount == 0) continue;
+        culler.cullAndDraw(*this, lod, shader, instanceVBO, bucket.firstInstance, bucket.instanceCount);
+    }
+}
+
+}
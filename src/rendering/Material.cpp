@@ -1,10 +1,11 @@
 #include "rendering/Material.hpp"
+#include "rendering/ResourceRegistry.hpp"
 #include <glad/glad.h>
 #include <stdexcept>
 
 namespace SFE {
 
-Material::Material(std::shared_ptr<Shader> shader)
+Material::Material(ShaderHandle shader)
     : shader(shader) {
     if (!shader) {
         throw std::runtime_error("Material: Shader cannot be null");
@@ -24,7 +25,10 @@ Material::UniformValue Material::getUniform(const std::string& name) const {
 }
 
 void Material::bind() {
-    shader->use();
+    auto& registry = ResourceRegistry::getInstance();
+    Shader* program = registry.get(shader);
+    if (!program) return;
+    program->use();
 
     // Apply render states
     if (blendingEnabled) {
@@ -48,34 +52,41 @@ void Material::bind() {
 
     // Bind uniforms
     for (const auto& [name, value] : uniforms) {
-        std::visit([this, &name](auto&& arg) {
+        std::visit([&](auto&& arg) {
             using T = std::decay_t<decltype(arg)>;
             
             if constexpr (std::is_same_v<T, int>) {
-                shader->setInt(name, arg);
+                program->setInt(name, arg);
             }
             else if constexpr (std::is_same_v<T, float>) {
-                shader->setFloat(name, arg);
+                program->setFloat(name, arg);
             }
             else if constexpr (std::is_same_v<T, glm::vec2>) {
-                shader->setVec2(name, arg);
+                program->setVec2(name, arg);
             }
             else if constexpr (std::is_same_v<T, glm::vec3>) {
-                shader->setVec3(name, arg);
+                program->setVec3(name, arg);
             }
             else if constexpr (std::is_same_v<T, glm::vec4>) {
-                shader->setVec4(name, arg);
+                program->setVec4(name, arg);
             }
             else if constexpr (std::is_same_v<T, glm::mat3>) {
-                shader->setMat3(name, arg);
+                program->setMat3(name, arg);
             }
             else if constexpr (std::is_same_v<T, glm::mat4>) {
-                shader->setMat4(name, arg);
+                program->setMat4(name, arg);
             }
-            else if constexpr (std::is_same_v<T, std::shared_ptr<Texture>>) {
-                if (arg) {
-                    arg->bind();
-                    shader->setInt(name, 0); // Assuming texture unit 0
+            else if constexpr (std::is_same_v<T, TextureHandle>) {
+                if (const Texture* texture = registry.get(arg)) {
+                    texture->bind();
+                    program->setInt(name, 0); // Assuming texture unit 0
+                }
+            }
+            else if constexpr (std::is_same_v<T, TextureSlice>) {
+                if (arg.isValid()) {
+                    registry.getTextureArrays().bind(arg.array, 0);
+                    program->setInt(name, 0);
+                    program->setInt(name + "Layer", arg.layer);
                 }
             }
         }, value);
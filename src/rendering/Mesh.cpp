@@ -1,66 +1,232 @@
 // src/rendering/Mesh.cpp
 #include "rendering/Mesh.hpp"
+#include "rendering/MeshFormat.hpp"
+#include "rendering/MeshOptimizer.hpp"
+#include "rendering/RenderStats.hpp"
+#include "rendering/ResourceRegistry.hpp"
+#include "rendering/Shader.hpp"
+#include "rendering/VertexQuantization.hpp"
+#include "core/Logger.hpp"
+#include "core/VFS.hpp"
+#include "core/MemoryTracker.hpp"
+#include "core/Profiler.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
 #include <iostream>
+#include <utility>
 
 namespace SFE { // Changed namespace to SFE
 
-Mesh::Mesh() : m_VAO(0), m_VBO(0), m_EBO(0), m_indexCount(0), m_texture(nullptr) {
-    glGenVertexArrays(1, &m_VAO);
-    glGenBuffers(1, &m_VBO);
-    glGenBuffers(1, &m_EBO);
+// quantizeVertices() reads Mesh::Vertex arrays as its Standard layout
+static_assert(sizeof(Mesh::Vertex) == 32 && offsetof(Mesh::Vertex, normal) == 12 &&
+                  offsetof(Mesh::Vertex, texCoord) == 24,
+              "Mesh::Vertex must match VertexFormat::Standard");
+
+Mesh::Mesh() = default;
+
+Mesh::Mesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices) {
+    setVertices(vertices, indices);
 }
 
 Mesh::~Mesh() {
-    if (m_EBO) glDeleteBuffers(1, &m_EBO);
-    if (m_VBO) glDeleteBuffers(1, &m_VBO);
-    if (m_VAO) glDeleteVertexArrays(1, &m_VAO);
+    releaseGeometry();
+}
+
+Mesh::Mesh(Mesh&& other) noexcept
+    : m_allocation(other.m_allocation), m_texture(other.m_texture), m_boundsMin(other.m_boundsMin),
+      m_boundsMax(other.m_boundsMax), m_requestedFormat(other.m_requestedFormat),
+      m_lods(std::move(other.m_lods)) {
+    other.m_allocation = GeometryAllocation{};
+    other.m_texture = {};
+}
+
+Mesh& Mesh::operator=(Mesh&& other) noexcept {
+    if (this != &other) {
+        releaseGeometry();
+        m_allocation = other.m_allocation;
+        m_texture = other.m_texture;
+        m_boundsMin = other.m_boundsMin;
+        m_boundsMax = other.m_boundsMax;
+        m_requestedFormat = other.m_requestedFormat;
+        m_lods = std::move(other.m_lods);
+        other.m_allocation = GeometryAllocation{};
+        other.m_texture = {};
+    }
+    return *this;
+}
+
+void Mesh::releaseGeometry() {
+    if (m_allocation.isValid()) {
+        GeometryArena::getInstance().release(m_allocation);
+    }
+    m_lods.clear();
+}
+
+bool Mesh::loadFromFile(const std::string& filename) {
+    SFE_PROFILE_SCOPE("Mesh::loadFromFile");
+    SFE_MEMORY_TAG(Mesh);
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    AssetData file;
+    if (!VFS::getInstance().read(filename, file)) {
+        std::cerr << "Failed to open mesh: " << filename << std::endl;
+        return false;
+    }
+
+    std::string error;
+    const MeshFileHeader* header = validateMeshFile(file.getData(), file.getSize(), error);
+    if (!header) {
+        std::cerr << "Invalid mesh file " << filename << ": " << error << std::endl;
+        return false;
+    }
+
+    auto format = static_cast<VertexFormat>(header->vertexFormat);
+    if (header->vertexStride != static_cast<uint32_t>(GeometryArena::getVertexStride(format))) {
+        std::cerr << "Mesh file " << filename << " has vertex stride " << header->vertexStride
+                  << ", runtime expects " << GeometryArena::getVertexStride(format) << std::endl;
+        return false;
+    }
+
+    releaseGeometry();
+    auto& arena = GeometryArena::getInstance();
+    m_allocation = arena.allocate(format, header->vertexCount, header->indexCount);
+    if (!m_allocation.isValid()) {
+        std::cerr << "Mesh: failed to allocate " << filename << " in geometry arena" << std::endl;
+        return false;
+    }
+
+    // The file stores the GPU layout, so the mapped pages (of the pack or the loose file) are uploaded as-is
+    arena.upload(m_allocation, file.getData() + header->vertexDataOffset,
+                 reinterpret_cast<const uint32_t*>(file.getData() + header->indexDataOffset));
+    m_boundsMin = glm::vec3(header->boundsMin[0], header->boundsMin[1], header->boundsMin[2]);
+    m_boundsMax = glm::vec3(header->boundsMax[0], header->boundsMax[1], header->boundsMax[2]);
+
+    if (const MeshFileLod* lods = getMeshFileLods(file.getData(), *header)) {
+        for (uint32_t i = 0; i < header->lodCount; ++i) {
+            m_lods.push_back({lods[i].firstIndex, lods[i].indexCount, lods[i].error});
+        }
+    } else {
+        m_lods.push_back({0, header->indexCount, 0.0f});
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - startTime;
+    double megabytes = static_cast<double>(file.getSize()) / (1024.0 * 1024.0);
+    std::cout << "Loaded mesh " << filename << ": " << header->vertexCount << " vertices, "
+              << m_lods[0].indexCount / 3 << " triangles, " << m_lods.size() << " LODs, "
+              << megabytes * 1024.0 << " KB in " << elapsed.count() * 1000.0 << " ms ("
+              << megabytes / std::max(elapsed.count(), 1e-9) << " MB/s)" << std::endl;
+    return true;
 }
 
 void Mesh::setVertices(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices) {
-    glBindVertexArray(m_VAO);
+    uploadGeometry(vertices, indices, {{0, static_cast<uint32_t>(indices.size()), 0.0f}});
+}
+
+void Mesh::uploadGeometry(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+                          std::vector<MeshLod> lods) {
+    SFE_MEMORY_TAG(Mesh);
+    releaseGeometry();
+    if (vertices.empty() || indices.empty()) return;
 
-    // Vertex data
-    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
+    m_boundsMin = m_boundsMax = vertices[0].position;
+    for (const auto& vertex : vertices) {
+        m_boundsMin = glm::min(m_boundsMin, vertex.position);
+        m_boundsMax = glm::max(m_boundsMax, vertex.position);
+    }
+
+    auto& arena = GeometryArena::getInstance();
+    m_allocation = arena.allocate(m_requestedFormat, static_cast<uint32_t>(vertices.size()),
+                                  static_cast<uint32_t>(indices.size()));
+    if (!m_allocation.isValid()) {
+        std::cerr << "Mesh: failed to allocate " << vertices.size() << " vertices in geometry arena"
+                  << std::endl;
+        return;
+    }
 
-    // Index data
-    m_indexCount = static_cast<GLsizei>(indices.size());
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+    if (isQuantized(m_requestedFormat)) {
+        std::vector<uint8_t> packed = quantizeVertices(m_requestedFormat, vertices.data(), vertices.size(),
+                                                       &m_boundsMin.x, &m_boundsMax.x);
+        arena.upload(m_allocation, packed.data(), indices.data());
+    } else {
+        arena.upload(m_allocation, vertices.data(), indices.data());
+    }
+    m_lods = std::move(lods);
+}
 
-    // Position attribute
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
-    glEnableVertexAttribArray(0);
+void Mesh::applyVertexDecode(const Shader& shader) const {
+    if (isQuantized(m_allocation.format)) {
+        shader.setVec3("positionOffset", m_boundsMin);
+        shader.setVec3("positionScale", m_boundsMax - m_boundsMin);
+    } else {
+        shader.setVec3("positionOffset", glm::vec3(0.0f));
+        shader.setVec3("positionScale", glm::vec3(1.0f));
+    }
+    shader.setBool("octNormals", m_allocation.format == VertexFormat::QuantizedOct);
+}
 
-    // Normal attribute
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, normal));
-    glEnableVertexAttribArray(1);
+void Mesh::setVertices(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+                       bool optimize, uint32_t lodCount) {
+    SFE_MEMORY_TAG(Mesh);
+    if (!optimize && lodCount <= 1) {
+        setVertices(vertices, indices);
+        return;
+    }
+    if (vertices.empty() || indices.empty()) return;
 
-    // Texture coordinate attribute
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texCoord));
-    glEnableVertexAttribArray(2);
+    std::vector<Vertex> optimizedVertices = vertices;
+    std::vector<unsigned int> optimizedIndices = indices;
+    if (optimize) {
+        auto report = optimizeMesh(optimizedVertices, optimizedIndices, offsetof(Vertex, position));
+        char summary[96];
+        std::snprintf(summary, sizeof(summary), "Mesh optimised: ACMR %.3f -> %.3f, ATVR %.3f -> %.3f",
+                      report.before.acmr, report.after.acmr, report.before.atvr, report.after.atvr);
+        Logger::getInstance().logMessage(summary);
+        // The optimiser drops triangles that reference missing vertices
+        if (optimizedIndices.empty()) return;
+    }
+    if (lodCount <= 1) {
+        setVertices(optimizedVertices, optimizedIndices);
+        return;
+    }
 
-    glBindVertexArray(0);
+    LodChain chain = buildLodChain(optimizedIndices, &optimizedVertices[0].position.x, optimizedVertices.size(),
+                                   sizeof(Vertex), lodCount);
+    uploadGeometry(optimizedVertices, chain.indices, std::move(chain.lods));
 }
 
-void Mesh::setTexture(Texture* texture) {
-    m_texture = texture;
+uint32_t Mesh::selectLod(float distance, float scale, float screenScale, float maxPixelError) const {
+    // Errors grow monotonically along the chain, so stop at the first LOD that is too coarse
+    float pixelsPerUnit = scale * screenScale / std::max(distance, 1e-4f);
+    uint32_t selected = 0;
+    for (uint32_t lod = 1; lod < m_lods.size(); ++lod) {
+        if (m_lods[lod].error * pixelsPerUnit > maxPixelError) break;
+        selected = lod;
+    }
+    return selected;
 }
 
 void Mesh::render() const {
-    if (m_texture) {
-        m_texture->bind();
+    const Texture* texture = ResourceRegistry::getInstance().get(m_texture);
+    if (texture) {
+        texture->bind();
     }
 
-    glBindVertexArray(m_VAO);
-    if (m_indexCount > 0) {
-        glDrawElements(GL_TRIANGLES, m_indexCount, GL_UNSIGNED_INT, 0);
-    }
-    glBindVertexArray(0);
+    draw();
 
-    if (m_texture) {
-        m_texture->unbind();
+    if (texture) {
+        texture->unbind();
     }
 }
 
-} // End namespace SFE 
\ No newline at end of file
+void Mesh::draw() const {
+    if (!m_allocation.isValid()) return;
+
+    // Shared VAO: consecutive meshes of the same format only differ in their draw offsets
+    GeometryArena::getInstance().bindVertexFormat(m_allocation.format);
+    glDrawElementsBaseVertex(GL_TRIANGLES, getIndexCount(), GL_UNSIGNED_INT, getIndexOffset(),
+                             getBaseVertex());
+    RenderStats::getInstance().recordDraw(GL_TRIANGLES, getIndexCount());
+}
+
+} // End namespace SFE
@@ -0,0 +1,142 @@
+#include "rendering/MeshFormat.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+namespace SFE {
+
+namespace {
+
+uint64_t alignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+} // namespace
+
+bool writeMeshFile(const std::string& path, const MeshFileDesc& desc) {
+    MeshFileHeader header{};
+    header.magic = MESH_FILE_MAGIC;
+    header.version = MESH_FILE_VERSION;
+    header.vertexFormat = static_cast<uint32_t>(desc.vertexFormat);
+    header.vertexStride = desc.vertexStride;
+    header.vertexCount = desc.vertexCount;
+    header.indexCount = desc.indexCount;
+    header.flags = desc.flags;
+    header.lodCount = desc.lods ? desc.lodCount : 0;
+    std::memcpy(header.boundsMin, desc.boundsMin, sizeof(header.boundsMin));
+    std::memcpy(header.boundsMax, desc.boundsMax, sizeof(header.boundsMax));
+
+    uint64_t vertexBytes = uint64_t(desc.vertexCount) * desc.vertexStride;
+    uint64_t indexBytes = uint64_t(desc.indexCount) * sizeof(uint32_t);
+    uint64_t lodBytes = uint64_t(header.lodCount) * sizeof(MeshFileLod);
+    header.lodTableOffset = header.lodCount ? alignUp(sizeof(MeshFileHeader), MESH_FILE_ALIGNMENT) : 0;
+    header.vertexDataOffset = alignUp(sizeof(MeshFileHeader) + lodBytes, MESH_FILE_ALIGNMENT);
+    header.indexDataOffset = alignUp(header.vertexDataOffset + vertexBytes, MESH_FILE_ALIGNMENT);
+    header.fileSize = header.indexDataOffset + indexBytes;
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    const char zeros[MESH_FILE_ALIGNMENT] = {};
+    auto padTo = [&](uint64_t offset) {
+        uint64_t position = static_cast<uint64_t>(file.tellp());
+        file.write(zeros, static_cast<std::streamsize>(offset - position));
+    };
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    if (header.lodCount) {
+        padTo(header.lodTableOffset);
+        file.write(reinterpret_cast<const char*>(desc.lods), static_cast<std::streamsize>(lodBytes));
+    }
+    padTo(header.vertexDataOffset);
+    file.write(static_cast<const char*>(desc.vertexData), static_cast<std::streamsize>(vertexBytes));
+    padTo(header.indexDataOffset);
+    file.write(reinterpret_cast<const char*>(desc.indexData), static_cast<std::streamsize>(indexBytes));
+
+    return file.good();
+}
+
+const MeshFileHeader* validateMeshFile(const uint8_t* data, size_t size, std::string& error) {
+    if (!data || size < sizeof(MeshFileHeader)) {
+        error = "file too small for header";
+        return nullptr;
+    }
+
+    const auto* header = reinterpret_cast<const MeshFileHeader*>(data);
+    if (header->magic != MESH_FILE_MAGIC) {
+        error = "bad magic";
+        return nullptr;
+    }
+    if (header->version < MESH_FILE_MIN_VERSION || header->version > MESH_FILE_VERSION) {
+        error = "unsupported version " + std::to_string(header->version) + " (expected " +
+                std::to_string(MESH_FILE_VERSION) + ")";
+        return nullptr;
+    }
+    if (header->vertexFormat >= static_cast<uint32_t>(VertexFormat::Count)) {
+        error = "unknown vertex format " + std::to_string(header->vertexFormat);
+        return nullptr;
+    }
+    if (header->fileSize != size) {
+        error = "truncated or padded file";
+        return nullptr;
+    }
+
+    uint64_t vertexEnd = header->vertexDataOffset + uint64_t(header->vertexCount) * header->vertexStride;
+    uint64_t indexEnd = header->indexDataOffset + uint64_t(header->indexCount) * sizeof(uint32_t);
+    if (vertexEnd > size || indexEnd > size || header->indexCount % 3 != 0 ||
+        header->indexDataOffset % alignof(uint32_t) != 0) {
+        error = "section out of range";
+        return nullptr;
+    }
+    auto vertexFormat = static_cast<VertexFormat>(header->vertexFormat);
+    if (header->vertexDataOffset % getVertexAlignment(vertexFormat) != 0) {
+        error = "vertex data misaligned";
+        return nullptr;
+    }
+
+    // Vertex data is uploaded straight from the file, so it must not alias another section
+    auto overlapsVertices = [&](uint64_t begin, uint64_t end) {
+        return begin < end && begin < vertexEnd && header->vertexDataOffset < end;
+    };
+    // Version 1 headers had the LOD fields reserved (zero)
+    bool hasLodTable = header->version >= 2 && header->lodCount;
+    uint64_t lodTableEnd = header->lodTableOffset + uint64_t(header->lodCount) * sizeof(MeshFileLod);
+    if (header->vertexDataOffset < sizeof(MeshFileHeader) ||
+        overlapsVertices(header->indexDataOffset, indexEnd) || (hasLodTable && overlapsVertices(header->lodTableOffset, lodTableEnd))) {
+        error = "vertex data overlaps another section";
+        return nullptr;
+    }
+
+    // An index past the vertex data would make the GPU read other meshes' vertices
+    const auto* indices = reinterpret_cast<const uint32_t*>(data + header->indexDataOffset);
+    uint32_t maxIndex = 0;
+    for (uint32_t i = 0; i < header->indexCount; ++i) maxIndex = std::max(maxIndex, indices[i]);
+    if (header->indexCount > 0 && maxIndex >= header->vertexCount) {
+        error = "index " + std::to_string(maxIndex) + " out of range for " + std::to_string(header->vertexCount) +
+                " vertices";
+        return nullptr;
+    }
+
+    if (hasLodTable) {
+        if (header->lodCount > MESH_FILE_MAX_LODS || header->lodTableOffset % alignof(MeshFileLod) != 0 ||
+            lodTableEnd > size) {
+            error = "LOD table out of range";
+            return nullptr;
+        }
+        const MeshFileLod* lods = getMeshFileLods(data, *header);
+        for (uint32_t i = 0; i < header->lodCount; ++i) {
+            if (lods[i].indexCount % 3 != 0 ||
+                uint64_t(lods[i].firstIndex) + lods[i].indexCount > header->indexCount) {
+                error = "LOD " + std::to_string(i) + " index range out of range";
+                return nullptr;
+            }
+        }
+    }
+
+    return header;
+}
+
+} // namespace SFE
@@ -0,0 +1,335 @@
+#include "rendering/MeshOptimizer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace SFE {
+
+namespace {
+
+constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+
+// Forsyth scoring parameters (see "Linear-Speed Vertex Cache Optimisation", 2006)
+constexpr int FORSYTH_CACHE_SIZE = 32;
+constexpr float CACHE_DECAY_POWER = 1.5f;
+constexpr float LAST_TRIANGLE_SCORE = 0.75f;
+constexpr float VALENCE_BOOST_SCALE = 2.0f;
+constexpr float VALENCE_BOOST_POWER = 0.5f;
+
+float vertexScore(int cachePosition, uint32_t remainingValence) {
+    if (remainingValence == 0) return -1.0f;
+
+    float score = 0.0f;
+    if (cachePosition >= 0) {
+        if (cachePosition < 3) {
+            // The three most recent vertices get a fixed score so the next triangle does not
+            // simply reuse the edge that was just emitted
+            score = LAST_TRIANGLE_SCORE;
+        } else {
+            float scaler = 1.0f / (FORSYTH_CACHE_SIZE - 3);
+            score = std::pow(1.0f - (cachePosition - 3) * scaler, CACHE_DECAY_POWER);
+        }
+    }
+
+    // Favour vertices with few triangles left so they get finished off
+    score += VALENCE_BOOST_SCALE * std::pow(static_cast<float>(remainingValence), -VALENCE_BOOST_POWER);
+    return score;
+}
+
+struct Vec3 {
+    float x, y, z;
+};
+
+Vec3 readPosition(const float* positions, size_t positionStride, uint32_t index) {
+    const float* p = reinterpret_cast<const float*>(reinterpret_cast<const uint8_t*>(positions) +
+                                                    index * positionStride);
+    return {p[0], p[1], p[2]};
+}
+
+// Whole triangles of 'indices' whose three vertices exist. Returns 'indices' itself when nothing
+// needs dropping, otherwise a filtered copy in 'storage'.
+const std::vector<uint32_t>& validTriangles(const std::vector<uint32_t>& indices, size_t vertexCount,
+                                            std::vector<uint32_t>& storage) {
+    size_t wholeCount = indices.size() - indices.size() % 3;
+    auto inRange = [vertexCount](uint32_t index) { return index < vertexCount; };
+    bool valid = wholeCount == indices.size() && std::all_of(indices.begin(), indices.end(), inRange);
+    if (valid) return indices;
+
+    storage.clear();
+    storage.reserve(wholeCount);
+    for (size_t i = 0; i < wholeCount; i += 3) {
+        if (indices[i] < vertexCount && indices[i + 1] < vertexCount && indices[i + 2] < vertexCount) {
+            storage.insert(storage.end(), indices.begin() + i, indices.begin() + i + 3);
+        }
+    }
+    return storage;
+}
+
+} // namespace
+
+VertexCacheStats analyzeVertexCache(const std::vector<uint32_t>& indices, size_t vertexCount,
+                                    uint32_t cacheSize) {
+    VertexCacheStats stats;
+    if (indices.empty() || vertexCount == 0) return stats;
+
+    // FIFO cache: a vertex is resident if it was inserted less than cacheSize misses ago
+    std::vector<uint32_t> insertedAt(vertexCount, 0);
+    std::vector<bool> referenced(vertexCount, false);
+    uint32_t misses = 0;
+    size_t uniqueVertices = 0;
+
+    for (uint32_t index : indices) {
+        if (index >= vertexCount) continue;
+        if (!referenced[index]) {
+            referenced[index] = true;
+            ++uniqueVertices;
+        }
+        bool resident = insertedAt[index] != 0 && misses + 1 - insertedAt[index] <= cacheSize;
+        if (!resident) {
+            ++misses;
+            insertedAt[index] = misses;
+        }
+    }
+
+    stats.vertexTransforms = misses;
+    stats.acmr = static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+    stats.atvr = uniqueVertices ? static_cast<float>(misses) / static_cast<float>(uniqueVertices) : 0.0f;
+    return stats;
+}
+
+std::vector<uint32_t> optimizeVertexCache(const std::vector<uint32_t>& sourceIndices, size_t vertexCount) {
+    std::vector<uint32_t> checked;
+    const std::vector<uint32_t>& indices = validTriangles(sourceIndices, vertexCount, checked);
+    size_t triangleCount = indices.size() / 3;
+    std::vector<uint32_t> result;
+    result.reserve(triangleCount * 3);
+    if (triangleCount == 0) return result;
+
+    // Vertex -> triangle adjacency in CSR form
+    std::vector<uint32_t> valence(vertexCount, 0);
+    for (uint32_t index : indices) {
+        ++valence[index];
+    }
+    std::vector<uint32_t> adjacencyOffset(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        adjacencyOffset[v + 1] = adjacencyOffset[v] + valence[v];
+    }
+    std::vector<uint32_t> adjacency(indices.size());
+    std::vector<uint32_t> fill(adjacencyOffset.begin(), adjacencyOffset.end() - 1);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        for (size_t k = 0; k < 3; ++k) {
+            adjacency[fill[indices[t * 3 + k]]++] = static_cast<uint32_t>(t);
+        }
+    }
+
+    std::vector<float> score(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        score[v] = vertexScore(-1, valence[v]);
+    }
+
+    std::vector<bool> emitted(triangleCount, false);
+
+    // LRU cache with room for the three vertices being pushed in
+    std::vector<uint32_t> cache;
+    std::vector<uint32_t> nextCache;
+    cache.reserve(FORSYTH_CACHE_SIZE + 3);
+    nextCache.reserve(FORSYTH_CACHE_SIZE + 3);
+
+    size_t scanCursor = 0;
+    uint32_t bestTriangle = 0;
+    for (float bestScore = -1.0f; true;) {
+        if (bestScore < 0.0f) {
+            // Nothing in the cache has triangles left: fall back to the next unemitted triangle
+            while (scanCursor < triangleCount && emitted[scanCursor]) ++scanCursor;
+            if (scanCursor == triangleCount) break;
+            bestTriangle = static_cast<uint32_t>(scanCursor);
+        }
+
+        emitted[bestTriangle] = true;
+        const uint32_t* tri = &indices[size_t(bestTriangle) * 3];
+        result.insert(result.end(), tri, tri + 3);
+
+        // Push the triangle's vertices to the front of the cache and retire its adjacency
+        nextCache.assign(tri, tri + 3);
+        for (size_t k = 0; k < 3; ++k) {
+            uint32_t v = tri[k];
+            uint32_t* begin = &adjacency[adjacencyOffset[v]];
+            uint32_t* end = begin + valence[v];
+            uint32_t* found = std::find(begin, end, bestTriangle);
+            if (found != end) {
+                std::swap(*found, *(end - 1));
+                --valence[v];
+            }
+        }
+        for (uint32_t v : cache) {
+            if (v != tri[0] && v != tri[1] && v != tri[2]) nextCache.push_back(v);
+        }
+        for (size_t i = FORSYTH_CACHE_SIZE; i < nextCache.size(); ++i) {
+            score[nextCache[i]] = vertexScore(-1, valence[nextCache[i]]);
+        }
+        if (nextCache.size() > FORSYTH_CACHE_SIZE) nextCache.resize(FORSYTH_CACHE_SIZE);
+        cache.swap(nextCache);
+
+        // Rescore cached vertices and their live triangles; remember the best candidate
+        for (size_t i = 0; i < cache.size(); ++i) {
+            score[cache[i]] = vertexScore(static_cast<int>(i), valence[cache[i]]);
+        }
+        bestScore = -1.0f;
+        for (uint32_t v : cache) {
+            for (uint32_t a = 0; a < valence[v]; ++a) {
+                uint32_t t = adjacency[adjacencyOffset[v] + a];
+                float s = score[indices[size_t(t) * 3]] + score[indices[size_t(t) * 3 + 1]] +
+                          score[indices[size_t(t) * 3 + 2]];
+                if (s > bestScore) {
+                    bestScore = s;
+                    bestTriangle = t;
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+std::vector<uint32_t> optimizeOverdraw(const std::vector<uint32_t>& sourceIndices, const float* positions,
+                                       size_t vertexCount, size_t positionStride, float threshold) {
+    std::vector<uint32_t> checked;
+    const std::vector<uint32_t>& indices = validTriangles(sourceIndices, vertexCount, checked);
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount < 2 || !positions) return indices;
+
+    // Split the cache-ordered stream into clusters: hard boundaries where the simulated cache
+    // missed all three vertices (the optimiser restarted), soft boundaries wherever the cluster
+    // so far is already within 'threshold' of the whole mesh's ACMR
+    const uint32_t cacheSize = 16;
+    float meshAcmr = analyzeVertexCache(indices, vertexCount, cacheSize).acmr;
+
+    std::vector<size_t> clusterStart{0};
+    std::vector<uint32_t> insertedAt(vertexCount, 0);
+    uint32_t misses = 0;
+    uint32_t clusterMisses = 0;
+    for (size_t t = 0; t < triangleCount; ++t) {
+        uint32_t triangleMisses = 0;
+        for (size_t k = 0; k < 3; ++k) {
+            uint32_t v = indices[t * 3 + k];
+            if (insertedAt[v] == 0 || misses + 1 - insertedAt[v] > cacheSize) {
+                insertedAt[v] = ++misses;
+                ++triangleMisses;
+            }
+        }
+
+        size_t clusterTriangles = t - clusterStart.back();
+        float clusterAcmr = clusterTriangles ? float(clusterMisses) / float(clusterTriangles) : 0.0f;
+        bool hardBoundary = triangleMisses == 3 && clusterTriangles > 0;
+        bool softBoundary = clusterTriangles >= 16 && clusterAcmr <= meshAcmr * threshold &&
+                            triangleMisses >= 2;
+        if (hardBoundary || softBoundary) {
+            clusterStart.push_back(t);
+            clusterMisses = 0;
+        }
+        clusterMisses += triangleMisses;
+    }
+    clusterStart.push_back(triangleCount);
+
+    // Mesh centroid (area weighted)
+    Vec3 meshCentroid{0.0f, 0.0f, 0.0f};
+    float meshArea = 0.0f;
+    std::vector<Vec3> triangleNormal(triangleCount);
+    std::vector<Vec3> triangleCentroid(triangleCount);
+    std::vector<float> triangleArea(triangleCount);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        Vec3 a = readPosition(positions, positionStride, indices[t * 3]);
+        Vec3 b = readPosition(positions, positionStride, indices[t * 3 + 1]);
+        Vec3 c = readPosition(positions, positionStride, indices[t * 3 + 2]);
+        Vec3 e1{b.x - a.x, b.y - a.y, b.z - a.z};
+        Vec3 e2{c.x - a.x, c.y - a.y, c.z - a.z};
+        Vec3 n{e1.y * e2.z - e1.z * e2.y, e1.z * e2.x - e1.x * e2.z, e1.x * e2.y - e1.y * e2.x};
+        float area = 0.5f * std::sqrt(n.x * n.x + n.y * n.y + n.z * n.z);
+        Vec3 centroid{(a.x + b.x + c.x) / 3.0f, (a.y + b.y + c.y) / 3.0f, (a.z + b.z + c.z) / 3.0f};
+
+        triangleNormal[t] = n; // Length is 2 * area, so summing gives area-weighted normals
+        triangleCentroid[t] = centroid;
+        triangleArea[t] = area;
+        meshCentroid.x += centroid.x * area;
+        meshCentroid.y += centroid.y * area;
+        meshCentroid.z += centroid.z * area;
+        meshArea += area;
+    }
+    if (meshArea > 0.0f) {
+        meshCentroid = {meshCentroid.x / meshArea, meshCentroid.y / meshArea, meshCentroid.z / meshArea};
+    }
+
+    // Outward-facing clusters far from the centre tend to occlude the rest: draw them first
+    size_t clusterCount = clusterStart.size() - 1;
+    std::vector<float> sortKey(clusterCount);
+    for (size_t c = 0; c < clusterCount; ++c) {
+        Vec3 centroid{0.0f, 0.0f, 0.0f};
+        Vec3 normal{0.0f, 0.0f, 0.0f};
+        float area = 0.0f;
+        for (size_t t = clusterStart[c]; t < clusterStart[c + 1]; ++t) {
+            centroid.x += triangleCentroid[t].x * triangleArea[t];
+            centroid.y += triangleCentroid[t].y * triangleArea[t];
+            centroid.z += triangleCentroid[t].z * triangleArea[t];
+            normal.x += triangleNormal[t].x;
+            normal.y += triangleNormal[t].y;
+            normal.z += triangleNormal[t].z;
+            area += triangleArea[t];
+        }
+        float normalLength = std::sqrt(normal.x * normal.x + normal.y * normal.y + normal.z * normal.z);
+        if (area <= 0.0f || normalLength <= 0.0f) {
+            sortKey[c] = -std::numeric_limits<float>::max();
+            continue;
+        }
+        Vec3 offset{centroid.x / area - meshCentroid.x, centroid.y / area - meshCentroid.y,
+                    centroid.z / area - meshCentroid.z};
+        sortKey[c] = (offset.x * normal.x + offset.y * normal.y + offset.z * normal.z) / normalLength;
+    }
+
+    std::vector<uint32_t> order(clusterCount);
+    for (size_t c = 0; c < clusterCount; ++c) order[c] = static_cast<uint32_t>(c);
+    std::stable_sort(order.begin(), order.end(),
+                     [&](uint32_t lhs, uint32_t rhs) { return sortKey[lhs] > sortKey[rhs]; });
+
+    std::vector<uint32_t> result;
+    result.reserve(indices.size());
+    for (uint32_t c : order) {
+        result.insert(result.end(), indices.begin() + clusterStart[c] * 3,
+                      indices.begin() + clusterStart[c + 1] * 3);
+    }
+    return result;
+}
+
+size_t buildVertexFetchRemap(std::vector<uint32_t>& remap, const std::vector<uint32_t>& indices,
+                             size_t vertexCount) {
+    remap.assign(vertexCount, INVALID_INDEX);
+    uint32_t next = 0;
+    for (uint32_t index : indices) {
+        if (index >= vertexCount) continue;
+        if (remap[index] == INVALID_INDEX) {
+            remap[index] = next++;
+        }
+    }
+    return next;
+}
+
+void remapVertexBuffer(void* vertices, size_t vertexCount, size_t vertexSize,
+                       const std::vector<uint32_t>& remap) {
+    std::vector<uint8_t> source(static_cast<uint8_t*>(vertices),
+                                static_cast<uint8_t*>(vertices) + vertexCount * vertexSize);
+    auto* destination = static_cast<uint8_t*>(vertices);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        if (remap[v] != INVALID_INDEX) {
+            std::memcpy(destination + size_t(remap[v]) * vertexSize, source.data() + v * vertexSize,
+                        vertexSize);
+        }
+    }
+}
+
+void remapIndexBuffer(std::vector<uint32_t>& indices, const std::vector<uint32_t>& remap) {
+    for (uint32_t& index : indices) {
+        if (index < remap.size()) index = remap[index];
+    }
+}
+
+} // namespace SFE
@@ -0,0 +1,303 @@
+#include "rendering/MeshSimplifier.hpp"
+#include "rendering/MeshOptimizer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace SFE {
+
+namespace {
+
+struct Vec3 {
+    float x, y, z;
+};
+
+Vec3 operator-(const Vec3& a, const Vec3& b) { return {a.x - b.x, a.y - b.y, a.z - b.z}; }
+
+Vec3 cross(const Vec3& a, const Vec3& b) {
+    return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+}
+
+float dot(const Vec3& a, const Vec3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+
+// Symmetric 4x4 error quadric: Q(p) = p'Ap + 2b'p + c, accumulated with area weights so that
+// Q(p) / weight is the mean squared distance of p to the planes of the absorbed triangles
+struct Quadric {
+    double a00 = 0, a11 = 0, a22 = 0, a01 = 0, a02 = 0, a12 = 0;
+    double b0 = 0, b1 = 0, b2 = 0, c = 0;
+    double weight = 0;
+
+    void addPlane(double nx, double ny, double nz, double d, double w) {
+        a00 += w * nx * nx; a11 += w * ny * ny; a22 += w * nz * nz;
+        a01 += w * nx * ny; a02 += w * nx * nz; a12 += w * ny * nz;
+        b0 += w * nx * d; b1 += w * ny * d; b2 += w * nz * d;
+        c += w * d * d;
+        weight += w;
+    }
+
+    void add(const Quadric& other) {
+        a00 += other.a00; a11 += other.a11; a22 += other.a22;
+        a01 += other.a01; a02 += other.a02; a12 += other.a12;
+        b0 += other.b0; b1 += other.b1; b2 += other.b2;
+        c += other.c;
+        weight += other.weight;
+    }
+
+    double evaluate(const Vec3& p) const {
+        double x = p.x, y = p.y, z = p.z;
+        double result = a00 * x * x + a11 * y * y + a22 * z * z +
+                        2.0 * (a01 * x * y + a02 * x * z + a12 * y * z) +
+                        2.0 * (b0 * x + b1 * y + b2 * z) + c;
+        return std::max(result, 0.0);
+    }
+};
+
+struct Collapse {
+    uint32_t from;
+    uint32_t to;
+    float cost; // Squared error
+};
+
+struct PositionKey {
+    uint32_t bits[3];
+    bool operator==(const PositionKey& other) const {
+        return bits[0] == other.bits[0] && bits[1] == other.bits[1] && bits[2] == other.bits[2];
+    }
+};
+
+struct PositionKeyHash {
+    size_t operator()(const PositionKey& key) const {
+        return (key.bits[0] * 73856093u) ^ (key.bits[1] * 19349663u) ^ (key.bits[2] * 83492791u);
+    }
+};
+
+// Map every vertex to the first vertex with a bit-identical position
+std::vector<uint32_t> buildPositionRemap(const std::vector<Vec3>& positions) {
+    std::vector<uint32_t> canonical(positions.size());
+    std::unordered_map<PositionKey, uint32_t, PositionKeyHash> firstVertex;
+    firstVertex.reserve(positions.size());
+    for (uint32_t v = 0; v < positions.size(); ++v) {
+        PositionKey key;
+        std::memcpy(key.bits, &positions[v], sizeof(key.bits));
+        canonical[v] = firstVertex.emplace(key, v).first->second;
+    }
+    return canonical;
+}
+
+// Lock vertices on open edges and on attribute seams; everything else may be collapsed
+std::vector<bool> findLockedVertices(const std::vector<uint32_t>& indices, const std::vector<uint32_t>& canonical) {
+    size_t vertexCount = canonical.size();
+    std::vector<bool> locked(vertexCount, false);
+
+    std::vector<uint32_t> wedgeCount(vertexCount, 0);
+    std::vector<bool> referenced(vertexCount, false);
+    for (uint32_t index : indices) referenced[index] = true;
+    for (uint32_t v = 0; v < vertexCount; ++v) {
+        if (referenced[v]) ++wedgeCount[canonical[v]];
+    }
+
+    std::unordered_set<uint64_t> directedEdges;
+    directedEdges.reserve(indices.size());
+    auto edgeKey = [](uint32_t a, uint32_t b) { return (uint64_t(a) << 32) | b; };
+    for (size_t i = 0; i < indices.size(); i += 3) {
+        for (int e = 0; e < 3; ++e) {
+            directedEdges.insert(edgeKey(canonical[indices[i + e]], canonical[indices[i + (e + 1) % 3]]));
+        }
+    }
+
+    std::vector<bool> lockedPosition(vertexCount, false);
+    for (size_t i = 0; i < indices.size(); i += 3) {
+        for (int e = 0; e < 3; ++e) {
+            uint32_t a = canonical[indices[i + e]];
+            uint32_t b = canonical[indices[i + (e + 1) % 3]];
+            if (!directedEdges.count(edgeKey(b, a))) {
+                lockedPosition[a] = true;
+                lockedPosition[b] = true;
+            }
+        }
+    }
+
+    for (uint32_t v = 0; v < vertexCount; ++v) {
+        locked[v] = lockedPosition[canonical[v]] || wedgeCount[canonical[v]] > 1;
+    }
+    return locked;
+}
+
+// Would replacing 'from' by 'to' flip (or collapse to zero area) a surviving triangle around 'from'?
+bool collapseFlipsTriangle(uint32_t from, uint32_t to, const std::vector<uint32_t>& indices,
+                           const std::vector<uint32_t>& adjacencyOffsets,
+                           const std::vector<uint32_t>& adjacency, const std::vector<uint32_t>& remap,
+                           const std::vector<Vec3>& positions) {
+    for (uint32_t a = adjacencyOffsets[from]; a < adjacencyOffsets[from + 1]; ++a) {
+        uint32_t triangle = adjacency[a];
+        uint32_t v[3] = {remap[indices[triangle * 3 + 0]], remap[indices[triangle * 3 + 1]],
+                         remap[indices[triangle * 3 + 2]]};
+        if (v[0] == to || v[1] == to || v[2] == to) continue; // Degenerates and disappears
+        if (v[0] == v[1] || v[1] == v[2] || v[0] == v[2]) continue;
+
+        Vec3 before = cross(positions[v[1]] - positions[v[0]], positions[v[2]] - positions[v[0]]);
+        for (auto& vertex : v) {
+            if (vertex == from) vertex = to;
+        }
+        Vec3 after = cross(positions[v[1]] - positions[v[0]], positions[v[2]] - positions[v[0]]);
+        if (dot(before, after) <= 0.0f) return true;
+    }
+    return false;
+}
+
+} // namespace
+
+std::vector<uint32_t> simplifyMesh(const std::vector<uint32_t>& indices, const float* positions,
+                                   size_t vertexCount, size_t positionStride, size_t targetIndexCount,
+                                   float targetError, float* resultError) {
+    std::vector<uint32_t> result = indices;
+    float maxCost = 0.0f;
+    if (indices.size() <= targetIndexCount || vertexCount == 0) {
+        if (resultError) *resultError = 0.0f;
+        return result;
+    }
+
+    std::vector<Vec3> points(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        std::memcpy(&points[v], reinterpret_cast<const uint8_t*>(positions) + v * positionStride, sizeof(Vec3));
+    }
+
+    std::vector<uint32_t> canonical = buildPositionRemap(points);
+    std::vector<bool> locked = findLockedVertices(indices, canonical);
+
+    // Per-position quadrics from the planes of the original triangles, weighted by area
+    std::vector<Quadric> quadrics(vertexCount);
+    for (size_t i = 0; i < indices.size(); i += 3) {
+        const Vec3& p0 = points[indices[i]];
+        Vec3 normal = cross(points[indices[i + 1]] - p0, points[indices[i + 2]] - p0);
+        double length = std::sqrt(double(dot(normal, normal)));
+        if (length <= 0.0) continue;
+        double nx = normal.x / length, ny = normal.y / length, nz = normal.z / length;
+        double d = -(nx * p0.x + ny * p0.y + nz * p0.z);
+        for (int corner = 0; corner < 3; ++corner) {
+            quadrics[canonical[indices[i + corner]]].addPlane(nx, ny, nz, d, length * 0.5);
+        }
+    }
+
+    float maxCostLimit = targetError >= std::sqrt(std::numeric_limits<float>::max())
+                             ? std::numeric_limits<float>::max()
+                             : targetError * targetError;
+    std::vector<uint32_t> remap(vertexCount);
+    std::vector<bool> touched(vertexCount);
+    std::vector<uint32_t> adjacencyOffsets(vertexCount + 1);
+    std::vector<uint32_t> adjacency;
+    std::vector<Collapse> collapses;
+
+    while (result.size() > targetIndexCount) {
+        size_t triangleCount = result.size() / 3;
+
+        // Vertex -> triangle adjacency for this pass
+        std::fill(adjacencyOffsets.begin(), adjacencyOffsets.end(), 0);
+        for (uint32_t index : result) ++adjacencyOffsets[index + 1];
+        for (size_t v = 0; v < vertexCount; ++v) adjacencyOffsets[v + 1] += adjacencyOffsets[v];
+        adjacency.resize(result.size());
+        std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+        for (size_t i = 0; i < result.size(); ++i) adjacency[fill[result[i]]++] = static_cast<uint32_t>(i / 3);
+
+        // Each interior edge is seen from both of its triangles; keep one orientation
+        collapses.clear();
+        for (size_t i = 0; i < result.size(); i += 3) {
+            for (int e = 0; e < 3; ++e) {
+                uint32_t a = result[i + e];
+                uint32_t b = result[i + (e + 1) % 3];
+                if (a > b) continue;
+                for (int direction = 0; direction < 2; ++direction) {
+                    uint32_t from = direction ? b : a;
+                    uint32_t to = direction ? a : b;
+                    if (locked[from]) continue;
+                    Quadric combined = quadrics[canonical[from]];
+                    combined.add(quadrics[canonical[to]]);
+                    float cost = static_cast<float>(combined.evaluate(points[to]) / std::max(combined.weight, 1e-12));
+                    collapses.push_back({from, to, cost});
+                }
+            }
+        }
+        std::sort(collapses.begin(), collapses.end(),
+                  [](const Collapse& x, const Collapse& y) { return x.cost < y.cost; });
+
+        for (uint32_t v = 0; v < vertexCount; ++v) remap[v] = v;
+        std::fill(touched.begin(), touched.end(), false);
+
+        size_t removedTriangles = 0;
+        size_t targetTriangles = targetIndexCount / 3;
+        size_t collapseCount = 0;
+        for (const Collapse& collapse : collapses) {
+            if (triangleCount - removedTriangles <= targetTriangles) break;
+            if (collapse.cost > maxCostLimit) break; // Sorted: nothing cheaper follows
+            if (touched[collapse.from] || touched[collapse.to]) continue;
+            if (collapseFlipsTriangle(collapse.from, collapse.to, result, adjacencyOffsets, adjacency,
+                                      remap, points)) {
+                continue;
+            }
+
+            for (uint32_t a = adjacencyOffsets[collapse.from]; a < adjacencyOffsets[collapse.from + 1]; ++a) {
+                uint32_t triangle = adjacency[a];
+                for (int corner = 0; corner < 3; ++corner) {
+                    if (remap[result[triangle * 3 + corner]] == collapse.to) ++removedTriangles;
+                }
+            }
+
+            remap[collapse.from] = collapse.to;
+            quadrics[canonical[collapse.to]].add(quadrics[canonical[collapse.from]]);
+            touched[collapse.from] = true;
+            touched[collapse.to] = true;
+            maxCost = std::max(maxCost, collapse.cost);
+            ++collapseCount;
+        }
+
+        if (collapseCount == 0) break;
+
+        // Apply this pass's collapses and drop the triangles they degenerated
+        size_t write = 0;
+        for (size_t i = 0; i < result.size(); i += 3) {
+            uint32_t v0 = remap[result[i]], v1 = remap[result[i + 1]], v2 = remap[result[i + 2]];
+            if (v0 == v1 || v1 == v2 || v0 == v2) continue;
+            result[write++] = v0;
+            result[write++] = v1;
+            result[write++] = v2;
+        }
+        result.resize(write);
+    }
+
+    if (resultError) *resultError = std::sqrt(maxCost);
+    return result;
+}
+
+LodChain buildLodChain(const std::vector<uint32_t>& indices, const float* positions, size_t vertexCount,
+                       size_t positionStride, uint32_t maxLods, float reduction) {
+    LodChain chain;
+    chain.indices = indices;
+    chain.lods.push_back({0, static_cast<uint32_t>(indices.size()), 0.0f});
+
+    std::vector<uint32_t> current = indices;
+    float accumulatedError = 0.0f;
+    for (uint32_t level = 1; level < maxLods; ++level) {
+        size_t targetIndexCount = static_cast<size_t>(current.size() / 3 * reduction) * 3;
+        if (targetIndexCount < 3) break;
+
+        // Simplifying from the previous level keeps each step cheap; the error bound is the sum
+        float levelError = 0.0f;
+        std::vector<uint32_t> simplified = simplifyMesh(current, positions, vertexCount, positionStride,
+                                                        targetIndexCount, std::numeric_limits<float>::max(),
+                                                        &levelError);
+        if (simplified.empty() || simplified.size() * 10 > current.size() * 9) break;
+
+        simplified = optimizeVertexCache(simplified, vertexCount);
+        accumulatedError += levelError;
+        chain.lods.push_back({static_cast<uint32_t>(chain.indices.size()),
+                              static_cast<uint32_t>(simplified.size()), accumulatedError});
+        chain.indices.insert(chain.indices.end(), simplified.begin(), simplified.end());
+        current = std::move(simplified);
+    }
+    return chain;
+}
+
+} // namespace SFE
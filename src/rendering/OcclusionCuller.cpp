@@ -0,0 +1,262 @@
+#include "rendering/OcclusionCuller.hpp"
+#include "core/JobSystem.hpp"
+#include "core/Profiler.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SFE_OCCLUSION_SSE 1
+#else
+#define SFE_OCCLUSION_SSE 0
+#endif
+
+namespace SFE {
+
+OcclusionCuller::OcclusionCuller(uint32_t width, uint32_t height)
+    : width((std::max(width, 1u) + TILE_SIZE - 1) / TILE_SIZE * TILE_SIZE),
+      height((std::max(height, 1u) + TILE_SIZE - 1) / TILE_SIZE * TILE_SIZE) {
+    tilesX = this->width / TILE_SIZE;
+    tilesY = this->height / TILE_SIZE;
+    tileBins.resize(tilesX * tilesY);
+    uint32_t levelWidth = this->width, levelHeight = this->height;
+    for (;;) {
+        levels.push_back({levelWidth, levelHeight, std::vector<float>(size_t(levelWidth) * levelHeight, 1.0f)});
+        if (levelWidth == 1 && levelHeight == 1) break;
+        levelWidth = std::max(1u, (levelWidth + 1) / 2);
+        levelHeight = std::max(1u, (levelHeight + 1) / 2);
+    }
+}
+
+void OcclusionCuller::begin(const glm::mat4& viewProjection) {
+    this->viewProjection = viewProjection;
+    occluders.clear();
+    triangles.clear();
+    stats = {};
+}
+
+void OcclusionCuller::addOccluder(const glm::vec3* positions, const uint32_t* indices, uint32_t indexCount,
+                                  const glm::mat4& model) {
+    if (!positions || !indices || indexCount < 3) return;
+    occluders.push_back({positions, indices, indexCount, model, static_cast<uint32_t>(triangles.size())});
+    triangles.resize(triangles.size() + indexCount / 3);
+}
+
+void OcclusionCuller::end() {
+    SFE_PROFILE_SCOPE("OcclusionCuller::end");
+    auto start = std::chrono::steady_clock::now();
+    auto& jobs = JobSystem::getInstance();
+
+    jobs.parallelFor(occluders.size(), 1, [this](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) setupTriangles(occluders[i]);
+    });
+
+    // Binning is a few integer ops per triangle; not worth splitting
+    for (auto& bin : tileBins) bin.clear();
+    for (uint32_t i = 0; i < triangles.size(); ++i) {
+        const ScreenTriangle& triangle = triangles[i];
+        if (triangle.minX > triangle.maxX || triangle.minY > triangle.maxY) continue;
+        ++stats.triangles;
+        for (uint32_t ty = triangle.minY / TILE_SIZE; ty <= uint32_t(triangle.maxY) / TILE_SIZE; ++ty) {
+            for (uint32_t tx = triangle.minX / TILE_SIZE; tx <= uint32_t(triangle.maxX) / TILE_SIZE; ++tx) {
+                tileBins[ty * tilesX + tx].push_back(i);
+            }
+        }
+    }
+
+    jobs.parallelFor(tileBins.size(), 1, [this](size_t begin, size_t end) {
+        for (size_t tile = begin; tile < end; ++tile) rasterizeTile(static_cast<uint32_t>(tile));
+    });
+    buildPyramid();
+
+    stats.occluders = static_cast<uint32_t>(occluders.size());
+    stats.rasterizeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void OcclusionCuller::setupTriangles(const Occluder& occluder) {
+    glm::mat4 transform = viewProjection * occluder.model;
+    for (uint32_t t = 0; t < occluder.indexCount / 3; ++t) {
+        ScreenTriangle& out = triangles[occluder.firstTriangle + t];
+        out.minX = out.minY = 1;
+        out.maxX = out.maxY = 0; // Dropped unless set up below
+
+        glm::vec3 screen[3];
+        bool behindNear = false;
+        for (int v = 0; v < 3; ++v) {
+            glm::vec4 clip = transform * glm::vec4(occluder.positions[occluder.indices[t * 3 + v]], 1.0f);
+            if (clip.z < -clip.w || clip.w <= 0.0f) {
+                behindNear = true;
+                break;
+            }
+            float inverseW = 1.0f / clip.w;
+            screen[v] = glm::vec3((clip.x * inverseW * 0.5f + 0.5f) * width, (clip.y * inverseW * 0.5f + 0.5f) * height,
+                                  clip.z * inverseW * 0.5f + 0.5f);
+        }
+        if (behindNear) continue;
+
+        // Either winding: occluders are solid from both sides
+        float area = (screen[1].x - screen[0].x) * (screen[2].y - screen[0].y) -
+                     (screen[2].x - screen[0].x) * (screen[1].y - screen[0].y);
+        if (std::fabs(area) < 1e-6f) continue;
+        if (area < 0.0f) {
+            std::swap(screen[1], screen[2]);
+            area = -area;
+        }
+
+        float minX = std::min({screen[0].x, screen[1].x, screen[2].x});
+        float maxX = std::max({screen[0].x, screen[1].x, screen[2].x});
+        float minY = std::min({screen[0].y, screen[1].y, screen[2].y});
+        float maxY = std::max({screen[0].y, screen[1].y, screen[2].y});
+        if (maxX < 0.0f || maxY < 0.0f || minX >= float(width) || minY >= float(height)) continue;
+
+        for (int e = 0; e < 3; ++e) {
+            const glm::vec3& a = screen[e];
+            const glm::vec3& b = screen[(e + 1) % 3];
+            out.edgeA[e] = a.y - b.y;
+            out.edgeB[e] = b.x - a.x;
+            out.edgeC[e] = -(out.edgeA[e] * a.x + out.edgeB[e] * a.y);
+        }
+        float dz1 = screen[1].z - screen[0].z, dz2 = screen[2].z - screen[0].z;
+        out.depthX = (dz1 * (screen[2].y - screen[0].y) - dz2 * (screen[1].y - screen[0].y)) / area;
+        out.depthY = (dz2 * (screen[1].x - screen[0].x) - dz1 * (screen[2].x - screen[0].x)) / area;
+        out.depthC = screen[0].z - out.depthX * screen[0].x - out.depthY * screen[0].y;
+        out.minX = std::max(0, static_cast<int>(std::floor(minX)));
+        out.minY = std::max(0, static_cast<int>(std::floor(minY)));
+        out.maxX = std::min(int(width) - 1, static_cast<int>(std::floor(maxX)));
+        out.maxY = std::min(int(height) - 1, static_cast<int>(std::floor(maxY)));
+    }
+}
+
+void OcclusionCuller::rasterizeTile(uint32_t tile) {
+    const int tileX = int(tile % tilesX) * int(TILE_SIZE);
+    const int tileY = int(tile / tilesX) * int(TILE_SIZE);
+    float* depth = levels[0].depth.data();
+    for (int y = tileY; y < tileY + int(TILE_SIZE); ++y) {
+        std::fill_n(depth + size_t(y) * width + tileX, TILE_SIZE, 1.0f);
+    }
+
+    for (uint32_t index : tileBins[tile]) {
+        const ScreenTriangle& triangle = triangles[index];
+        // Rows start on a multiple of four pixels; the edge tests reject the extra ones
+        const int x0 = std::max(triangle.minX, tileX) & ~3;
+        const int x1 = std::min(triangle.maxX, tileX + int(TILE_SIZE) - 1);
+        const int y0 = std::max(triangle.minY, tileY);
+        const int y1 = std::min(triangle.maxY, tileY + int(TILE_SIZE) - 1);
+        for (int y = y0; y <= y1; ++y) {
+            const float py = float(y) + 0.5f;
+            float* row = depth + size_t(y) * width;
+            float rowEdge[3];
+            for (int e = 0; e < 3; ++e) rowEdge[e] = triangle.edgeB[e] * py + triangle.edgeC[e];
+            const float rowDepth = triangle.depthY * py + triangle.depthC;
+#if SFE_OCCLUSION_SSE
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 centres = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+            __m128 stepX[3], rowStart[3];
+            for (int e = 0; e < 3; ++e) {
+                stepX[e] = _mm_set1_ps(triangle.edgeA[e]);
+                rowStart[e] = _mm_set1_ps(rowEdge[e]);
+            }
+            const __m128 depthStep = _mm_set1_ps(triangle.depthX);
+            const __m128 depthStart = _mm_set1_ps(rowDepth);
+            for (int x = x0; x <= x1; x += 4) {
+                __m128 px = _mm_add_ps(_mm_set1_ps(float(x)), centres);
+                __m128 inside = _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(stepX[0], px), rowStart[0]), zero);
+                inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(stepX[1], px), rowStart[1]), zero));
+                inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(stepX[2], px), rowStart[2]), zero));
+                if (_mm_movemask_ps(inside) == 0) continue;
+                __m128 z = _mm_add_ps(_mm_mul_ps(depthStep, px), depthStart);
+                __m128 previous = _mm_loadu_ps(row + x);
+                __m128 nearer = _mm_min_ps(previous, z);
+                _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearer), _mm_andnot_ps(inside, previous)));
+            }
+#else
+            for (int x = x0; x <= x1; ++x) {
+                const float px = float(x) + 0.5f;
+                if (triangle.edgeA[0] * px + rowEdge[0] < 0.0f || triangle.edgeA[1] * px + rowEdge[1] < 0.0f ||
+                    triangle.edgeA[2] * px + rowEdge[2] < 0.0f) {
+                    continue;
+                }
+                row[x] = std::min(row[x], triangle.depthX * px + rowDepth);
+            }
+#endif
+        }
+    }
+}
+
+void OcclusionCuller::buildPyramid() {
+    auto& jobs = JobSystem::getInstance();
+    for (size_t level = 1; level < levels.size(); ++level) {
+        const Level& source = levels[level - 1];
+        Level& target = levels[level];
+        jobs.parallelFor(target.height, 16, [&source, &target](size_t begin, size_t end) {
+            for (uint32_t y = uint32_t(begin); y < end; ++y) {
+                const float* row0 = source.depth.data() + size_t(2 * y) * source.width;
+                const float* row1 = source.depth.data() + size_t(std::min(2 * y + 1, source.height - 1)) * source.width;
+                for (uint32_t x = 0; x < target.width; ++x) {
+                    uint32_t left = 2 * x, right = std::min(2 * x + 1, source.width - 1);
+                    target.depth[size_t(y) * target.width + x] =
+                        std::max(std::max(row0[left], row0[right]), std::max(row1[left], row1[right]));
+                }
+            }
+        });
+    }
+}
+
+bool OcclusionCuller::isVisible(const Aabb& bounds) const {
+    glm::vec3 ndcMin(std::numeric_limits<float>::max());
+    glm::vec3 ndcMax(-std::numeric_limits<float>::max());
+    int behindNear = 0;
+    for (int corner = 0; corner < 8; ++corner) {
+        glm::vec3 point((corner & 1) ? bounds.max.x : bounds.min.x, (corner & 2) ? bounds.max.y : bounds.min.y,
+                        (corner & 4) ? bounds.max.z : bounds.min.z);
+        glm::vec4 clip = viewProjection * glm::vec4(point, 1.0f);
+        if (clip.z < -clip.w || clip.w <= 0.0f) {
+            ++behindNear;
+            continue;
+        }
+        glm::vec3 ndc = glm::vec3(clip) / clip.w;
+        ndcMin = glm::min(ndcMin, ndc);
+        ndcMax = glm::max(ndcMax, ndc);
+    }
+    // Entirely behind the camera, or crossing the near plane where it may cover the whole view
+    if (behindNear == 8) return false;
+    if (behindNear > 0) return true;
+    if (ndcMax.x < -1.0f || ndcMin.x > 1.0f || ndcMax.y < -1.0f || ndcMin.y > 1.0f || ndcMin.z > 1.0f) return false;
+
+    auto toPixel = [](float ndc, uint32_t size) {
+        return std::clamp(static_cast<int>(std::floor((ndc * 0.5f + 0.5f) * size)), 0, int(size) - 1);
+    };
+    int x0 = toPixel(ndcMin.x, width), x1 = toPixel(ndcMax.x, width);
+    int y0 = toPixel(ndcMin.y, height), y1 = toPixel(ndcMax.y, height);
+    // Coarsest level where the rectangle spans at most two texels each way
+    int span = std::max(x1 - x0, y1 - y0) + 1;
+    uint32_t level = 0;
+    while ((1 << level) < span && level + 1 < levels.size()) ++level;
+
+    const Level& source = levels[level];
+    float farthest = 0.0f;
+    for (int y = y0 >> level; y <= (y1 >> level); ++y) {
+        for (int x = x0 >> level; x <= (x1 >> level); ++x) {
+            farthest = std::max(farthest, source.depth[size_t(y) * source.width + x]);
+        }
+    }
+    return ndcMin.z * 0.5f + 0.5f <= farthest;
+}
+
+uint32_t OcclusionCuller::testVisibility(const Aabb* bounds, size_t count, uint8_t* visible) const {
+    std::atomic<uint32_t> culled{0};
+    JobSystem::getInstance().parallelFor(count, 256, [&](size_t begin, size_t end) {
+        uint32_t rangeCulled = 0;
+        for (size_t i = begin; i < end; ++i) {
+            visible[i] = isVisible(bounds[i]) ? 1 : 0;
+            rangeCulled += visible[i] ? 0 : 1;
+        }
+        culled.fetch_add(rangeCulled, std::memory_order_relaxed);
+    });
+    return culled.load(std::memory_order_relaxed);
+}
+
+} // namespace SFE
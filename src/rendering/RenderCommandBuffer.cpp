@@ -0,0 +1,263 @@
+#include "rendering/RenderCommandBuffer.hpp"
+#include "rendering/RenderStats.hpp"
+#include "core/Profiler.hpp"
+#include <glm/gtc/type_ptr.hpp>
+
+namespace SFE {
+
+namespace {
+
+struct ClearPayload {
+    glm::vec4 color;
+    GLbitfield mask;
+};
+
+struct ViewportPayload {
+    GLint x, y;
+    GLsizei width, height;
+};
+
+struct CapabilityPayload {
+    GLenum capability;
+    bool enabled;
+};
+
+struct ProgramPayload {
+    GLuint program;
+};
+
+template <typename T>
+struct UniformPayload {
+    const char* name;
+    T value;
+};
+
+struct TexturePayload {
+    GLuint unit;
+    GLenum target;
+    GLuint texture;
+};
+
+struct VertexArrayPayload {
+    GLuint vertexArray;
+};
+
+struct BufferSubDataPayload {
+    GLenum target;
+    GLuint buffer;
+    GLintptr offset;
+    const void* data; // Copy at the back of the command buffer
+    size_t size;
+};
+
+struct DrawArraysPayload {
+    GLenum mode;
+    GLint first;
+    GLsizei count;
+    GLsizei instances;
+};
+
+struct DrawElementsPayload {
+    GLenum mode;
+    GLsizei count;
+    GLenum indexType;
+    size_t indexOffset;
+    GLsizei instances;
+};
+
+} // namespace
+
+RenderCommandBuffer::RenderCommandBuffer(size_t capacityBytes)
+    : storage(new unsigned char[capacityBytes]), capacity(capacityBytes), dataStart(capacityBytes) {
+}
+
+void RenderCommandBuffer::reset() {
+    packetBytes = 0;
+    dataStart = capacity;
+    packetCount = 0;
+    dropped = 0;
+}
+
+bool RenderCommandBuffer::clear(const glm::vec4& color, GLbitfield mask) {
+    return push(PacketType::Clear, ClearPayload{color, mask});
+}
+
+bool RenderCommandBuffer::viewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+    return push(PacketType::Viewport, ViewportPayload{x, y, width, height});
+}
+
+bool RenderCommandBuffer::setCapability(GLenum capability, bool enabled) {
+    return push(PacketType::SetCapability, CapabilityPayload{capability, enabled});
+}
+
+bool RenderCommandBuffer::useProgram(GLuint program) {
+    return push(PacketType::UseProgram, ProgramPayload{program});
+}
+
+bool RenderCommandBuffer::setUniform(const char* name, int value) {
+    return push(PacketType::UniformInt, UniformPayload<int>{name, value});
+}
+
+bool RenderCommandBuffer::setUniform(const char* name, float value) {
+    return push(PacketType::UniformFloat, UniformPayload<float>{name, value});
+}
+
+bool RenderCommandBuffer::setUniform(const char* name, const glm::vec3& value) {
+    return push(PacketType::UniformVec3, UniformPayload<glm::vec3>{name, value});
+}
+
+bool RenderCommandBuffer::setUniform(const char* name, const glm::mat4& value) {
+    return push(PacketType::UniformMat4, UniformPayload<glm::mat4>{name, value});
+}
+
+bool RenderCommandBuffer::bindTexture(GLuint unit, GLenum target, GLuint texture) {
+    return push(PacketType::BindTexture, TexturePayload{unit, target, texture});
+}
+
+bool RenderCommandBuffer::bindVertexArray(GLuint vertexArray) {
+    return push(PacketType::BindVertexArray, VertexArrayPayload{vertexArray});
+}
+
+bool RenderCommandBuffer::bufferSubData(GLenum target, GLuint buffer, GLintptr offset, const void* data, size_t size) {
+    const unsigned char* bytes = copy(static_cast<const unsigned char*>(data), size);
+    if (!bytes) {
+        ++dropped;
+        return false;
+    }
+    return push(PacketType::BufferSubData, BufferSubDataPayload{target, buffer, offset, bytes, size});
+}
+
+bool RenderCommandBuffer::drawArrays(GLenum mode, GLint first, GLsizei count, GLsizei instances) {
+    return push(PacketType::DrawArrays, DrawArraysPayload{mode, first, count, instances});
+}
+
+bool RenderCommandBuffer::drawElements(GLenum mode, GLsizei count, GLenum indexType, size_t indexOffset,
+                                       GLsizei instances) {
+    return push(PacketType::DrawElements, DrawElementsPayload{mode, count, indexType, indexOffset, instances});
+}
+
+void* RenderCommandBuffer::allocate(size_t size, size_t alignment) {
+    if (size > dataStart) return nullptr;
+    size_t start = (dataStart - size) & ~(alignment - 1);
+    if (start < packetBytes) return nullptr;
+    dataStart = start;
+    return storage.get() + start;
+}
+
+const char* RenderCommandBuffer::copyString(std::string_view text) {
+    char* copied = static_cast<char*>(allocate(text.size() + 1, 1));
+    if (!copied) return nullptr;
+    std::memcpy(copied, text.data(), text.size());
+    copied[text.size()] = '\0';
+    return copied;
+}
+
+void RenderCommandBuffer::replay() const {
+    SFE_PROFILE_SCOPE("RenderCommandBuffer::replay");
+    RenderStats& stats = RenderStats::getInstance();
+    GLuint program = 0;
+
+    for (size_t offset = 0; offset < packetBytes;) {
+        const unsigned char* at = storage.get() + offset;
+        const auto* header = reinterpret_cast<const PacketHeader*>(at);
+        offset += header->size;
+
+        switch (header->type) {
+        case PacketType::Clear: {
+            const auto& clear = payloadAt<ClearPayload>(at);
+            glClearColor(clear.color.x, clear.color.y, clear.color.z, clear.color.w);
+            glClear(clear.mask);
+            break;
+        }
+        case PacketType::Viewport: {
+            const auto& viewport = payloadAt<ViewportPayload>(at);
+            glViewport(viewport.x, viewport.y, viewport.width, viewport.height);
+            break;
+        }
+        case PacketType::SetCapability: {
+            const auto& capability = payloadAt<CapabilityPayload>(at);
+            if (capability.enabled) {
+                glEnable(capability.capability);
+            } else {
+                glDisable(capability.capability);
+            }
+            break;
+        }
+        case PacketType::UseProgram:
+            program = payloadAt<ProgramPayload>(at).program;
+            glUseProgram(program);
+            stats.recordProgramBind();
+            break;
+        case PacketType::UniformInt: {
+            const auto& uniform = payloadAt<UniformPayload<int>>(at);
+            glUniform1i(glGetUniformLocation(program, uniform.name), uniform.value);
+            break;
+        }
+        case PacketType::UniformFloat: {
+            const auto& uniform = payloadAt<UniformPayload<float>>(at);
+            glUniform1f(glGetUniformLocation(program, uniform.name), uniform.value);
+            break;
+        }
+        case PacketType::UniformVec3: {
+            const auto& uniform = payloadAt<UniformPayload<glm::vec3>>(at);
+            glUniform3fv(glGetUniformLocation(program, uniform.name), 1, glm::value_ptr(uniform.value));
+            break;
+        }
+        case PacketType::UniformMat4: {
+            const auto& uniform = payloadAt<UniformPayload<glm::mat4>>(at);
+            glUniformMatrix4fv(glGetUniformLocation(program, uniform.name), 1, GL_FALSE,
+                               glm::value_ptr(uniform.value));
+            break;
+        }
+        case PacketType::BindTexture: {
+            const auto& texture = payloadAt<TexturePayload>(at);
+            glActiveTexture(GL_TEXTURE0 + texture.unit);
+            glBindTexture(texture.target, texture.texture);
+            if (texture.texture != 0) stats.recordTextureBind();
+            break;
+        }
+        case PacketType::BindVertexArray: {
+            GLuint vertexArray = payloadAt<VertexArrayPayload>(at).vertexArray;
+            glBindVertexArray(vertexArray);
+            if (vertexArray != 0) stats.recordVertexArrayBind();
+            break;
+        }
+        case PacketType::BufferSubData: {
+            const auto& upload = payloadAt<BufferSubDataPayload>(at);
+            glBindBuffer(upload.target, upload.buffer);
+            glBufferSubData(upload.target, upload.offset, static_cast<GLsizeiptr>(upload.size), upload.data);
+            stats.recordBufferUpload(upload.size);
+            break;
+        }
+        case PacketType::DrawArrays: {
+            const auto& draw = payloadAt<DrawArraysPayload>(at);
+            if (draw.instances == 1) {
+                glDrawArrays(draw.mode, draw.first, draw.count);
+            } else {
+                glDrawArraysInstanced(draw.mode, draw.first, draw.count, draw.instances);
+            }
+            stats.recordDraw(draw.mode, draw.count, draw.instances);
+            break;
+        }
+        case PacketType::DrawElements: {
+            const auto& draw = payloadAt<DrawElementsPayload>(at);
+            const void* indices = reinterpret_cast<const void*>(draw.indexOffset);
+            if (draw.instances == 1) {
+                glDrawElements(draw.mode, draw.count, draw.indexType, indices);
+            } else {
+                glDrawElementsInstanced(draw.mode, draw.count, draw.indexType, indices, draw.instances);
+            }
+            stats.recordDraw(draw.mode, draw.count, draw.instances);
+            break;
+        }
+        case PacketType::Call: {
+            // Laid out by call(): the invoker in the first aligned slot, the argument in the next
+            const auto* invoker = reinterpret_cast<const CallPayload*>(at + PACKET_ALIGNMENT);
+            invoker->invoke(at + 2 * PACKET_ALIGNMENT);
+            break;
+        }
+        }
+    }
+}
+
+} // namespace SFE
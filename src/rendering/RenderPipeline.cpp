@@ -1,5 +1,7 @@
 #include "rendering/RenderPipeline.hpp"
 #include "rendering/Material.hpp"
+#include "rendering/ResourceRegistry.hpp"
+#include "rendering/GpuProfiler.hpp"
 #include <algorithm>
 
 namespace SFE {
@@ -43,6 +45,8 @@ void RenderPipeline::setProjectionMatrix(const glm::mat4& projection) {
 }
 
 void RenderPipeline::render() {
+    SFE_PROFILE_SCOPE("RenderPipeline::render");
+    SFE_GPU_PROFILE_SCOPE("RenderPipeline::render");
     if (needsSorting) {
         sortRenderables();
         needsSorting = false;
@@ -51,39 +55,44 @@ void RenderPipeline::render() {
     // Clear the screen
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-    // Render each batch
-    for (const auto& [shader, batch] : renderBatches) {
-        renderBatch(batch);
+    // Render each run of items sharing a shader
+    const DrawItem* items = drawItems.data();
+    for (size_t start = 0, end = 0; start < drawItems.size(); start = end) {
+        while (end < drawItems.size() && drawItems[end].shader == drawItems[start].shader) ++end;
+        renderBatch(items + start, items + end);
     }
 }
 
 void RenderPipeline::clear() {
     renderables.clear();
-    renderBatches.clear();
+    drawItems.clear();
     needsSorting = true;
 }
 
 void RenderPipeline::sortRenderables() {
-    renderBatches.clear();
+    drawItems.clear();
 
-    // Group renderables by shader
+    // Group renderables by shader, then material
     for (const auto& renderable : renderables) {
         if (auto material = renderable->getMaterial()) {
-            if (auto shader = material->getShader()) {
-                renderBatches[shader].push_back(renderable);
+            if (ShaderHandle shader = material->getShader()) {
+                drawItems.push_back({shader, material.get(), renderable.get()});
             }
         }
     }
+    std::sort(drawItems.begin(), drawItems.end(), [](const DrawItem& a, const DrawItem& b) {
+        if (a.shader != b.shader) return a.shader < b.shader;
+        return a.material < b.material;
+    });
 }
 
-void RenderPipeline::renderBatch(const std::vector<std::shared_ptr<Renderable>>& batch) {
-    if (batch.empty()) return;
+void RenderPipeline::renderBatch(const DrawItem* begin, const DrawItem* end) {
+    if (begin == end) return;
+    SFE_PROFILE_SCOPE("RenderPipeline::renderBatch");
+    SFE_GPU_PROFILE_SCOPE("RenderPipeline::renderBatch");
 
-    // Get the shader from the first renderable's material
-    auto material = batch[0]->getMaterial();
-    if (!material) return;
-
-    auto shader = material->getShader();
+    // A released shader skips its batch
+    Shader* shader = ResourceRegistry::getInstance().get(begin->shader);
     if (!shader) return;
 
     // Bind the shader and set common uniforms
@@ -92,13 +101,12 @@ void RenderPipeline::renderBatch(const std::vector<std::shared_ptr<Renderable>>&
     shader->setMat4("projection", projectionMatrix);
 
     // Render each object in the batch
-    for (const auto& renderable : batch) {
-        if (auto renderableMaterial = renderable->getMaterial()) {
-            renderableMaterial->bind();
-        }
-        renderable->prepare();
-        renderable->bind();
-        renderable->draw();
+    for (const DrawItem* item = begin; item != end; ++item) {
+        item->material->bind();
+        item->renderable->prepare();
+        item->renderable->bind();
+        item->renderable->applyVertexDecode(*shader);
+        item->renderable->draw();
     }
 }
 
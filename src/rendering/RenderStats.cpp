@@ -0,0 +1,56 @@
+#include "rendering/RenderStats.hpp"
+#include <algorithm>
+
+namespace SFE {
+
+namespace {
+
+// Applies 'op' to every field of the three counter sets
+template <typename Op>
+void forEachField(RenderStats::Counters& out, const RenderStats::Counters& a, const RenderStats::Counters& b, Op op) {
+    out.drawCalls = op(a.drawCalls, b.drawCalls);
+    out.indirectDrawCalls = op(a.indirectDrawCalls, b.indirectDrawCalls);
+    out.triangles = op(a.triangles, b.triangles);
+    out.instances = op(a.instances, b.instances);
+    out.programBinds = op(a.programBinds, b.programBinds);
+    out.vertexArrayBinds = op(a.vertexArrayBinds, b.vertexArrayBinds);
+    out.textureBinds = op(a.textureBinds, b.textureBinds);
+    out.bufferBytesUploaded = op(a.bufferBytesUploaded, b.bufferBytesUploaded);
+    out.textureBytesUploaded = op(a.textureBytesUploaded, b.textureBytesUploaded);
+}
+
+} // namespace
+
+void RenderStats::endFrame() {
+    lastFrame = current;
+    summary.frames++;
+    forEachField(summary.total, summary.total, current, [](auto a, auto b) { return a + b; });
+    forEachField(summary.peak, summary.peak, current, [](auto a, auto b) { return std::max(a, b); });
+    current = Counters{};
+}
+
+RenderStats::Counters RenderStats::difference(const Counters& later, const Counters& earlier) {
+    Counters result;
+    forEachField(result, later, earlier, [](auto a, auto b) { return a - b; });
+    return result;
+}
+
+std::string RenderStats::toJson(const Counters& c) {
+    return "{\"draw_calls\":" + std::to_string(c.drawCalls) +
+           ",\"indirect_draw_calls\":" + std::to_string(c.indirectDrawCalls) +
+           ",\"triangles\":" + std::to_string(c.triangles) +
+           ",\"instances\":" + std::to_string(c.instances) +
+           ",\"program_binds\":" + std::to_string(c.programBinds) +
+           ",\"vertex_array_binds\":" + std::to_string(c.vertexArrayBinds) +
+           ",\"texture_binds\":" + std::to_string(c.textureBinds) +
+           ",\"buffer_bytes_uploaded\":" + std::to_string(c.bufferBytesUploaded) +
+           ",\"texture_bytes_uploaded\":" + std::to_string(c.textureBytesUploaded) + "}";
+}
+
+std::string RenderStats::toJson(const Summary& s) {
+    // Per-frame averages are total / frames; kept as totals so nothing is rounded away
+    return "{\"frames\":" + std::to_string(s.frames) + ",\"total\":" + toJson(s.total) +
+           ",\"peak\":" + toJson(s.peak) + "}";
+}
+
+} // namespace SFE
@@ -0,0 +1,137 @@
+#include "rendering/RenderThread.hpp"
+#include "core/Profiler.hpp"
+#include <chrono>
+#include <iostream>
+
+namespace SFE {
+
+RenderThread::~RenderThread() {
+    stop();
+}
+
+bool RenderThread::start(GLFWwindow* targetWindow, bool runThreaded, size_t commandBufferBytes) {
+    if (running) return true;
+    if (!targetWindow || glfwGetCurrentContext() != targetWindow) {
+        std::cerr << "RenderThread: the window's context must be current on the calling thread" << std::endl;
+        return false;
+    }
+
+    window = targetWindow;
+    threaded = runThreaded;
+    for (auto& commands : commandBuffers) {
+        if (!commands) commands = std::make_unique<RenderCommandBuffer>(commandBufferBytes);
+        commands->reset();
+    }
+    recordIndex = replayIndex = 0;
+    queued[0] = queued[1] = false;
+    task = nullptr;
+    stopping = false;
+    running = true;
+
+    if (threaded) {
+        // A context can only be current on one thread at a time
+        glfwMakeContextCurrent(nullptr);
+        thread = std::thread(&RenderThread::run, this);
+    }
+    return true;
+}
+
+void RenderThread::stop() {
+    if (!running) return;
+    if (threaded) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        workAvailable.notify_all();
+        thread.join();
+        glfwMakeContextCurrent(window);
+    }
+    running = false;
+}
+
+RenderCommandBuffer& RenderThread::beginFrame() {
+    RenderCommandBuffer& commands = *commandBuffers[recordIndex];
+    if (threaded) {
+        SFE_PROFILE_SCOPE("RenderThread::wait");
+        auto waitStart = std::chrono::steady_clock::now();
+        std::unique_lock<std::mutex> lock(mutex);
+        workFinished.wait(lock, [&] { return !queued[recordIndex]; });
+        lastWaitMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - waitStart).count();
+    }
+    commands.reset();
+    return commands;
+}
+
+void RenderThread::submitFrame() {
+    if (!threaded) {
+        present(*commandBuffers[recordIndex]);
+        std::lock_guard<std::mutex> lock(mutex);
+        ++framesPresented;
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queued[recordIndex] = true;
+    }
+    workAvailable.notify_one();
+    recordIndex ^= 1;
+}
+
+void RenderThread::execute(const std::function<void()>& work) {
+    if (!threaded) {
+        work();
+        return;
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    task = &work;
+    workAvailable.notify_one();
+    workFinished.wait(lock, [&] { return task == nullptr; });
+}
+
+uint64_t RenderThread::getFramesPresented() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return framesPresented;
+}
+
+void RenderThread::present(RenderCommandBuffer& commands) {
+    if (commands.getDroppedCount() > 0) {
+        std::cerr << "RenderThread: command buffer full, " << commands.getDroppedCount()
+                  << " packets dropped this frame" << std::endl;
+    }
+    commands.replay();
+    SFE_PROFILE_SCOPE("Present");
+    glfwSwapBuffers(window);
+}
+
+void RenderThread::run() {
+    glfwMakeContextCurrent(window);
+    Profiler::getInstance().setThreadName("Render");
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        // Frames are replayed in submission order, and before any task queued after them
+        workAvailable.wait(lock, [&] { return queued[replayIndex] || task || stopping; });
+        if (queued[replayIndex]) {
+            lock.unlock();
+            present(*commandBuffers[replayIndex]);
+            lock.lock();
+            queued[replayIndex] = false;
+            replayIndex ^= 1;
+            ++framesPresented;
+            workFinished.notify_all();
+        } else if (task) {
+            lock.unlock();
+            (*task)();
+            lock.lock();
+            task = nullptr;
+            workFinished.notify_all();
+        } else {
+            break; // Stopping with nothing left to do
+        }
+    }
+    lock.unlock();
+    glfwMakeContextCurrent(nullptr);
+}
+
+} // namespace SFE
@@ -0,0 +1,81 @@
+#include "rendering/ResourceRegistry.hpp"
+#include "core/MemoryTracker.hpp"
+#include <iostream>
+
+namespace SFE {
+
+namespace {
+
+template <typename Map, typename HandleType>
+void forgetPath(Map& paths, HandleType handle) {
+    for (auto it = paths.begin(); it != paths.end(); ++it) {
+        if (it->second == handle) {
+            paths.erase(it);
+            return;
+        }
+    }
+}
+
+} // namespace
+
+ResourceRegistry& ResourceRegistry::getInstance() {
+    static ResourceRegistry instance;
+    return instance;
+}
+
+TextureHandle ResourceRegistry::loadTexture(const std::string& path) {
+    auto it = texturePaths.find(path);
+    if (it != texturePaths.end() && textures.isValid(it->second)) return it->second;
+
+    SFE_MEMORY_TAG(Texture);
+    Texture texture;
+    if (!texture.loadFromFile(path)) return {};
+    TextureHandle handle = textures.create(std::move(texture));
+    texturePaths[path] = handle;
+    return handle;
+}
+
+MeshHandle ResourceRegistry::loadMesh(const std::string& path) {
+    auto it = meshPaths.find(path);
+    if (it != meshPaths.end() && meshes.isValid(it->second)) return it->second;
+
+    SFE_MEMORY_TAG(Mesh);
+    Mesh mesh;
+    if (!mesh.loadFromFile(path)) return {};
+    MeshHandle handle = meshes.create(std::move(mesh));
+    meshPaths[path] = handle;
+    return handle;
+}
+
+bool ResourceRegistry::replaceShader(ShaderHandle handle, Shader&& shader) {
+    Shader* current = get(handle);
+    if (!current) return false;
+    *current = std::move(shader);
+    return true;
+}
+
+void ResourceRegistry::release(TextureHandle handle) {
+    if (textures.destroy(handle)) forgetPath(texturePaths, handle);
+}
+
+void ResourceRegistry::release(MeshHandle handle) {
+    if (meshes.destroy(handle)) forgetPath(meshPaths, handle);
+}
+
+void ResourceRegistry::clear() {
+    textures.clear();
+    meshes.clear();
+    shaders.clear();
+    textureArrays.shutdown();
+    texturePaths.clear();
+    meshPaths.clear();
+}
+
+void ResourceRegistry::reportStale(const char* kind, uint32_t index, uint32_t generation) {
+    if (staleLookups.fetch_add(1, std::memory_order_relaxed) == 0) {
+        std::cerr << "ResourceRegistry: stale " << kind << " handle (slot " << index << ", generation "
+                  << generation << "); further stale lookups are only counted" << std::endl;
+    }
+}
+
+} // namespace SFE
@@ -0,0 +1,34 @@
+#include "rendering/SceneBatchBuilder.hpp"
+#include <algorithm>
+
+namespace SFE {
+
+void buildSceneBatches(std::vector<SceneBatchItem>& items, const std::vector<glm::mat4>& matrices,
+                       std::vector<SceneBatch>& batches, std::vector<glm::mat4>& sortedMatrices) {
+    batches.clear();
+    sortedMatrices.clear();
+
+    // Shader first so programs switch as rarely as possible, then material, mesh and texture
+    std::sort(items.begin(), items.end(), [](const SceneBatchItem& a, const SceneBatchItem& b) {
+        if (a.shader != b.shader) return a.shader < b.shader;
+        if (a.material != b.material) return a.material < b.material;
+        if (a.mesh != b.mesh) return a.mesh < b.mesh;
+        if (a.texture != b.texture) return a.texture < b.texture;
+        return a.instance < b.instance;
+    });
+
+    for (const SceneBatchItem& item : items) {
+        if (!item.shader) continue;
+        SceneBatch* batch = batches.empty() ? nullptr : &batches.back();
+        if (!batch || batch->shader != item.shader || batch->material != item.material || batch->mesh != item.mesh ||
+            batch->texture != item.texture) {
+            batches.push_back({item.shader, item.material, item.mesh, item.texture,
+                               static_cast<uint32_t>(sortedMatrices.size()), 0});
+            batch = &batches.back();
+        }
+        ++batch->instanceCount;
+        sortedMatrices.push_back(matrices[item.instance]);
+    }
+}
+
+} // namespace SFE
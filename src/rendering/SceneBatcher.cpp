@@ -0,0 +1,142 @@
+#include "rendering/SceneBatcher.hpp"
+#include "core/MemoryTracker.hpp"
+#include "core/Profiler.hpp"
+#include "core/SceneComponents.hpp"
+#include "core/SceneNode.hpp"
+#include "rendering/GeometryArena.hpp"
+#include "rendering/GpuProfiler.hpp"
+#include "rendering/Material.hpp"
+#include "rendering/OcclusionCuller.hpp"
+#include "rendering/RenderStats.hpp"
+#include "rendering/ResourceRegistry.hpp"
+#include <algorithm>
+
+namespace SFE {
+
+SceneBatcher::~SceneBatcher() {
+    shutdown();
+}
+
+void SceneBatcher::begin(const glm::mat4& view, const glm::mat4& projection) {
+    viewMatrix = view;
+    projectionMatrix = projection;
+    frustum = Frustum::fromMatrix(projection * view);
+    submittedCount = 0;
+    occludedCount = 0;
+    items.clear();
+    matrices.clear();
+}
+
+void SceneBatcher::submit(const SceneNode& node) {
+    ++submittedCount;
+    if (!node.isVisible()) return;
+    submitInstance(node.getModelMatrix(), node.getMesh(), node.getTexture(), node.getTextureSlice(),
+                   node.getMaterial());
+}
+
+void SceneBatcher::submit(World& world) {
+    world.forEachChunk<LocalToWorld, MeshInstance>(
+        [this](size_t count, const Entity*, const LocalToWorld* matrices, const MeshInstance* instances) {
+            for (size_t i = 0; i < count; ++i) submit(matrices[i].matrix, instances[i]);
+        });
+}
+
+void SceneBatcher::submit(const glm::mat4& model, const MeshInstance& instance) {
+    ++submittedCount;
+    if (!instance.visible) return;
+    submitInstance(model, instance.mesh, instance.texture, instance.textureSlice, instance.material);
+}
+
+void SceneBatcher::submitInstance(glm::mat4 model, MeshHandle meshHandle, TextureHandle texture,
+                                  TextureSlice slice, Material* material) {
+    const Mesh* mesh = ResourceRegistry::getInstance().get(meshHandle);
+    if (!mesh) return;
+
+    glm::vec3 center = (mesh->getBoundsMin() + mesh->getBoundsMax()) * 0.5f;
+    float radius = glm::length(mesh->getBoundsMax() - mesh->getBoundsMin()) * 0.5f;
+    glm::vec3 worldCenter;
+    float worldRadius;
+    transformBoundingSphere(model, center, radius, worldCenter, worldRadius);
+    if (!frustum.intersectsSphere(worldCenter, worldRadius)) return;
+    if (occlusionCuller &&
+        !occlusionCuller->isVisible(Aabb{mesh->getBoundsMin(), mesh->getBoundsMax()}.transformed(model))) {
+        ++occludedCount;
+        return;
+    }
+
+    SFE_MEMORY_TAG(Mesh);
+    if (slice.isValid()) setInstanceTextureSlice(model, slice);
+    items.push_back({ShaderHandle{}, material, meshHandle, texture, static_cast<uint32_t>(matrices.size())});
+    matrices.push_back(model);
+}
+
+void SceneBatcher::draw(ShaderHandle defaultShader) {
+    SFE_PROFILE_SCOPE("SceneBatcher::draw");
+    SFE_GPU_PROFILE_SCOPE("SceneBatcher::draw");
+    {
+        SFE_MEMORY_TAG(Mesh);
+        for (SceneBatchItem& item : items) item.shader = item.material ? item.material->getShader() : defaultShader;
+        buildSceneBatches(items, matrices, batches, sortedMatrices);
+    }
+    if (batches.empty()) return;
+    uploadInstances();
+
+    auto& registry = ResourceRegistry::getInstance();
+    auto& arena = GeometryArena::getInstance();
+    Shader* shader = nullptr;
+    const Batch* previous = nullptr;
+    for (const Batch& batch : batches) {
+        bool shaderChanged = !previous || batch.shader != previous->shader;
+        if (shaderChanged) {
+            if (shader) shader->setBool("instanced", false);
+            shader = registry.get(batch.shader);
+        }
+        if (!shader) continue; // Released shader: skip its batches
+        if (batch.material && (shaderChanged || batch.material != previous->material)) {
+            batch.material->bind();
+        } else if (shaderChanged) {
+            shader->use();
+        }
+        if (shaderChanged) {
+            shader->setMat4("view", viewMatrix);
+            shader->setMat4("projection", projectionMatrix);
+            shader->setBool("instanced", true);
+        }
+        if (batch.texture && (shaderChanged || batch.texture != previous->texture)) {
+            if (const Texture* texture = registry.get(batch.texture)) texture->bind();
+        }
+        previous = &batch;
+
+        const Mesh* mesh = registry.get(batch.mesh);
+        if (!mesh || mesh->getIndexCount() == 0) continue;
+        mesh->applyVertexDecode(*shader);
+        // GL 3.3 has no base instance, so each batch re-points the instance attributes at its range
+        arena.bindInstanceBuffer(mesh->getVertexFormat(), instanceBuffer, batch.firstInstance * sizeof(glm::mat4));
+        glDrawElementsInstancedBaseVertex(GL_TRIANGLES, mesh->getIndexCount(), GL_UNSIGNED_INT,
+                                          mesh->getIndexOffset(), batch.instanceCount, mesh->getBaseVertex());
+        RenderStats::getInstance().recordDraw(GL_TRIANGLES, mesh->getIndexCount(), batch.instanceCount);
+    }
+    if (shader) shader->setBool("instanced", false);
+}
+
+void SceneBatcher::uploadInstances() {
+    if (instanceBuffer == 0) glGenBuffers(1, &instanceBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+    // Grow to the largest frame seen; re-specifying the storage each frame lets the driver hand
+    // out fresh memory instead of waiting for last frame's draws
+    instanceCapacity = std::max(instanceCapacity, sortedMatrices.size());
+    glBufferData(GL_ARRAY_BUFFER, instanceCapacity * sizeof(glm::mat4), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, sortedMatrices.size() * sizeof(glm::mat4), sortedMatrices.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    RenderStats::getInstance().recordBufferUpload(sortedMatrices.size() * sizeof(glm::mat4));
+}
+
+void SceneBatcher::shutdown() {
+    if (instanceBuffer != 0) {
+        glDeleteBuffers(1, &instanceBuffer);
+        instanceBuffer = 0;
+        instanceCapacity = 0;
+    }
+}
+
+} // namespace SFE
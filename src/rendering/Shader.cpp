@@ -1,6 +1,7 @@
 #include "rendering/Shader.hpp"
-#include <fstream>
-#include <sstream>
+#include "rendering/RenderStats.hpp"
+#include "core/VFS.hpp"
+#include "core/MemoryTracker.hpp"
 #include <iostream>
 #include <vector>
 #include <glm/gtc/type_ptr.hpp> // For glm::value_ptr
@@ -8,6 +9,7 @@
 namespace SFE {
 
 Shader::Shader(const std::string& vertexPath, const std::string& fragmentPath) : programID(0) {
+    SFE_MEMORY_TAG(Shader);
     // 1. Retrieve the vertex/fragment source code from filePath
     std::string vertexCode = readFile(vertexPath);
     std::string fragmentCode = readFile(fragmentPath);
@@ -49,22 +51,35 @@ Shader::~Shader() {
     }
 }
 
+Shader::Shader(Shader&& other) noexcept : programID(other.programID) {
+    other.programID = 0;
+}
+
+Shader& Shader::operator=(Shader&& other) noexcept {
+    if (this != &other) {
+        if (programID != 0) {
+            glDeleteProgram(programID);
+        }
+        programID = other.programID;
+        other.programID = 0;
+    }
+    return *this;
+}
+
 void Shader::use() const {
     if (programID != 0) {
         glUseProgram(programID);
+        RenderStats::getInstance().recordProgramBind();
     }
 }
 
 std::string Shader::readFile(const std::string& path) {
-    std::ifstream file(path);
-    if (!file.is_open()) {
+    AssetData file;
+    if (!VFS::getInstance().read(path, file)) {
         std::cerr << "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ: " << path << std::endl;
         return "";
     }
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    file.close();
-    return buffer.str();
+    return std::string(file.getText());
 }
 
 GLuint Shader::compileShader(GLenum type, const std::string& source) {
@@ -1,5 +1,7 @@
 #include "rendering/ShaderManager.hpp"
+#include "rendering/ResourceRegistry.hpp"
 #include "rendering/Shader.hpp"
+#include "core/MemoryTracker.hpp"
 #include <stdexcept>
 #include <iostream>
 
@@ -10,21 +12,21 @@ ShaderManager& ShaderManager::getInstance() {
     return instance;
 }
 
-std::shared_ptr<Shader> ShaderManager::loadShader(const std::string& name,
-                                                 const std::string& vertexPath,
-                                                 const std::string& fragmentPath) {
+ShaderHandle ShaderManager::loadShader(const std::string& name,
+                                       const std::string& vertexPath,
+                                       const std::string& fragmentPath) {
+    SFE_MEMORY_TAG(Shader);
     // Check if shader already exists
-    auto it = shaderCache.find(name);
-    if (it != shaderCache.end()) {
-        return it->second;
+    auto it = shaders.find(name);
+    if (it != shaders.end()) {
+        return it->second.handle;
     }
 
     try {
         // Create new shader
-        auto shader = std::make_shared<Shader>(vertexPath, fragmentPath);
-        shaderCache[name] = shader;
-        shaderPaths[name] = {vertexPath, fragmentPath};
-        return shader;
+        ShaderHandle handle = ResourceRegistry::getInstance().addShader(Shader(vertexPath, fragmentPath));
+        shaders[name] = {handle, vertexPath, fragmentPath};
+        return handle;
     }
     catch (const std::exception& e) {
         std::cerr << "Failed to load shader '" << name << "': " << e.what() << std::endl;
@@ -32,38 +34,36 @@ std::shared_ptr<Shader> ShaderManager::loadShader(const std::string& name,
     }
 }
 
-std::shared_ptr<Shader> ShaderManager::getShader(const std::string& name) {
-    auto it = shaderCache.find(name);
-    if (it == shaderCache.end()) {
+ShaderHandle ShaderManager::getShader(const std::string& name) {
+    auto it = shaders.find(name);
+    if (it == shaders.end()) {
         throw std::runtime_error("Shader '" + name + "' not found");
     }
-    return it->second;
+    return it->second.handle;
 }
 
 void ShaderManager::reloadAllShaders() {
-    std::unordered_map<std::string, std::shared_ptr<Shader>> newCache;
+    SFE_MEMORY_TAG(Shader);
+    auto& registry = ResourceRegistry::getInstance();
     
-    for (const auto& [name, paths] : shaderPaths) {
+    for (const auto& [name, entry] : shaders) {
         try {
-            auto shader = std::make_shared<Shader>(paths.first, paths.second);
-            newCache[name] = shader;
+            registry.replaceShader(entry.handle, Shader(entry.vertexPath, entry.fragmentPath));
             std::cout << "Successfully reloaded shader '" << name << "'" << std::endl;
         }
         catch (const std::exception& e) {
+            // The old program stays in place
             std::cerr << "Failed to reload shader '" << name << "': " << e.what() << std::endl;
-            // Keep the old shader in case of reload failure
-            if (auto it = shaderCache.find(name); it != shaderCache.end()) {
-                newCache[name] = it->second;
-            }
         }
     }
-    
-    shaderCache = std::move(newCache);
 }
 
 void ShaderManager::clear() {
-    shaderCache.clear();
-    shaderPaths.clear();
+    auto& registry = ResourceRegistry::getInstance();
+    for (const auto& [name, entry] : shaders) {
+        registry.release(entry.handle);
+    }
+    shaders.clear();
 }
 
-} // namespace SFE 
\ No newline at end of file
+} // namespace SFE
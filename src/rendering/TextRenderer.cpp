@@ -1,5 +1,8 @@
 #include "rendering/TextRenderer.hpp"
-#include <fstream>
+#include "core/VFS.hpp"
+#include "core/MemoryTracker.hpp"
+#include "rendering/GpuProfiler.hpp"
+#include "rendering/RenderStats.hpp"
 #include <sstream>
 #include <iostream>
 #include <glad/glad.h>
@@ -10,8 +13,8 @@
 namespace SFE {
 
 TextRenderer::TextRenderer() 
-    : vao(0), vbo(0), textureID(0), atlasWidth(0), atlasHeight(0),
-      shader("shaders/text2d.vert", "shaders/text2d.frag") {
+    : vao(0), vbo(0), textureID(0), atlasWidth(0), atlasHeight(0) {
+    SFE_MEMORY_TAG(Text);
     batchedVertices.reserve(MAX_BATCH_VERTICES);
 }
 
@@ -27,7 +30,8 @@ TextRenderer::~TextRenderer() {
     }
 }
 
-bool TextRenderer::initialize(const std::string& fontAtlasPath, const std::string& fontDescPath) {
+bool TextRenderer::loadFont(const std::string& fontAtlasPath, const std::string& fontDescPath) {
+    SFE_MEMORY_TAG(Text);
     // Load font atlas texture
     if (!loadFontAtlas(fontAtlasPath)) {
         std::cerr << "Failed to load font atlas: " << fontAtlasPath << std::endl;
@@ -39,13 +43,27 @@ bool TextRenderer::initialize(const std::string& fontAtlasPath, const std::strin
         std::cerr << "Failed to load font descriptor: " << fontDescPath << std::endl;
         return false;
     }
+    return true;
+}
 
+bool TextRenderer::initialize() {
+    SFE_MEMORY_TAG(Text);
+    if (atlasPixels.empty()) {
+        std::cerr << "TextRenderer: no font loaded" << std::endl;
+        return false;
+    }
+    shader = Shader("shaders/text2d.vert", "shaders/text2d.frag");
+    uploadFontAtlas();
     setupBuffers();
 
     std::cout << "TextRenderer initialized successfully" << std::endl;
     return true;
 }
 
+bool TextRenderer::initialize(const std::string& fontAtlasPath, const std::string& fontDescPath) {
+    return loadFont(fontAtlasPath, fontDescPath) && initialize();
+}
+
 void TextRenderer::setupBuffers() {
     glGenVertexArrays(1, &vao);
     glGenBuffers(1, &vbo);
@@ -71,47 +89,60 @@ void TextRenderer::setupBuffers() {
 }
 
 bool TextRenderer::loadFontAtlas(const std::string& atlasPath) {
-    // Generate and bind texture
-    glGenTextures(1, &textureID);
-    glBindTexture(GL_TEXTURE_2D, textureID);
-    
-    // Set texture parameters
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    
-    // Load texture data from file using stb_image
+    // Load texture data from file using stb_image. The flip setting is per thread: this may run
+    // on a worker while another thread decodes unflipped images.
     int width, height, channels;
-    stbi_set_flip_vertically_on_load(true);
-    unsigned char* data = stbi_load(atlasPath.c_str(), &width, &height, &channels, STBI_rgb_alpha);
+    stbi_set_flip_vertically_on_load_thread(true);
+    AssetData atlasFile;
+    unsigned char* data = nullptr;
+    if (VFS::getInstance().read(atlasPath, atlasFile)) {
+        data = stbi_load_from_memory(atlasFile.getData(), static_cast<int>(atlasFile.getSize()), &width, &height,
+                                     &channels, STBI_rgb_alpha);
+    }
     if (!data) {
-        std::cerr << "STB Image failed to load: " << atlasPath << " (" << stbi_failure_reason() << ")" << std::endl;
+        std::cerr << "STB Image failed to load: " << atlasPath << " ("
+                  << (atlasFile.getData() ? stbi_failure_reason() : "file not found") << ")" << std::endl;
         // Fallback: create a 16x16 white square
-        unsigned char fallbackData[16 * 16 * 4];
-        for (int i = 0; i < 16 * 16 * 4; i++) {
-            fallbackData[i] = 255;
-        }
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 16, 16, 0, GL_RGBA, GL_UNSIGNED_BYTE, fallbackData);
+        atlasPixels.assign(16 * 16 * 4, 255);
         atlasWidth = 16.0f;
         atlasHeight = 16.0f;
     } else {
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+        atlasPixels.assign(data, data + size_t(width) * height * 4);
         atlasWidth = static_cast<float>(width);
         atlasHeight = static_cast<float>(height);
         stbi_image_free(data);
     }
+    return true;
+}
+
+void TextRenderer::uploadFontAtlas() {
+    // Generate and bind texture
+    glGenTextures(1, &textureID);
+    glBindTexture(GL_TEXTURE_2D, textureID);
     
+    // Set texture parameters
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    GLsizei width = static_cast<GLsizei>(atlasWidth);
+    GLsizei height = static_cast<GLsizei>(atlasHeight);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, atlasPixels.data());
+    RenderStats::getInstance().recordTextureUpload(atlasPixels.size());
     glBindTexture(GL_TEXTURE_2D, 0);
-    return true;
+
+    atlasPixels.clear();
+    atlasPixels.shrink_to_fit();
 }
 
 bool TextRenderer::loadFontDescriptor(const std::string& descPath) {
-    std::ifstream file(descPath);
-    if (!file.is_open()) {
+    AssetData descFile;
+    if (!VFS::getInstance().read(descPath, descFile)) {
         std::cerr << "Failed to open font descriptor file: " << descPath << std::endl;
         return false;
     }
+    std::istringstream file{std::string(descFile.getText())};
     
     std::string line;
     
@@ -183,7 +214,7 @@ bool TextRenderer::loadFontDescriptor(const std::string& descPath) {
     return !characters.empty();
 }
 
-void TextRenderer::generateVertices(const std::string& text, float x, float y, float scale, 
+void TextRenderer::generateVertices(std::string_view text, float x, float y, float scale, 
                                   const glm::vec3& color, std::vector<float>& vertices) {
     float cursorX = x;
     
@@ -214,32 +245,10 @@ void TextRenderer::generateVertices(const std::string& text, float x, float y, f
     }
 }
 
-void TextRenderer::addToBatch(const std::string& text, float x, float y, float scale, const glm::vec3& color) {
-    // Check if text is cached
-    auto it = cachedText.find(text);
-    if (it != cachedText.end() && 
-        it->second.x == x && 
-        it->second.y == y && 
-        it->second.scale == scale &&
-        it->second.color == color) {
-        // Use cached vertices
-        batchedVertices.insert(batchedVertices.end(), 
-                             it->second.vertices.begin(), 
-                             it->second.vertices.end());
-    } else {
-        // Generate new vertices
-        std::vector<float> vertices;
-        generateVertices(text, x, y, scale, color, vertices);
-        
-        // Cache the text if it's not too large
-        if (vertices.size() <= MAX_BATCH_VERTICES / 4) { // Allow caching if less than 25% of max batch
-            TextInstance instance{text, x, y, scale, color, vertices};
-            cachedText[text] = instance;
-        }
-        
-        batchedVertices.insert(batchedVertices.end(), vertices.begin(), vertices.end());
-    }
-    
+void TextRenderer::addToBatch(std::string_view text, float x, float y, float scale, const glm::vec3& color) {
+    SFE_MEMORY_TAG(Text);
+    generateVertices(text, x, y, scale, color, batchedVertices);
+
     // Flush if batch is full
     if (batchedVertices.size() >= MAX_BATCH_VERTICES) {
         flushBatch(glm::mat4(1.0f)); // Use identity matrix as projection will be set later
@@ -248,6 +257,8 @@ void TextRenderer::addToBatch(const std::string& text, float x, float y, float s
 
 void TextRenderer::flushBatch(const glm::mat4& projection) {
     if (batchedVertices.empty()) return;
+    SFE_PROFILE_SCOPE("TextRenderer::flushBatch");
+    SFE_GPU_PROFILE_SCOPE("TextRenderer::flushBatch");
     
     shader.use();
     shader.setMat4("projection", projection);
@@ -260,6 +271,12 @@ void TextRenderer::flushBatch(const glm::mat4& projection) {
     glBufferSubData(GL_ARRAY_BUFFER, 0, batchedVertices.size() * sizeof(float), batchedVertices.data());
     
     glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(batchedVertices.size() / 7));
+
+    auto& stats = RenderStats::getInstance();
+    stats.recordTextureBind();
+    stats.recordVertexArrayBind();
+    stats.recordBufferUpload(batchedVertices.size() * sizeof(float));
+    stats.recordDraw(GL_TRIANGLES, static_cast<uint32_t>(batchedVertices.size() / 7));
     
     glBindVertexArray(0);
     glBindTexture(GL_TEXTURE_2D, 0);
@@ -267,7 +284,7 @@ void TextRenderer::flushBatch(const glm::mat4& projection) {
     batchedVertices.clear();
 }
 
-void TextRenderer::renderText(const std::string& text, float x, float y, float scale, 
+void TextRenderer::renderText(std::string_view text, float x, float y, float scale, 
                             const glm::vec3& color, const glm::mat4& projection) {
     addToBatch(text, x, y, scale, color);
     flushBatch(projection);
@@ -1,4 +1,9 @@
 #include "rendering/Texture.hpp"
+#include "rendering/RenderStats.hpp"
+#include "rendering/GLExtensions.hpp"
+#include "rendering/TextureCompression.hpp"
+#include "core/VFS.hpp"
+#include "core/MemoryTracker.hpp"
 #include <stb_image.h>
 #include <iostream>
 
@@ -12,36 +17,141 @@ Texture::~Texture() {
     }
 }
 
+Texture::Texture(Texture&& other) noexcept
+    : m_textureID(other.m_textureID), m_width(other.m_width), m_height(other.m_height),
+      m_channels(other.m_channels) {
+    other.m_textureID = 0;
+}
+
+Texture& Texture::operator=(Texture&& other) noexcept {
+    if (this != &other) {
+        if (m_textureID) {
+            glDeleteTextures(1, &m_textureID);
+        }
+        m_textureID = other.m_textureID;
+        m_width = other.m_width;
+        m_height = other.m_height;
+        m_channels = other.m_channels;
+        other.m_textureID = 0;
+    }
+    return *this;
+}
+
 bool Texture::loadFromFile(const std::string& filename) {
+    SFE_MEMORY_TAG(Texture);
+    SFE::AssetData file;
+    if (!SFE::VFS::getInstance().read(filename, file)) {
+        std::cerr << "Failed to load texture: " << filename << std::endl;
+        return false;
+    }
+    if (filename.size() > 4 && filename.compare(filename.size() - 4, 4, ".sft") == 0) {
+        return loadCooked(file.getData(), file.getSize(), filename);
+    }
     stbi_set_flip_vertically_on_load(true);
-    unsigned char* data = stbi_load(filename.c_str(), &m_width, &m_height, &m_channels, 0);
+    int width, height, channels;
+    unsigned char* data = stbi_load_from_memory(file.getData(), static_cast<int>(file.getSize()), &width, &height,
+                                                &channels, 0);
     
     if (!data) {
         std::cerr << "Failed to load texture: " << filename << std::endl;
         return false;
     }
+    // stb_image allocates with malloc, which the tracker does not see
+    size_t pixelBytes = size_t(width) * height * channels;
+    if (SFE::MemoryTracker::isEnabled()) {
+        SFE::MemoryTracker::getInstance().recordAllocation(SFE::MemoryTag::Texture, pixelBytes);
+    }
 
-    bind();
+    bool loaded = loadFromPixels(data, width, height, channels);
 
+    stbi_image_free(data);
+    if (SFE::MemoryTracker::isEnabled()) {
+        SFE::MemoryTracker::getInstance().recordFree(SFE::MemoryTag::Texture, pixelBytes);
+    }
+    return loaded;
+}
+
+bool Texture::loadFromPixels(const unsigned char* pixels, int width, int height, int channels, bool mipmaps) {
     GLenum format;
-    if (m_channels == 1) {
+    if (channels == 1) {
         format = GL_RED;
-    } else if (m_channels == 3) {
+    } else if (channels == 3) {
         format = GL_RGB;
-    } else if (m_channels == 4) {
+    } else if (channels == 4) {
         format = GL_RGBA;
+    } else {
+        std::cerr << "Texture: unsupported channel count " << channels << std::endl;
+        return false;
     }
+    m_width = width;
+    m_height = height;
+    m_channels = channels;
 
-    glTexImage2D(GL_TEXTURE_2D, 0, format, m_width, m_height, 0, format, GL_UNSIGNED_BYTE, data);
-    glGenerateMipmap(GL_TEXTURE_2D);
+    bind();
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // Rows of 1 and 3 channel images are not 4-byte aligned
+    glTexImage2D(GL_TEXTURE_2D, 0, format, m_width, m_height, 0, format, GL_UNSIGNED_BYTE, pixels);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    SFE::RenderStats::getInstance().recordTextureUpload(size_t(width) * height * channels);
+    if (mipmaps) {
+        glGenerateMipmap(GL_TEXTURE_2D);
+    }
 
     // Set texture parameters
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, mipmaps ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, mipmaps ? GL_LINEAR : GL_NEAREST);
+
+    unbind();
+    return true;
+}
+
+bool Texture::loadCooked(const uint8_t* fileData, size_t fileSize, const std::string& filename) {
+    std::string error;
+    const SFE::TextureFileHeader* header = SFE::validateTextureFile(fileData, fileSize, error);
+    if (!header) {
+        std::cerr << "Texture: " << filename << ": " << error << std::endl;
+        return false;
+    }
+
+    auto format = static_cast<SFE::TextureFileFormat>(header->format);
+    GLenum internalFormat = SFE::GLExtensions::getCompressedTextureFormat(format);
+    if (!internalFormat && format != SFE::TextureFileFormat::RGBA8) {
+        std::cerr << "Texture: " << filename << ": no " << SFE::getTextureFileFormatName(format)
+                  << " support, decoding on the CPU" << std::endl;
+    }
+    m_width = static_cast<int>(header->width);
+    m_height = static_cast<int>(header->height);
+    m_channels = 4;
+
+    // Straight from the mapping; the levels were filtered offline, so no glGenerateMipmap
+    bind();
+    const SFE::TextureFileLevel* levels = SFE::getTextureFileLevels(fileData, *header);
+    for (uint32_t i = 0; i < header->levelCount; ++i) {
+        const SFE::TextureFileLevel& level = levels[i];
+        const uint8_t* data = fileData + level.offset;
+        GLsizei width = static_cast<GLsizei>(level.width), height = static_cast<GLsizei>(level.height);
+        if (internalFormat) {
+            glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(i), internalFormat, width, height, 0,
+                                   static_cast<GLsizei>(level.size), data);
+        } else if (format == SFE::TextureFileFormat::RGBA8) {
+            glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(i), GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+        } else {
+            std::vector<uint8_t> pixels = SFE::decompressTexture(format, data, level.width, level.height);
+            glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(i), GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                         pixels.data());
+        }
+        SFE::RenderStats::getInstance().recordTextureUpload(level.size);
+    }
+
+    bool mipmaps = header->levelCount > 1;
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(header->levelCount - 1));
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, mipmaps ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-    stbi_image_free(data);
     unbind();
     return true;
 }
@@ -49,6 +159,7 @@ bool Texture::loadFromFile(const std::string& filename) {
 void Texture::bind(GLenum textureUnit) const {
     glActiveTexture(textureUnit);
     glBindTexture(GL_TEXTURE_2D, m_textureID);
+    SFE::RenderStats::getInstance().recordTextureBind();
 }
 
 void Texture::unbind() const {
@@ -0,0 +1,284 @@
+#include "rendering/TextureArrayPool.hpp"
+#include "rendering/GLExtensions.hpp"
+#include "rendering/RenderStats.hpp"
+#include "rendering/TextureCompression.hpp"
+#include "core/VFS.hpp"
+#include "core/MemoryTracker.hpp"
+#include <algorithm>
+#include <iostream>
+#include <stb_image.h>
+
+namespace SFE {
+
+namespace {
+
+bool getFormats(int channels, GLenum& internalFormat, GLenum& format) {
+    switch (channels) {
+    case 1: internalFormat = GL_R8; format = GL_RED; return true;
+    case 3: internalFormat = GL_RGB8; format = GL_RGB; return true;
+    case 4: internalFormat = GL_RGBA8; format = GL_RGBA; return true;
+    default: return false;
+    }
+}
+
+GLenum getUncompressedFormat(GLenum internalFormat) {
+    switch (internalFormat) {
+    case GL_R8: return GL_RED;
+    case GL_RGB8: return GL_RGB;
+    default: return GL_RGBA;
+    }
+}
+
+uint32_t getFullMipCount(int width, int height) {
+    uint32_t levels = 1;
+    while (width > 1 || height > 1) {
+        width = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+        ++levels;
+    }
+    return levels;
+}
+
+bool endsWith(const std::string& text, const char* suffix) {
+    size_t length = std::char_traits<char>::length(suffix);
+    return text.size() >= length && text.compare(text.size() - length, length, suffix) == 0;
+}
+
+} // namespace
+
+TextureArrayPool::~TextureArrayPool() {
+    shutdown();
+}
+
+TextureSlice TextureArrayPool::add(const unsigned char* pixels, int width, int height, int channels) {
+    GLenum internalFormat, format;
+    if (!pixels || width <= 0 || height <= 0 || !getFormats(channels, internalFormat, format)) {
+        std::cerr << "TextureArrayPool: unsupported texture " << width << "x" << height << ", " << channels
+                  << " channels" << std::endl;
+        return {};
+    }
+
+    uint32_t arrayIndex = findOrCreateArray(width, height, internalFormat, TextureFileFormat::RGBA8,
+                                            getFullMipCount(width, height));
+    if (arrayIndex == TextureSlice::INVALID_ARRAY) return {};
+    ArrayTexture& array = arrays[arrayIndex];
+    uint16_t layer = allocateLayer(array);
+
+    glBindTexture(GL_TEXTURE_2D_ARRAY, array.texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // Rows of 1 and 3 channel images are not 4-byte aligned
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, width, height, 1, format, GL_UNSIGNED_BYTE, pixels);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    RenderStats::getInstance().recordTextureUpload(size_t(width) * height * channels);
+
+    array.mipmapsDirty = true;
+    return {static_cast<uint16_t>(arrayIndex), layer};
+}
+
+void TextureSource::PixelDeleter::operator()(unsigned char* pixels) const {
+    stbi_image_free(pixels);
+    if (MemoryTracker::isEnabled()) MemoryTracker::getInstance().recordFree(MemoryTag::Texture, bytes);
+}
+
+TextureSlice TextureArrayPool::addFromFile(const std::string& path) {
+    TextureSource source;
+    if (!loadSource(path, source)) return {};
+    return addSource(source);
+}
+
+bool TextureArrayPool::loadSource(const std::string& path, TextureSource& source) {
+    SFE_MEMORY_TAG(Texture);
+    source.path = path;
+    if (!VFS::getInstance().read(path, source.file)) {
+        std::cerr << "TextureArrayPool: failed to load " << path << std::endl;
+        return false;
+    }
+    if (endsWith(path, ".sft")) return true;
+    // Per-thread flip: this may run on a worker
+    stbi_set_flip_vertically_on_load_thread(true);
+    int width, height, channels;
+    unsigned char* pixels = stbi_load_from_memory(source.file.getData(), static_cast<int>(source.file.getSize()),
+                                                  &width, &height, &channels, 0);
+    if (!pixels) {
+        std::cerr << "TextureArrayPool: failed to load " << path << std::endl;
+        return false;
+    }
+    size_t pixelBytes = size_t(width) * height * channels;
+    if (MemoryTracker::isEnabled()) MemoryTracker::getInstance().recordAllocation(MemoryTag::Texture, pixelBytes);
+    source.pixels = std::unique_ptr<unsigned char, TextureSource::PixelDeleter>(pixels, {pixelBytes});
+    source.width = width;
+    source.height = height;
+    source.channels = channels;
+    source.file = AssetData(); // The encoded image is no longer needed
+    return true;
+}
+
+TextureSlice TextureArrayPool::addSource(const TextureSource& source) {
+    SFE_MEMORY_TAG(Texture);
+    if (source.pixels) return add(source.pixels.get(), source.width, source.height, source.channels);
+    if (source.file.getData()) return addCooked(source.file.getData(), source.file.getSize(), source.path);
+    return {};
+}
+
+void TextureArrayPool::remove(TextureSlice slice) {
+    if (!slice.isValid() || slice.array >= arrays.size()) return;
+    ArrayTexture& array = arrays[slice.array];
+    if (slice.layer >= array.used ||
+        std::find(array.freeLayers.begin(), array.freeLayers.end(), slice.layer) != array.freeLayers.end()) {
+        return;
+    }
+    array.freeLayers.push_back(slice.layer);
+    --usedLayers;
+}
+
+void TextureArrayPool::bind(uint32_t array, GLuint unit) {
+    if (array >= arrays.size()) return;
+    updateMipmaps(arrays[array]);
+    glActiveTexture(GL_TEXTURE0 + unit);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, arrays[array].texture);
+    RenderStats::getInstance().recordTextureBind();
+}
+
+bool TextureArrayPool::isBindlessAvailable() const {
+    return GLExtensions::hasBindlessTexture();
+}
+
+GLuint64 TextureArrayPool::getBindlessHandle(uint32_t array) {
+    if (array >= arrays.size() || !isBindlessAvailable()) return 0;
+    ArrayTexture& texture = arrays[array];
+    updateMipmaps(texture);
+    if (texture.bindlessHandle == 0) {
+        // Sampler state becomes immutable once a handle exists; it was set at creation
+        texture.bindlessHandle = GLExtensions::getTextureHandle(texture.texture);
+        if (texture.bindlessHandle != 0) GLExtensions::makeTextureHandleResident(texture.bindlessHandle);
+    }
+    return texture.bindlessHandle;
+}
+
+uint32_t TextureArrayPool::getBindlessHandles(glm::uvec2* handles, uint32_t maxArrays) {
+    uint32_t count = std::min(maxArrays, getArrayCount());
+    for (uint32_t i = 0; i < count; ++i) {
+        GLuint64 handle = getBindlessHandle(i);
+        handles[i] = glm::uvec2(static_cast<uint32_t>(handle), static_cast<uint32_t>(handle >> 32));
+    }
+    return count;
+}
+
+void TextureArrayPool::shutdown() {
+    for (ArrayTexture& array : arrays) {
+        if (array.bindlessHandle != 0) GLExtensions::makeTextureHandleNonResident(array.bindlessHandle);
+        if (array.texture) glDeleteTextures(1, &array.texture);
+    }
+    arrays.clear();
+    usedLayers = 0;
+}
+
+TextureSlice TextureArrayPool::addCooked(const uint8_t* fileData, size_t fileSize, const std::string& path) {
+    std::string error;
+    const TextureFileHeader* header = validateTextureFile(fileData, fileSize, error);
+    if (!header) {
+        std::cerr << "TextureArrayPool: " << path << ": " << error << std::endl;
+        return {};
+    }
+    auto format = static_cast<TextureFileFormat>(header->format);
+    const TextureFileLevel* levels = getTextureFileLevels(fileData, *header);
+    GLenum internalFormat = GLExtensions::getCompressedTextureFormat(format);
+    if (!internalFormat) {
+        // Uncompressed, or blocks this context cannot sample: level 0 as RGBA8, mips rebuilt
+        std::vector<uint8_t> pixels =
+            decompressTexture(format, fileData + levels[0].offset, header->width, header->height);
+        return add(pixels.data(), static_cast<int>(header->width), static_cast<int>(header->height), 4);
+    }
+
+    int width = static_cast<int>(header->width), height = static_cast<int>(header->height);
+    uint32_t arrayIndex = findOrCreateArray(width, height, internalFormat, format, header->levelCount);
+    if (arrayIndex == TextureSlice::INVALID_ARRAY) return {};
+    ArrayTexture& array = arrays[arrayIndex];
+    uint16_t layer = allocateLayer(array);
+
+    glBindTexture(GL_TEXTURE_2D_ARRAY, array.texture);
+    for (uint32_t i = 0; i < header->levelCount; ++i) {
+        const TextureFileLevel& level = levels[i];
+        glCompressedTexSubImage3D(GL_TEXTURE_2D_ARRAY, static_cast<GLint>(i), 0, 0, layer,
+                                  static_cast<GLsizei>(level.width), static_cast<GLsizei>(level.height), 1,
+                                  internalFormat, static_cast<GLsizei>(level.size), fileData + level.offset);
+        RenderStats::getInstance().recordTextureUpload(level.size);
+    }
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    return {static_cast<uint16_t>(arrayIndex), layer};
+}
+
+uint16_t TextureArrayPool::allocateLayer(ArrayTexture& array) {
+    uint16_t layer;
+    if (!array.freeLayers.empty()) {
+        layer = array.freeLayers.back();
+        array.freeLayers.pop_back();
+    } else {
+        layer = static_cast<uint16_t>(array.used++);
+    }
+    ++usedLayers;
+    return layer;
+}
+
+uint32_t TextureArrayPool::findOrCreateArray(int width, int height, GLenum internalFormat, TextureFileFormat blockFormat,
+                                             uint32_t levels) {
+    for (uint32_t i = 0; i < arrays.size(); ++i) {
+        const ArrayTexture& array = arrays[i];
+        if (array.width == width && array.height == height && array.internalFormat == internalFormat &&
+            array.levels == levels && (!array.freeLayers.empty() || array.used < array.capacity)) {
+            return i;
+        }
+    }
+    if (arrays.size() >= TextureSlice::INVALID_ARRAY) return TextureSlice::INVALID_ARRAY;
+
+    GLint maxLayers = 256; // GL 3.3 minimum
+    glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers);
+
+    ArrayTexture array;
+    array.width = width;
+    array.height = height;
+    array.internalFormat = internalFormat;
+    array.blockFormat = blockFormat;
+    array.levels = levels;
+    array.capacity = std::min<uint32_t>({layersPerArray, static_cast<uint32_t>(maxLayers), 0xFFFFu});
+
+    bool compressed = getTextureBlockBytes(blockFormat) != 0;
+    glGenTextures(1, &array.texture);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, array.texture);
+    // Every mip level is allocated up front; layers are filled in by add()
+    int levelWidth = width, levelHeight = height;
+    for (uint32_t level = 0; level < levels; ++level) {
+        if (compressed) {
+            size_t layerSize = getTextureLevelSize(blockFormat, static_cast<uint32_t>(levelWidth),
+                                                   static_cast<uint32_t>(levelHeight));
+            glCompressedTexImage3D(GL_TEXTURE_2D_ARRAY, static_cast<GLint>(level), internalFormat, levelWidth,
+                                   levelHeight, static_cast<GLsizei>(array.capacity), 0,
+                                   static_cast<GLsizei>(layerSize * array.capacity), nullptr);
+        } else {
+            glTexImage3D(GL_TEXTURE_2D_ARRAY, static_cast<GLint>(level), static_cast<GLint>(internalFormat), levelWidth,
+                         levelHeight, static_cast<GLsizei>(array.capacity), 0, getUncompressedFormat(internalFormat),
+                         GL_UNSIGNED_BYTE, nullptr);
+        }
+        levelWidth = std::max(1, levelWidth / 2);
+        levelHeight = std::max(1, levelHeight / 2);
+    }
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(levels - 1));
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    arrays.push_back(std::move(array));
+    return static_cast<uint32_t>(arrays.size() - 1);
+}
+
+void TextureArrayPool::updateMipmaps(ArrayTexture& array) {
+    if (!array.mipmapsDirty) return;
+    glBindTexture(GL_TEXTURE_2D_ARRAY, array.texture);
+    glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    array.mipmapsDirty = false;
+}
+
+} // namespace SFE
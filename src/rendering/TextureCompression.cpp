@@ -0,0 +1,636 @@
+#include "rendering/TextureCompression.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SFE_TEXTURE_SSE 1
+#else
+#define SFE_TEXTURE_SSE 0
+#endif
+
+namespace SFE {
+
+namespace {
+
+// ---------------------------------------------------------------------------------------------
+// Mip filtering
+
+float srgbToLinear(float value) {
+    return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+}
+
+float linearToSrgb(float value) {
+    return value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+}
+
+uint8_t toByte(float value) {
+    return static_cast<uint8_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+// Average of four RGBA texels weighted by alpha; falls back to the plain average when all four
+// are fully transparent
+void filterTexels(const float* t0, const float* t1, const float* t2, const float* t3, float* out) {
+#if SFE_TEXTURE_SSE
+    const __m128 rgbMask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+    const __m128 alphaOne = _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f);
+    auto weighted = [&](const float* texel) {
+        __m128 value = _mm_loadu_ps(texel);
+        __m128 alpha = _mm_shuffle_ps(value, value, _MM_SHUFFLE(3, 3, 3, 3));
+        // (r*a, g*a, b*a, a)
+        return _mm_mul_ps(value, _mm_or_ps(_mm_and_ps(alpha, rgbMask), alphaOne));
+    };
+    __m128 sum = _mm_add_ps(_mm_add_ps(weighted(t0), weighted(t1)), _mm_add_ps(weighted(t2), weighted(t3)));
+    float totals[4];
+    _mm_storeu_ps(totals, sum);
+    if (totals[3] > 0.0f) {
+        __m128 alpha = _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(3, 3, 3, 3));
+        __m128 colour = _mm_div_ps(sum, alpha);
+        __m128 result = _mm_or_ps(_mm_and_ps(colour, rgbMask), _mm_andnot_ps(rgbMask, _mm_mul_ps(sum, _mm_set1_ps(0.25f))));
+        _mm_storeu_ps(out, result);
+        return;
+    }
+    __m128 plain = _mm_add_ps(_mm_add_ps(_mm_loadu_ps(t0), _mm_loadu_ps(t1)), _mm_add_ps(_mm_loadu_ps(t2), _mm_loadu_ps(t3)));
+    _mm_storeu_ps(out, _mm_mul_ps(plain, _mm_set1_ps(0.25f)));
+#else
+    const float* texels[4] = {t0, t1, t2, t3};
+    float sum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    for (const float* texel : texels) {
+        for (int c = 0; c < 3; ++c) sum[c] += texel[c] * texel[3];
+        sum[3] += texel[3];
+    }
+    if (sum[3] > 0.0f) {
+        for (int c = 0; c < 3; ++c) out[c] = sum[c] / sum[3];
+        out[3] = sum[3] * 0.25f;
+        return;
+    }
+    for (int c = 0; c < 4; ++c) out[c] = (t0[c] + t1[c] + t2[c] + t3[c]) * 0.25f;
+#endif
+}
+
+// ---------------------------------------------------------------------------------------------
+// Block compression helpers. Texels are floats in 0..255.
+
+struct Block {
+    float texels[16][4];
+};
+
+Block loadBlock(const uint8_t rgba[64]) {
+    Block block;
+    for (int i = 0; i < 16; ++i) {
+        for (int c = 0; c < 4; ++c) block.texels[i][c] = rgba[i * 4 + c];
+    }
+    return block;
+}
+
+float distanceSquared(const float* a, const float* b, int channels) {
+    float sum = 0.0f;
+    for (int c = 0; c < channels; ++c) {
+        float d = a[c] - b[c];
+        sum += d * d;
+    }
+    return sum;
+}
+
+// Endpoints at the extremes of the block's projection onto its principal axis
+void fitPrincipalAxis(const Block& block, int channels, float start[4], float end[4]) {
+    float mean[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    for (const auto& texel : block.texels) {
+        for (int c = 0; c < channels; ++c) mean[c] += texel[c] / 16.0f;
+    }
+    float covariance[4][4] = {};
+    for (const auto& texel : block.texels) {
+        for (int i = 0; i < channels; ++i) {
+            for (int j = 0; j < channels; ++j) covariance[i][j] += (texel[i] - mean[i]) * (texel[j] - mean[j]);
+        }
+    }
+
+    // Power iteration, starting from the diagonal so a single dominant channel converges at once
+    float axis[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    for (int c = 0; c < channels; ++c) axis[c] = covariance[c][c] + 1e-3f * (c + 1);
+    for (int iteration = 0; iteration < 8; ++iteration) {
+        float next[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        float length = 0.0f;
+        for (int i = 0; i < channels; ++i) {
+            for (int j = 0; j < channels; ++j) next[i] += covariance[i][j] * axis[j];
+            length += next[i] * next[i];
+        }
+        if (length < 1e-12f) break;
+        length = std::sqrt(length);
+        for (int c = 0; c < channels; ++c) axis[c] = next[c] / length;
+    }
+
+    float minProjection = std::numeric_limits<float>::max();
+    float maxProjection = -std::numeric_limits<float>::max();
+    for (const auto& texel : block.texels) {
+        float projection = 0.0f;
+        for (int c = 0; c < channels; ++c) projection += (texel[c] - mean[c]) * axis[c];
+        minProjection = std::min(minProjection, projection);
+        maxProjection = std::max(maxProjection, projection);
+    }
+    for (int c = 0; c < 4; ++c) {
+        start[c] = c < channels ? std::clamp(mean[c] + axis[c] * minProjection, 0.0f, 255.0f) : 255.0f;
+        end[c] = c < channels ? std::clamp(mean[c] + axis[c] * maxProjection, 0.0f, 255.0f) : 255.0f;
+    }
+}
+
+// Least-squares endpoints for fixed interpolation weights (texel ~ (1 - w) * start + w * end).
+// Returns false when the weights do not determine both endpoints.
+bool fitLeastSquares(const Block& block, int channels, const float weights[16], float start[4], float end[4]) {
+    float aa = 0.0f, bb = 0.0f, ab = 0.0f;
+    float ax[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    float bx[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    for (int i = 0; i < 16; ++i) {
+        float a = 1.0f - weights[i];
+        float b = weights[i];
+        aa += a * a;
+        bb += b * b;
+        ab += a * b;
+        for (int c = 0; c < channels; ++c) {
+            ax[c] += a * block.texels[i][c];
+            bx[c] += b * block.texels[i][c];
+        }
+    }
+    float determinant = aa * bb - ab * ab;
+    if (std::fabs(determinant) < 1e-6f) return false;
+    for (int c = 0; c < channels; ++c) {
+        start[c] = std::clamp((ax[c] * bb - bx[c] * ab) / determinant, 0.0f, 255.0f);
+        end[c] = std::clamp((bx[c] * aa - ax[c] * ab) / determinant, 0.0f, 255.0f);
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------
+// BC1 colour block
+
+uint16_t packRgb565(const float colour[4]) {
+    auto quantize = [](float value, int maxValue) {
+        return static_cast<uint16_t>(std::clamp(static_cast<int>(value * maxValue / 255.0f + 0.5f), 0, maxValue));
+    };
+    return static_cast<uint16_t>(quantize(colour[0], 31) << 11 | quantize(colour[1], 63) << 5 | quantize(colour[2], 31));
+}
+
+void unpackRgb565(uint16_t packed, int colour[3]) {
+    int r = packed >> 11 & 31, g = packed >> 5 & 63, b = packed & 31;
+    colour[0] = r << 3 | r >> 2;
+    colour[1] = g << 2 | g >> 4;
+    colour[2] = b << 3 | b >> 2;
+}
+
+// Palette of a colour block; 'fourColour' is the c0 > c1 mode, otherwise entry 3 is transparent black
+void buildBc1Palette(uint16_t c0, uint16_t c1, bool fourColour, int palette[4][4]) {
+    unpackRgb565(c0, palette[0]);
+    unpackRgb565(c1, palette[1]);
+    palette[0][3] = palette[1][3] = 255;
+    for (int c = 0; c < 3; ++c) {
+        if (fourColour) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        } else {
+            palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+            palette[3][c] = 0;
+        }
+    }
+    palette[2][3] = 255;
+    palette[3][3] = fourColour ? 255 : 0;
+}
+
+// Indices for quantised endpoints in four-colour order; returns the squared error
+float assignBc1Indices(const Block& block, uint16_t c0, uint16_t c1, uint8_t indices[16]) {
+    int palette[4][4];
+    buildBc1Palette(c0, c1, true, palette);
+    float error = 0.0f;
+    for (int i = 0; i < 16; ++i) {
+        float best = std::numeric_limits<float>::max();
+        for (int entry = 0; entry < 4; ++entry) {
+            float colour[3] = {float(palette[entry][0]), float(palette[entry][1]), float(palette[entry][2])};
+            float distance = distanceSquared(block.texels[i], colour, 3);
+            if (distance < best) {
+                best = distance;
+                indices[i] = static_cast<uint8_t>(entry);
+            }
+        }
+        error += best;
+    }
+    return error;
+}
+
+// Always produces a four-colour block (c0 > c1), which BC3 requires
+void encodeColourBlock(const Block& block, uint8_t out[8]) {
+    static const float weightOfIndex[4] = {0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f};
+
+    float start[4], end[4];
+    fitPrincipalAxis(block, 3, start, end);
+    uint16_t c0 = packRgb565(end), c1 = packRgb565(start);
+    uint8_t indices[16];
+    float error = assignBc1Indices(block, c0, c1, indices);
+
+    float weights[16];
+    for (int i = 0; i < 16; ++i) weights[i] = weightOfIndex[indices[i]];
+    if (fitLeastSquares(block, 3, weights, end, start)) {
+        uint16_t refined0 = packRgb565(end), refined1 = packRgb565(start);
+        uint8_t refinedIndices[16];
+        float refinedError = assignBc1Indices(block, refined0, refined1, refinedIndices);
+        if (refinedError < error) {
+            c0 = refined0;
+            c1 = refined1;
+            std::memcpy(indices, refinedIndices, sizeof(indices));
+        }
+    }
+
+    if (c0 < c1) {
+        // Swap into four-colour order; entries 0<->1 and 2<->3 trade places
+        std::swap(c0, c1);
+        for (uint8_t& index : indices) index ^= 1;
+    } else if (c0 == c1) {
+        std::memset(indices, 0, sizeof(indices));
+    }
+
+    uint32_t packedIndices = 0;
+    for (int i = 0; i < 16; ++i) packedIndices |= uint32_t(indices[i]) << (2 * i);
+    out[0] = static_cast<uint8_t>(c0);
+    out[1] = static_cast<uint8_t>(c0 >> 8);
+    out[2] = static_cast<uint8_t>(c1);
+    out[3] = static_cast<uint8_t>(c1 >> 8);
+    for (int i = 0; i < 4; ++i) out[4 + i] = static_cast<uint8_t>(packedIndices >> (8 * i));
+}
+
+void decodeColourBlock(const uint8_t block[8], bool forceFourColour, uint8_t rgba[64]) {
+    uint16_t c0 = static_cast<uint16_t>(block[0] | block[1] << 8);
+    uint16_t c1 = static_cast<uint16_t>(block[2] | block[3] << 8);
+    uint32_t indices = uint32_t(block[4]) | uint32_t(block[5]) << 8 | uint32_t(block[6]) << 16 | uint32_t(block[7]) << 24;
+    int palette[4][4];
+    buildBc1Palette(c0, c1, forceFourColour || c0 > c1, palette);
+    for (int i = 0; i < 16; ++i) {
+        const int* colour = palette[indices >> (2 * i) & 3];
+        for (int c = 0; c < 4; ++c) rgba[i * 4 + c] = static_cast<uint8_t>(colour[c]);
+    }
+}
+
+// ---------------------------------------------------------------------------------------------
+// BC3 alpha block
+
+void buildAlphaPalette(int a0, int a1, int palette[8]) {
+    palette[0] = a0;
+    palette[1] = a1;
+    if (a0 > a1) {
+        for (int k = 2; k < 8; ++k) palette[k] = ((8 - k) * a0 + (k - 1) * a1) / 7;
+    } else {
+        for (int k = 2; k < 6; ++k) palette[k] = ((6 - k) * a0 + (k - 1) * a1) / 5;
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+}
+
+void encodeAlphaBlock(const uint8_t rgba[64], uint8_t out[8]) {
+    int minAlpha = 255, maxAlpha = 0;
+    for (int i = 0; i < 16; ++i) {
+        minAlpha = std::min<int>(minAlpha, rgba[i * 4 + 3]);
+        maxAlpha = std::max<int>(maxAlpha, rgba[i * 4 + 3]);
+    }
+    // Eight-value mode (a0 > a1) unless the block is constant
+    int palette[8];
+    buildAlphaPalette(maxAlpha, minAlpha, palette);
+    uint64_t packedIndices = 0;
+    if (maxAlpha != minAlpha) {
+        for (int i = 0; i < 16; ++i) {
+            int alpha = rgba[i * 4 + 3];
+            int bestIndex = 0, bestDistance = 256;
+            for (int entry = 0; entry < 8; ++entry) {
+                int distance = std::abs(palette[entry] - alpha);
+                if (distance < bestDistance) {
+                    bestDistance = distance;
+                    bestIndex = entry;
+                }
+            }
+            packedIndices |= uint64_t(bestIndex) << (3 * i);
+        }
+    }
+    out[0] = static_cast<uint8_t>(maxAlpha);
+    out[1] = static_cast<uint8_t>(minAlpha);
+    for (int i = 0; i < 6; ++i) out[2 + i] = static_cast<uint8_t>(packedIndices >> (8 * i));
+}
+
+void decodeAlphaBlock(const uint8_t block[8], uint8_t rgba[64]) {
+    int palette[8];
+    buildAlphaPalette(block[0], block[1], palette);
+    uint64_t indices = 0;
+    for (int i = 0; i < 6; ++i) indices |= uint64_t(block[2 + i]) << (8 * i);
+    for (int i = 0; i < 16; ++i) rgba[i * 4 + 3] = static_cast<uint8_t>(palette[indices >> (3 * i) & 7]);
+}
+
+// ---------------------------------------------------------------------------------------------
+// BC7 mode 6
+
+const int BC7_WEIGHTS[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+// 7-bit endpoint plus shared p-bit, expanded to 8 bits
+struct Bc7Endpoint {
+    uint8_t value[4]; // 7-bit per channel
+    uint8_t pBit;
+
+    int expand(int channel) const { return value[channel] << 1 | pBit; }
+};
+
+// Picks the p-bit that quantises 'colour' with the smaller error
+Bc7Endpoint quantizeBc7Endpoint(const float colour[4]) {
+    Bc7Endpoint best{};
+    float bestError = std::numeric_limits<float>::max();
+    for (uint8_t pBit = 0; pBit < 2; ++pBit) {
+        Bc7Endpoint candidate{};
+        candidate.pBit = pBit;
+        float error = 0.0f;
+        for (int c = 0; c < 4; ++c) {
+            int value = std::clamp(static_cast<int>((colour[c] - pBit) / 2.0f + 0.5f), 0, 127);
+            candidate.value[c] = static_cast<uint8_t>(value);
+            float d = colour[c] - candidate.expand(c);
+            error += d * d;
+        }
+        if (error < bestError) {
+            bestError = error;
+            best = candidate;
+        }
+    }
+    return best;
+}
+
+void buildBc7Palette(const Bc7Endpoint& e0, const Bc7Endpoint& e1, int palette[16][4]) {
+    for (int entry = 0; entry < 16; ++entry) {
+        int weight = BC7_WEIGHTS[entry];
+        for (int c = 0; c < 4; ++c) palette[entry][c] = ((64 - weight) * e0.expand(c) + weight * e1.expand(c) + 32) >> 6;
+    }
+}
+
+float assignBc7Indices(const Block& block, const Bc7Endpoint& e0, const Bc7Endpoint& e1, uint8_t indices[16]) {
+    int palette[16][4];
+    buildBc7Palette(e0, e1, palette);
+    float error = 0.0f;
+    for (int i = 0; i < 16; ++i) {
+        float best = std::numeric_limits<float>::max();
+        for (int entry = 0; entry < 16; ++entry) {
+            float colour[4] = {float(palette[entry][0]), float(palette[entry][1]), float(palette[entry][2]),
+                               float(palette[entry][3])};
+            float distance = distanceSquared(block.texels[i], colour, 4);
+            if (distance < best) {
+                best = distance;
+                indices[i] = static_cast<uint8_t>(entry);
+            }
+        }
+        error += best;
+    }
+    return error;
+}
+
+class BitWriter {
+public:
+    explicit BitWriter(uint8_t* out) : out(out) { std::memset(out, 0, 16); }
+    void write(uint32_t value, int bits) {
+        for (int i = 0; i < bits; ++i, ++position) {
+            if (value >> i & 1) out[position >> 3] |= static_cast<uint8_t>(1 << (position & 7));
+        }
+    }
+
+private:
+    uint8_t* out;
+    int position = 0;
+};
+
+class BitReader {
+public:
+    explicit BitReader(const uint8_t* in) : in(in) {}
+    uint32_t read(int bits) {
+        uint32_t value = 0;
+        for (int i = 0; i < bits; ++i, ++position) value |= uint32_t(in[position >> 3] >> (position & 7) & 1) << i;
+        return value;
+    }
+
+private:
+    const uint8_t* in;
+    int position = 0;
+};
+
+void copyBlockFromImage(const uint8_t* rgba, uint32_t width, uint32_t height, uint32_t blockX, uint32_t blockY,
+                        uint8_t block[64]) {
+    for (uint32_t y = 0; y < 4; ++y) {
+        uint32_t sourceY = std::min(blockY * 4 + y, height - 1);
+        for (uint32_t x = 0; x < 4; ++x) {
+            uint32_t sourceX = std::min(blockX * 4 + x, width - 1);
+            std::memcpy(block + (y * 4 + x) * 4, rgba + (size_t(sourceY) * width + sourceX) * 4, 4);
+        }
+    }
+}
+
+} // namespace
+
+std::vector<TextureMipLevel> generateMipChain(const uint8_t* rgba, uint32_t width, uint32_t height, bool srgb,
+                                              uint32_t maxLevels) {
+    std::vector<TextureMipLevel> levels;
+    if (!rgba || width == 0 || height == 0 || maxLevels == 0) return levels;
+
+    float toLinear[256];
+    for (int i = 0; i < 256; ++i) toLinear[i] = srgb ? srgbToLinear(i / 255.0f) : i / 255.0f;
+
+    TextureMipLevel base;
+    base.width = width;
+    base.height = height;
+    base.pixels.assign(rgba, rgba + size_t(width) * height * 4);
+    levels.push_back(std::move(base));
+
+    std::vector<float> current(size_t(width) * height * 4);
+    for (size_t i = 0; i < size_t(width) * height; ++i) {
+        for (int c = 0; c < 3; ++c) current[i * 4 + c] = toLinear[rgba[i * 4 + c]];
+        current[i * 4 + 3] = rgba[i * 4 + 3] / 255.0f;
+    }
+
+    std::vector<float> next;
+    uint32_t levelWidth = width, levelHeight = height;
+    while ((levelWidth > 1 || levelHeight > 1) && levels.size() < maxLevels) {
+        uint32_t nextWidth = std::max(1u, levelWidth / 2);
+        uint32_t nextHeight = std::max(1u, levelHeight / 2);
+        next.resize(size_t(nextWidth) * nextHeight * 4);
+
+        for (uint32_t y = 0; y < nextHeight; ++y) {
+            // Odd sizes drop nothing: the last texel pairs with itself
+            uint32_t y0 = std::min(y * 2, levelHeight - 1);
+            uint32_t y1 = std::min(y * 2 + 1, levelHeight - 1);
+            for (uint32_t x = 0; x < nextWidth; ++x) {
+                uint32_t x0 = std::min(x * 2, levelWidth - 1);
+                uint32_t x1 = std::min(x * 2 + 1, levelWidth - 1);
+                filterTexels(&current[(size_t(y0) * levelWidth + x0) * 4], &current[(size_t(y0) * levelWidth + x1) * 4],
+                             &current[(size_t(y1) * levelWidth + x0) * 4], &current[(size_t(y1) * levelWidth + x1) * 4],
+                             &next[(size_t(y) * nextWidth + x) * 4]);
+            }
+        }
+
+        TextureMipLevel level;
+        level.width = nextWidth;
+        level.height = nextHeight;
+        level.pixels.resize(next.size());
+        for (size_t i = 0; i < size_t(nextWidth) * nextHeight; ++i) {
+            for (int c = 0; c < 3; ++c) {
+                float value = next[i * 4 + c];
+                level.pixels[i * 4 + c] = toByte(srgb ? linearToSrgb(std::clamp(value, 0.0f, 1.0f)) : value);
+            }
+            level.pixels[i * 4 + 3] = toByte(next[i * 4 + 3]);
+        }
+        levels.push_back(std::move(level));
+
+        current.swap(next);
+        levelWidth = nextWidth;
+        levelHeight = nextHeight;
+    }
+    return levels;
+}
+
+void compressBlockBC1(const uint8_t rgba[64], uint8_t block[8]) {
+    encodeColourBlock(loadBlock(rgba), block);
+}
+
+void compressBlockBC3(const uint8_t rgba[64], uint8_t block[16]) {
+    encodeAlphaBlock(rgba, block);
+    encodeColourBlock(loadBlock(rgba), block + 8);
+}
+
+void compressBlockBC7(const uint8_t rgba[64], uint8_t block[16]) {
+    Block texels = loadBlock(rgba);
+    float start[4], end[4];
+    fitPrincipalAxis(texels, 4, start, end);
+    Bc7Endpoint e0 = quantizeBc7Endpoint(start), e1 = quantizeBc7Endpoint(end);
+    uint8_t indices[16];
+    float error = assignBc7Indices(texels, e0, e1, indices);
+
+    float weights[16];
+    for (int i = 0; i < 16; ++i) weights[i] = BC7_WEIGHTS[indices[i]] / 64.0f;
+    if (fitLeastSquares(texels, 4, weights, start, end)) {
+        Bc7Endpoint refined0 = quantizeBc7Endpoint(start), refined1 = quantizeBc7Endpoint(end);
+        uint8_t refinedIndices[16];
+        float refinedError = assignBc7Indices(texels, refined0, refined1, refinedIndices);
+        if (refinedError < error) {
+            e0 = refined0;
+            e1 = refined1;
+            std::memcpy(indices, refinedIndices, sizeof(indices));
+        }
+    }
+
+    // The anchor texel's index is stored without its top bit, which must therefore be 0
+    if (indices[0] & 8) {
+        std::swap(e0, e1);
+        for (uint8_t& index : indices) index = static_cast<uint8_t>(15 - index);
+    }
+
+    BitWriter writer(block);
+    writer.write(1 << 6, 7); // Mode 6
+    for (int c = 0; c < 4; ++c) {
+        writer.write(e0.value[c], 7);
+        writer.write(e1.value[c], 7);
+    }
+    writer.write(e0.pBit, 1);
+    writer.write(e1.pBit, 1);
+    writer.write(indices[0], 3);
+    for (int i = 1; i < 16; ++i) writer.write(indices[i], 4);
+}
+
+void decompressBlockBC1(const uint8_t block[8], uint8_t rgba[64]) {
+    decodeColourBlock(block, false, rgba);
+}
+
+void decompressBlockBC3(const uint8_t block[16], uint8_t rgba[64]) {
+    decodeColourBlock(block + 8, true, rgba);
+    decodeAlphaBlock(block, rgba);
+}
+
+void decompressBlockBC7(const uint8_t block[16], uint8_t rgba[64]) {
+    BitReader reader(block);
+    if (reader.read(7) != 1 << 6) {
+        for (int i = 0; i < 16; ++i) {
+            rgba[i * 4 + 0] = 255;
+            rgba[i * 4 + 1] = 0;
+            rgba[i * 4 + 2] = 255;
+            rgba[i * 4 + 3] = 255;
+        }
+        return;
+    }
+    Bc7Endpoint e0{}, e1{};
+    for (int c = 0; c < 4; ++c) {
+        e0.value[c] = static_cast<uint8_t>(reader.read(7));
+        e1.value[c] = static_cast<uint8_t>(reader.read(7));
+    }
+    e0.pBit = static_cast<uint8_t>(reader.read(1));
+    e1.pBit = static_cast<uint8_t>(reader.read(1));
+    int palette[16][4];
+    buildBc7Palette(e0, e1, palette);
+    for (int i = 0; i < 16; ++i) {
+        const int* colour = palette[reader.read(i == 0 ? 3 : 4)];
+        for (int c = 0; c < 4; ++c) rgba[i * 4 + c] = static_cast<uint8_t>(colour[c]);
+    }
+}
+
+std::vector<uint8_t> compressTexture(TextureFileFormat format, const uint8_t* rgba, uint32_t width, uint32_t height) {
+    std::vector<uint8_t> data(getTextureLevelSize(format, width, height));
+    uint32_t blockBytes = getTextureBlockBytes(format);
+    if (blockBytes == 0) {
+        std::memcpy(data.data(), rgba, data.size());
+        return data;
+    }
+
+    uint32_t blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+    uint8_t texels[64];
+    for (uint32_t blockY = 0; blockY < blocksY; ++blockY) {
+        for (uint32_t blockX = 0; blockX < blocksX; ++blockX) {
+            copyBlockFromImage(rgba, width, height, blockX, blockY, texels);
+            uint8_t* out = data.data() + (size_t(blockY) * blocksX + blockX) * blockBytes;
+            switch (format) {
+            case TextureFileFormat::BC1: compressBlockBC1(texels, out); break;
+            case TextureFileFormat::BC3: compressBlockBC3(texels, out); break;
+            case TextureFileFormat::BC7: compressBlockBC7(texels, out); break;
+            default: break;
+            }
+        }
+    }
+    return data;
+}
+
+std::vector<uint8_t> decompressTexture(TextureFileFormat format, const uint8_t* data, uint32_t width,
+                                       uint32_t height) {
+    std::vector<uint8_t> rgba(size_t(width) * height * 4);
+    uint32_t blockBytes = getTextureBlockBytes(format);
+    if (blockBytes == 0) {
+        std::memcpy(rgba.data(), data, rgba.size());
+        return rgba;
+    }
+
+    uint32_t blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+    uint8_t texels[64];
+    for (uint32_t blockY = 0; blockY < blocksY; ++blockY) {
+        for (uint32_t blockX = 0; blockX < blocksX; ++blockX) {
+            const uint8_t* block = data + (size_t(blockY) * blocksX + blockX) * blockBytes;
+            switch (format) {
+            case TextureFileFormat::BC1: decompressBlockBC1(block, texels); break;
+            case TextureFileFormat::BC3: decompressBlockBC3(block, texels); break;
+            case TextureFileFormat::BC7: decompressBlockBC7(block, texels); break;
+            default: break;
+            }
+            for (uint32_t y = 0; y < 4 && blockY * 4 + y < height; ++y) {
+                for (uint32_t x = 0; x < 4 && blockX * 4 + x < width; ++x) {
+                    std::memcpy(&rgba[(size_t(blockY * 4 + y) * width + blockX * 4 + x) * 4], texels + (y * 4 + x) * 4, 4);
+                }
+            }
+        }
+    }
+    return rgba;
+}
+
+double computeTexturePsnr(const uint8_t* a, const uint8_t* b, uint32_t width, uint32_t height) {
+    size_t count = size_t(width) * height * 4;
+    double sum = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        double d = double(a[i]) - double(b[i]);
+        sum += d * d;
+    }
+    if (sum == 0.0 || count == 0) return std::numeric_limits<double>::infinity();
+    return 10.0 * std::log10(255.0 * 255.0 / (sum / count));
+}
+
+} // namespace SFE
@@ -0,0 +1,148 @@
+#include "rendering/TextureFormat.hpp"
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+namespace SFE {
+
+namespace {
+
+uint64_t alignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+uint32_t getLevelDimension(uint32_t base, uint32_t level) {
+    return std::max(1u, base >> level);
+}
+
+} // namespace
+
+const char* getTextureFileFormatName(TextureFileFormat format) {
+    switch (format) {
+    case TextureFileFormat::RGBA8: return "RGBA8";
+    case TextureFileFormat::BC1: return "BC1";
+    case TextureFileFormat::BC3: return "BC3";
+    case TextureFileFormat::BC7: return "BC7";
+    case TextureFileFormat::Count: break;
+    }
+    return "Unknown";
+}
+
+uint32_t getTextureBlockBytes(TextureFileFormat format) {
+    switch (format) {
+    case TextureFileFormat::BC1: return 8;
+    case TextureFileFormat::BC3:
+    case TextureFileFormat::BC7: return 16;
+    default: return 0;
+    }
+}
+
+size_t getTextureLevelSize(TextureFileFormat format, uint32_t width, uint32_t height) {
+    uint32_t blockBytes = getTextureBlockBytes(format);
+    if (blockBytes == 0) return size_t(width) * height * 4;
+    return size_t((width + 3) / 4) * ((height + 3) / 4) * blockBytes;
+}
+
+bool writeTextureFile(const std::string& path, const TextureFileDesc& desc) {
+    if (desc.levelCount == 0 || desc.levelCount > TEXTURE_FILE_MAX_LEVELS || !desc.levelData ||
+        desc.format >= TextureFileFormat::Count) {
+        return false;
+    }
+
+    TextureFileHeader header{};
+    header.magic = TEXTURE_FILE_MAGIC;
+    header.version = TEXTURE_FILE_VERSION;
+    header.format = static_cast<uint32_t>(desc.format);
+    header.flags = desc.flags;
+    header.width = desc.width;
+    header.height = desc.height;
+    header.levelCount = desc.levelCount;
+    header.levelIndexOffset = alignUp(sizeof(TextureFileHeader), alignof(TextureFileLevel));
+
+    // Smallest level first in the file; the index stays in level order
+    std::vector<TextureFileLevel> levels(desc.levelCount);
+    uint64_t offset = header.levelIndexOffset + levels.size() * sizeof(TextureFileLevel);
+    for (uint32_t i = desc.levelCount; i > 0; --i) {
+        TextureFileLevel& level = levels[i - 1];
+        level.width = getLevelDimension(desc.width, i - 1);
+        level.height = getLevelDimension(desc.height, i - 1);
+        level.size = getTextureLevelSize(desc.format, level.width, level.height);
+        level.offset = alignUp(offset, TEXTURE_FILE_ALIGNMENT);
+        offset = level.offset + level.size;
+    }
+    header.fileSize = offset;
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    const char zeros[TEXTURE_FILE_ALIGNMENT] = {};
+    auto padTo = [&](uint64_t target) {
+        uint64_t position = static_cast<uint64_t>(file.tellp());
+        file.write(zeros, static_cast<std::streamsize>(target - position));
+    };
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    padTo(header.levelIndexOffset);
+    file.write(reinterpret_cast<const char*>(levels.data()),
+               static_cast<std::streamsize>(levels.size() * sizeof(TextureFileLevel)));
+    for (uint32_t i = desc.levelCount; i > 0; --i) {
+        padTo(levels[i - 1].offset);
+        file.write(reinterpret_cast<const char*>(desc.levelData[i - 1]), static_cast<std::streamsize>(levels[i - 1].size));
+    }
+
+    return file.good();
+}
+
+const TextureFileHeader* validateTextureFile(const uint8_t* data, size_t size, std::string& error) {
+    if (!data || size < sizeof(TextureFileHeader)) {
+        error = "file too small for header";
+        return nullptr;
+    }
+
+    const auto* header = reinterpret_cast<const TextureFileHeader*>(data);
+    if (header->magic != TEXTURE_FILE_MAGIC) {
+        error = "bad magic";
+        return nullptr;
+    }
+    if (header->version != TEXTURE_FILE_VERSION) {
+        error = "unsupported version " + std::to_string(header->version) + " (expected " +
+                std::to_string(TEXTURE_FILE_VERSION) + ")";
+        return nullptr;
+    }
+    if (header->format >= static_cast<uint32_t>(TextureFileFormat::Count)) {
+        error = "unknown format " + std::to_string(header->format);
+        return nullptr;
+    }
+    if (header->fileSize != size) {
+        error = "truncated or padded file";
+        return nullptr;
+    }
+    if (header->width == 0 || header->height == 0 || header->levelCount == 0 ||
+        header->levelCount > TEXTURE_FILE_MAX_LEVELS) {
+        error = "bad dimensions or level count";
+        return nullptr;
+    }
+    if (header->levelIndexOffset % alignof(TextureFileLevel) != 0 ||
+        header->levelIndexOffset + uint64_t(header->levelCount) * sizeof(TextureFileLevel) > size) {
+        error = "level index out of range";
+        return nullptr;
+    }
+
+    auto format = static_cast<TextureFileFormat>(header->format);
+    const TextureFileLevel* levels = getTextureFileLevels(data, *header);
+    for (uint32_t i = 0; i < header->levelCount; ++i) {
+        const TextureFileLevel& level = levels[i];
+        if (level.width != getLevelDimension(header->width, i) || level.height != getLevelDimension(header->height, i) ||
+            level.size != getTextureLevelSize(format, level.width, level.height) || level.offset > size ||
+            level.size > size - level.offset) {
+            error = "level " + std::to_string(i) + " out of range";
+            return nullptr;
+        }
+    }
+
+    return header;
+}
+
+} // namespace SFE
@@ -0,0 +1,187 @@
+#include "rendering/VertexQuantization.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace SFE {
+
+namespace {
+
+struct StandardVertexData {
+    float position[3];
+    float normal[3];
+    float texCoord[2];
+};
+static_assert(sizeof(StandardVertexData) == 32, "Standard vertex layout is 32 bytes");
+
+float signNotZero(float value) {
+    return value >= 0.0f ? 1.0f : -1.0f;
+}
+
+int16_t toSnorm16(float value) {
+    return static_cast<int16_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * 32767.0f));
+}
+
+template <typename QuantizedT, typename EncodeNormal>
+void quantizeInto(std::vector<uint8_t>& output, const StandardVertexData* source, size_t vertexCount,
+                  const float boundsMin[3], const float boundsMax[3], EncodeNormal encodeNormal) {
+    output.resize(vertexCount * sizeof(QuantizedT));
+    auto* destination = reinterpret_cast<QuantizedT*>(output.data());
+    for (size_t v = 0; v < vertexCount; ++v) {
+        QuantizedT packed{};
+        for (int axis = 0; axis < 3; ++axis) {
+            packed.position[axis] = quantizeUnorm16(source[v].position[axis], boundsMin[axis], boundsMax[axis]);
+        }
+        encodeNormal(source[v].normal, packed.normal);
+        packed.texCoord[0] = floatToHalf(source[v].texCoord[0]);
+        packed.texCoord[1] = floatToHalf(source[v].texCoord[1]);
+        destination[v] = packed;
+    }
+}
+
+} // namespace
+
+uint16_t floatToHalf(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    uint32_t sign = (bits >> 16) & 0x8000u;
+    uint32_t rawExponent = (bits >> 23) & 0xFFu;
+    uint32_t mantissa = bits & 0x7FFFFFu;
+
+    if (rawExponent == 0xFFu) {
+        // Inf stays inf, NaN stays a (quiet) NaN
+        return static_cast<uint16_t>(sign | 0x7C00u | (mantissa ? 0x200u : 0u));
+    }
+
+    int32_t exponent = static_cast<int32_t>(rawExponent) - 127 + 15;
+    if (exponent >= 31) {
+        return static_cast<uint16_t>(sign | 0x7C00u); // Overflow to inf
+    }
+
+    if (exponent <= 0) {
+        // Half denormal (or zero); round to nearest even
+        if (exponent < -10) return static_cast<uint16_t>(sign);
+        mantissa |= 0x800000u;
+        uint32_t shift = static_cast<uint32_t>(14 - exponent);
+        uint32_t half = mantissa >> shift;
+        uint32_t remainder = mantissa & ((1u << shift) - 1u);
+        uint32_t halfway = 1u << (shift - 1u);
+        if (remainder > halfway || (remainder == halfway && (half & 1u))) ++half;
+        return static_cast<uint16_t>(sign | half);
+    }
+
+    uint32_t half = (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+    uint32_t remainder = mantissa & 0x1FFFu;
+    // A carry out of the mantissa correctly bumps the exponent (up to inf)
+    if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u))) ++half;
+    return static_cast<uint16_t>(sign | half);
+}
+
+float halfToFloat(uint16_t value) {
+    uint32_t sign = static_cast<uint32_t>(value & 0x8000u) << 16;
+    uint32_t exponent = (value >> 10) & 0x1Fu;
+    uint32_t mantissa = value & 0x3FFu;
+
+    uint32_t bits;
+    if (exponent == 0) {
+        if (mantissa == 0) {
+            bits = sign;
+        } else {
+            // Normalise the denormal
+            exponent = 127 - 15 + 1;
+            while ((mantissa & 0x400u) == 0) {
+                mantissa <<= 1;
+                --exponent;
+            }
+            bits = sign | (exponent << 23) | ((mantissa & 0x3FFu) << 13);
+        }
+    } else if (exponent == 0x1Fu) {
+        bits = sign | 0x7F800000u | (mantissa << 13);
+    } else {
+        bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+    }
+
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+uint16_t quantizeUnorm16(float value, float minimum, float maximum) {
+    float range = maximum - minimum;
+    if (range <= 0.0f) return 0;
+    float normalized = std::clamp((value - minimum) / range, 0.0f, 1.0f);
+    return static_cast<uint16_t>(std::lround(normalized * 65535.0f));
+}
+
+void encodeOctahedral(const float normal[3], int16_t encoded[2]) {
+    float length = std::fabs(normal[0]) + std::fabs(normal[1]) + std::fabs(normal[2]);
+    if (length <= 0.0f) {
+        encoded[0] = 0;
+        encoded[1] = 0;
+        return;
+    }
+
+    // Project onto the octahedron, then fold the lower hemisphere over the diagonals
+    float x = normal[0] / length;
+    float y = normal[1] / length;
+    if (normal[2] < 0.0f) {
+        float foldedX = (1.0f - std::fabs(y)) * signNotZero(x);
+        float foldedY = (1.0f - std::fabs(x)) * signNotZero(y);
+        x = foldedX;
+        y = foldedY;
+    }
+    encoded[0] = toSnorm16(x);
+    encoded[1] = toSnorm16(y);
+}
+
+void decodeOctahedral(const int16_t encoded[2], float normal[3]) {
+    float x = std::max(encoded[0] / 32767.0f, -1.0f);
+    float y = std::max(encoded[1] / 32767.0f, -1.0f);
+    float z = 1.0f - std::fabs(x) - std::fabs(y);
+    if (z < 0.0f) {
+        float unfoldedX = (1.0f - std::fabs(y)) * signNotZero(x);
+        float unfoldedY = (1.0f - std::fabs(x)) * signNotZero(y);
+        x = unfoldedX;
+        y = unfoldedY;
+    }
+    float length = std::sqrt(x * x + y * y + z * z);
+    normal[0] = x / length;
+    normal[1] = y / length;
+    normal[2] = z / length;
+}
+
+uint32_t packSnorm1010102(const float normal[3]) {
+    // GL_INT_2_10_10_10_REV: x in the low bits, w (unused, 0) in the top two
+    uint32_t packed = 0;
+    for (int axis = 0; axis < 3; ++axis) {
+        int32_t component = static_cast<int32_t>(std::lround(std::clamp(normal[axis], -1.0f, 1.0f) * 511.0f));
+        packed |= (static_cast<uint32_t>(component) & 0x3FFu) << (10 * axis);
+    }
+    return packed;
+}
+
+std::vector<uint8_t> quantizeVertices(VertexFormat format, const void* standardVertices,
+                                      size_t vertexCount, const float boundsMin[3],
+                                      const float boundsMax[3]) {
+    std::vector<uint8_t> output;
+    const auto* source = static_cast<const StandardVertexData*>(standardVertices);
+
+    switch (format) {
+    case VertexFormat::QuantizedOct:
+        quantizeInto<QuantizedVertexOct>(output, source, vertexCount, boundsMin, boundsMax,
+                                         [](const float* n, int16_t* out) { encodeOctahedral(n, out); });
+        break;
+    case VertexFormat::Quantized1010102:
+        quantizeInto<QuantizedVertex1010102>(output, source, vertexCount, boundsMin, boundsMax,
+                                             [](const float* n, uint32_t& out) { out = packSnorm1010102(n); });
+        break;
+    default:
+        output.assign(static_cast<const uint8_t*>(standardVertices),
+                      static_cast<const uint8_t*>(standardVertices) + vertexCount * sizeof(StandardVertexData));
+        break;
+    }
+    return output;
+}
+
+} // namespace SFE
@@ -0,0 +1,113 @@
+#include <catch2/catch_test_macros.hpp>
+#include "core/AssetPack.hpp"
+#include "core/AssetPackFormat.hpp"
+#include "core/Lz4.hpp"
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::vector<uint8_t> bytesOf(const std::string& text) {
+    return std::vector<uint8_t>(text.begin(), text.end());
+}
+
+} // namespace
+
+TEST_CASE("LZ4 blocks round trip", "[assetpack]") {
+    SECTION("Repetitive data compresses") {
+        std::string text;
+        for (int i = 0; i < 200; ++i) text += "uniform mat4 model; // line " + std::to_string(i % 7) + "\n";
+        std::vector<uint8_t> source = bytesOf(text);
+        std::vector<uint8_t> packed = SFE::lz4Compress(source.data(), source.size());
+        REQUIRE(packed.size() < source.size() / 4);
+
+        std::vector<uint8_t> unpacked(source.size());
+        REQUIRE(SFE::lz4Decompress(packed.data(), packed.size(), unpacked.data(), unpacked.size()));
+        REQUIRE(unpacked == source);
+    }
+
+    SECTION("Random data stays within the bound") {
+        std::mt19937 random(7);
+        std::vector<uint8_t> source(10000);
+        for (auto& byte : source) byte = static_cast<uint8_t>(random());
+        std::vector<uint8_t> packed = SFE::lz4Compress(source.data(), source.size());
+        REQUIRE(packed.size() <= SFE::lz4CompressBound(source.size()));
+
+        std::vector<uint8_t> unpacked(source.size());
+        REQUIRE(SFE::lz4Decompress(packed.data(), packed.size(), unpacked.data(), unpacked.size()));
+        REQUIRE(unpacked == source);
+    }
+
+    SECTION("Truncated input is rejected") {
+        std::vector<uint8_t> source = bytesOf(std::string(4096, 'a') + "tail");
+        std::vector<uint8_t> packed = SFE::lz4Compress(source.data(), source.size());
+        std::vector<uint8_t> unpacked(source.size());
+        REQUIRE_FALSE(SFE::lz4Decompress(packed.data(), packed.size() - 3, unpacked.data(), unpacked.size()));
+        REQUIRE_FALSE(SFE::lz4Decompress(packed.data(), packed.size(), unpacked.data(), unpacked.size() - 1));
+    }
+}
+
+TEST_CASE("Asset packs serve stored and compressed entries", "[assetpack]") {
+    const std::string packPath = "AssetPack_test.sfp";
+    std::string shaderText;
+    for (int i = 0; i < 64; ++i) shaderText += "void main() { gl_Position = vec4(0.0); }\n";
+    std::vector<uint8_t> meshBytes(1000);
+    for (size_t i = 0; i < meshBytes.size(); ++i) meshBytes[i] = static_cast<uint8_t>(i * 31);
+
+    std::vector<SFE::AssetPackSource> sources(2);
+    sources[0].path = "shaders/x.vert";
+    sources[0].data = bytesOf(shaderText);
+    sources[0].compress = true;
+    sources[1].path = "assets/meshes/cube.sfm";
+    sources[1].data = meshBytes;
+
+    SFE::AssetPackStats stats;
+    REQUIRE(SFE::writeAssetPack(packPath, sources, &stats));
+    REQUIRE(stats.entryCount == 2);
+    REQUIRE(stats.compressedEntries == 1);
+
+    SFE::AssetPack pack;
+    REQUIRE(pack.open(packPath));
+    REQUIRE(pack.getEntryCount() == 2);
+
+    SECTION("Lookups normalise the path") {
+        const SFE::AssetPackEntry* entry = pack.find("./shaders\\x.vert");
+        REQUIRE(entry != nullptr);
+        REQUIRE(pack.getPath(*entry) == "shaders/x.vert");
+        REQUIRE(pack.find("shaders/y.vert") == nullptr);
+
+        SFE::AssetData data;
+        REQUIRE(pack.read(*entry, data));
+        REQUIRE(data.ownsData());
+        REQUIRE(data.getText() == shaderText);
+    }
+
+    SECTION("Stored entries are aligned views into the mapping") {
+        const SFE::AssetPackEntry* entry = pack.find("assets/meshes/cube.sfm");
+        REQUIRE(entry != nullptr);
+        REQUIRE(entry->offset % SFE::ASSET_PACK_ALIGNMENT == 0);
+
+        SFE::AssetData data;
+        REQUIRE(pack.read(*entry, data));
+        REQUIRE_FALSE(data.ownsData());
+        REQUIRE(std::vector<uint8_t>(data.getData(), data.getData() + data.getSize()) == meshBytes);
+    }
+
+    SECTION("Duplicate paths and corrupt files are rejected") {
+        sources[1].path = sources[0].path;
+        REQUIRE_FALSE(SFE::writeAssetPack(packPath + ".dup", sources));
+        std::remove((packPath + ".dup").c_str());
+
+        pack.close();
+        std::fstream file(packPath, std::ios::in | std::ios::out | std::ios::binary);
+        file.put('X');
+        file.close();
+        REQUIRE_FALSE(pack.open(packPath));
+    }
+
+    pack.close();
+    std::remove(packPath.c_str());
+}
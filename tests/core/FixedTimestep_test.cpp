@@ -0,0 +1,38 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "core/FixedTimestep.hpp"
+
+TEST_CASE("FixedTimestep pays out whole ticks and keeps the remainder", "[timestep]") {
+    SFE::FixedTimestep timestep(0.01, 8);
+
+    REQUIRE(timestep.advance(0.004) == 0);
+    REQUIRE(timestep.getAlpha() == Approx(0.4f));
+
+    REQUIRE(timestep.advance(0.021) == 2); // 0.025 accumulated
+    REQUIRE(timestep.getAlpha() == Approx(0.5f));
+    REQUIRE(timestep.getTickCount() == 2);
+    REQUIRE(timestep.getSimulationTime() == Approx(0.02));
+
+    SECTION("Variable frame times add up to the same simulation time") {
+        for (int i = 0; i < 100; ++i) timestep.advance(i % 2 ? 0.003 : 0.017);
+        // 1.0 s more in total, 0.025 + 1.0 = 102.5 ticks
+        REQUIRE(timestep.getTickCount() == 102);
+        REQUIRE(timestep.getAlpha() == Approx(0.5f).margin(1e-3));
+    }
+
+    SECTION("A long stall is clamped") {
+        REQUIRE(timestep.advance(1.0) == 8);
+        REQUIRE(timestep.getAlpha() < 1.0f);
+        REQUIRE(timestep.getDiscardedTime() == Approx(0.92).margin(1e-9));
+        REQUIRE(timestep.advance(0.0) == 0);
+    }
+}
+
+TEST_CASE("FixedTimestep lockstep runs one tick per frame", "[timestep]") {
+    SFE::FixedTimestep timestep(1.0 / 60.0);
+    timestep.setLockstep(true);
+    REQUIRE(timestep.advance(0.5) == 1);
+    REQUIRE(timestep.advance(0.0) == 1);
+    REQUIRE(timestep.getTickCount() == 2);
+    REQUIRE(timestep.getAlpha() == 1.0f);
+}
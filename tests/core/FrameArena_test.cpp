@@ -0,0 +1,91 @@
+#include <catch2/catch_test_macros.hpp>
+#include "core/FrameArena.hpp"
+#include <cstring>
+#include <memory_resource>
+#include <vector>
+
+namespace {
+
+// Counts what reaches the heap
+class CountingResource : public std::pmr::memory_resource {
+public:
+    int allocations = 0;
+    int outstanding = 0;
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        ++allocations;
+        ++outstanding;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* pointer, size_t bytes, size_t alignment) override {
+        --outstanding;
+        std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+} // namespace
+
+TEST_CASE("LinearArena bumps, aligns and resets", "[arena]") {
+    CountingResource heap;
+    SFE::LinearArena arena(1024, &heap);
+
+    void* a = arena.allocate(3, 1);
+    void* b = arena.allocate(16, 16);
+    REQUIRE(reinterpret_cast<uintptr_t>(b) % 16 == 0);
+    REQUIRE(static_cast<char*>(b) > static_cast<char*>(a));
+    REQUIRE(arena.getUsedBytes() >= 19);
+
+    arena.reset();
+    REQUIRE(arena.getUsedBytes() == 0);
+    REQUIRE(arena.allocate(3, 1) == a); // Same memory again
+
+    SECTION("pmr containers allocate from the arena") {
+        std::pmr::vector<int> values(&arena);
+        values.reserve(100); // Growth would leave every old block in the arena until reset
+        for (int i = 0; i < 100; ++i) values.push_back(i);
+        std::pmr::string text("a string long enough to defeat the small string buffer", &arena);
+        REQUIRE(values[99] == 99);
+        REQUIRE(heap.allocations == 0);
+    }
+
+    SECTION("Overflow goes upstream and is returned on reset") {
+        void* large = arena.allocate(4096, 64);
+        REQUIRE(reinterpret_cast<uintptr_t>(large) % 64 == 0);
+        std::memset(large, 0xAB, 4096);
+        REQUIRE(arena.getOverflowCount() == 1);
+        REQUIRE(heap.outstanding == 1);
+        REQUIRE(arena.getPeakBytes() >= 4096);
+        arena.reset();
+        REQUIRE(heap.outstanding == 0);
+    }
+}
+
+TEST_CASE("LinearArena formats strings in place", "[arena]") {
+    SFE::LinearArena arena(64);
+    const char* first = arena.format("FPS: %d", 60);
+    const char* second = arena.format("%s-%c", "x", 'y');
+    REQUIRE(std::strcmp(first, "FPS: 60") == 0);
+    REQUIRE(std::strcmp(second, "x-y") == 0);
+    REQUIRE(arena.getUsedBytes() == 8 + 4);
+
+    // Too long for what is left: measured and allocated instead
+    const char* longer = arena.format("%0100d", 7);
+    REQUIRE(std::strlen(longer) == 100);
+    REQUIRE(longer[99] == '7');
+    REQUIRE(std::strcmp(first, "FPS: 60") == 0);
+}
+
+TEST_CASE("FrameArena keeps the previous frame's data", "[arena]") {
+    SFE::FrameArena frames(256);
+    frames.beginFrame();
+    const char* frame0 = frames.format("frame %d", 0);
+    frames.beginFrame();
+    const char* frame1 = frames.format("frame %d", 1);
+    REQUIRE(std::strcmp(frame0, "frame 0") == 0); // Still being consumed while frame 1 records
+    frames.beginFrame();
+    const char* frame2 = frames.format("frame %d", 2);
+    REQUIRE(frame2 == frame0); // Frame 0's arena was reset and reused
+    REQUIRE(std::strcmp(frame1, "frame 1") == 0);
+}
@@ -0,0 +1,70 @@
+#include <catch2/catch_test_macros.hpp>
+#include "core/FreeListAllocator.hpp"
+
+using SFE::FreeListAllocator;
+
+TEST_CASE("FreeListAllocator suballocates and coalesces ranges", "[allocator]") {
+    FreeListAllocator allocator(100);
+
+    SECTION("Allocations are packed from the start") {
+        REQUIRE(allocator.allocate(10) == 0);
+        REQUIRE(allocator.allocate(20) == 10);
+        REQUIRE(allocator.getUsed() == 30);
+        REQUIRE(allocator.getLargestFreeBlock() == 70);
+    }
+
+    SECTION("Oversized request fails") {
+        REQUIRE(allocator.allocate(101) == FreeListAllocator::INVALID_OFFSET);
+        REQUIRE(allocator.allocate(0) == FreeListAllocator::INVALID_OFFSET);
+    }
+
+    SECTION("Freed neighbours merge back into one block") {
+        uint32_t a = allocator.allocate(10);
+        uint32_t b = allocator.allocate(10);
+        uint32_t c = allocator.allocate(10);
+        allocator.free(a);
+        allocator.free(c);
+        REQUIRE(allocator.getFreeBlockCount() == 2);
+        allocator.free(b);
+        REQUIRE(allocator.getFreeBlockCount() == 1);
+        REQUIRE(allocator.getLargestFreeBlock() == 100);
+        REQUIRE(allocator.getUsed() == 0);
+    }
+
+    SECTION("Best fit reuses the smallest hole") {
+        uint32_t a = allocator.allocate(30);
+        allocator.allocate(5);
+        uint32_t c = allocator.allocate(10);
+        allocator.allocate(5);
+        allocator.free(a);
+        allocator.free(c);
+        REQUIRE(allocator.allocate(8) == c);
+        REQUIRE(allocator.allocate(25) == a);
+    }
+
+    SECTION("Double free is ignored") {
+        uint32_t a = allocator.allocate(10);
+        allocator.free(a);
+        allocator.free(a);
+        REQUIRE(allocator.getUsed() == 0);
+        REQUIRE(allocator.getFreeBlockCount() == 1);
+    }
+
+    SECTION("Grow keeps existing offsets and extends the tail block") {
+        allocator.allocate(90);
+        REQUIRE(allocator.allocate(20) == FreeListAllocator::INVALID_OFFSET);
+        allocator.grow(200);
+        REQUIRE(allocator.getCapacity() == 200);
+        REQUIRE(allocator.getFreeBlockCount() == 1);
+        REQUIRE(allocator.allocate(20) == 90);
+    }
+
+    SECTION("Reset drops all allocations") {
+        allocator.allocate(40);
+        allocator.allocate(40);
+        allocator.reset();
+        REQUIRE(allocator.getUsed() == 0);
+        REQUIRE(allocator.getAllocationCount() == 0);
+        REQUIRE(allocator.allocate(100) == 0);
+    }
+}
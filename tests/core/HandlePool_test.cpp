@@ -0,0 +1,67 @@
+#include <catch2/catch_test_macros.hpp>
+#include "core/HandlePool.hpp"
+#include <string>
+
+using SFE::HandlePool;
+
+TEST_CASE("HandlePool resolves handles and rejects stale ones", "[handles]") {
+    HandlePool<std::string> pool;
+    auto a = pool.create("a");
+    auto b = pool.create("b");
+    auto c = pool.create("c");
+
+    REQUIRE(sizeof(a) == 4);
+    REQUIRE(!a.isNull());
+    REQUIRE(*pool.get(a) == "a");
+    REQUIRE(*pool.get(c) == "c");
+    REQUIRE(pool.get(decltype(a){}) == nullptr);
+
+    SECTION("Destroying keeps the storage dense and the other handles valid") {
+        REQUIRE(pool.destroy(a));
+        REQUIRE(pool.size() == 2);
+        REQUIRE(pool.get(a) == nullptr);
+        REQUIRE(!pool.destroy(a));
+        REQUIRE(*pool.get(b) == "b");
+        REQUIRE(*pool.get(c) == "c");
+
+        std::string joined;
+        for (const std::string& value : pool) joined += value;
+        REQUIRE(joined.size() == 2);
+    }
+
+    SECTION("A recycled slot does not answer to the old handle") {
+        pool.destroy(b);
+        auto d = pool.create("d");
+        REQUIRE(d.getIndex() == b.getIndex());
+        REQUIRE(d != b);
+        REQUIRE(pool.get(b) == nullptr);
+        REQUIRE(*pool.get(d) == "d");
+    }
+
+    SECTION("Handles can be recovered while iterating") {
+        for (size_t i = 0; i < pool.size(); ++i) {
+            REQUIRE(pool.get(pool.getHandle(i)) == &*(pool.begin() + i));
+        }
+    }
+
+    SECTION("clear() invalidates everything") {
+        pool.clear();
+        REQUIRE(pool.empty());
+        REQUIRE(pool.get(a) == nullptr);
+        REQUIRE(pool.get(c) == nullptr);
+    }
+}
+
+TEST_CASE("Handle generations wrap without producing the null handle", "[handles]") {
+    HandlePool<int> pool;
+    auto first = pool.create(0);
+    auto handle = first;
+    for (uint32_t i = 0; i < SFE::Handle<int>::MAX_GENERATION + 5; ++i) {
+        pool.destroy(handle);
+        handle = pool.create(static_cast<int>(i));
+        REQUIRE(!handle.isNull());
+        REQUIRE(handle.getIndex() == first.getIndex());
+        REQUIRE(handle.getGeneration() != 0);
+    }
+    REQUIRE(*pool.get(handle) == static_cast<int>(SFE::Handle<int>::MAX_GENERATION + 4));
+}
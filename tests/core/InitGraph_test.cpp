@@ -0,0 +1,88 @@
+#include <catch2/catch_test_macros.hpp>
+#include "core/InitGraph.hpp"
+#include "core/JobSystem.hpp"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+TEST_CASE("InitGraph runs tasks after their dependencies", "[init]") {
+    SFE::JobSystem::getInstance().initialize(2);
+    const std::thread::id mainThread = std::this_thread::get_id();
+    std::mutex mutex;
+    std::vector<const char*> order;
+    std::atomic<bool> mainTaskOffThread{false};
+    auto task = [&](const char* name, bool onMain, bool result = true) {
+        return [&, name, onMain, result] {
+            if (onMain && std::this_thread::get_id() != mainThread) mainTaskOffThread = true;
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(name);
+            return result;
+        };
+    };
+    auto indexOf = [&](const char* name) {
+        for (size_t i = 0; i < order.size(); ++i) {
+            if (order[i] == name) return static_cast<int>(i);
+        }
+        return -1;
+    };
+    using Thread = SFE::InitGraph::Thread;
+    using Status = SFE::InitGraph::Status;
+
+    SECTION("Dependencies order main and worker tasks") {
+        SFE::InitGraph graph;
+        auto window = graph.add("window", Thread::Main, task("window", true));
+        auto decode = graph.add("decode", Thread::Worker, [&] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            return task("decode", false)();
+        });
+        auto font = graph.add("font", Thread::Worker, task("font", false));
+        auto upload = graph.add("upload", Thread::Main, task("upload", true), {window, decode});
+        graph.add("text", Thread::Main, task("text", true), {window, font});
+        graph.add("last", Thread::Main, task("last", true), {upload});
+
+        REQUIRE(graph.run());
+        REQUIRE_FALSE(mainTaskOffThread.load());
+        REQUIRE(order.size() == 6);
+        REQUIRE(indexOf("upload") > indexOf("window"));
+        REQUIRE(indexOf("upload") > indexOf("decode"));
+        REQUIRE(indexOf("text") > indexOf("font"));
+        REQUIRE(indexOf("last") > indexOf("upload"));
+        // The window came up while the decode was still sleeping
+        const auto& records = graph.getRecords();
+        REQUIRE(records[window].endMs <= records[decode].endMs);
+        REQUIRE(records[upload].startMs >= records[decode].endMs);
+        REQUIRE(graph.getSerialMs() >= 20.0);
+        REQUIRE(graph.getStatus(upload) == Status::Done);
+    }
+
+    SECTION("A failed task skips its dependents only") {
+        SFE::InitGraph graph;
+        auto broken = graph.add("broken", Thread::Worker, task("broken", false, false));
+        auto dependent = graph.add("dependent", Thread::Main, task("dependent", true), {broken});
+        auto transitive = graph.add("transitive", Thread::Worker, task("transitive", false), {dependent});
+        auto independent = graph.add("independent", Thread::Main, task("independent", true));
+
+        REQUIRE_FALSE(graph.run());
+        REQUIRE(graph.getStatus(broken) == Status::Failed);
+        REQUIRE(graph.getStatus(dependent) == Status::Skipped);
+        REQUIRE(graph.getStatus(transitive) == Status::Skipped);
+        REQUIRE(graph.getStatus(independent) == Status::Done);
+        REQUIRE(indexOf("dependent") == -1);
+        REQUIRE(indexOf("transitive") == -1);
+    }
+
+    SECTION("Marks and the report") {
+        SFE::InitGraph graph;
+        graph.add("only", Thread::Main, task("only", true));
+        REQUIRE(graph.run());
+        REQUIRE(graph.getMarkMs("first frame") < 0.0);
+        graph.mark("first frame");
+        REQUIRE(graph.getMarkMs("first frame") >= graph.getWallMs());
+        REQUIRE(graph.formatReport().find("first frame") != std::string::npos);
+        REQUIRE(graph.toJson().find("\"name\":\"only\"") != std::string::npos);
+    }
+
+    SFE::JobSystem::getInstance().shutdown();
+}
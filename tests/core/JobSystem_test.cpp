@@ -0,0 +1,62 @@
+#include <catch2/catch_test_macros.hpp>
+#include "core/JobSystem.hpp"
+#include <atomic>
+#include <numeric>
+#include <vector>
+
+TEST_CASE("JobSystem runs scheduled jobs and waits on counters", "[jobs]") {
+    SFE::JobSystem& jobs = SFE::JobSystem::getInstance();
+    jobs.initialize(3);
+    REQUIRE(jobs.getWorkerCount() == 3);
+
+    SECTION("Every job runs exactly once") {
+        std::vector<std::atomic<int>> runs(1000);
+        SFE::JobCounter counter;
+        for (auto& run : runs) jobs.schedule([&run] { run.fetch_add(1); }, &counter);
+        jobs.wait(counter);
+        REQUIRE(counter.isDone());
+        for (auto& run : runs) REQUIRE(run.load() == 1);
+    }
+
+    SECTION("Jobs can wait on jobs they schedule") {
+        // More waiting parents than workers: waiters have to run the children themselves
+        std::atomic<int> children{0};
+        SFE::JobCounter parents;
+        for (int parent = 0; parent < 16; ++parent) {
+            jobs.schedule(
+                [&] {
+                    SFE::JobCounter counter;
+                    for (int child = 0; child < 8; ++child) jobs.schedule([&] { children.fetch_add(1); }, &counter);
+                    jobs.wait(counter);
+                },
+                &parents);
+        }
+        jobs.wait(parents);
+        REQUIRE(children.load() == 16 * 8);
+    }
+
+    SECTION("Work outside the queue holds a counter open") {
+        SFE::JobCounter counter;
+        jobs.begin(counter);
+        std::atomic<bool> ran{false};
+        jobs.schedule([&] { ran = true; }, &counter);
+        jobs.schedule([&] { jobs.end(counter); });
+        jobs.wait(counter);
+        REQUIRE(ran.load());
+    }
+
+    SECTION("parallelFor covers the range once") {
+        std::vector<int> values(100000);
+        jobs.parallelFor(values.size(), 1000, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) values[i] += static_cast<int>(i % 7);
+        });
+        long long expected = 0;
+        for (size_t i = 0; i < values.size(); ++i) expected += i % 7;
+        REQUIRE(std::accumulate(values.begin(), values.end(), 0LL) == expected);
+
+        jobs.parallelFor(0, 1, [](size_t, size_t) { FAIL("empty range"); });
+    }
+
+    jobs.shutdown();
+    REQUIRE(jobs.getWorkerCount() == 0);
+}
@@ -0,0 +1,104 @@
+#include <catch2/catch_test_macros.hpp>
+#include "core/Logger.hpp"
+#include "core/MpscRing.hpp"
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+size_t countLines(const std::string& path) {
+    std::ifstream file(path);
+    std::string line;
+    size_t lines = 0;
+    while (std::getline(file, line)) ++lines;
+    return lines;
+}
+
+} // namespace
+
+TEST_CASE("MpscRing rejects pushes when full and preserves order", "[logger]") {
+    SFE::MpscRing<int> ring(5);
+    REQUIRE(ring.capacity() == 8);
+    for (int i = 0; i < 8; ++i) REQUIRE(ring.tryPush(i));
+    REQUIRE_FALSE(ring.tryPush(8));
+
+    int value = -1;
+    for (int i = 0; i < 8; ++i) {
+        REQUIRE(ring.tryPop(value));
+        REQUIRE(value == i);
+    }
+    REQUIRE_FALSE(ring.tryPop(value));
+    REQUIRE(ring.tryPush(9)); // Cells are reusable after wrap-around
+}
+
+TEST_CASE("MpscRing delivers every record from concurrent producers", "[logger]") {
+    SFE::MpscRing<uint32_t> ring(1024);
+    const uint32_t producers = 4, perProducer = 50000;
+    std::vector<std::thread> threads;
+    for (uint32_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&ring, p] {
+            for (uint32_t i = 0; i < perProducer; ++i) {
+                while (!ring.tryPush((p << 24) | i)) std::this_thread::yield();
+            }
+        });
+    }
+
+    std::vector<uint32_t> next(producers, 0);
+    uint32_t received = 0, value = 0;
+    while (received < producers * perProducer) {
+        if (!ring.tryPop(value)) continue;
+        uint32_t producer = value >> 24;
+        REQUIRE((value & 0xFFFFFF) == next[producer]); // FIFO per producer
+        ++next[producer];
+        ++received;
+    }
+    for (auto& thread : threads) thread.join();
+}
+
+TEST_CASE("Logger writes or counts every record", "[logger]") {
+    const std::string path = "logger_test.csv";
+    std::remove(path.c_str());
+    auto& logger = SFE::Logger::getInstance();
+    REQUIRE(logger.initialize(path, 64)); // Small ring so that bursts overflow
+
+    const int threadCount = 4, perThread = 5000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&logger, t] {
+            for (int i = 0; i < perThread; ++i) {
+                if (i % 2) logger.logMessage("thread " + std::to_string(t) + " says \"" + std::to_string(i) + "\"");
+                else logger.logPerformanceMetrics(60, 0.01f, 0.002f, 3, 100, false);
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    logger.shutdown(std::chrono::seconds(5));
+
+    REQUIRE(logger.getWrittenCount() + logger.getDroppedCount() == uint64_t(threadCount * perThread));
+    REQUIRE(countLines(path) == logger.getWrittenCount() + 1); // Plus the CSV header
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Logger writes JSON lines and truncates long messages", "[logger]") {
+    const std::string path = "logger_test.jsonl";
+    std::remove(path.c_str());
+    auto& logger = SFE::Logger::getInstance();
+    REQUIRE(logger.initialize(path));
+    REQUIRE(logger.getFormat() == SFE::Logger::Format::JSON);
+
+    logger.logMessage(std::string(300, 'x'));
+    logger.logMessage("quote \" and backslash \\");
+    logger.shutdown();
+
+    std::ifstream file(path);
+    std::string first, second;
+    std::getline(file, first);
+    std::getline(file, second);
+    REQUIRE(first.find(std::string(SFE::Logger::MAX_MESSAGE_LENGTH, 'x') + "...\"}") != std::string::npos);
+    REQUIRE(second.find("quote \\\" and backslash \\\\") != std::string::npos);
+    file.close();
+    std::remove(path.c_str());
+}
@@ -0,0 +1,90 @@
+#include <catch2/catch_test_macros.hpp>
+#include "core/MemoryTracker.hpp"
+#include <memory>
+#include <thread>
+
+// The Mesh and Texture tags are only charged explicitly here, so the counts do not depend on
+// whether the global operator new is replaced in this build
+TEST_CASE("MemoryTracker counts per tag and restarts every frame", "[memory]") {
+    SFE::MemoryTracker& tracker = SFE::MemoryTracker::getInstance();
+    tracker.endFrame();
+
+    tracker.recordAllocation(SFE::MemoryTag::Mesh, 1000);
+    tracker.recordAllocation(SFE::MemoryTag::Mesh, 500);
+    tracker.recordFree(SFE::MemoryTag::Mesh, 1000);
+    tracker.recordAllocation(SFE::MemoryTag::Texture, 64);
+
+    SFE::MemoryTracker::FrameStats frame = tracker.endFrame();
+    REQUIRE(frame[SFE::MemoryTag::Mesh].allocations == 2);
+    REQUIRE(frame[SFE::MemoryTag::Mesh].frees == 1);
+    REQUIRE(frame[SFE::MemoryTag::Mesh].bytes == 1500);
+    REQUIRE(frame[SFE::MemoryTag::Mesh].liveBytes == 500);
+    REQUIRE(frame[SFE::MemoryTag::Mesh].peakBytes >= 1500);
+    REQUIRE(frame[SFE::MemoryTag::Texture].allocations == 1);
+
+    // Per-frame counts restart, live bytes carry over
+    SFE::MemoryTracker::FrameStats next = tracker.endFrame();
+    REQUIRE(next[SFE::MemoryTag::Mesh].allocations == 0);
+    REQUIRE(next[SFE::MemoryTag::Mesh].bytes == 0);
+    REQUIRE(next[SFE::MemoryTag::Mesh].liveBytes == 500);
+
+    // resetPeaks() starts again from what is live
+    tracker.resetPeaks();
+    REQUIRE(tracker.endFrame()[SFE::MemoryTag::Mesh].peakBytes == 500);
+
+    tracker.recordFree(SFE::MemoryTag::Mesh, 500);
+    tracker.recordFree(SFE::MemoryTag::Texture, 64);
+    tracker.endFrame();
+}
+
+TEST_CASE("MemoryTagScope sets the tag for the calling thread only", "[memory]") {
+    REQUIRE(SFE::MemoryTracker::getCurrentTag() == SFE::MemoryTag::General);
+    {
+        SFE::MemoryTagScope text(SFE::MemoryTag::Text);
+        REQUIRE(SFE::MemoryTracker::getCurrentTag() == SFE::MemoryTag::Text);
+        {
+            SFE::MemoryTagScope logger(SFE::MemoryTag::Logger);
+            REQUIRE(SFE::MemoryTracker::getCurrentTag() == SFE::MemoryTag::Logger);
+        }
+        REQUIRE(SFE::MemoryTracker::getCurrentTag() == SFE::MemoryTag::Text);
+
+        SFE::MemoryTag otherThreadTag = SFE::MemoryTag::Count;
+        std::thread([&] { otherThreadTag = SFE::MemoryTracker::getCurrentTag(); }).join();
+        REQUIRE(otherThreadTag == SFE::MemoryTag::General);
+    }
+    REQUIRE(SFE::MemoryTracker::getCurrentTag() == SFE::MemoryTag::General);
+}
+
+#if SFE_ALLOCATION_TRACKING
+TEST_CASE("Tracked frees are charged to the allocating tag", "[memory]") {
+    SFE::MemoryTracker& tracker = SFE::MemoryTracker::getInstance();
+    tracker.endFrame();
+
+    std::unique_ptr<double[]> block;
+    {
+        SFE_MEMORY_TAG(Shader);
+        block.reset(new double[128]);
+    }
+    struct alignas(64) Aligned {
+        float values[16];
+    };
+    std::unique_ptr<Aligned> aligned;
+    {
+        SFE_MEMORY_TAG(Shader);
+        aligned.reset(new Aligned());
+    }
+    REQUIRE(reinterpret_cast<uintptr_t>(aligned.get()) % 64 == 0);
+
+    SFE::MemoryTracker::FrameStats frame = tracker.endFrame();
+    REQUIRE(frame[SFE::MemoryTag::Shader].allocations == 2);
+    REQUIRE(frame[SFE::MemoryTag::Shader].liveBytes >= 128 * sizeof(double) + sizeof(Aligned));
+
+    // Freed outside the scope, still charged to Shader
+    uint64_t liveBefore = frame[SFE::MemoryTag::Shader].liveBytes;
+    block.reset();
+    aligned.reset();
+    frame = tracker.endFrame();
+    REQUIRE(frame[SFE::MemoryTag::Shader].frees == 2);
+    REQUIRE(frame[SFE::MemoryTag::Shader].liveBytes == liveBefore - 128 * sizeof(double) - sizeof(Aligned));
+}
+#endif
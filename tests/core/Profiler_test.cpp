@@ -0,0 +1,88 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "core/Profiler.hpp"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+namespace {
+
+void spin(std::chrono::microseconds duration) {
+    auto end = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < end) {
+    }
+}
+
+const SFE::Profiler::ZoneStats* findZone(const SFE::Profiler::FrameStats& frame, const char* name) {
+    for (const auto& zone : frame.zones) {
+        if (std::string(zone.name) == name) return &zone;
+    }
+    return nullptr;
+}
+
+} // namespace
+
+TEST_CASE("Nested zones aggregate inclusive and exclusive time", "[profiler]") {
+    auto& profiler = SFE::Profiler::getInstance();
+    profiler.endFrame(); // Discard anything earlier
+    {
+        SFE_PROFILE_SCOPE("Outer");
+        spin(std::chrono::microseconds(2000));
+        for (int i = 0; i < 3; ++i) {
+            SFE_PROFILE_SCOPE("Inner");
+            spin(std::chrono::microseconds(1000));
+        }
+    }
+    profiler.endFrame();
+
+    const auto& frame = profiler.getLastFrame();
+    const auto* outer = findZone(frame, "Outer");
+    const auto* inner = findZone(frame, "Inner");
+    REQUIRE(outer);
+    REQUIRE(inner);
+    REQUIRE(outer->depth == 0);
+    REQUIRE(inner->depth == 1);
+    REQUIRE(inner->calls == 3);
+    REQUIRE(outer->inclusiveMs >= 4.9);
+    REQUIRE(inner->inclusiveMs >= 2.9);
+    REQUIRE(outer->exclusiveMs == Approx(outer->inclusiveMs - inner->inclusiveMs).margin(0.01));
+    REQUIRE(frame.frameMs >= outer->inclusiveMs);
+}
+
+TEST_CASE("Zones from other threads land in the frame and the trace", "[profiler]") {
+    auto& profiler = SFE::Profiler::getInstance();
+    profiler.endFrame();
+    profiler.startCapture();
+
+    std::thread worker([] {
+        SFE::Profiler::getInstance().setThreadName("Worker");
+        SFE_PROFILE_SCOPE("WorkerJob");
+        spin(std::chrono::microseconds(500));
+    });
+    worker.join();
+    {
+        SFE_PROFILE_SCOPE("MainJob");
+    }
+    profiler.endFrame();
+
+    const auto* job = findZone(profiler.getLastFrame(), "WorkerJob");
+    const auto* mainJob = findZone(profiler.getLastFrame(), "MainJob");
+    REQUIRE(job);
+    REQUIRE(mainJob);
+    REQUIRE(job->threadId != mainJob->threadId);
+    REQUIRE(profiler.getLastFrame().getZoneMs("WorkerJob") >= 0.45);
+
+    const std::string path = "profiler_test_trace.json";
+    REQUIRE(profiler.stopCapture(path));
+    std::ifstream file(path);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    std::string json = contents.str();
+    REQUIRE(json.find("\"traceEvents\"") != std::string::npos);
+    REQUIRE(json.find("\"name\":\"WorkerJob\"") != std::string::npos);
+    REQUIRE(json.find("{\"name\":\"Worker\"}") != std::string::npos);
+    file.close();
+    std::remove(path.c_str());
+}
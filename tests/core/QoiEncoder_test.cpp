@@ -0,0 +1,96 @@
+#include <catch2/catch_test_macros.hpp>
+#include "core/QoiEncoder.hpp"
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Minimal reference decoder, straight from the specification
+std::vector<uint8_t> decodeQoi(const std::vector<uint8_t>& data, uint32_t& width, uint32_t& height) {
+    auto readBigEndian = [&](size_t offset) {
+        return (uint32_t(data[offset]) << 24) | (uint32_t(data[offset + 1]) << 16) |
+               (uint32_t(data[offset + 2]) << 8) | uint32_t(data[offset + 3]);
+    };
+    width = readBigEndian(4);
+    height = readBigEndian(8);
+
+    std::vector<uint8_t> pixels(size_t(width) * height * 4);
+    uint8_t index[64][4] = {};
+    uint8_t px[4] = {0, 0, 0, 255};
+    size_t p = 14;
+    int run = 0;
+    for (size_t i = 0; i < pixels.size(); i += 4) {
+        if (run > 0) {
+            --run;
+        } else {
+            uint8_t b1 = data[p++];
+            if (b1 == 0xFE) {
+                px[0] = data[p++]; px[1] = data[p++]; px[2] = data[p++];
+            } else if (b1 == 0xFF) {
+                px[0] = data[p++]; px[1] = data[p++]; px[2] = data[p++]; px[3] = data[p++];
+            } else if ((b1 & 0xC0) == 0x00) {
+                std::memcpy(px, index[b1], 4);
+            } else if ((b1 & 0xC0) == 0x40) {
+                px[0] += ((b1 >> 4) & 3) - 2;
+                px[1] += ((b1 >> 2) & 3) - 2;
+                px[2] += (b1 & 3) - 2;
+            } else if ((b1 & 0xC0) == 0x80) {
+                uint8_t b2 = data[p++];
+                int vg = (b1 & 0x3F) - 32;
+                px[0] += vg - 8 + ((b2 >> 4) & 0x0F);
+                px[1] += vg;
+                px[2] += vg - 8 + (b2 & 0x0F);
+            } else {
+                run = b1 & 0x3F;
+            }
+            std::memcpy(index[(px[0] * 3 + px[1] * 5 + px[2] * 7 + px[3] * 11) % 64], px, 4);
+        }
+        std::memcpy(&pixels[i], px, 4);
+    }
+    return pixels;
+}
+
+} // namespace
+
+TEST_CASE("Solid image encodes as runs", "[qoi]") {
+    const uint32_t width = 64, height = 64;
+    std::vector<uint8_t> pixels(width * height * 4);
+    for (size_t i = 0; i < pixels.size(); i += 4) {
+        pixels[i] = 20; pixels[i + 1] = 40; pixels[i + 2] = 60; pixels[i + 3] = 255;
+    }
+
+    auto encoded = SFE::encodeQoi(pixels.data(), width, height);
+    REQUIRE(std::memcmp(encoded.data(), "qoif", 4) == 0);
+    REQUIRE(encoded.size() < 200); // 14 header + a few ops + 67 runs of 62 + 8 end marker
+    REQUIRE(encoded[encoded.size() - 1] == 1);
+
+    uint32_t decodedWidth = 0, decodedHeight = 0;
+    REQUIRE(decodeQoi(encoded, decodedWidth, decodedHeight) == pixels);
+    REQUIRE(decodedWidth == width);
+    REQUIRE(decodedHeight == height);
+}
+
+TEST_CASE("Noisy and smooth images round-trip", "[qoi]") {
+    const uint32_t width = 97, height = 31;
+    std::vector<uint8_t> pixels(width * height * 4);
+    std::mt19937 rng(7);
+
+    // Left half gradient (DIFF/LUMA ops), right half noise with random alpha (RGB/RGBA/INDEX)
+    for (uint32_t y = 0; y < height; ++y) {
+        for (uint32_t x = 0; x < width; ++x) {
+            uint8_t* px = &pixels[(y * width + x) * 4];
+            if (x < width / 2) {
+                px[0] = uint8_t(x * 3); px[1] = uint8_t(y * 5 + x); px[2] = uint8_t(x + y); px[3] = 255;
+            } else {
+                uint32_t value = rng();
+                std::memcpy(px, &value, 4);
+                if (value % 3 == 0) px[3] = 255;
+            }
+        }
+    }
+
+    auto encoded = SFE::encodeQoi(pixels.data(), width, height);
+    uint32_t decodedWidth = 0, decodedHeight = 0;
+    REQUIRE(decodeQoi(encoded, decodedWidth, decodedHeight) == pixels);
+}
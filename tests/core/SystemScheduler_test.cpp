@@ -0,0 +1,100 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "core/SceneComponents.hpp"
+#include "core/SystemScheduler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct A {
+    float value;
+};
+struct B {
+    float value;
+};
+struct C {
+    float value;
+};
+
+} // namespace
+
+TEST_CASE("SystemScheduler stages systems by component access", "[ecs]") {
+    using SFE::World;
+    SFE::SystemScheduler scheduler;
+    std::mutex mutex;
+    std::vector<std::string> order;
+    auto record = [&](const char* name) {
+        return [&, name](World&, float) {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(name);
+        };
+    };
+
+    scheduler.add("writeA", 0, World::maskOf<A>(), record("writeA"));
+    scheduler.add("writeB", 0, World::maskOf<B>(), record("writeB"));           // Shares stage 0
+    scheduler.add("readA", World::maskOf<A>(), World::maskOf<C>(), record("readA")); // After writeA
+    scheduler.add("readB", World::maskOf<B>(), 0, record("readB"));               // After writeB, beside readA
+    scheduler.add("writeAgain", 0, World::maskOf<A>(), record("writeAgain"));     // After readA
+
+    const auto& systems = scheduler.getSystems();
+    REQUIRE(systems[0].stage == 0);
+    REQUIRE(systems[1].stage == 0);
+    REQUIRE(systems[2].stage == 1);
+    REQUIRE(systems[3].stage == 1);
+    REQUIRE(systems[4].stage == 2);
+    REQUIRE(scheduler.getStageCount() == 3);
+
+    World world;
+    scheduler.run(world, 0.0f);
+    REQUIRE(order.size() == 5);
+    auto position = [&](const char* name) { return std::find(order.begin(), order.end(), name) - order.begin(); };
+    REQUIRE(position("writeA") < position("readA"));
+    REQUIRE(position("writeB") < position("readB"));
+    REQUIRE(position("readA") < position("writeAgain"));
+}
+
+TEST_CASE("Scene systems animate transforms", "[ecs]") {
+    SFE::World world;
+    SFE::SystemScheduler scheduler;
+    SFE::addSceneSystems(scheduler);
+    REQUIRE(scheduler.getStageCount() == 2);
+
+    SFE::Entity still = SFE::createTransformEntity(world, glm::vec3(1.0f, 2.0f, 3.0f), glm::vec3(2.0f));
+    SFE::Entity orbiting = SFE::createTransformEntity(world, glm::vec3(0.0f));
+    world.set(orbiting, SFE::Orbit{glm::vec3(0.0f, 1.0f, 0.0f), 2.0f, 0.0f, 1.0f});
+    SFE::Entity spinning = SFE::createTransformEntity(world, glm::vec3(0.0f));
+    world.set(spinning, SFE::Spin{glm::vec3(0.0f, 90.0f, 0.0f)});
+    std::vector<SFE::Entity> crowd;
+    for (int i = 0; i < 5000; ++i) {
+        crowd.push_back(SFE::createTransformEntity(world, glm::vec3(0.0f)));
+        world.set(crowd.back(), SFE::Orbit{glm::vec3(0.0f), 1.0f + i, 0.0f, 0.5f});
+    }
+
+    scheduler.run(world, 1.0f);
+
+    const glm::mat4& stillMatrix = world.get<SFE::LocalToWorld>(still)->matrix;
+    REQUIRE(stillMatrix[0][0] == Approx(2.0f));
+    REQUIRE(stillMatrix[1][1] == Approx(2.0f));
+    REQUIRE(stillMatrix[3][2] == Approx(3.0f));
+
+    const glm::vec3& position = world.get<SFE::Position>(orbiting)->value;
+    REQUIRE(position.x == Approx(2.0f * std::cos(1.0f)));
+    REQUIRE(position.y == Approx(1.0f));
+    REQUIRE(position.z == Approx(2.0f * std::sin(1.0f)));
+    REQUIRE(world.get<SFE::LocalToWorld>(orbiting)->matrix[3][0] == Approx(position.x));
+
+    // 90 degrees about Y takes +X to -Z
+    REQUIRE(world.get<SFE::Rotation>(spinning)->degrees.y == Approx(90.0f));
+    const glm::mat4& spun = world.get<SFE::LocalToWorld>(spinning)->matrix;
+    REQUIRE(spun[0][0] == Approx(0.0f).margin(1e-6));
+    REQUIRE(spun[0][2] == Approx(-1.0f));
+    REQUIRE(spun[2][0] == Approx(1.0f));
+
+    for (int i = 0; i < 5000; i += 499) {
+        REQUIRE(world.get<SFE::LocalToWorld>(crowd[i])->matrix[3][0] == Approx((1.0f + i) * std::cos(0.5f)));
+    }
+}
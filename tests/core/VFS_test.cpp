@@ -0,0 +1,131 @@
+#include <catch2/catch_test_macros.hpp>
+#include "core/VFS.hpp"
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace {
+
+void writeFile(const std::filesystem::path& path, const std::string& text) {
+    std::filesystem::create_directories(path.parent_path());
+    std::ofstream(path, std::ios::binary) << text;
+}
+
+std::string contentsFor(int index) {
+    // Sizes from empty to a few hundred KB so some reads come back short
+    return std::string(static_cast<size_t>(index) * index * 97, static_cast<char>('a' + index % 26));
+}
+
+} // namespace
+
+TEST_CASE("VFS resolves paths through mount points", "[vfs]") {
+    namespace fs = std::filesystem;
+    const fs::path root = fs::temp_directory_path() / "sfe_vfs_test";
+    fs::remove_all(root);
+    writeFile(root / "base/shaders/a.vert", "loose a");
+    writeFile(root / "base/shaders/b.vert", "loose b");
+    writeFile(root / "mod/textures/c.png", "loose c");
+
+    std::vector<SFE::AssetPackSource> sources(1);
+    sources[0].path = "shaders/a.vert";
+    sources[0].data = {'p', 'a', 'c', 'k', 'e', 'd'};
+    REQUIRE(SFE::writeAssetPack((root / "pack.sfp").string(), sources));
+
+    SFE::VFS& vfs = SFE::VFS::getInstance();
+    vfs.unmountAll();
+    REQUIRE(vfs.mountDirectory("", (root / "base").string()));
+    REQUIRE(vfs.mountDirectory("mods/", (root / "mod").string()));
+    REQUIRE_FALSE(vfs.mountDirectory("", (root / "missing").string()));
+    REQUIRE(vfs.getMountCount() == 2);
+
+    SFE::AssetData data;
+    REQUIRE(vfs.read("./shaders/b.vert", data));
+    REQUIRE(data.getText() == "loose b");
+    REQUIRE(vfs.read("mods/textures/c.png", data));
+    REQUIRE(data.getText() == "loose c");
+    REQUIRE_FALSE(vfs.exists("textures/c.png"));
+    REQUIRE_FALSE(vfs.read("shaders/missing.vert", data));
+
+    SECTION("Newer mounts shadow older ones") {
+        REQUIRE(vfs.mountPack("", (root / "pack.sfp").string()));
+        REQUIRE(vfs.read("shaders/a.vert", data));
+        REQUIRE(data.getText() == "packed");
+        REQUIRE(vfs.read("shaders/b.vert", data));
+        REQUIRE(data.getText() == "loose b");
+    }
+
+    SECTION("Absolute paths bypass the mounts") {
+        REQUIRE(vfs.read((root / "mod/textures/c.png").string(), data));
+        REQUIRE(data.getText() == "loose c");
+    }
+
+    vfs.unmountAll();
+    fs::remove_all(root);
+}
+
+TEST_CASE("VFS asynchronous reads complete on jobs", "[vfs]") {
+    namespace fs = std::filesystem;
+    const fs::path root = fs::temp_directory_path() / "sfe_vfs_async_test";
+    fs::remove_all(root);
+    const int fileCount = 100; // More than one io_uring submission queue
+    for (int i = 0; i < fileCount; ++i) writeFile(root / ("file" + std::to_string(i)), contentsFor(i));
+
+    SFE::VFS& vfs = SFE::VFS::getInstance();
+    vfs.unmountAll();
+    REQUIRE(vfs.mountDirectory("data", root.string()));
+
+    auto readAll = [&] {
+        std::mutex mutex;
+        std::vector<std::string> results(fileCount);
+        std::vector<int> failures;
+        for (int i = 0; i < fileCount; ++i) {
+            vfs.readAsync("data/file" + std::to_string(i),
+                          [&, i](const std::string&, SFE::AssetData& data, bool success) {
+                              std::lock_guard<std::mutex> lock(mutex);
+                              if (!success) failures.push_back(i);
+                              results[i] = std::string(data.getText());
+                          });
+        }
+        bool missingReported = false;
+        vfs.readAsync("data/missing", [&](const std::string&, SFE::AssetData&, bool success) {
+            std::lock_guard<std::mutex> lock(mutex);
+            missingReported = !success;
+        });
+        vfs.waitForReads();
+        REQUIRE(failures.empty());
+        REQUIRE(missingReported);
+        for (int i = 0; i < fileCount; ++i) REQUIRE(results[i] == contentsFor(i));
+    };
+
+    SECTION("Thread pool") {
+        REQUIRE(vfs.setBackend(SFE::VFS::Backend::ThreadPool));
+        readAll();
+    }
+
+    SECTION("io_uring, where the kernel allows it") {
+        if (vfs.setBackend(SFE::VFS::Backend::IoUring)) {
+            REQUIRE(vfs.getBackend() == SFE::VFS::Backend::IoUring);
+            readAll();
+        }
+    }
+
+    SECTION("Preloaded files are taken by the next read") {
+        vfs.preload("data/file42");
+        vfs.preload("data/missing");
+        SFE::AssetData data;
+        REQUIRE(vfs.read("data/file42", data));
+        REQUIRE(data.ownsData());
+        REQUIRE(data.getText() == contentsFor(42));
+        // The second read maps the file again
+        REQUIRE(vfs.read("data/file42", data));
+        REQUIRE_FALSE(data.ownsData());
+        REQUIRE(data.getText() == contentsFor(42));
+        vfs.clearPreloads();
+    }
+
+    vfs.unmountAll();
+    vfs.shutdown();
+    fs::remove_all(root);
+}
@@ -0,0 +1,91 @@
+#include <catch2/catch_test_macros.hpp>
+#include "core/World.hpp"
+#include <atomic>
+#include <set>
+#include <vector>
+
+namespace {
+
+struct Health {
+    int value;
+};
+struct Velocity {
+    float x, y;
+};
+struct Frozen {};
+
+} // namespace
+
+TEST_CASE("World stores entities by archetype", "[ecs]") {
+    SFE::World world;
+    SFE::Entity a = world.create(Health{10}, Velocity{1.0f, 2.0f});
+    SFE::Entity b = world.create(Health{20});
+    SFE::Entity c = world.create(Health{30}, Velocity{3.0f, 4.0f});
+    REQUIRE(world.getEntityCount() == 3);
+    REQUIRE(world.getArchetypeCount() == 3); // Empty, Health + Velocity, Health
+    REQUIRE(world.get<Health>(b)->value == 20);
+    REQUIRE(world.get<Velocity>(b) == nullptr);
+    REQUIRE(world.has<Velocity>(c));
+
+    SECTION("Adding and removing components moves rows and keeps the values") {
+        world.set(b, Velocity{5.0f, 6.0f});
+        REQUIRE(world.getArchetypeCount() == 3);
+        REQUIRE(world.get<Health>(b)->value == 20);
+        REQUIRE(world.get<Velocity>(b)->y == 6.0f);
+        world.set(a, Frozen{});
+        REQUIRE(world.getArchetypeCount() == 4);
+        REQUIRE(world.get<Velocity>(a)->x == 1.0f);
+        REQUIRE(world.remove<Velocity>(a));
+        REQUIRE_FALSE(world.remove<Velocity>(a));
+        REQUIRE(world.get<Health>(a)->value == 10);
+        REQUIRE(world.has<Frozen>(a));
+        // c was moved within its archetype when a left it
+        REQUIRE(world.get<Health>(c)->value == 30);
+        REQUIRE(world.get<Velocity>(c)->x == 3.0f);
+    }
+
+    SECTION("Destroyed entities stop resolving") {
+        REQUIRE(world.destroy(a));
+        REQUIRE_FALSE(world.destroy(a));
+        REQUIRE_FALSE(world.isAlive(a));
+        REQUIRE(world.get<Health>(a) == nullptr);
+        REQUIRE(world.get<Health>(c)->value == 30);
+        SFE::Entity d = world.create(Health{40});
+        REQUIRE(d != a);
+        REQUIRE(world.getEntityCount() == 3);
+        world.clear();
+        REQUIRE(world.getEntityCount() == 0);
+        REQUIRE_FALSE(world.isAlive(c));
+    }
+
+    SECTION("Iteration visits exactly the matching entities") {
+        int sum = 0;
+        world.forEach<Health>([&](Health& health) { sum += health.value; });
+        REQUIRE(sum == 60);
+
+        std::set<uint32_t> seen;
+        world.forEachChunk<Velocity, Health>([&](size_t count, const SFE::Entity* entities, Velocity* velocities,
+                                                 Health* healths) {
+            for (size_t i = 0; i < count; ++i) {
+                seen.insert(entities[i].value);
+                REQUIRE(healths[i].value == (velocities[i].x == 1.0f ? 10 : 30));
+            }
+        });
+        REQUIRE(seen == std::set<uint32_t>{a.value, c.value});
+    }
+}
+
+TEST_CASE("World iterates large archetypes in parallel", "[ecs]") {
+    SFE::World world;
+    std::vector<SFE::Entity> entities;
+    for (int i = 0; i < 20000; ++i) {
+        entities.push_back(i % 2 ? world.create(Health{i}, Velocity{float(i), 0.0f}) : world.create(Health{i}));
+    }
+    std::atomic<size_t> visited{0};
+    world.parallelForEachChunk<Health>(256, [&](size_t count, const SFE::Entity*, Health* healths) {
+        for (size_t i = 0; i < count; ++i) healths[i].value *= 2;
+        visited += count;
+    });
+    REQUIRE(visited == 20000);
+    for (int i = 0; i < 20000; i += 777) REQUIRE(world.get<Health>(entities[i])->value == 2 * i);
+}
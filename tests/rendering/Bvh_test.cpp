@@ -0,0 +1,145 @@
+#include <catch2/catch_test_macros.hpp>
+#include "rendering/Bvh.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct Scene {
+    std::vector<SFE::Aabb> boxes;
+    std::vector<SFE::Bvh::ProxyId> proxies;
+};
+
+SFE::Aabb randomBox(std::mt19937& rng) {
+    std::uniform_real_distribution<float> position(-50.0f, 50.0f);
+    std::uniform_real_distribution<float> size(0.1f, 3.0f);
+    glm::vec3 min(position(rng), position(rng), position(rng));
+    return {min, min + glm::vec3(size(rng), size(rng), size(rng))};
+}
+
+std::vector<uint32_t> sorted(std::vector<uint32_t> values) {
+    std::sort(values.begin(), values.end());
+    return values;
+}
+
+// Every query against brute force over the proxies' (enlarged) boxes
+void checkQueries(const SFE::Bvh& bvh, const Scene& scene, std::mt19937& rng) {
+    REQUIRE(bvh.validate());
+    auto live = [&](uint32_t index) { return scene.proxies[index] != SFE::Bvh::INVALID; };
+    auto bounds = [&](uint32_t index) { return bvh.getFatBounds(scene.proxies[index]); };
+
+    for (int query = 0; query < 10; ++query) {
+        SFE::Aabb region = randomBox(rng);
+        region.max += glm::vec3(10.0f);
+        std::vector<uint32_t> found, expected;
+        bvh.queryAabb(region, [&](uint32_t userData) { found.push_back(userData); });
+        for (uint32_t i = 0; i < scene.boxes.size(); ++i) {
+            if (live(i) && bounds(i).overlaps(region)) expected.push_back(i);
+        }
+        REQUIRE(sorted(found) == expected);
+
+        glm::vec3 eye = randomBox(rng).min;
+        glm::mat4 view = glm::lookAt(eye, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        SFE::Frustum frustum = SFE::Frustum::fromMatrix(glm::perspective(glm::radians(60.0f), 1.5f, 0.1f, 60.0f) * view);
+        found.clear();
+        expected.clear();
+        bvh.queryFrustum(frustum, [&](uint32_t userData) { found.push_back(userData); });
+        for (uint32_t i = 0; i < scene.boxes.size(); ++i) {
+            if (live(i) && frustum.intersectsAabb(bounds(i).min, bounds(i).max)) expected.push_back(i);
+        }
+        REQUIRE(sorted(found) == expected);
+
+        // Nearest box along a ray, using the box entry distance as the hit
+        glm::vec3 direction = glm::vec3(0.0f) - eye;
+        float distance = bvh.raycast(eye, direction, 2.0f, [](uint32_t, float entry) { return entry; });
+        float expectedDistance = 2.0f;
+        glm::vec3 inverse = glm::vec3(1.0f) / direction;
+        for (uint32_t i = 0; i < scene.boxes.size(); ++i) {
+            if (!live(i)) continue;
+            glm::vec3 t0 = (bounds(i).min - eye) * inverse, t1 = (bounds(i).max - eye) * inverse;
+            glm::vec3 nearT = glm::min(t0, t1), farT = glm::max(t0, t1);
+            float entry = std::max({nearT.x, nearT.y, nearT.z, 0.0f});
+            float exit = std::min({farT.x, farT.y, farT.z, expectedDistance});
+            if (entry <= exit) expectedDistance = std::min(expectedDistance, entry);
+        }
+        REQUIRE(distance == expectedDistance);
+    }
+}
+
+} // namespace
+
+TEST_CASE("Bvh queries match brute force", "[bvh]") {
+    std::mt19937 rng(1234);
+    SFE::Bvh bvh(0.0f);
+    Scene scene;
+    for (uint32_t i = 0; i < 2000; ++i) {
+        scene.boxes.push_back(randomBox(rng));
+        scene.proxies.push_back(bvh.insert(scene.boxes.back(), i));
+    }
+    REQUIRE(bvh.getProxyCount() == 2000);
+
+    SECTION("Built by insertion") {
+        checkQueries(bvh, scene, rng);
+    }
+
+    SECTION("SAH rebuild keeps proxy ids and lowers the cost") {
+        float insertedCost = bvh.getCost();
+        bvh.rebuild();
+        REQUIRE(bvh.getCost() <= insertedCost);
+        REQUIRE(bvh.getQuality() == 1.0f);
+        for (uint32_t i = 0; i < scene.proxies.size(); i += 97) REQUIRE(bvh.getUserData(scene.proxies[i]) == i);
+        checkQueries(bvh, scene, rng);
+    }
+
+    SECTION("Moves refit, removals free ids for reuse") {
+        bvh.rebuild();
+        std::uniform_real_distribution<float> offset(-5.0f, 5.0f);
+        for (uint32_t i = 0; i < scene.boxes.size(); i += 3) {
+            glm::vec3 delta(offset(rng), offset(rng), offset(rng));
+            scene.boxes[i].min += delta;
+            scene.boxes[i].max += delta;
+            REQUIRE(bvh.move(scene.proxies[i], scene.boxes[i]));
+        }
+        REQUIRE(bvh.getQuality() > 1.0f);
+        for (uint32_t i = 1; i < scene.boxes.size(); i += 5) {
+            bvh.remove(scene.proxies[i]);
+            scene.proxies[i] = SFE::Bvh::INVALID;
+        }
+        checkQueries(bvh, scene, rng);
+
+        uint32_t index = static_cast<uint32_t>(scene.boxes.size());
+        scene.boxes.push_back(randomBox(rng));
+        SFE::Bvh::ProxyId reused = bvh.insert(scene.boxes.back(), index);
+        REQUIRE(reused < 2000);
+        scene.proxies.push_back(reused);
+        bvh.rebuild();
+        checkQueries(bvh, scene, rng);
+    }
+
+    SECTION("The margin absorbs small moves") {
+        SFE::Bvh fat(0.5f);
+        SFE::Bvh::ProxyId proxy = fat.insert(scene.boxes[0], 0);
+        SFE::Aabb nudged = {scene.boxes[0].min + glm::vec3(0.25f), scene.boxes[0].max + glm::vec3(0.25f)};
+        REQUIRE_FALSE(fat.move(proxy, nudged));
+        nudged = {scene.boxes[0].min + glm::vec3(1.0f), scene.boxes[0].max + glm::vec3(1.0f)};
+        REQUIRE(fat.move(proxy, nudged));
+        REQUIRE(fat.validate());
+
+        // Stale and unknown ids are ignored like remove() ignores them
+        fat.remove(proxy);
+        REQUIRE_FALSE(fat.move(proxy, scene.boxes[0]));
+        REQUIRE_FALSE(fat.move(proxy + 1, scene.boxes[0]));
+        REQUIRE(fat.validate());
+    }
+
+    SECTION("Removing everything empties the tree") {
+        for (SFE::Bvh::ProxyId proxy : scene.proxies) bvh.remove(proxy);
+        REQUIRE(bvh.getProxyCount() == 0);
+        REQUIRE(bvh.validate());
+        int calls = 0;
+        bvh.queryAabb({glm::vec3(-100.0f), glm::vec3(100.0f)}, [&](uint32_t) { ++calls; });
+        REQUIRE(calls == 0);
+    }
+}
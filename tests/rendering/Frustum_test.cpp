@@ -0,0 +1,37 @@
+#include <catch2/catch_test_macros.hpp>
+#include "rendering/Frustum.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+
+TEST_CASE("Frustum planes from a perspective view", "[frustum]") {
+    glm::mat4 projection = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 100.0f);
+    glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    SFE::Frustum frustum = SFE::Frustum::fromMatrix(projection * view);
+
+    SECTION("Spheres") {
+        REQUIRE(frustum.intersectsSphere(glm::vec3(0.0f, 0.0f, -10.0f), 1.0f));
+        REQUIRE_FALSE(frustum.intersectsSphere(glm::vec3(0.0f, 0.0f, 10.0f), 1.0f));   // Behind
+        REQUIRE_FALSE(frustum.intersectsSphere(glm::vec3(0.0f, 0.0f, -110.0f), 1.0f)); // Past far
+        // 90 degree fov: the side planes are the x = -z diagonals, distances are in world units
+        REQUIRE_FALSE(frustum.intersectsSphere(glm::vec3(12.0f, 0.0f, -10.0f), 1.0f));
+        REQUIRE(frustum.intersectsSphere(glm::vec3(12.0f, 0.0f, -10.0f), 1.5f));
+    }
+
+    SECTION("Boxes") {
+        REQUIRE(frustum.intersectsAabb(glm::vec3(-1.0f, -1.0f, -11.0f), glm::vec3(1.0f, 1.0f, -9.0f)));
+        REQUIRE_FALSE(frustum.intersectsAabb(glm::vec3(-1.0f, -1.0f, 1.0f), glm::vec3(1.0f, 1.0f, 3.0f)));
+        // Straddling the near plane still intersects
+        REQUIRE(frustum.intersectsAabb(glm::vec3(-1.0f, -1.0f, -1.0f), glm::vec3(1.0f, 1.0f, 1.0f)));
+    }
+}
+
+TEST_CASE("Bounding spheres follow the largest instance scale", "[frustum]") {
+    glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(5.0f, 0.0f, 0.0f));
+    model = glm::scale(model, glm::vec3(1.0f, 3.0f, 2.0f));
+
+    glm::vec3 center;
+    float radius = 0.0f;
+    SFE::transformBoundingSphere(model, glm::vec3(0.0f, 1.0f, 0.0f), 0.5f, center, radius);
+    REQUIRE(center.x == 5.0f);
+    REQUIRE(center.y == 3.0f);
+    REQUIRE(radius == 1.5f);
+}
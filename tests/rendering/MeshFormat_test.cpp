@@ -0,0 +1,110 @@
+#include <catch2/catch_test_macros.hpp>
+#include "rendering/MeshFormat.hpp"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::vector<uint8_t> readFile(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+} // namespace
+
+TEST_CASE("Mesh files survive a write and validate round trip", "[mesh]") {
+    namespace fs = std::filesystem;
+    const fs::path path = fs::temp_directory_path() / "sfe_mesh_format_test.sfm";
+
+    // A quad as two triangles, plus a one-triangle coarse LOD after them
+    const float positions[] = {0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f};
+    const uint32_t indices[] = {0, 1, 2, 2, 3, 0, 0, 1, 2};
+    const SFE::MeshFileLod lods[] = {{0, 6, 0.0f, 0}, {6, 3, 0.5f, 0}};
+    SFE::MeshFileDesc desc;
+    desc.vertexStride = 3 * sizeof(float);
+    desc.vertexData = positions;
+    desc.vertexCount = 4;
+    desc.indexData = indices;
+    desc.indexCount = 9;
+    desc.flags = SFE::MESH_FILE_VERTEX_CACHE_OPTIMIZED;
+    desc.lods = lods;
+    desc.lodCount = 2;
+    desc.boundsMax[0] = desc.boundsMax[1] = 1.0f;
+    REQUIRE(SFE::writeMeshFile(path.string(), desc));
+
+    std::vector<uint8_t> data = readFile(path);
+    fs::remove(path);
+    std::string error;
+
+    SECTION("A written file validates with its contents intact") {
+        const SFE::MeshFileHeader* header = SFE::validateMeshFile(data.data(), data.size(), error);
+        REQUIRE(header != nullptr);
+        REQUIRE(header->version == SFE::MESH_FILE_VERSION);
+        REQUIRE(header->vertexCount == 4);
+        REQUIRE(header->indexCount == 9);
+        REQUIRE(header->flags == SFE::MESH_FILE_VERTEX_CACHE_OPTIMIZED);
+        REQUIRE(header->boundsMax[1] == 1.0f);
+        REQUIRE(header->vertexDataOffset % SFE::MESH_FILE_ALIGNMENT == 0);
+        REQUIRE(header->indexDataOffset % SFE::MESH_FILE_ALIGNMENT == 0);
+        REQUIRE(std::memcmp(data.data() + header->vertexDataOffset, positions, sizeof(positions)) == 0);
+        REQUIRE(std::memcmp(data.data() + header->indexDataOffset, indices, sizeof(indices)) == 0);
+
+        const SFE::MeshFileLod* readLods = SFE::getMeshFileLods(data.data(), *header);
+        REQUIRE(readLods != nullptr);
+        REQUIRE(header->lodCount == 2);
+        REQUIRE(readLods[1].firstIndex == 6);
+        REQUIRE(readLods[1].indexCount == 3);
+        REQUIRE(readLods[1].error == 0.5f);
+    }
+
+    SECTION("Truncated files are rejected") {
+        REQUIRE(SFE::validateMeshFile(data.data(), sizeof(SFE::MeshFileHeader) - 1, error) == nullptr);
+        REQUIRE(SFE::validateMeshFile(data.data(), data.size() - sizeof(uint32_t), error) == nullptr);
+        REQUIRE(error == "truncated or padded file");
+    }
+
+    SECTION("A LOD past the index data is rejected") {
+        auto* header = reinterpret_cast<SFE::MeshFileHeader*>(data.data());
+        auto* writableLods = reinterpret_cast<SFE::MeshFileLod*>(data.data() + header->lodTableOffset);
+        writableLods[1].firstIndex = 9;
+        REQUIRE(SFE::validateMeshFile(data.data(), data.size(), error) == nullptr);
+        REQUIRE(error == "LOD 1 index range out of range");
+    }
+
+    SECTION("A LOD table outside the file is rejected") {
+        reinterpret_cast<SFE::MeshFileHeader*>(data.data())->lodTableOffset = data.size();
+        REQUIRE(SFE::validateMeshFile(data.data(), data.size(), error) == nullptr);
+        REQUIRE(error == "LOD table out of range");
+    }
+
+    SECTION("An index past the vertex data is rejected") {
+        auto* header = reinterpret_cast<SFE::MeshFileHeader*>(data.data());
+        reinterpret_cast<uint32_t*>(data.data() + header->indexDataOffset)[4] = 4;
+        REQUIRE(SFE::validateMeshFile(data.data(), data.size(), error) == nullptr);
+        REQUIRE(error == "index 4 out of range for 4 vertices");
+    }
+
+    SECTION("A misaligned vertex offset is rejected") {
+        reinterpret_cast<SFE::MeshFileHeader*>(data.data())->vertexDataOffset += 2;
+        REQUIRE(SFE::validateMeshFile(data.data(), data.size(), error) == nullptr);
+        REQUIRE(error == "vertex data misaligned");
+    }
+
+    SECTION("Vertex data overlapping another section is rejected") {
+        auto* header = reinterpret_cast<SFE::MeshFileHeader*>(data.data());
+        const uint64_t vertexDataOffset = header->vertexDataOffset;
+        header->vertexDataOffset = 0; // The header
+        REQUIRE(SFE::validateMeshFile(data.data(), data.size(), error) == nullptr);
+        REQUIRE(error == "vertex data overlaps another section");
+        header->vertexDataOffset = header->lodTableOffset;
+        REQUIRE(SFE::validateMeshFile(data.data(), data.size(), error) == nullptr);
+        REQUIRE(error == "vertex data overlaps another section");
+        header->vertexDataOffset = vertexDataOffset + 16; // Into the index data
+        REQUIRE(SFE::validateMeshFile(data.data(), data.size(), error) == nullptr);
+        REQUIRE(error == "vertex data overlaps another section");
+    }
+}
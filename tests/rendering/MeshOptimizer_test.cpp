@@ -0,0 +1,129 @@
+#include <catch2/catch_test_macros.hpp>
+#include "rendering/MeshOptimizer.hpp"
+#include <algorithm>
+#include <array>
+#include <random>
+
+namespace {
+
+struct TestVertex {
+    float position[3];
+    float id;
+};
+
+// (size+1)^2 vertex grid, two triangles per cell, triangles shuffled to defeat the cache
+void buildShuffledGrid(int size, std::vector<TestVertex>& vertices, std::vector<uint32_t>& indices) {
+    for (int y = 0; y <= size; ++y) {
+        for (int x = 0; x <= size; ++x) {
+            vertices.push_back({{float(x), float(y), 0.0f}, float(vertices.size())});
+        }
+    }
+    std::vector<std::array<uint32_t, 3>> triangles;
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            uint32_t i0 = y * (size + 1) + x;
+            uint32_t i1 = i0 + 1;
+            uint32_t i2 = i0 + size + 1;
+            uint32_t i3 = i2 + 1;
+            triangles.push_back({i0, i1, i3});
+            triangles.push_back({i0, i3, i2});
+        }
+    }
+    std::mt19937 rng(1234);
+    std::shuffle(triangles.begin(), triangles.end(), rng);
+    for (const auto& t : triangles) indices.insert(indices.end(), t.begin(), t.end());
+}
+
+// Canonical triangle list (rotation-invariant, order-invariant) in terms of original vertex ids
+std::vector<std::array<uint32_t, 3>> canonicalTriangles(const std::vector<TestVertex>& vertices,
+                                                        const std::vector<uint32_t>& indices) {
+    std::vector<std::array<uint32_t, 3>> result;
+    for (size_t i = 0; i < indices.size(); i += 3) {
+        std::array<uint32_t, 3> t = {uint32_t(vertices[indices[i]].id), uint32_t(vertices[indices[i + 1]].id),
+                                     uint32_t(vertices[indices[i + 2]].id)};
+        std::rotate(t.begin(), std::min_element(t.begin(), t.end()), t.end());
+        result.push_back(t);
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("analyzeVertexCache reports ACMR and ATVR", "[meshoptimizer]") {
+    std::vector<uint32_t> single = {0, 1, 2};
+    auto stats = SFE::analyzeVertexCache(single, 3);
+    REQUIRE(stats.vertexTransforms == 3);
+    REQUIRE(stats.acmr == 3.0f);
+    REQUIRE(stats.atvr == 1.0f);
+
+    // Quad sharing an edge: 4 transforms for 2 triangles
+    std::vector<uint32_t> quad = {0, 1, 2, 2, 1, 3};
+    stats = SFE::analyzeVertexCache(quad, 4);
+    REQUIRE(stats.acmr == 2.0f);
+    REQUIRE(stats.atvr == 1.0f);
+}
+
+TEST_CASE("Mesh optimisation keeps triangles and improves cache use", "[meshoptimizer]") {
+    std::vector<TestVertex> vertices;
+    std::vector<uint32_t> indices;
+    buildShuffledGrid(32, vertices, indices);
+    auto original = canonicalTriangles(vertices, indices);
+
+    SECTION("Vertex cache order") {
+        auto before = SFE::analyzeVertexCache(indices, vertices.size());
+        auto optimized = SFE::optimizeVertexCache(indices, vertices.size());
+        auto after = SFE::analyzeVertexCache(optimized, vertices.size());
+
+        REQUIRE(optimized.size() == indices.size());
+        REQUIRE(canonicalTriangles(vertices, optimized) == original);
+        REQUIRE(after.acmr < before.acmr);
+        REQUIRE(after.acmr < 0.8f);
+    }
+
+    SECTION("Vertex fetch remap is first-use ordered") {
+        std::vector<uint32_t> remap;
+        size_t unique = SFE::buildVertexFetchRemap(remap, indices, vertices.size());
+        REQUIRE(unique == vertices.size());
+        REQUIRE(remap[indices[0]] == 0);
+
+        std::vector<TestVertex> remapped = vertices;
+        std::vector<uint32_t> remappedIndices = indices;
+        SFE::remapVertexBuffer(remapped.data(), remapped.size(), sizeof(TestVertex), remap);
+        SFE::remapIndexBuffer(remappedIndices, remap);
+        REQUIRE(canonicalTriangles(remapped, remappedIndices) == original);
+
+        uint32_t highest = 0;
+        for (uint32_t index : remappedIndices) {
+            REQUIRE(index <= highest + 1);
+            highest = std::max(highest, index);
+        }
+    }
+
+    SECTION("Full pipeline with overdraw ordering") {
+        vertices.push_back({{100.0f, 100.0f, 0.0f}, float(vertices.size())}); // Unreferenced
+        auto report = SFE::optimizeMesh(vertices, indices, 0, true);
+
+        REQUIRE(report.vertexCountBefore == report.vertexCountAfter + 1);
+        REQUIRE(vertices.size() == report.vertexCountAfter);
+        REQUIRE(canonicalTriangles(vertices, indices) == original);
+        REQUIRE(report.after.acmr < report.before.acmr);
+    }
+}
+
+TEST_CASE("Mesh optimisation drops triangles it cannot draw", "[meshoptimizer]") {
+    // Quad, a triangle referencing a missing vertex and a trailing partial triangle
+    std::vector<uint32_t> indices = {0, 1, 2, 2, 3, 0, 1, 7, 2, 3, 1};
+
+    std::vector<uint32_t> optimized = SFE::optimizeVertexCache(indices, 4);
+    REQUIRE(optimized.size() == 6);
+    REQUIRE(std::all_of(optimized.begin(), optimized.end(), [](uint32_t index) { return index < 4; }));
+
+    const float positions[] = {0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f};
+    REQUIRE(SFE::optimizeOverdraw(indices, positions, 4, 3 * sizeof(float)).size() == 6);
+
+    std::vector<uint32_t> remap;
+    REQUIRE(SFE::buildVertexFetchRemap(remap, indices, 4) == 4);
+    SFE::remapIndexBuffer(indices, remap);
+    REQUIRE(indices[7] == 7);
+}
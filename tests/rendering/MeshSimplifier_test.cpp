@@ -0,0 +1,98 @@
+#include <catch2/catch_test_macros.hpp>
+#include "rendering/MeshSimplifier.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+struct TestVertex {
+    float position[3];
+};
+
+// UV sphere with shared vertices except along the seam; poles and seam columns are duplicated
+void buildSphere(int rings, int segments, std::vector<TestVertex>& vertices, std::vector<uint32_t>& indices) {
+    for (int r = 0; r <= rings; ++r) {
+        float theta = 3.14159265f * r / rings;
+        for (int s = 0; s <= segments; ++s) {
+            float phi = 2.0f * 3.14159265f * s / segments;
+            vertices.push_back({{std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi)}});
+        }
+    }
+    for (int r = 0; r < rings; ++r) {
+        for (int s = 0; s < segments; ++s) {
+            uint32_t i0 = r * (segments + 1) + s;
+            uint32_t i1 = i0 + segments + 1;
+            indices.insert(indices.end(), {i0, i0 + 1, i1, i0 + 1, i1 + 1, i1});
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE("Flat grid simplifies down to its locked border without error", "[meshsimplifier]") {
+    const int size = 16;
+    std::vector<TestVertex> vertices;
+    std::vector<uint32_t> indices;
+    for (int y = 0; y <= size; ++y) {
+        for (int x = 0; x <= size; ++x) vertices.push_back({{float(x), float(y), 0.0f}});
+    }
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            uint32_t i0 = y * (size + 1) + x;
+            uint32_t i2 = i0 + size + 1;
+            indices.insert(indices.end(), {i0, i0 + 1, i2 + 1, i0, i2 + 1, i2});
+        }
+    }
+
+    float error = -1.0f;
+    auto simplified = SFE::simplifyMesh(indices, vertices[0].position, vertices.size(), sizeof(TestVertex),
+                                        0, 1.0f, &error);
+    REQUIRE(simplified.size() < indices.size() / 4);
+    REQUIRE(error < 1e-4f);
+
+    // Every border vertex is still referenced, so the outline is intact
+    for (uint32_t v = 0; v < vertices.size(); ++v) {
+        int x = v % (size + 1), y = v / (size + 1);
+        if (x == 0 || y == 0 || x == size || y == size) {
+            REQUIRE(std::find(simplified.begin(), simplified.end(), v) != simplified.end());
+        }
+    }
+}
+
+TEST_CASE("Sphere LOD chain halves triangles with growing error", "[meshsimplifier]") {
+    std::vector<TestVertex> vertices;
+    std::vector<uint32_t> indices;
+    buildSphere(32, 64, vertices, indices);
+
+    auto chain = SFE::buildLodChain(indices, vertices[0].position, vertices.size(), sizeof(TestVertex), 4);
+    REQUIRE(chain.lods.size() == 4);
+    REQUIRE(chain.lods[0].indexCount == indices.size());
+    REQUIRE(chain.lods[0].error == 0.0f);
+
+    for (size_t level = 1; level < chain.lods.size(); ++level) {
+        const auto& lod = chain.lods[level];
+        const auto& previous = chain.lods[level - 1];
+        REQUIRE(lod.firstIndex == previous.firstIndex + previous.indexCount);
+        REQUIRE(lod.indexCount <= previous.indexCount * 6 / 10);
+        REQUIRE(lod.error >= previous.error);
+        REQUIRE(lod.error < 0.2f); // Unit sphere: coarse but recognisable
+        for (uint32_t i = 0; i < lod.indexCount; ++i) {
+            REQUIRE(chain.indices[lod.firstIndex + i] < vertices.size());
+        }
+    }
+    REQUIRE(chain.indices.size() == chain.lods.back().firstIndex + chain.lods.back().indexCount);
+}
+
+TEST_CASE("Error limit stops simplification", "[meshsimplifier]") {
+    std::vector<TestVertex> vertices;
+    std::vector<uint32_t> indices;
+    buildSphere(16, 32, vertices, indices);
+
+    float error = 0.0f;
+    auto simplified = SFE::simplifyMesh(indices, vertices[0].position, vertices.size(), sizeof(TestVertex),
+                                        0, 0.01f, &error);
+    REQUIRE(error <= 0.01f);
+    REQUIRE(simplified.size() < indices.size());
+    REQUIRE(simplified.size() > indices.size() / 4);
+}
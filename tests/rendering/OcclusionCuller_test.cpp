@@ -0,0 +1,94 @@
+#include <catch2/catch_test_macros.hpp>
+#include "rendering/OcclusionCuller.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+// 10x10 wall at z = -10 in front of a camera at the origin looking down -z
+const glm::vec3 wallPositions[] = {{-5.0f, -5.0f, -10.0f}, {5.0f, -5.0f, -10.0f}, {5.0f, 5.0f, -10.0f}, {-5.0f, 5.0f, -10.0f}};
+const uint32_t wallIndices[] = {0, 1, 2, 0, 2, 3};
+
+glm::mat4 cameraViewProjection() {
+    return glm::perspective(glm::radians(90.0f), 2.0f, 0.1f, 100.0f) *
+           glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+}
+
+SFE::Aabb boxAt(const glm::vec3& center, float halfSize) {
+    return {center - glm::vec3(halfSize), center + glm::vec3(halfSize)};
+}
+
+} // namespace
+
+TEST_CASE("OcclusionCuller hides boxes behind occluders", "[occlusion]") {
+    SFE::OcclusionCuller culler(200, 100);
+    REQUIRE(culler.getWidth() == 224); // Whole tiles
+    REQUIRE(culler.getHeight() == 128);
+
+    culler.begin(cameraViewProjection());
+    culler.addOccluder(wallPositions, wallIndices, 6, glm::mat4(1.0f));
+    culler.end();
+    REQUIRE(culler.getStats().occluders == 1);
+    REQUIRE(culler.getStats().triangles == 2);
+
+    SECTION("Depth buffer and pyramid") {
+        const std::vector<float>& depth = culler.getDepth();
+        REQUIRE(depth[(culler.getHeight() / 2) * culler.getWidth() + culler.getWidth() / 2] < 1.0f);
+        REQUIRE(depth[0] == 1.0f);
+        // Every level keeps the farthest depth beneath it; the top is the farthest of all
+        REQUIRE(culler.getLevelCount() == 9);
+        REQUIRE(culler.getDepth(culler.getLevelCount() - 1)[0] == *std::max_element(depth.begin(), depth.end()));
+    }
+
+    SECTION("Boxes behind, in front of and beside the wall") {
+        REQUIRE_FALSE(culler.isVisible(boxAt({0.0f, 0.0f, -20.0f}, 1.0f)));
+        REQUIRE_FALSE(culler.isVisible(boxAt({3.0f, -3.0f, -30.0f}, 2.0f)));
+        REQUIRE(culler.isVisible(boxAt({0.0f, 0.0f, -5.0f}, 1.0f)));
+        REQUIRE(culler.isVisible(boxAt({30.0f, 0.0f, -40.0f}, 1.0f)));
+        // Straddling the wall's edge in screen space
+        REQUIRE(culler.isVisible(boxAt({10.0f, 0.0f, -20.0f}, 1.0f)));
+        // Out of view and behind the camera
+        REQUIRE_FALSE(culler.isVisible(boxAt({0.0f, 0.0f, 20.0f}, 1.0f)));
+        REQUIRE_FALSE(culler.isVisible(boxAt({500.0f, 0.0f, -20.0f}, 1.0f)));
+        // Crossing the near plane
+        REQUIRE(culler.isVisible(boxAt({0.0f, 0.0f, 0.0f}, 1.0f)));
+    }
+
+    SECTION("Batched tests match single ones") {
+        std::vector<SFE::Aabb> boxes;
+        for (int x = -20; x <= 20; ++x) {
+            for (int z = 1; z <= 40; ++z) boxes.push_back(boxAt({x * 1.5f, 0.0f, -2.0f * z}, 0.5f));
+        }
+        std::vector<uint8_t> visible(boxes.size());
+        uint32_t culled = culler.testVisibility(boxes.data(), boxes.size(), visible.data());
+        uint32_t expectedCulled = 0;
+        for (size_t i = 0; i < boxes.size(); ++i) {
+            REQUIRE(visible[i] == (culler.isVisible(boxes[i]) ? 1 : 0));
+            expectedCulled += visible[i] ? 0 : 1;
+        }
+        REQUIRE(culled == expectedCulled);
+        REQUIRE(culled > 0);
+        REQUIRE(culled < boxes.size());
+    }
+}
+
+TEST_CASE("OcclusionCuller drops occluders crossing the near plane", "[occlusion]") {
+    const glm::vec3 floor[] = {{-5.0f, -1.0f, 5.0f}, {5.0f, -1.0f, 5.0f}, {5.0f, -1.0f, -50.0f}, {-5.0f, -1.0f, -50.0f}};
+    SFE::OcclusionCuller culler;
+    culler.begin(cameraViewProjection());
+    culler.addOccluder(floor, wallIndices, 6, glm::mat4(1.0f));
+    culler.end();
+    REQUIRE(culler.getStats().triangles == 0);
+    REQUIRE(culler.isVisible(boxAt({0.0f, -3.0f, -20.0f}, 1.0f)));
+
+    SECTION("The next frame starts from an empty buffer") {
+        culler.begin(cameraViewProjection());
+        culler.addOccluder(wallPositions, wallIndices, 6, glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -5.0f)));
+        culler.end();
+        REQUIRE_FALSE(culler.isVisible(boxAt({0.0f, 0.0f, -20.0f}, 1.0f)));
+        culler.begin(cameraViewProjection());
+        culler.end();
+        REQUIRE(culler.isVisible(boxAt({0.0f, 0.0f, -20.0f}, 1.0f)));
+    }
+}
@@ -0,0 +1,64 @@
+#include <catch2/catch_test_macros.hpp>
+#include "rendering/RenderCommandBuffer.hpp"
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Recorded {
+    std::vector<std::string>* log;
+    const char* text;
+    int value;
+};
+
+void record(const Recorded& call) {
+    call.log->push_back(std::string(call.text) + ":" + std::to_string(call.value));
+}
+
+} // namespace
+
+TEST_CASE("RenderCommandBuffer replays calls in order with their copied data", "[rendercommands]") {
+    SFE::RenderCommandBuffer commands(4096);
+    std::vector<std::string> log;
+
+    std::string name = "first";
+    REQUIRE(commands.call(record, Recorded{&log, commands.copyString(name), 1}));
+    name = "overwritten"; // The copy is what gets replayed
+    REQUIRE(commands.call(record, Recorded{&log, commands.copyString("second"), 2}));
+    REQUIRE(commands.getPacketCount() == 2);
+
+    commands.replay();
+    REQUIRE(log == std::vector<std::string>{"first:1", "second:2"});
+
+    SECTION("Reset forgets packets and copies") {
+        size_t used = commands.getUsedBytes();
+        REQUIRE(used > 0);
+        commands.reset();
+        REQUIRE(commands.getPacketCount() == 0);
+        REQUIRE(commands.getUsedBytes() == 0);
+        log.clear();
+        commands.replay();
+        REQUIRE(log.empty());
+    }
+}
+
+TEST_CASE("RenderCommandBuffer drops packets once full", "[rendercommands]") {
+    SFE::RenderCommandBuffer commands(256);
+    std::vector<std::string> log;
+
+    // Copies grow from the back and packets from the front until they meet
+    float data[40] = {};
+    float* copied = commands.copy(data, 40);
+    REQUIRE(copied != nullptr);
+    REQUIRE(reinterpret_cast<uintptr_t>(copied) % alignof(float) == 0);
+    REQUIRE(commands.copy(data, 40) == nullptr);
+
+    uint32_t accepted = 0;
+    while (commands.call(record, Recorded{&log, "packet", 0})) ++accepted;
+    REQUIRE(accepted > 0);
+    REQUIRE(commands.getDroppedCount() == 1);
+    REQUIRE(commands.getUsedBytes() <= commands.getCapacity());
+
+    commands.replay();
+    REQUIRE(log.size() == accepted);
+}
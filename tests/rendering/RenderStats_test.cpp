@@ -0,0 +1,46 @@
+#include <catch2/catch_test_macros.hpp>
+#include "rendering/RenderStats.hpp"
+
+TEST_CASE("RenderStats counts per frame", "[renderstats]") {
+    auto& stats = SFE::RenderStats::getInstance();
+    stats.endFrame();
+    stats.resetSummary();
+
+    stats.recordProgramBind();
+    stats.recordVertexArrayBind();
+    stats.recordDraw(GL_TRIANGLES, 36);
+    stats.recordDraw(GL_TRIANGLE_STRIP, 4, 10);
+    stats.recordDraw(GL_POINTS, 100);
+    stats.recordIndirectDraw();
+    stats.recordBufferUpload(256);
+
+    SFE::RenderStats::Counters before = stats.getCurrent();
+    REQUIRE(before.drawCalls == 4);
+    REQUIRE(before.indirectDrawCalls == 1);
+    REQUIRE(before.triangles == 12 + 2 * 10); // Points add no triangles
+    REQUIRE(before.instances == 1 + 10 + 1);
+
+    stats.recordDraw(GL_TRIANGLES, 6);
+    stats.recordTextureUpload(1024);
+    SFE::RenderStats::Counters section = SFE::RenderStats::difference(stats.getCurrent(), before);
+    REQUIRE(section.drawCalls == 1);
+    REQUIRE(section.triangles == 2);
+    REQUIRE(section.textureBytesUploaded == 1024);
+    REQUIRE(section.bufferBytesUploaded == 0);
+
+    stats.endFrame();
+    REQUIRE(stats.getCurrent().drawCalls == 0);
+    REQUIRE(stats.getLastFrame().drawCalls == 5);
+
+    stats.recordDraw(GL_TRIANGLES, 3);
+    stats.endFrame();
+    const auto& summary = stats.getSummary();
+    REQUIRE(summary.frames == 2);
+    REQUIRE(summary.total.drawCalls == 6);
+    REQUIRE(summary.peak.drawCalls == 5);
+    REQUIRE(summary.peak.triangles == 12 + 20 + 2);
+
+    std::string json = SFE::RenderStats::toJson(summary);
+    REQUIRE(json.find("\"frames\":2") != std::string::npos);
+    REQUIRE(json.find("\"draw_calls\":6") != std::string::npos);
+}
@@ -0,0 +1,80 @@
+#include <catch2/catch_test_macros.hpp>
+#include "rendering/SceneBatchBuilder.hpp"
+#include <vector>
+
+TEST_CASE("Scene batches group instances by shader, material, mesh and texture", "[batching]") {
+    using SFE::MeshHandle;
+    using SFE::ShaderHandle;
+    using SFE::TextureHandle;
+    // Materials are only compared, so any distinct addresses will do
+    SFE::Material* materialA = reinterpret_cast<SFE::Material*>(0x1000);
+    SFE::Material* materialB = reinterpret_cast<SFE::Material*>(0x2000);
+    ShaderHandle shader1 = ShaderHandle::make(1, 1);
+    ShaderHandle shader2 = ShaderHandle::make(2, 1);
+    MeshHandle cube = MeshHandle::make(1, 1);
+    MeshHandle sphere = MeshHandle::make(2, 1);
+    TextureHandle stone = TextureHandle::make(1, 1);
+    TextureHandle wood = TextureHandle::make(2, 1);
+
+    // Submission order interleaves the batches; the matrices tag each instance by its index
+    std::vector<SFE::SceneBatchItem> items = {
+        {shader2, materialA, cube, stone, 0},
+        {shader1, materialB, cube, stone, 1},
+        {shader1, materialA, sphere, wood, 2},
+        {shader1, materialA, cube, stone, 3},
+        {ShaderHandle{}, nullptr, cube, stone, 4}, // No material and no default shader
+        {shader1, materialA, cube, wood, 5},
+        {shader1, materialA, cube, stone, 6},
+        {shader2, materialA, cube, stone, 7},
+    };
+    std::vector<glm::mat4> matrices;
+    for (int i = 0; i < 8; ++i) {
+        glm::mat4 matrix(1.0f);
+        matrix[3][0] = static_cast<float>(i);
+        matrices.push_back(matrix);
+    }
+
+    std::vector<SFE::SceneBatch> batches;
+    std::vector<glm::mat4> sortedMatrices;
+    SFE::buildSceneBatches(items, matrices, batches, sortedMatrices);
+
+    struct Expected {
+        ShaderHandle shader;
+        SFE::Material* material;
+        MeshHandle mesh;
+        TextureHandle texture;
+        std::vector<int> instances;
+    };
+    const std::vector<Expected> expected = {
+        {shader1, materialA, cube, stone, {3, 6}},
+        {shader1, materialA, cube, wood, {5}},
+        {shader1, materialA, sphere, wood, {2}},
+        {shader1, materialB, cube, stone, {1}},
+        {shader2, materialA, cube, stone, {0, 7}},
+    };
+    REQUIRE(batches.size() == expected.size());
+    REQUIRE(sortedMatrices.size() == 7); // The null-shader item is dropped
+
+    uint32_t next = 0;
+    for (size_t b = 0; b < batches.size(); ++b) {
+        const SFE::SceneBatch& batch = batches[b];
+        REQUIRE(batch.shader == expected[b].shader);
+        REQUIRE(batch.material == expected[b].material);
+        REQUIRE(batch.mesh == expected[b].mesh);
+        REQUIRE(batch.texture == expected[b].texture);
+        // Ranges are back to back and keep submission order inside a batch
+        REQUIRE(batch.firstInstance == next);
+        REQUIRE(batch.instanceCount == expected[b].instances.size());
+        for (uint32_t i = 0; i < batch.instanceCount; ++i) {
+            REQUIRE(sortedMatrices[batch.firstInstance + i][3][0] == static_cast<float>(expected[b].instances[i]));
+        }
+        next += batch.instanceCount;
+    }
+
+    SECTION("Rebuilding replaces the previous frame's output") {
+        std::vector<SFE::SceneBatchItem> none = {{ShaderHandle{}, nullptr, cube, stone, 0}};
+        SFE::buildSceneBatches(none, matrices, batches, sortedMatrices);
+        REQUIRE(batches.empty());
+        REQUIRE(sortedMatrices.empty());
+    }
+}
@@ -0,0 +1,151 @@
+#include <catch2/catch_test_macros.hpp>
+#include "rendering/TextureCompression.hpp"
+#include <cstdio>
+#include <random>
+
+namespace {
+
+// Smooth gradients with a little noise: the kind of content block compression is built for
+std::vector<uint8_t> buildTestImage(uint32_t width, uint32_t height, bool alpha) {
+    std::mt19937 random(7);
+    std::uniform_int_distribution<int> noise(-3, 3);
+    std::vector<uint8_t> image(size_t(width) * height * 4);
+    for (uint32_t y = 0; y < height; ++y) {
+        for (uint32_t x = 0; x < width; ++x) {
+            uint8_t* texel = &image[(size_t(y) * width + x) * 4];
+            texel[0] = static_cast<uint8_t>(std::clamp(int(255 * x / width) + noise(random), 0, 255));
+            texel[1] = static_cast<uint8_t>(std::clamp(int(255 * y / height) + noise(random), 0, 255));
+            texel[2] = static_cast<uint8_t>(std::clamp(128 + noise(random) * 2, 0, 255));
+            texel[3] = alpha ? static_cast<uint8_t>(255 * ((x / 8 + y / 8) % 2)) : 255;
+        }
+    }
+    return image;
+}
+
+} // namespace
+
+TEST_CASE("Mip chain goes down to 1x1 and filters in linear light", "[texture]") {
+    // Black/white checkerboard: the sRGB-correct average is 188, not 128
+    std::vector<uint8_t> checker(8 * 4 * 4);
+    for (uint32_t i = 0; i < 8 * 4; ++i) {
+        uint8_t value = ((i % 8) + (i / 8)) % 2 ? 255 : 0;
+        checker[i * 4 + 0] = checker[i * 4 + 1] = checker[i * 4 + 2] = value;
+        checker[i * 4 + 3] = 255;
+    }
+
+    auto srgbChain = SFE::generateMipChain(checker.data(), 8, 4, true);
+    REQUIRE(srgbChain.size() == 4);
+    REQUIRE(srgbChain[1].width == 4);
+    REQUIRE(srgbChain[1].height == 2);
+    REQUIRE(srgbChain[3].width == 1);
+    REQUIRE(srgbChain[3].height == 1);
+    REQUIRE(int(srgbChain[1].pixels[0]) == 188);
+    REQUIRE(int(srgbChain[3].pixels[0]) == 188);
+    REQUIRE(int(srgbChain[3].pixels[3]) == 255);
+
+    auto linearChain = SFE::generateMipChain(checker.data(), 8, 4, false);
+    REQUIRE(int(linearChain[1].pixels[0]) == 128);
+
+    REQUIRE(SFE::generateMipChain(checker.data(), 8, 4, true, 2).size() == 2);
+}
+
+TEST_CASE("Transparent texels do not bleed into mips", "[texture]") {
+    // Red opaque texel next to three transparent green ones
+    uint8_t texels[16] = {255, 0, 0, 255, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0};
+    auto chain = SFE::generateMipChain(texels, 2, 2, true);
+    REQUIRE(chain.size() == 2);
+    REQUIRE(int(chain[1].pixels[0]) == 255);
+    REQUIRE(int(chain[1].pixels[1]) == 0);
+    REQUIRE(int(chain[1].pixels[3]) == 64);
+}
+
+TEST_CASE("BC1, BC3 and BC7 round trip within quality bounds", "[texture]") {
+    const uint32_t width = 37, height = 21; // Partial edge blocks on both axes
+    std::vector<uint8_t> opaque = buildTestImage(width, height, false);
+    std::vector<uint8_t> cutout = buildTestImage(width, height, true);
+
+    auto bc1 = SFE::compressTexture(SFE::TextureFileFormat::BC1, opaque.data(), width, height);
+    REQUIRE(bc1.size() == 10 * 6 * 8);
+    auto bc1Decoded = SFE::decompressTexture(SFE::TextureFileFormat::BC1, bc1.data(), width, height);
+    REQUIRE(SFE::computeTexturePsnr(opaque.data(), bc1Decoded.data(), width, height) > 32.0);
+
+    auto bc3 = SFE::compressTexture(SFE::TextureFileFormat::BC3, cutout.data(), width, height);
+    REQUIRE(bc3.size() == 10 * 6 * 16);
+    auto bc3Decoded = SFE::decompressTexture(SFE::TextureFileFormat::BC3, bc3.data(), width, height);
+    REQUIRE(SFE::computeTexturePsnr(cutout.data(), bc3Decoded.data(), width, height) > 32.0);
+
+    auto bc7 = SFE::compressTexture(SFE::TextureFileFormat::BC7, cutout.data(), width, height);
+    auto bc7Decoded = SFE::decompressTexture(SFE::TextureFileFormat::BC7, bc7.data(), width, height);
+    REQUIRE(SFE::computeTexturePsnr(cutout.data(), bc7Decoded.data(), width, height) > 32.0);
+}
+
+TEST_CASE("Solid blocks compress exactly where the endpoints can represent them", "[texture]") {
+    uint8_t solid[64];
+    for (int i = 0; i < 16; ++i) {
+        solid[i * 4 + 0] = 255;
+        solid[i * 4 + 1] = 0;
+        solid[i * 4 + 2] = 0;
+        solid[i * 4 + 3] = 90;
+    }
+    uint8_t block[16], decoded[64];
+    SFE::compressBlockBC3(solid, block);
+    SFE::decompressBlockBC3(block, decoded);
+    for (int i = 0; i < 16; ++i) {
+        REQUIRE(int(decoded[i * 4 + 0]) == 255);
+        REQUIRE(int(decoded[i * 4 + 1]) == 0);
+        REQUIRE(int(decoded[i * 4 + 3]) == 90);
+    }
+
+    SFE::compressBlockBC7(solid, block);
+    REQUIRE((block[0] & 0x7F) == 0x40); // Mode 6
+    SFE::decompressBlockBC7(block, decoded);
+    for (int i = 0; i < 16; ++i) {
+        REQUIRE(std::abs(int(decoded[i * 4 + 0]) - 255) <= 1);
+        REQUIRE(std::abs(int(decoded[i * 4 + 3]) - 90) <= 1);
+    }
+}
+
+TEST_CASE("Texture files round trip and reject bad input", "[texture]") {
+    std::vector<uint8_t> image = buildTestImage(16, 8, false);
+    auto chain = SFE::generateMipChain(image.data(), 16, 8, true);
+    std::vector<std::vector<uint8_t>> levels;
+    std::vector<const uint8_t*> levelData;
+    for (const auto& level : chain) {
+        levels.push_back(SFE::compressTexture(SFE::TextureFileFormat::BC1, level.pixels.data(), level.width, level.height));
+    }
+    for (const auto& level : levels) levelData.push_back(level.data());
+
+    SFE::TextureFileDesc desc;
+    desc.format = SFE::TextureFileFormat::BC1;
+    desc.flags = SFE::TEXTURE_FILE_SRGB | SFE::TEXTURE_FILE_LINEAR_MIPS;
+    desc.width = 16;
+    desc.height = 8;
+    desc.levelCount = static_cast<uint32_t>(levelData.size());
+    desc.levelData = levelData.data();
+
+    const std::string path = "texture_format_test.sft";
+    REQUIRE(SFE::writeTextureFile(path, desc));
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    REQUIRE(file);
+    std::vector<uint8_t> bytes(4096);
+    bytes.resize(std::fread(bytes.data(), 1, bytes.size(), file));
+    std::fclose(file);
+    std::remove(path.c_str());
+
+    std::string error;
+    const SFE::TextureFileHeader* header = SFE::validateTextureFile(bytes.data(), bytes.size(), error);
+    REQUIRE(header);
+    REQUIRE(header->levelCount == 5);
+    const SFE::TextureFileLevel* fileLevels = SFE::getTextureFileLevels(bytes.data(), *header);
+    for (uint32_t i = 0; i < header->levelCount; ++i) {
+        REQUIRE(fileLevels[i].offset % SFE::TEXTURE_FILE_ALIGNMENT == 0);
+        REQUIRE(std::equal(levels[i].begin(), levels[i].end(), bytes.begin() + fileLevels[i].offset));
+    }
+    // Smallest level first
+    REQUIRE(fileLevels[4].offset < fileLevels[0].offset);
+
+    REQUIRE_FALSE(SFE::validateTextureFile(bytes.data(), bytes.size() - 1, error));
+    bytes[0] ^= 0xFF;
+    REQUIRE_FALSE(SFE::validateTextureFile(bytes.data(), bytes.size(), error));
+    REQUIRE(error == "bad magic");
+}
@@ -0,0 +1,55 @@
+#include <catch2/catch_test_macros.hpp>
+#include "rendering/VertexQuantization.hpp"
+#include <cmath>
+
+TEST_CASE("Half-float conversion round trips", "[quantization]") {
+    REQUIRE(SFE::floatToHalf(0.0f) == 0x0000);
+    REQUIRE(SFE::floatToHalf(1.0f) == 0x3C00);
+    REQUIRE(SFE::floatToHalf(-2.0f) == 0xC000);
+    REQUIRE(SFE::floatToHalf(65504.0f) == 0x7BFF);
+    REQUIRE(SFE::floatToHalf(1.0e6f) == 0x7C00); // Overflow to inf
+
+    for (float value : {0.5f, 0.25f, 0.333f, 0.999f, 3.75f, -0.125f, 1.0e-5f}) {
+        float roundTrip = SFE::halfToFloat(SFE::floatToHalf(value));
+        REQUIRE(std::fabs(roundTrip - value) <= std::fabs(value) * 1.0e-3f + 1.0e-7f);
+    }
+}
+
+TEST_CASE("Octahedral normals decode close to the input", "[quantization]") {
+    const float normals[][3] = {{0.0f, 0.0f, 1.0f},   {0.0f, 0.0f, -1.0f}, {1.0f, 0.0f, 0.0f},
+                                {0.0f, -1.0f, 0.0f},  {0.577f, 0.577f, 0.577f},
+                                {-0.577f, 0.577f, -0.577f}, {0.267f, -0.534f, -0.801f}};
+    for (const auto& n : normals) {
+        float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        float unit[3] = {n[0] / length, n[1] / length, n[2] / length};
+
+        int16_t encoded[2];
+        float decoded[3];
+        SFE::encodeOctahedral(unit, encoded);
+        SFE::decodeOctahedral(encoded, decoded);
+
+        float dot = unit[0] * decoded[0] + unit[1] * decoded[1] + unit[2] * decoded[2];
+        REQUIRE(dot > 0.99999f);
+    }
+}
+
+TEST_CASE("Quantized vertex buffers are half the size", "[quantization]") {
+    float vertices[2][8] = {{-1.0f, 0.0f, 2.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f},
+                            {1.0f, 4.0f, 3.0f, 0.0f, 0.0f, -1.0f, 1.0f, 0.5f}};
+    float boundsMin[3] = {-1.0f, 0.0f, 2.0f};
+    float boundsMax[3] = {1.0f, 4.0f, 3.0f};
+
+    auto oct = SFE::quantizeVertices(SFE::VertexFormat::QuantizedOct, vertices, 2, boundsMin, boundsMax);
+    REQUIRE(oct.size() == 2 * 16);
+    const auto* packed = reinterpret_cast<const SFE::QuantizedVertexOct*>(oct.data());
+    REQUIRE(packed[0].position[0] == 0);
+    REQUIRE(packed[1].position[0] == 65535);
+    REQUIRE(packed[1].position[1] == 65535);
+    REQUIRE(SFE::halfToFloat(packed[1].texCoord[1]) == 0.5f);
+
+    auto rev = SFE::quantizeVertices(SFE::VertexFormat::Quantized1010102, vertices, 2, boundsMin, boundsMax);
+    REQUIRE(rev.size() == 2 * 16);
+    const auto* packed1010102 = reinterpret_cast<const SFE::QuantizedVertex1010102*>(rev.data());
+    REQUIRE(((packed1010102[0].normal >> 10) & 0x3FF) == 511);  // +y
+    REQUIRE(((packed1010102[1].normal >> 20) & 0x3FF) == 0x201); // -z (two's complement -511)
+}
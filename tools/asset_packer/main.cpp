@@ -0,0 +1,144 @@
+// tools/asset_packer/main.cpp
+// Offline packer: loose asset files -> one .sfp pack mapped at startup (see include/core/AssetPackFormat.hpp)
+#include "core/AssetPackFormat.hpp"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+
+enum class CompressMode { Auto, None, All };
+
+struct PackerOptions {
+    std::string outputPath;
+    std::vector<std::string> inputs; // Files or directories, walked recursively
+    std::string reportPath;          // Optional CSV that gets one line per pack
+    CompressMode compress = CompressMode::Auto;
+};
+
+void printUsage() {
+    std::cout << "Usage: asset_packer [options] <output.sfp> <dir|file>...\n"
+              << "  --compress <auto|none|all>\n"
+              << "                    auto (default) LZ4-compresses everything except cooked meshes,\n"
+              << "                    cooked textures and already compressed images, which stay\n"
+              << "                    uncompressed so they load zero-copy\n"
+              << "  --report <csv>    append entry counts and sizes to a CSV file\n"
+              << "Paths are stored relative to the working directory." << std::endl;
+}
+
+bool parseArguments(int argc, char** argv, PackerOptions& options) {
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--compress" && i + 1 < argc) {
+            std::string mode = argv[++i];
+            if (mode == "auto") {
+                options.compress = CompressMode::Auto;
+            } else if (mode == "none") {
+                options.compress = CompressMode::None;
+            } else if (mode == "all") {
+                options.compress = CompressMode::All;
+            } else {
+                return false;
+            }
+        } else if (arg == "--report" && i + 1 < argc) {
+            options.reportPath = argv[++i];
+        } else if (!arg.empty() && arg[0] != '-') {
+            positional.push_back(arg);
+        } else {
+            return false;
+        }
+    }
+    if (positional.size() < 2) return false;
+    options.outputPath = positional[0];
+    options.inputs.assign(positional.begin() + 1, positional.end());
+    return true;
+}
+
+bool shouldCompress(CompressMode mode, const std::filesystem::path& path) {
+    if (mode != CompressMode::Auto) return mode == CompressMode::All;
+    std::string extension = path.extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return extension != ".sft" && extension != ".sfm" && extension != ".png" && extension != ".jpg";
+}
+
+bool addFile(const std::filesystem::path& path, CompressMode mode, std::vector<SFE::AssetPackSource>& sources) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "asset_packer: cannot read " << path.string() << std::endl;
+        return false;
+    }
+    SFE::AssetPackSource source;
+    source.path = SFE::normalizeAssetPath(path.lexically_normal().generic_string());
+    source.data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    source.compress = shouldCompress(mode, path);
+    sources.push_back(std::move(source));
+    return true;
+}
+
+void appendReport(const std::string& path, const std::string& pack, const SFE::AssetPackStats& stats) {
+    bool writeHeader = !std::ifstream(path).good();
+    std::ofstream csv(path, std::ios::app);
+    if (!csv.is_open()) {
+        std::cerr << "asset_packer: cannot write report " << path << std::endl;
+        return;
+    }
+    if (writeHeader) {
+        csv << "Pack,Entries,CompressedEntries,InputBytes,PackBytes\n";
+    }
+    csv << pack << "," << stats.entryCount << "," << stats.compressedEntries << "," << stats.inputBytes << ","
+        << stats.fileSize << "\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    PackerOptions options;
+    if (!parseArguments(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    namespace fs = std::filesystem;
+    fs::path outputPath = fs::absolute(options.outputPath).lexically_normal();
+    std::vector<SFE::AssetPackSource> sources;
+    for (const auto& input : options.inputs) {
+        std::error_code error;
+        if (fs::is_directory(input, error)) {
+            for (const auto& item : fs::recursive_directory_iterator(input)) {
+                // Never pack a previous pack into the new one
+                if (!item.is_regular_file() || fs::absolute(item.path()).lexically_normal() == outputPath) continue;
+                if (!addFile(item.path(), options.compress, sources)) return 1;
+            }
+        } else if (fs::is_regular_file(input, error)) {
+            if (!addFile(input, options.compress, sources)) return 1;
+        } else {
+            std::cerr << "asset_packer: no such file or directory " << input << std::endl;
+            return 1;
+        }
+    }
+
+    SFE::AssetPackStats stats;
+    if (!SFE::writeAssetPack(options.outputPath, sources, &stats)) {
+        std::cerr << "asset_packer: failed to write " << options.outputPath << std::endl;
+        return 1;
+    }
+    if (!options.reportPath.empty()) {
+        appendReport(options.reportPath, options.outputPath, stats);
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - startTime;
+    std::cout << "asset_packer: " << options.outputPath << " (" << stats.entryCount << " entries, "
+              << stats.compressedEntries << " LZ4, " << stats.inputBytes / 1024.0 << " KB -> "
+              << stats.fileSize / 1024.0 << " KB, " << elapsed.count() * 1000.0 << " ms)" << std::endl;
+    return 0;
+}
@@ -0,0 +1,207 @@
+// tools/bvh_benchmark/main.cpp
+// Query throughput of the scene Bvh against brute force over every box (see include/rendering/Bvh.hpp)
+#include "rendering/Bvh.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct BenchmarkOptions {
+    std::vector<uint32_t> counts{10000, 100000, 1000000};
+    uint32_t queries = 100;  // Of each kind, the same set for the Bvh and brute force
+    std::string reportPath;  // Optional CSV that gets one line per count and query kind
+};
+
+struct Result {
+    const char* query;
+    double bvhMs = 0.0;   // All queries
+    double bruteMs = 0.0;
+    uint64_t bvhHits = 0; // Must match brute force
+    uint64_t bruteHits = 0;
+};
+
+void printUsage() {
+    std::cout << "Usage: bvh_benchmark [options]\n"
+              << "  --counts <n,n,...>  object counts (default 10000,100000,1000000)\n"
+              << "  --queries <n>       queries of each kind per count (default 100)\n"
+              << "  --report <csv>      append the timings to a CSV file" << std::endl;
+}
+
+bool parseArguments(int argc, char** argv, BenchmarkOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--counts" && i + 1 < argc) {
+            options.counts.clear();
+            std::stringstream list(argv[++i]);
+            std::string count;
+            while (std::getline(list, count, ',')) {
+                long value = std::atol(count.c_str());
+                if (value <= 0) return false;
+                options.counts.push_back(static_cast<uint32_t>(value));
+            }
+        } else if (arg == "--queries" && i + 1 < argc) {
+            long value = std::atol(argv[++i]);
+            if (value <= 0) return false;
+            options.queries = static_cast<uint32_t>(value);
+        } else if (arg == "--report" && i + 1 < argc) {
+            options.reportPath = argv[++i];
+        } else {
+            return false;
+        }
+    }
+    return !options.counts.empty();
+}
+
+double millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Slab test, the same as the Bvh's, against every box
+float rayEntry(const SFE::Aabb& box, const glm::vec3& origin, const glm::vec3& inverseDirection, float maxDistance) {
+    glm::vec3 t0 = (box.min - origin) * inverseDirection;
+    glm::vec3 t1 = (box.max - origin) * inverseDirection;
+    glm::vec3 nearT = glm::min(t0, t1);
+    glm::vec3 farT = glm::max(t0, t1);
+    float entry = std::max(std::max(nearT.x, nearT.y), std::max(nearT.z, 0.0f));
+    float exit = std::min(std::min(farT.x, farT.y), std::min(farT.z, maxDistance));
+    return entry <= exit ? entry : -1.0f;
+}
+
+void appendReport(const std::string& path, uint32_t count, uint32_t queries, const Result& result) {
+    bool writeHeader = !std::ifstream(path).good();
+    std::ofstream csv(path, std::ios::app);
+    if (!csv.is_open()) {
+        std::cerr << "bvh_benchmark: cannot write report " << path << std::endl;
+        return;
+    }
+    if (writeHeader) {
+        csv << "Objects,Query,Queries,BvhMs,BruteForceMs,Hits\n";
+    }
+    csv << count << "," << result.query << "," << queries << "," << result.bvhMs << "," << result.bruteMs << ","
+        << result.bvhHits << "\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    BenchmarkOptions options;
+    if (!parseArguments(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+
+    bool mismatch = false;
+    for (uint32_t count : options.counts) {
+        // Constant density: the world grows with the object count
+        std::mt19937 rng(count);
+        float worldSize = 4.0f * std::cbrt(static_cast<float>(count));
+        std::uniform_real_distribution<float> position(0.0f, worldSize);
+        std::uniform_real_distribution<float> size(0.5f, 2.0f);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        std::vector<SFE::Aabb> boxes(count);
+        for (auto& box : boxes) {
+            box.min = glm::vec3(position(rng), position(rng), position(rng));
+            box.max = box.min + glm::vec3(size(rng), size(rng), size(rng));
+        }
+
+        // Zero margin so the Bvh and brute force test the same boxes
+        SFE::Bvh bvh(0.0f);
+        auto start = std::chrono::steady_clock::now();
+        std::vector<SFE::Bvh::ProxyId> proxies(count);
+        for (uint32_t i = 0; i < count; ++i) proxies[i] = bvh.insert(boxes[i], i);
+        double insertMs = millisecondsSince(start);
+        float insertedCost = bvh.getCost();
+        start = std::chrono::steady_clock::now();
+        bvh.rebuild();
+        double rebuildMs = millisecondsSince(start);
+
+        // Queries sized to see a few hundred objects each
+        std::vector<SFE::Frustum> frustums;
+        std::vector<SFE::Aabb> regions;
+        std::vector<std::pair<glm::vec3, glm::vec3>> rays;
+        glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 40.0f);
+        for (uint32_t i = 0; i < options.queries; ++i) {
+            glm::vec3 eye(position(rng), position(rng), position(rng));
+            glm::vec3 forward = glm::normalize(glm::vec3(unit(rng), unit(rng), unit(rng)) + glm::vec3(1e-3f));
+            frustums.push_back(SFE::Frustum::fromMatrix(projection * glm::lookAt(eye, eye + forward, glm::vec3(0, 1, 0))));
+            glm::vec3 corner(position(rng), position(rng), position(rng));
+            regions.push_back({corner, corner + glm::vec3(20.0f)});
+            rays.push_back({eye, forward});
+        }
+        const float rayLength = worldSize;
+
+        Result results[3] = {{"frustum"}, {"aabb"}, {"ray"}};
+        start = std::chrono::steady_clock::now();
+        for (const auto& frustum : frustums) bvh.queryFrustum(frustum, [&](uint32_t) { ++results[0].bvhHits; });
+        results[0].bvhMs = millisecondsSince(start);
+        start = std::chrono::steady_clock::now();
+        for (const auto& frustum : frustums) {
+            for (const auto& box : boxes) results[0].bruteHits += frustum.intersectsAabb(box.min, box.max);
+        }
+        results[0].bruteMs = millisecondsSince(start);
+
+        start = std::chrono::steady_clock::now();
+        for (const auto& region : regions) bvh.queryAabb(region, [&](uint32_t) { ++results[1].bvhHits; });
+        results[1].bvhMs = millisecondsSince(start);
+        start = std::chrono::steady_clock::now();
+        for (const auto& region : regions) {
+            for (const auto& box : boxes) results[1].bruteHits += box.overlaps(region);
+        }
+        results[1].bruteMs = millisecondsSince(start);
+
+        // Nearest box along each ray; hits counted as rays that hit something
+        start = std::chrono::steady_clock::now();
+        for (const auto& [origin, direction] : rays) {
+            float nearest = bvh.raycast(origin, direction, rayLength, [](uint32_t, float entry) { return entry; });
+            results[2].bvhHits += nearest < rayLength;
+        }
+        results[2].bvhMs = millisecondsSince(start);
+        start = std::chrono::steady_clock::now();
+        for (const auto& [origin, direction] : rays) {
+            glm::vec3 inverseDirection = glm::vec3(1.0f) / direction;
+            float nearest = rayLength;
+            for (const auto& box : boxes) {
+                float entry = rayEntry(box, origin, inverseDirection, nearest);
+                if (entry >= 0.0f) nearest = std::min(nearest, entry);
+            }
+            results[2].bruteHits += nearest < rayLength;
+        }
+        results[2].bruteMs = millisecondsSince(start);
+
+        // A tenth of the objects move a little: incremental refit, then how far quality dropped
+        start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < count; i += 10) {
+            glm::vec3 delta = glm::vec3(unit(rng), unit(rng), unit(rng)) * 2.0f;
+            bvh.move(proxies[i], {boxes[i].min + delta, boxes[i].max + delta});
+        }
+        double refitMs = millisecondsSince(start);
+
+        std::cout << count << " objects: insert " << insertMs << " ms (SAH cost " << insertedCost << "), rebuild "
+                  << rebuildMs << " ms (cost " << bvh.getCost() / bvh.getQuality() << ", height " << bvh.getHeight()
+                  << "), refit of " << (count + 9) / 10 << " moves " << refitMs << " ms (quality "
+                  << bvh.getQuality() << ")\n";
+        for (const Result& result : results) {
+            double bvhRate = options.queries / (result.bvhMs / 1000.0);
+            double bruteRate = options.queries / (result.bruteMs / 1000.0);
+            std::cout << "  " << result.query << ": " << bvhRate << " queries/s vs " << bruteRate
+                      << " brute force (" << result.bruteMs / result.bvhMs << "x), " << result.bvhHits << " hits"
+                      << std::endl;
+            if (result.bvhHits != result.bruteHits) {
+                std::cerr << "bvh_benchmark: " << result.query << " found " << result.bvhHits << ", brute force "
+                          << result.bruteHits << std::endl;
+                mismatch = true;
+            }
+            if (!options.reportPath.empty()) appendReport(options.reportPath, count, options.queries, result);
+        }
+    }
+    return mismatch ? 1 : 0;
+}
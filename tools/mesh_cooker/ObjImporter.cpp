@@ -0,0 +1,171 @@
+#include "ObjImporter.hpp"
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+namespace SFE {
+
+namespace {
+
+struct VertexKey {
+    int position;
+    int texCoord;
+    int normal;
+
+    bool operator==(const VertexKey& other) const {
+        return position == other.position && texCoord == other.texCoord && normal == other.normal;
+    }
+};
+
+struct VertexKeyHash {
+    size_t operator()(const VertexKey& key) const {
+        size_t hash = static_cast<size_t>(key.position) * 73856093u;
+        hash ^= static_cast<size_t>(key.texCoord) * 19349663u;
+        hash ^= static_cast<size_t>(key.normal) * 83492791u;
+        return hash;
+    }
+};
+
+// OBJ indices are 1-based, negative values count back from the end
+int resolveIndex(int index, size_t count) {
+    if (index > 0) return index - 1;
+    if (index < 0) return static_cast<int>(count) + index;
+    return -1;
+}
+
+bool parseFaceVertex(const std::string& token, const std::vector<glm::vec3>& positions,
+                     const std::vector<glm::vec2>& texCoords, const std::vector<glm::vec3>& normals,
+                     VertexKey& key) {
+    int values[3] = {0, 0, 0};
+    size_t start = 0;
+    for (int component = 0; component < 3 && start <= token.size(); ++component) {
+        size_t slash = token.find('/', start);
+        std::string part = token.substr(start, slash == std::string::npos ? std::string::npos : slash - start);
+        if (!part.empty()) {
+            values[component] = std::stoi(part);
+        }
+        if (slash == std::string::npos) break;
+        start = slash + 1;
+    }
+
+    key.position = resolveIndex(values[0], positions.size());
+    key.texCoord = resolveIndex(values[1], texCoords.size());
+    key.normal = resolveIndex(values[2], normals.size());
+    return key.position >= 0 && key.position < static_cast<int>(positions.size()) &&
+           key.texCoord < static_cast<int>(texCoords.size()) &&
+           key.normal < static_cast<int>(normals.size());
+}
+
+} // namespace
+
+bool importObj(const std::string& path, ImportedMesh& mesh, std::string& error) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        error = "cannot open " + path;
+        return false;
+    }
+
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec2> texCoords;
+    std::vector<glm::vec3> normals;
+    std::unordered_map<VertexKey, uint32_t, VertexKeyHash> welded;
+    std::vector<int> vertexPosition; // Source position per welded vertex, for generated normals
+    bool needsNormals = false;
+
+    mesh = ImportedMesh{};
+
+    std::string line;
+    size_t lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        std::istringstream stream(line);
+        std::string type;
+        stream >> type;
+
+        if (type == "v") {
+            glm::vec3 p;
+            stream >> p.x >> p.y >> p.z;
+            positions.push_back(p);
+        } else if (type == "vt") {
+            glm::vec2 uv;
+            stream >> uv.x >> uv.y;
+            texCoords.push_back(uv);
+        } else if (type == "vn") {
+            glm::vec3 n;
+            stream >> n.x >> n.y >> n.z;
+            normals.push_back(n);
+        } else if (type == "f") {
+            std::vector<uint32_t> polygon;
+            std::string token;
+            while (stream >> token) {
+                VertexKey key{};
+                try {
+                    if (!parseFaceVertex(token, positions, texCoords, normals, key)) {
+                        error = "invalid face index at line " + std::to_string(lineNumber);
+                        return false;
+                    }
+                } catch (const std::exception&) {
+                    error = "malformed face at line " + std::to_string(lineNumber);
+                    return false;
+                }
+
+                auto it = welded.find(key);
+                if (it == welded.end()) {
+                    CookedVertex vertex{};
+                    vertex.position = positions[key.position];
+                    vertex.texCoord = key.texCoord >= 0 ? texCoords[key.texCoord] : glm::vec2(0.0f);
+                    vertex.normal = key.normal >= 0 ? normals[key.normal] : glm::vec3(0.0f);
+                    needsNormals |= key.normal < 0;
+
+                    uint32_t index = static_cast<uint32_t>(mesh.vertices.size());
+                    mesh.vertices.push_back(vertex);
+                    vertexPosition.push_back(key.position);
+                    it = welded.emplace(key, index).first;
+                }
+                polygon.push_back(it->second);
+            }
+
+            // Fan triangulation
+            for (size_t i = 2; i < polygon.size(); ++i) {
+                mesh.indices.push_back(polygon[0]);
+                mesh.indices.push_back(polygon[i - 1]);
+                mesh.indices.push_back(polygon[i]);
+            }
+        }
+    }
+
+    if (mesh.indices.empty()) {
+        error = "no faces in " + path;
+        return false;
+    }
+
+    if (needsNormals) {
+        // Accumulate area-weighted face normals per source position so welded seams stay smooth
+        std::vector<glm::vec3> accumulated(positions.size(), glm::vec3(0.0f));
+        for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+            const glm::vec3& a = mesh.vertices[mesh.indices[i]].position;
+            const glm::vec3& b = mesh.vertices[mesh.indices[i + 1]].position;
+            const glm::vec3& c = mesh.vertices[mesh.indices[i + 2]].position;
+            glm::vec3 faceNormal = glm::cross(b - a, c - a);
+            for (size_t k = 0; k < 3; ++k) {
+                accumulated[vertexPosition[mesh.indices[i + k]]] += faceNormal;
+            }
+        }
+        for (size_t v = 0; v < mesh.vertices.size(); ++v) {
+            if (mesh.vertices[v].normal == glm::vec3(0.0f)) {
+                glm::vec3 n = accumulated[vertexPosition[v]];
+                float length = glm::length(n);
+                mesh.vertices[v].normal = length > 0.0f ? n / length : glm::vec3(0.0f, 1.0f, 0.0f);
+            }
+        }
+    }
+
+    mesh.boundsMin = mesh.boundsMax = mesh.vertices[0].position;
+    for (const auto& vertex : mesh.vertices) {
+        mesh.boundsMin = glm::min(mesh.boundsMin, vertex.position);
+        mesh.boundsMax = glm::max(mesh.boundsMax, vertex.position);
+    }
+    return true;
+}
+
+} // namespace SFE
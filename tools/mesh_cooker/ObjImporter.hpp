@@ -0,0 +1,28 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace SFE {
+
+// Same memory layout as Mesh::Vertex / VertexFormat::Standard
+struct CookedVertex {
+    glm::vec3 position;
+    glm::vec3 normal;
+    glm::vec2 texCoord;
+};
+
+struct ImportedMesh {
+    std::vector<CookedVertex> vertices;
+    std::vector<uint32_t> indices; // Triangle list
+    glm::vec3 boundsMin{0.0f};
+    glm::vec3 boundsMax{0.0f};
+};
+
+// Minimal Wavefront OBJ reader: v/vt/vn/f, polygons are fan-triangulated and identical
+// position/uv/normal triples are welded into one indexed vertex. Faces without normals get
+// area-weighted face normals accumulated per position.
+bool importObj(const std::string& path, ImportedMesh& mesh, std::string& error);
+
+} // namespace SFE
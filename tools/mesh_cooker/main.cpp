@@ -0,0 +1,160 @@
+// tools/mesh_cooker/main.cpp
+// Offline converter: Wavefront OBJ -> binary .sfm mesh blob (see include/rendering/MeshFormat.hpp)
+#include "ObjImporter.hpp"
+#include "rendering/MeshFormat.hpp"
+#include "rendering/MeshOptimizer.hpp"
+#include "rendering/MeshSimplifier.hpp"
+#include "rendering/VertexQuantization.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct CookerOptions {
+    std::string inputPath;
+    std::string outputPath;
+    std::string reportPath;   // Optional CSV that gets one line per cooked asset
+    bool optimize = true;     // Vertex cache + vertex fetch ordering
+    bool overdraw = false;    // Additionally sort triangle clusters for overdraw
+    SFE::VertexFormat format = SFE::VertexFormat::Standard;
+    uint32_t lodCount = 1;    // Levels of detail to generate, including the full mesh
+};
+
+void printUsage() {
+    std::cout << "Usage: mesh_cooker [options] <input.obj> <output.sfm>\n"
+              << "  --no-optimize     keep the triangle/vertex order of the source file\n"
+              << "  --overdraw        sort triangle clusters to reduce overdraw\n"
+              << "  --report <csv>    append ACMR/ATVR before/after to a CSV file\n"
+              << "  --lods <n>        generate up to n levels of detail (QEM simplification)\n"
+              << "  --quantize <oct|1010102>\n"
+              << "                    store 16-byte vertices: unorm16 positions, half UVs and\n"
+              << "                    octahedral or 10:10:10:2 normals" << std::endl;
+}
+
+bool parseArguments(int argc, char** argv, CookerOptions& options) {
+    std::string positional[2];
+    int positionalCount = 0;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--no-optimize") {
+            options.optimize = false;
+        } else if (arg == "--overdraw") {
+            options.overdraw = true;
+        } else if (arg == "--report" && i + 1 < argc) {
+            options.reportPath = argv[++i];
+        } else if (arg == "--lods" && i + 1 < argc) {
+            int lods = std::atoi(argv[++i]);
+            if (lods < 1 || lods > static_cast<int>(SFE::MESH_FILE_MAX_LODS)) return false;
+            options.lodCount = static_cast<uint32_t>(lods);
+        } else if (arg == "--quantize" && i + 1 < argc) {
+            std::string mode = argv[++i];
+            if (mode == "oct") {
+                options.format = SFE::VertexFormat::QuantizedOct;
+            } else if (mode == "1010102") {
+                options.format = SFE::VertexFormat::Quantized1010102;
+            } else {
+                return false;
+            }
+        } else if (!arg.empty() && arg[0] != '-' && positionalCount < 2) {
+            positional[positionalCount++] = arg;
+        } else {
+            return false;
+        }
+    }
+    options.inputPath = positional[0];
+    options.outputPath = positional[1];
+    return positionalCount == 2;
+}
+
+void appendReport(const std::string& path, const std::string& asset, size_t triangles,
+                  const SFE::MeshOptimizationReport& report) {
+    bool writeHeader = !std::ifstream(path).good();
+    std::ofstream csv(path, std::ios::app);
+    if (!csv.is_open()) {
+        std::cerr << "mesh_cooker: cannot write report " << path << std::endl;
+        return;
+    }
+    if (writeHeader) {
+        csv << "Asset,Triangles,VerticesBefore,VerticesAfter,ACMR_Before,ACMR_After,ATVR_Before,ATVR_After\n";
+    }
+    csv << asset << "," << triangles << "," << report.vertexCountBefore << ","
+        << report.vertexCountAfter << "," << report.before.acmr << "," << report.after.acmr << ","
+        << report.before.atvr << "," << report.after.atvr << "\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    CookerOptions options;
+    if (!parseArguments(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    SFE::ImportedMesh mesh;
+    std::string error;
+    if (!SFE::importObj(options.inputPath, mesh, error)) {
+        std::cerr << "mesh_cooker: " << error << std::endl;
+        return 1;
+    }
+
+    uint32_t flags = 0;
+    if (options.optimize) {
+        auto report = SFE::optimizeMesh(mesh.vertices, mesh.indices,
+                                        offsetof(SFE::CookedVertex, position), options.overdraw);
+        flags |= SFE::MESH_FILE_VERTEX_CACHE_OPTIMIZED | SFE::MESH_FILE_VERTEX_FETCH_OPTIMIZED;
+        if (options.overdraw) flags |= SFE::MESH_FILE_OVERDRAW_OPTIMIZED;
+
+        std::cout << "mesh_cooker: ACMR " << report.before.acmr << " -> " << report.after.acmr
+                  << ", ATVR " << report.before.atvr << " -> " << report.after.atvr << std::endl;
+        if (!options.reportPath.empty()) {
+            appendReport(options.reportPath, options.inputPath, mesh.indices.size() / 3, report);
+        }
+    }
+
+    // LODs reuse the optimised vertex buffer; only index ranges are appended
+    SFE::LodChain chain = SFE::buildLodChain(mesh.indices, &mesh.vertices[0].position.x, mesh.vertices.size(),
+                                             sizeof(SFE::CookedVertex), options.lodCount);
+    std::vector<SFE::MeshFileLod> lods;
+    for (const auto& lod : chain.lods) {
+        lods.push_back({lod.firstIndex, lod.indexCount, lod.error, 0});
+        std::cout << "mesh_cooker: LOD " << lods.size() - 1 << ": " << lod.indexCount / 3
+                  << " triangles, error " << lod.error << std::endl;
+    }
+
+    // Quantize last so the optimisers above work on full-precision positions
+    std::vector<uint8_t> vertexData = SFE::quantizeVertices(
+        options.format, mesh.vertices.data(), mesh.vertices.size(), &mesh.boundsMin.x, &mesh.boundsMax.x);
+
+    SFE::MeshFileDesc desc;
+    desc.vertexFormat = options.format;
+    desc.vertexStride = static_cast<uint32_t>(vertexData.size() / mesh.vertices.size());
+    desc.vertexData = vertexData.data();
+    desc.vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+    desc.indexData = chain.indices.data();
+    desc.indexCount = static_cast<uint32_t>(chain.indices.size());
+    desc.flags = flags;
+    desc.lods = lods.data();
+    desc.lodCount = static_cast<uint32_t>(lods.size());
+    std::memcpy(desc.boundsMin, &mesh.boundsMin, sizeof(desc.boundsMin));
+    std::memcpy(desc.boundsMax, &mesh.boundsMax, sizeof(desc.boundsMax));
+
+    if (!SFE::writeMeshFile(options.outputPath, desc)) {
+        std::cerr << "mesh_cooker: failed to write " << options.outputPath << std::endl;
+        return 1;
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - startTime;
+    std::cout << "mesh_cooker: " << options.inputPath << " -> " << options.outputPath << " ("
+              << desc.vertexCount << " vertices, " << mesh.indices.size() / 3 << " triangles, "
+              << vertexData.size() / 1024.0 << " KB vertex data, " << elapsed.count() * 1000.0 << " ms)" << std::endl;
+    return 0;
+}
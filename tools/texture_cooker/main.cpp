@@ -0,0 +1,167 @@
+// tools/texture_cooker/main.cpp
+// Offline converter: PNG/TGA/JPEG -> block-compressed .sft texture with a full mip chain
+// (see include/rendering/TextureFormat.hpp)
+#include "rendering/TextureCompression.hpp"
+#include "rendering/TextureFormat.hpp"
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+enum class FormatChoice { Auto, RGBA8, BC1, BC3, BC7 };
+
+struct CookerOptions {
+    std::string inputPath;
+    std::string outputPath;
+    std::string reportPath; // Optional CSV that gets one line per cooked asset
+    FormatChoice format = FormatChoice::Auto;
+    bool srgb = true;       // Colour texture; --linear for normal maps and other data
+    uint32_t maxLevels = SFE::TEXTURE_FILE_MAX_LEVELS;
+};
+
+void printUsage() {
+    std::cout << "Usage: texture_cooker [options] <input image> <output.sft>\n"
+              << "  --format <auto|bc1|bc3|bc7|rgba8>\n"
+              << "                    block format; auto picks BC1 for opaque images and BC3 otherwise\n"
+              << "                    (BC7 needs GL 4.2 or ARB_texture_compression_bptc at runtime)\n"
+              << "  --linear          data texture: filter mips without sRGB decoding\n"
+              << "  --levels <n>      at most n mip levels (default: down to 1x1)\n"
+              << "  --report <csv>    append sizes and PSNR to a CSV file" << std::endl;
+}
+
+bool parseArguments(int argc, char** argv, CookerOptions& options) {
+    std::string positional[2];
+    int positionalCount = 0;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--format" && i + 1 < argc) {
+            std::string format = argv[++i];
+            if (format == "auto") {
+                options.format = FormatChoice::Auto;
+            } else if (format == "bc1") {
+                options.format = FormatChoice::BC1;
+            } else if (format == "bc3") {
+                options.format = FormatChoice::BC3;
+            } else if (format == "bc7") {
+                options.format = FormatChoice::BC7;
+            } else if (format == "rgba8") {
+                options.format = FormatChoice::RGBA8;
+            } else {
+                return false;
+            }
+        } else if (arg == "--linear") {
+            options.srgb = false;
+        } else if (arg == "--levels" && i + 1 < argc) {
+            int levels = std::atoi(argv[++i]);
+            if (levels < 1 || levels > static_cast<int>(SFE::TEXTURE_FILE_MAX_LEVELS)) return false;
+            options.maxLevels = static_cast<uint32_t>(levels);
+        } else if (arg == "--report" && i + 1 < argc) {
+            options.reportPath = argv[++i];
+        } else if (!arg.empty() && arg[0] != '-' && positionalCount < 2) {
+            positional[positionalCount++] = arg;
+        } else {
+            return false;
+        }
+    }
+    options.inputPath = positional[0];
+    options.outputPath = positional[1];
+    return positionalCount == 2;
+}
+
+SFE::TextureFileFormat resolveFormat(FormatChoice choice, const uint8_t* rgba, size_t texelCount) {
+    switch (choice) {
+    case FormatChoice::RGBA8: return SFE::TextureFileFormat::RGBA8;
+    case FormatChoice::BC1: return SFE::TextureFileFormat::BC1;
+    case FormatChoice::BC3: return SFE::TextureFileFormat::BC3;
+    case FormatChoice::BC7: return SFE::TextureFileFormat::BC7;
+    case FormatChoice::Auto: break;
+    }
+    for (size_t i = 0; i < texelCount; ++i) {
+        if (rgba[i * 4 + 3] != 255) return SFE::TextureFileFormat::BC3;
+    }
+    return SFE::TextureFileFormat::BC1;
+}
+
+void appendReport(const std::string& path, const std::string& asset, SFE::TextureFileFormat format, uint32_t width,
+                  uint32_t height, size_t uncompressedBytes, size_t cookedBytes, double psnr) {
+    bool writeHeader = !std::ifstream(path).good();
+    std::ofstream csv(path, std::ios::app);
+    if (!csv.is_open()) {
+        std::cerr << "texture_cooker: cannot write report " << path << std::endl;
+        return;
+    }
+    if (writeHeader) {
+        csv << "Asset,Format,Width,Height,UncompressedBytes,CookedBytes,PSNR\n";
+    }
+    csv << asset << "," << SFE::getTextureFileFormatName(format) << "," << width << "," << height << ","
+        << uncompressedBytes << "," << cookedBytes << "," << psnr << "\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    CookerOptions options;
+    if (!parseArguments(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    // Rows bottom to top, like Texture::loadFromFile
+    stbi_set_flip_vertically_on_load(true);
+    int width, height, channels;
+    uint8_t* pixels = stbi_load(options.inputPath.c_str(), &width, &height, &channels, 4);
+    if (!pixels) {
+        std::cerr << "texture_cooker: cannot load " << options.inputPath << ": " << stbi_failure_reason() << std::endl;
+        return 1;
+    }
+
+    SFE::TextureFileFormat format = resolveFormat(options.format, pixels, size_t(width) * height);
+    std::vector<SFE::TextureMipLevel> chain =
+        SFE::generateMipChain(pixels, static_cast<uint32_t>(width), static_cast<uint32_t>(height), options.srgb,
+                              options.maxLevels);
+    stbi_image_free(pixels);
+
+    std::vector<std::vector<uint8_t>> levels;
+    std::vector<const uint8_t*> levelData;
+    size_t uncompressedBytes = 0, cookedBytes = 0;
+    for (const SFE::TextureMipLevel& level : chain) {
+        levels.push_back(SFE::compressTexture(format, level.pixels.data(), level.width, level.height));
+        uncompressedBytes += level.pixels.size();
+        cookedBytes += levels.back().size();
+    }
+    for (const auto& level : levels) levelData.push_back(level.data());
+
+    std::vector<uint8_t> decoded = SFE::decompressTexture(format, levels[0].data(), chain[0].width, chain[0].height);
+    double psnr = SFE::computeTexturePsnr(chain[0].pixels.data(), decoded.data(), chain[0].width, chain[0].height);
+
+    SFE::TextureFileDesc desc;
+    desc.format = format;
+    desc.flags = options.srgb ? SFE::TEXTURE_FILE_SRGB | SFE::TEXTURE_FILE_LINEAR_MIPS : 0;
+    desc.width = chain[0].width;
+    desc.height = chain[0].height;
+    desc.levelCount = static_cast<uint32_t>(levelData.size());
+    desc.levelData = levelData.data();
+    if (!SFE::writeTextureFile(options.outputPath, desc)) {
+        std::cerr << "texture_cooker: failed to write " << options.outputPath << std::endl;
+        return 1;
+    }
+    if (!options.reportPath.empty()) {
+        appendReport(options.reportPath, options.inputPath, format, desc.width, desc.height, uncompressedBytes,
+                     cookedBytes, psnr);
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - startTime;
+    std::cout << "texture_cooker: " << options.inputPath << " -> " << options.outputPath << " ("
+              << desc.width << "x" << desc.height << " " << SFE::getTextureFileFormatName(format) << ", "
+              << desc.levelCount << " levels, " << uncompressedBytes / 1024.0 << " KB -> " << cookedBytes / 1024.0
+              << " KB, PSNR " << psnr << " dB, " << elapsed.count() * 1000.0 << " ms)" << std::endl;
+    return 0;
+}